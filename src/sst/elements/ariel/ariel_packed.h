@@ -0,0 +1,244 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_ARIEL_PACKED_H
+#define SST_ARIEL_PACKED_H
+
+/*
+ * Compact encoding of the per-instruction command stream.
+ *
+ * Like ariel_shmem.h this file is compiled into both Ariel and the Pin3
+ * pintool and must stay PinCRT compatible (no RTTI, no C++11).
+ *
+ * A batch is carried in a single ARIEL_PACKED_BATCH ArielCommand. Each record
+ * starts with a header byte, bits 0-2 give the record type and the remaining
+ * bits are type specific:
+ *
+ *   READ/WRITE/WRITE_PAYLOAD  bits 3-6 log2(size), bit 7 set when the size is
+ *                             not a power of two and follows as a varint.
+ *                             Followed by the zig-zag varint delta between the
+ *                             address and the end of the previous access, then
+ *                             for WRITE_PAYLOAD min(size, ARIEL_MAX_PAYLOAD_SIZE)
+ *                             bytes of data.
+ *   START_INSTRUCTION         bits 3-5 instruction class, followed by the SIMD
+ *                             element count as a varint.
+ *   END_INSTRUCTION, NOOP     no further fields.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+enum ArielPackedRecord_t {
+    ARIEL_PACKED_NOOP = 0,
+    ARIEL_PACKED_READ = 1,
+    ARIEL_PACKED_WRITE = 2,
+    ARIEL_PACKED_WRITE_PAYLOAD = 3,
+    ARIEL_PACKED_START_INSTRUCTION = 4,
+    ARIEL_PACKED_END_INSTRUCTION = 5
+};
+
+struct ArielPackedEntry {
+    ArielPackedRecord_t type;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t instClass;
+    uint32_t simdElemCount;
+    const uint8_t* payload;
+};
+
+/* Fills one ARIEL_PACKED_BATCH command, the caller sends it when an append fails */
+class ArielPackedWriter {
+public:
+    ArielPackedWriter() : lastAddr(0) { reset(); }
+
+    void reset() {
+        cmd.command = ARIEL_PACKED_BATCH;
+        cmd.instPtr = 0;
+        cmd.packed.count = 0;
+        cmd.packed.length = 0;
+    }
+
+    bool empty() const { return 0 == cmd.packed.count; }
+    ArielCommand& getCommand() { return cmd; }
+
+    bool appendNoOp() { return appendMarker(ARIEL_PACKED_NOOP); }
+    bool appendEndInstruction() { return appendMarker(ARIEL_PACKED_END_INSTRUCTION); }
+
+    bool appendStartInstruction(uint32_t instClass, uint32_t simdElemCount) {
+        uint8_t rec[1 + 5];
+        uint32_t len = 0;
+
+        rec[len++] = (uint8_t) (ARIEL_PACKED_START_INSTRUCTION | ((instClass & 0x7) << 3));
+        len += putVarint(&rec[len], simdElemCount);
+
+        return append(rec, len, NULL, 0);
+    }
+
+    bool appendAccess(ArielPackedRecord_t type, uint64_t addr, uint32_t size, const uint8_t* payload) {
+        uint8_t rec[1 + 5 + 10];
+        uint32_t len = 0;
+        uint32_t log2Size = 0;
+
+        while ( (1U << log2Size) < size && log2Size < 15 ) {
+            log2Size++;
+        }
+
+        if ( (1U << log2Size) == size ) {
+            rec[len++] = (uint8_t) (type | (log2Size << 3));
+        } else {
+            rec[len++] = (uint8_t) (type | 0x80);
+            len += putVarint(&rec[len], size);
+        }
+
+        const int64_t delta = (int64_t) (addr - lastAddr);
+        len += putVarint(&rec[len], ((uint64_t) delta << 1) ^ (uint64_t) (delta >> 63));
+
+        const uint32_t payloadLen = (ARIEL_PACKED_WRITE_PAYLOAD == type) ?
+            (size < ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE) : 0;
+
+        if ( ! append(rec, len, payload, payloadLen) ) {
+            return false;
+        }
+
+        lastAddr = addr + size;
+        return true;
+    }
+
+private:
+    bool appendMarker(ArielPackedRecord_t type) {
+        uint8_t rec = (uint8_t) type;
+        return append(&rec, 1, NULL, 0);
+    }
+
+    bool append(const uint8_t* rec, uint32_t len, const uint8_t* payload, uint32_t payloadLen) {
+        if ( cmd.packed.length + len + payloadLen > ARIEL_PACKED_BATCH_BYTES ) {
+            return false;
+        }
+
+        memcpy(&cmd.packed.data[cmd.packed.length], rec, len);
+        cmd.packed.length += len;
+
+        if ( payloadLen > 0 ) {
+            memcpy(&cmd.packed.data[cmd.packed.length], payload, payloadLen);
+            cmd.packed.length += payloadLen;
+        }
+
+        cmd.packed.count++;
+        return true;
+    }
+
+    static uint32_t putVarint(uint8_t* buffer, uint64_t value) {
+        uint32_t len = 0;
+
+        while ( value >= 0x80 ) {
+            buffer[len++] = (uint8_t) (value | 0x80);
+            value >>= 7;
+        }
+
+        buffer[len++] = (uint8_t) value;
+        return len;
+    }
+
+    ArielCommand cmd;
+    uint64_t lastAddr;
+};
+
+/* Walks the records of an ARIEL_PACKED_BATCH command, the address state persists across batches */
+class ArielPackedReader {
+public:
+    ArielPackedReader() : cmd(NULL), offset(0), remaining(0), lastAddr(0) {}
+
+    void start(const ArielCommand* batch) {
+        cmd = batch;
+        offset = 0;
+        remaining = batch->packed.count;
+    }
+
+    bool next(ArielPackedEntry& entry) {
+        if ( 0 == remaining ) {
+            return false;
+        }
+
+        const uint8_t header = cmd->packed.data[offset++];
+        entry.type = (ArielPackedRecord_t) (header & 0x7);
+        entry.addr = 0;
+        entry.size = 0;
+        entry.instClass = 0;
+        entry.simdElemCount = 0;
+        entry.payload = NULL;
+
+        switch ( entry.type ) {
+        case ARIEL_PACKED_READ:
+        case ARIEL_PACKED_WRITE:
+        case ARIEL_PACKED_WRITE_PAYLOAD:
+            {
+                if ( header & 0x80 ) {
+                    entry.size = (uint32_t) getVarint();
+                } else {
+                    entry.size = 1U << ((header >> 3) & 0xF);
+                }
+
+                const uint64_t zz = getVarint();
+                entry.addr = lastAddr + (uint64_t) ((int64_t) (zz >> 1) ^ -((int64_t) (zz & 1)));
+                lastAddr = entry.addr + entry.size;
+
+                if ( ARIEL_PACKED_WRITE_PAYLOAD == entry.type ) {
+                    entry.payload = &cmd->packed.data[offset];
+                    offset += entry.size < ARIEL_MAX_PAYLOAD_SIZE ? entry.size : ARIEL_MAX_PAYLOAD_SIZE;
+                }
+            }
+            break;
+        case ARIEL_PACKED_START_INSTRUCTION:
+            entry.instClass = (header >> 3) & 0x7;
+            entry.simdElemCount = (uint32_t) getVarint();
+            break;
+        default:
+            break;
+        }
+
+        remaining--;
+        return true;
+    }
+
+private:
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        uint32_t shift = 0;
+        uint8_t byte;
+
+        do {
+            byte = cmd->packed.data[offset++];
+            value |= ((uint64_t) (byte & 0x7F)) << shift;
+            shift += 7;
+        } while ( byte & 0x80 );
+
+        return value;
+    }
+
+    const ArielCommand* cmd;
+    uint32_t offset;
+    uint32_t remaining;
+    uint64_t lastAddr;
+};
+
+}
+}
+
+#endif
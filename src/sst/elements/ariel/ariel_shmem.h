@@ -45,6 +45,10 @@
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
 
+/* Bytes of encoded records carried by one ARIEL_PACKED_BATCH command (see ariel_packed.h),
+ * sized so the batch does not grow ArielCommand beyond the inst member */
+#define ARIEL_PACKED_BATCH_BYTES 84
+
 namespace SST {
 namespace ArielComponent {
 
@@ -68,6 +72,7 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_PACKED_BATCH = 160,
 };
 
 #ifdef HAVE_CUDA
@@ -175,6 +180,11 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        struct {
+            uint16_t count;
+            uint16_t length;
+            uint8_t  data[ARIEL_PACKED_BATCH_BYTES];
+        } packed;
         struct {
             void* inp_ptr;
             void* ctrl_ptr;
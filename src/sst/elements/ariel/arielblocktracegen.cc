@@ -0,0 +1,81 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+
+
+#include "arielblocktracegen.h"
+
+using namespace SST::ArielComponent;
+using namespace SST::Prospero;
+
+ArielBlockTraceGenerator::ArielBlockTraceGenerator(Params& params) :
+    ArielTraceGenerator() {
+
+    output = new Output("ArielBlockTraceGenerator: ", 0, 0, Output::STDOUT);
+
+    tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
+    coreID = 0;
+
+    const std::string codecName = params.find<std::string>("codec", PROSPERO_BLOCK_DEFAULT_CODEC_NAME);
+    if(! prosperoBlockCodecFromName(codecName, codec)) {
+        output->fatal(CALL_INFO, -1, "Unknown trace codec: %s (or codec is not available in this build)\n", codecName.c_str());
+    }
+
+    const std::string layout = params.find<std::string>("layout", "columnar");
+    if(! prosperoBlockFlagsFromLayout(layout, flags)) {
+        output->fatal(CALL_INFO, -1, "Unknown trace layout: %s, must be rows or columnar\n", layout.c_str());
+    }
+
+    recordsPerBlock = params.find<uint32_t>("records_per_block", PROSPERO_BLOCK_DEFAULT_RECORDS);
+    flushBuffers = params.find<uint32_t>("flush_buffers", PROSPERO_BLOCK_DEFAULT_FLUSH_BUFFERS);
+
+    if(0 == recordsPerBlock) {
+        output->fatal(CALL_INFO, -1, "records_per_block must be greater than zero\n");
+    }
+}
+
+ArielBlockTraceGenerator::~ArielBlockTraceGenerator() {
+    if(! writer.close()) {
+        output->fatal(CALL_INFO, -1, "Error finishing trace for core %" PRIu32 ": %s\n",
+            coreID, writer.getError().c_str());
+    }
+
+    delete output;
+}
+
+void ArielBlockTraceGenerator::publishEntry(const uint64_t picoS,
+    const uint64_t physAddr, const uint32_t reqLength,
+    const ArielTraceEntryOperation op) {
+
+    if(! writer.append(picoS, physAddr, reqLength, (op == WRITE))) {
+        output->fatal(CALL_INFO, -1, "Error writing trace for core %" PRIu32 ": %s\n",
+            coreID, writer.getError().c_str());
+    }
+}
+
+void ArielBlockTraceGenerator::setCoreID(const uint32_t core) {
+    coreID = core;
+
+    size_t size = sizeof(char) * PATH_MAX;
+    char* tracePath = (char*) malloc(size);
+    snprintf(tracePath, size, "%s-%" PRIu32 ".trace.blk", tracePrefix.c_str(), core);
+
+    if(! writer.open(tracePath, codec, recordsPerBlock, flags, flushBuffers)) {
+        output->fatal(CALL_INFO, -1, "Error opening trace for core %" PRIu32 ": %s\n",
+            core, writer.getError().c_str());
+    }
+
+    free(tracePath);
+}
@@ -0,0 +1,75 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_BLOCK_TRACE_GEN
+#define _H_SST_ARIEL_BLOCK_TRACE_GEN
+
+#include <climits>
+
+#include <sst/core/params.h>
+#include <sst/core/output.h>
+#include <sst/elements/prospero/prosblockwriter.h>
+
+#include "arieltracegen.h"
+
+namespace SST {
+namespace ArielComponent {
+
+class ArielBlockTraceGenerator : public ArielTraceGenerator {
+
+    public:
+        SST_ELI_REGISTER_MODULE(
+            ArielBlockTraceGenerator,
+            "ariel",
+            "BlockTraceGenerator",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Provides tracing to buffered, block compressed binary files which can be replayed by prospero.ProsperoBlockTraceReader",
+            SST::ArielComponent::ArielTraceGenerator
+        )
+
+        SST_ELI_DOCUMENT_PARAMS(
+            { "trace_prefix", "Sets the prefix for the trace file, the core number and .trace.blk are appended", "ariel-core" },
+            { "codec", "Block compression, none or zlib", PROSPERO_BLOCK_DEFAULT_CODEC_NAME },
+            { "layout", "Block layout, rows or columnar (columnar compresses better)", "columnar" },
+            { "records_per_block", "Number of trace entries buffered into each block", "65536" },
+            { "flush_buffers", "Number of blocks which can be waiting to be compressed and written before tracing stalls", "4" }
+        )
+
+        ArielBlockTraceGenerator(Params& params);
+
+        ~ArielBlockTraceGenerator();
+
+        void publishEntry(const uint64_t picoS, const uint64_t physAddr,
+                const uint32_t reqLength, const ArielTraceEntryOperation op);
+
+        void setCoreID(const uint32_t core);
+
+    private:
+        Output* output;
+        SST::Prospero::ProsperoBlockTraceWriter writer;
+        std::string tracePrefix;
+        uint32_t coreID;
+        uint32_t codec;
+        uint32_t flags;
+        uint32_t recordsPerBlock;
+        uint32_t flushBuffers;
+
+};
+
+}
+}
+
+#endif
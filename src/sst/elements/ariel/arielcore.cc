@@ -59,9 +59,12 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
-    pendingTransactions = new std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>();
+    // Leave headroom for a full packed batch (at least a byte per record) arriving at the queue limit
+    coreQ = new ArielEventRing(maxQLength + ARIEL_PACKED_BATCH_BYTES);
+    pendingTransactions = new ArielPendingRequestSet(maxPendingTransactions + 2);
     pending_transaction_count = 0;
+    events_processed = 0;
+    eventClockStarted = false;
 
 #ifdef HAVE_CUDA
     midTransfer = false;
@@ -91,6 +94,8 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     statInstructionCount = registerStatistic<uint64_t>( "instruction_count", subID );
     statCycles = registerStatistic<uint64_t>( "cycles", subID );
     statActiveCycles = registerStatistic<uint64_t>( "active_cycles", subID );
+    statEventsProcessed = registerStatistic<uint64_t>( "events_processed", subID );
+    statEventsPerSecond = registerStatistic<uint64_t>( "events_per_second", subID );
 
     statFPSPIns = registerStatistic<uint64_t>("fp_sp_ins", subID);
     statFPDPIns = registerStatistic<uint64_t>("fp_dp_ins", subID);
@@ -138,6 +143,8 @@ ArielCore::~ArielCore() {
     }
 
     delete stdMemHandlers;
+    delete coreQ;
+    delete pendingTransactions;
 }
 
 void ArielCore::setCacheLink(StandardMem* newLink) {
@@ -179,7 +186,7 @@ void ArielCore::commitReadEvent(const uint64_t address,
         }else {
 #endif
             pending_transaction_count++;
-            pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+            pendingTransactions->insert(req->getID());
 #ifdef HAVE_CUDA
         }
 #endif
@@ -218,7 +225,7 @@ void ArielCore::commitWriteEvent(const uint64_t address,
             data.resize(length, 0);
         }
         
-        StandardMem::Write *req = new StandardMem::Write(address, length, data, false, 0, virtAddress);
+        StandardMem::Write *req = new StandardMem::Write(address, length, std::move(data), false, 0, virtAddress);
 
 #ifdef HAVE_CUDA
         if(isGpuEx()){
@@ -227,7 +234,7 @@ void ArielCore::commitWriteEvent(const uint64_t address,
         } else{
 #endif
             pending_transaction_count++;
-            pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+            pendingTransactions->insert(req->getID());
 #ifdef HAVE_CUDA
         }
 #endif
@@ -251,7 +258,7 @@ void ArielCore::commitFlushEvent(const uint64_t address,
         /*  Todo: should the request specify the physical address, or the virtual address? */
         StandardMem::Request *req = new StandardMem::FlushAddr( address, length, true, std::numeric_limits<uint32_t>::max());
         pending_transaction_count++;
-        pendingTransactions->insert( std::pair<StandardMem::Request::id_t, StandardMem::Request*>(req->getID(), req) );
+        pendingTransactions->insert(req->getID());
 
         cacheLink->send(req);
         statFlushRequests->addData(1);
@@ -261,7 +268,6 @@ void ArielCore::commitFlushEvent(const uint64_t address,
 void ArielCore::handleEvent(StandardMem::Request* event) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " handling a memory event.\n", coreID));
     StandardMem::Request::id_t mev_id = event->getID();
-    auto find_entry = pendingTransactions->find(mev_id);
 
 #ifdef HAVE_CUDA
     if(pendingGpuTransactions->find(mev_id) != pendingGpuTransactions->end()){
@@ -476,14 +482,13 @@ void ArielCore::handleEvent(StandardMem::Request* event) {
                 }
             }
         }
-    }else if(find_entry != pendingTransactions->end()) {
+    }else if(pendingTransactions->erase(mev_id)) {
 #else
-    if(find_entry != pendingTransactions->end()) {
+    if(pendingTransactions->erase(mev_id)) {
 #endif
-        ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Correctly identified event in pending transactions, removing from list, before there are: %" PRIu32 " transactions pending.\n",
+        ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Correctly identified event in pending transactions, removing from list, now there are: %" PRIu32 " transactions pending.\n",
                             (uint32_t) pendingTransactions->size()));
 
-        pendingTransactions->erase(find_entry);
         pending_transaction_count--;
         if(isCoreFenced() && pending_transaction_count == 0)
             unfence();
@@ -547,6 +552,14 @@ bool ArielCore::handleInterrupt(ArielMemoryManager::InterruptAction action) {
 }
 
 void ArielCore::finishCore() {
+    if(events_processed > 0) {
+        const double seconds = std::chrono::duration<double>(lastEventTime - firstEventTime).count();
+
+        if(seconds > 0.0) {
+            statEventsPerSecond->addData((uint64_t) (events_processed / seconds));
+        }
+    }
+
     // Close the trace file if we did in fact open it.
     if(enableTracing && traceGen) {
         delete traceGen;
@@ -665,28 +678,26 @@ void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
     ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    coreQ->pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    coreQ->pushNoOp();
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    coreQ->pushRead(address, length);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    coreQ->pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
@@ -694,7 +705,7 @@ void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t le
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    coreQ->pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
@@ -702,35 +713,40 @@ void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
     ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    coreQ->pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    if(length > ARIEL_MAX_PAYLOAD_SIZE) {
+        // Too large for the inline payload (xsave and friends)
+        coreQ->pushEvent(new ArielWriteEvent(address, length, payload));
+    } else {
+        // The payload is only consumed when payload tracing is enabled
+        coreQ->pushWrite(address, length, writePayloads ? payload : nullptr);
+    }
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
     ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    coreQ->pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
     ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    coreQ->pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
     ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    coreQ->pushEvent(xEv);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -751,7 +767,7 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
     Ev->set_rtl_inp_size(inp_size);
     Ev->set_rtl_ctrl_size(ctrl_size);
     Ev->set_updated_rtl_params_size(updated_rtl_params_size);
-    coreQ->push(Ev);
+    coreQ->pushEvent(Ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a RTL event.\n"));
 }
@@ -759,7 +775,7 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
     ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    coreQ->pushEvent(gEv);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
@@ -859,29 +875,7 @@ bool ArielCore::refillQueue() {
                 break;
 
             case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+                recordInstructionClass(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
@@ -914,6 +908,10 @@ bool ArielCore::refillQueue() {
                 createNoOpEvent();
                 break;
 
+            case ARIEL_PACKED_BATCH:
+                unpackCommands(ac);
+                break;
+
             case ARIEL_FLUSHLINE_INSTRUCTION:
                 createFlushEvent(ac.flushline.vaddr);
                 break;
@@ -962,6 +960,80 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
+void ArielCore::recordInstructionClass(uint32_t instClass, uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+            statFPSPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPSPSIMDIns->addData(1);
+            } else {
+                statFPSPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 32)
+                statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+            statFPDPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPDPSIMDIns->addData(1);
+            } else {
+                statFPDPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 16)
+                statFPDPOps->addData(simdElemCount);
+    }
+}
+
+// A packed batch may split an instruction's records across two batches, each
+// record is handled on its own so no state other than the reader's is kept
+void ArielCore::unpackCommands(const ArielCommand& ac) {
+    ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Core %" PRIu32 " unpacking batch of %" PRIu16 " records (%" PRIu16 " bytes)\n",
+                        coreID, ac.packed.count, ac.packed.length));
+
+    ArielPackedEntry entry;
+    packedReader.start(&ac);
+
+    while(packedReader.next(entry)) {
+        switch(entry.type) {
+            case ARIEL_PACKED_READ:
+                createReadEvent(entry.addr, entry.size);
+                break;
+
+            case ARIEL_PACKED_WRITE:
+                createWriteEvent(entry.addr, entry.size, nullptr);
+                break;
+
+            case ARIEL_PACKED_WRITE_PAYLOAD:
+                if(entry.size > ARIEL_MAX_PAYLOAD_SIZE) {
+                    // only the first ARIEL_MAX_PAYLOAD_SIZE bytes travel in the batch
+                    std::vector<uint8_t> payload(entry.size, 0);
+                    memcpy(payload.data(), entry.payload, ARIEL_MAX_PAYLOAD_SIZE);
+                    createWriteEvent(entry.addr, entry.size, payload.data());
+                } else {
+                    createWriteEvent(entry.addr, entry.size, entry.payload);
+                }
+                break;
+
+            case ARIEL_PACKED_START_INSTRUCTION:
+                recordInstructionClass(entry.instClass, entry.simdElemCount);
+                break;
+
+            case ARIEL_PACKED_END_INSTRUCTION:
+                break;
+
+            case ARIEL_PACKED_NOOP:
+                createNoOpEvent();
+                break;
+
+            default:
+                output->fatal(CALL_INFO, -1, "Error: Ariel did not understand packed record (%d) provided during instruction queue refill.\n", (int)(entry.type));
+                break;
+        }
+    }
+}
+
 void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
 
@@ -969,10 +1041,13 @@ void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
 }
 
 void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
+    handleReadRequest(rEv->getAddress(), rEv->getLength());
+}
+
+void ArielCore::handleReadRequest(const uint64_t readAddress, const uint32_t length) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a read event...\n", coreID));
 
-    const uint64_t readAddress = rEv->getAddress();
-    const uint64_t readLength  = std::min((uint64_t) rEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t readLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     /* No longer neccessary due to trimming above
      * if(readLength > cacheLineSize) {
@@ -1043,10 +1118,13 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
 }
 
 void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
+    handleWriteRequest(wEv->getAddress(), wEv->getLength(), wEv->getPayload());
+}
+
+void ArielCore::handleWriteRequest(const uint64_t writeAddress, const uint32_t length, const uint8_t* payload) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a write event...\n", coreID));
 
-    const uint64_t writeAddress = wEv->getAddress();
-    const uint64_t writeLength  = std::min((uint64_t) wEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t writeLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     // No longer neccessary due to trimming above
 /*    if(writeLength > cacheLineSize) {
@@ -1076,8 +1154,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
                             coreID, writeAddress, writeLength, physAddr));
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payload);
         } else {
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
         }
@@ -1116,9 +1193,8 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         }
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payload);
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payload[leftSize]);
         } else {
             commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL);
             commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL);
@@ -1428,10 +1504,11 @@ bool ArielCore::processNextEvent() {
 
     ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Processing next event in core %" PRIu32 "...\n", coreID));
 
-    ArielEvent* nextEvent = coreQ->front();
+    ArielQueuedEvent& next = coreQ->front();
+    ArielEvent* nextEvent = next.event;
     bool removeEvent = false;
 
-    switch(nextEvent->getEventType()) {
+    switch(next.type) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
                 statInstructionCount->addData(1);
@@ -1449,7 +1526,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(next.address, next.length);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1465,7 +1542,11 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    if(nullptr == nextEvent) {
+                        handleWriteRequest(next.address, next.length, next.payload);
+                    } else {
+                        handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    }
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1562,10 +1643,13 @@ bool ArielCore::processNextEvent() {
         coreQ->pop();
 
         delete nextEvent;
+
+        events_processed++;
+        statEventsProcessed->addData(1);
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
-                            (uint32_t)pendingTransactions->size(), maxPendingTransactions));
+                            pendingTransactions->size(), maxPendingTransactions));
         return false;
     }
 }
@@ -1600,6 +1684,13 @@ void ArielCore::tick() {
 
         if( updateCycle ) {
                 statActiveCycles->addData(1);
+
+                // One clock read per active cycle rather than per event
+                lastEventTime = std::chrono::steady_clock::now();
+                if(!eventClockStarted) {
+                    firstEventTime = lastEventTime;
+                    eventClockStarted = true;
+                }
         }
     }
 
@@ -32,11 +32,12 @@
 #include <poll.h>
 
 #include <string>
-#include <queue>
+#include <chrono>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
 #include "arielevent.h"
+#include "arieleventring.h"
 #include "arielreadev.h"
 #include "arielwriteev.h"
 #include "arielexitev.h"
@@ -50,6 +51,7 @@
 #include "tb_header.h"
 
 #include "ariel_shmem.h"
+#include "ariel_packed.h"
 #include "arieltracegen.h"
 
 #ifdef HAVE_CUDA
@@ -148,7 +150,9 @@ class ArielCore : public ComponentExtension {
 
         void handleEvent(StandardMem::Request* event);
         void handleReadRequest(ArielReadEvent* wEv);
+        void handleReadRequest(const uint64_t readAddress, const uint32_t length);
         void handleWriteRequest(ArielWriteEvent* wEv);
+        void handleWriteRequest(const uint64_t writeAddress, const uint32_t length, const uint8_t* payload);
         void handleAllocationEvent(ArielAllocateEvent* aEv);
         void handleMmapEvent(ArielMmapEvent* aEv);
         void handleFreeEvent(ArielFreeEvent* aFE);
@@ -194,6 +198,8 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        void unpackCommands(const ArielCommand& ac);
+        void recordInstructionClass(uint32_t instClass, uint32_t simdElemCount);
         bool writePayloads;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
@@ -217,13 +223,14 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventRing* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
 
         StandardMem* cacheLink;
         ArielTunnel *tunnel;
+        ArielPackedReader packedReader;
         StdMemHandler* stdMemHandlers;
         Link* RtlLink;
 
@@ -234,7 +241,7 @@ class ArielCore : public ComponentExtension {
         std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>* pendingGpuTransactions;
 #endif
 
-        std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>* pendingTransactions;
+        ArielPendingRequestSet* pendingTransactions;
         uint32_t maxIssuePerCycle;
         uint32_t maxQLength;
         uint64_t cacheLineSize;
@@ -267,6 +274,8 @@ class ArielCore : public ComponentExtension {
         Statistic<uint64_t>* statInstructionCount;
         Statistic<uint64_t>* statCycles;
         Statistic<uint64_t>* statActiveCycles;
+        Statistic<uint64_t>* statEventsProcessed;
+        Statistic<uint64_t>* statEventsPerSecond;
 
         Statistic<uint64_t>* statFPDPIns;
         Statistic<uint64_t>* statFPDPSIMDIns;
@@ -280,6 +289,12 @@ class ArielCore : public ComponentExtension {
         uint32_t pending_transaction_count;
         uint32_t pending_gpu_transaction_count;
 
+        // Wall-clock span over which this core processed events
+        uint64_t events_processed;
+        bool eventClockStarted;
+        std::chrono::steady_clock::time_point firstEventTime;
+        std::chrono::steady_clock::time_point lastEventTime;
+
 };
 
 }
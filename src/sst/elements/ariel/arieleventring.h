@@ -0,0 +1,260 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_EVENT_RING
+#define _H_SST_ARIEL_EVENT_RING
+
+#include <stdint.h>
+#include <cstring>
+#include <vector>
+
+#include "arielevent.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * A queued core event. Reads, writes and no-ops, which make up nearly
+ * all of the traffic from the frontend, are held by value in the slot.
+ * Everything else (and writes too large for the inline payload) is
+ * carried as a heap ArielEvent which the core deletes once processed.
+ */
+struct ArielQueuedEvent {
+    ArielEventType type;
+    uint32_t length;
+    uint64_t address;
+    ArielEvent* event;
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+};
+
+/*
+ * Per-core FIFO of queued events. The slots are allocated once and reused,
+ * the ring only grows (doubling) if a single instruction's worth of
+ * commands does not fit in the capacity given at construction.
+ */
+class ArielEventRing {
+
+    public:
+        ArielEventRing(uint32_t initialCapacity) :
+                head(0), count(0) {
+            uint32_t cap = 1;
+            while(cap < initialCapacity) {
+                cap <<= 1;
+            }
+
+            slots.resize(cap);
+            mask = cap - 1;
+        }
+
+        ~ArielEventRing() {
+            while(count > 0) {
+                delete slots[head].event;
+                pop();
+            }
+        }
+
+        bool empty() const {
+            return 0 == count;
+        }
+
+        uint32_t size() const {
+            return count;
+        }
+
+        uint32_t capacity() const {
+            return (uint32_t) slots.size();
+        }
+
+        ArielQueuedEvent& front() {
+            return slots[head];
+        }
+
+        void pop() {
+            head = (head + 1) & mask;
+            count--;
+        }
+
+        void pushNoOp() {
+            ArielQueuedEvent& slot = claim();
+            slot.type = NOOP;
+            slot.event = nullptr;
+        }
+
+        void pushRead(uint64_t address, uint32_t length) {
+            ArielQueuedEvent& slot = claim();
+            slot.type = READ_ADDRESS;
+            slot.address = address;
+            slot.length = length;
+            slot.event = nullptr;
+        }
+
+        // A null payload is stored as zeroes, length must fit the inline payload
+        void pushWrite(uint64_t address, uint32_t length, const uint8_t* payload) {
+            ArielQueuedEvent& slot = claim();
+            slot.type = WRITE_ADDRESS;
+            slot.address = address;
+            slot.length = length;
+            slot.event = nullptr;
+
+            if(nullptr == payload) {
+                memset(slot.payload, 0, length);
+            } else {
+                memcpy(slot.payload, payload, length);
+            }
+        }
+
+        void pushEvent(ArielEvent* ev) {
+            ArielQueuedEvent& slot = claim();
+            slot.type = ev->getEventType();
+            slot.event = ev;
+        }
+
+    private:
+        ArielQueuedEvent& claim() {
+            if(count == slots.size()) {
+                grow();
+            }
+
+            ArielQueuedEvent& slot = slots[(head + count) & mask];
+            count++;
+            return slot;
+        }
+
+        void grow() {
+            std::vector<ArielQueuedEvent> larger(slots.size() * 2);
+
+            for(uint32_t i = 0; i < count; ++i) {
+                larger[i] = slots[(head + i) & mask];
+            }
+
+            slots.swap(larger);
+            mask = (uint32_t) slots.size() - 1;
+            head = 0;
+        }
+
+        std::vector<ArielQueuedEvent> slots;
+        uint32_t mask;
+        uint32_t head;
+        uint32_t count;
+
+};
+
+/*
+ * Set of outstanding StandardMem request IDs. Request IDs are handed out
+ * sequentially so they are used directly as the hash into an open
+ * addressed table; removal uses backward shifting so no tombstones build
+ * up over a long run.
+ */
+class ArielPendingRequestSet {
+
+    public:
+        ArielPendingRequestSet(uint32_t expected) :
+                count(0) {
+            uint32_t cap = 16;
+            while(cap < (expected * 2)) {
+                cap <<= 1;
+            }
+
+            keys.resize(cap);
+            used.resize(cap, 0);
+            mask = cap - 1;
+        }
+
+        uint32_t size() const {
+            return count;
+        }
+
+        void insert(uint64_t id) {
+            if((count + 1) * 2 > keys.size()) {
+                grow();
+            }
+
+            uint32_t i = (uint32_t) (id & mask);
+            while(used[i]) {
+                i = (i + 1) & mask;
+            }
+
+            keys[i] = id;
+            used[i] = 1;
+            count++;
+        }
+
+        // Returns false if the ID was not outstanding
+        bool erase(uint64_t id) {
+            uint32_t i = (uint32_t) (id & mask);
+
+            while(used[i]) {
+                if(keys[i] == id) {
+                    break;
+                }
+                i = (i + 1) & mask;
+            }
+
+            if(!used[i]) {
+                return false;
+            }
+
+            // Shift later members of the probe chain back into the hole
+            uint32_t hole = i;
+            uint32_t j = (i + 1) & mask;
+
+            while(used[j]) {
+                const uint32_t home = (uint32_t) (keys[j] & mask);
+
+                if(((j - home) & mask) >= ((j - hole) & mask)) {
+                    keys[hole] = keys[j];
+                    used[hole] = 1;
+                    hole = j;
+                }
+
+                j = (j + 1) & mask;
+            }
+
+            used[hole] = 0;
+            count--;
+            return true;
+        }
+
+    private:
+        void grow() {
+            std::vector<uint64_t> oldKeys;
+            std::vector<uint8_t> oldUsed;
+            oldKeys.swap(keys);
+            oldUsed.swap(used);
+
+            keys.resize(oldKeys.size() * 2);
+            used.resize(oldKeys.size() * 2, 0);
+            mask = (uint32_t) keys.size() - 1;
+            count = 0;
+
+            for(size_t i = 0; i < oldKeys.size(); ++i) {
+                if(oldUsed[i]) {
+                    insert(oldKeys[i]);
+                }
+            }
+        }
+
+        std::vector<uint64_t> keys;
+        std::vector<uint8_t> used;
+        uint32_t mask;
+        uint32_t count;
+
+};
+
+}
+}
+
+#endif
@@ -19,6 +19,8 @@
 
 #include "arielevent.h"
 
+#include <cstring>
+
 using namespace SST;
 
 namespace SST {
@@ -32,6 +34,12 @@ class ArielWriteEvent : public ArielEvent {
 
                 payload = new uint8_t[length];
 
+                // packed write records without a payload pass no data
+                if( nullptr == payloadData ) {
+                	memset(payload, 0, length);
+                	return;
+                }
+
                 for( int i = 0; i < length; ++i ) {
                 	payload[i] = payloadData[i];
                 }
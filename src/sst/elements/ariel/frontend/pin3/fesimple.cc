@@ -52,6 +52,7 @@
 
 #include <sst/core/interprocess/mmapchild_pin3.h>
 #include "ariel_shmem.h"
+#include "ariel_packed.h"
 #include "ariel_inst_class.h"
 
 #undef __STDC_FORMAT_MACROS
@@ -69,6 +70,7 @@ KNOB<UINT32> StartupMode            (KNOB_MODE_WRITEONCE, "pintool", "s", "1", "
 KNOB<UINT32> InstrumentInstructions (KNOB_MODE_WRITEONCE, "pintool", "E", "1", "Enable instruction instrumentation");
 KNOB<UINT32> PerformWriteTrace      (KNOB_MODE_WRITEONCE, "pintool", "w", "0", "Perform write tracing (i.e copy values directly into SST memory operations) (0 = disabled, 1 = enabled)");
 KNOB<UINT32> TrapFunctionProfile    (KNOB_MODE_WRITEONCE, "pintool", "t", "0", "Function profiling level (0 = disabled, 1 = enabled)");
+KNOB<UINT32> PackCommands           (KNOB_MODE_WRITEONCE, "pintool", "b", "0", "Batch memory operations into compact packed tunnel commands (0 = disabled, 1 = enabled)");
 // Memory/malloc/etc. tracking
 KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "Should intercept multi-level memory allocations, mallocs, and frees, 1 = start enabled, 0 = start disabled");
 KNOB<string> UseMallocMap           (KNOB_MODE_WRITEONCE, "pintool", "u", "",  "Should intercept ariel_malloc_flag() and interpret using a malloc map: specify filename or leave blank for disabled");
@@ -97,6 +99,8 @@ PIN_LOCK mainLock;
 UINT32 instrument_instructions;
 bool writeTrace;
 UINT32 funcProfileLevel;
+bool packCommands;
+ArielPackedWriter* packedWriters;
 typedef struct {
     int64_t insExecuted;
 } ArielFunctionRecord;
@@ -283,16 +287,36 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+/* Send any partially filled packed batch for this thread */
+VOID FlushPackedCommands(UINT32 thr)
+{
+    if(packCommands && thr < core_count && !packedWriters[thr].empty()) {
+        tunnel->writeMessage(thr, packedWriters[thr].getCommand());
+        packedWriters[thr].reset();
+    }
+}
+
+/* Every non-packed command goes through here so it stays ordered after the thread's pending batch */
+VOID WriteTunnelMessage(UINT32 thr, ArielCommand& ac)
+{
+    FlushPackedCommands(thr);
+    tunnel->writeMessage(thr, ac);
+}
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    for(UINT32 i = 0; i < core_count; i++) {
+        FlushPackedCommands(i);
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(0, ac);
+    WriteTunnelMessage(0, ac);
 
     delete tunnelmgr;
 #ifdef HAVE_CUDA
@@ -340,7 +364,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -349,7 +373,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -358,6 +382,14 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
 
     const uint64_t addr64 = (uint64_t) address;
 
+    if(packCommands) {
+        if(!packedWriters[thr].appendAccess(ARIEL_PACKED_READ, addr64, readSize, NULL)) {
+            FlushPackedCommands(thr);
+            packedWriters[thr].appendAccess(ARIEL_PACKED_READ, addr64, readSize, NULL);
+        }
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_READ;
@@ -367,7 +399,7 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
@@ -375,6 +407,23 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
 {
 
     const uint64_t addr64 = (uint64_t) address;
+
+    if(packCommands) {
+        uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+        ArielPackedRecord_t type = ARIEL_PACKED_WRITE;
+
+        if( writeTrace ) {
+            PIN_SafeCopy( &payload[0], address, ARIEL_MIN( writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE ) );
+            type = ARIEL_PACKED_WRITE_PAYLOAD;
+        }
+
+        if(!packedWriters[thr].appendAccess(type, addr64, writeSize, payload)) {
+            FlushPackedCommands(thr);
+            packedWriters[thr].appendAccess(type, addr64, writeSize, payload);
+        }
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_WRITE;
@@ -399,23 +448,41 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     }
     printf("\n");
 */
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
-VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip)
+VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT32 simdOpWidth)
 {
+    if(packCommands) {
+        if(!packedWriters[thr].appendStartInstruction(instClass, simdOpWidth)) {
+            FlushPackedCommands(thr);
+            packedWriters[thr].appendStartInstruction(instClass, simdOpWidth);
+        }
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_START_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    ac.inst.instClass = instClass;
+    ac.inst.simdElemCount = simdOpWidth;
+    WriteTunnelMessage(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
 {
+    if(packCommands) {
+        if(!packedWriters[thr].appendEndInstruction()) {
+            FlushPackedCommands(thr);
+            packedWriters[thr].appendEndInstruction();
+        }
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -425,7 +492,7 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
-            WriteStartInstructionMarker( thr, ip );
+            WriteStartInstructionMarker( thr, ip, instClass, simdOpWidth );
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
             WriteEndInstructionMarker( thr, ip );
@@ -440,7 +507,7 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
     if(enable_output) {
         if(thr < core_count) {
             if (first)
-                WriteStartInstructionMarker(thr, ip);
+                WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             if (last)
                 WriteEndInstructionMarker(thr, ip);
@@ -453,10 +520,18 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
+            if(packCommands) {
+                if(!packedWriters[thr].appendNoOp()) {
+                    FlushPackedCommands(thr);
+                    packedWriters[thr].appendNoOp();
+                }
+                return;
+            }
+
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            WriteTunnelMessage(thr, ac);
         }
     }
 }
@@ -468,7 +543,7 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
     if(enable_output) {
         if(thr < core_count) {
             if (first)
-                WriteStartInstructionMarker(thr, ip);
+                WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
             if (last)
                 WriteEndInstructionMarker(thr, ip);
@@ -691,6 +766,7 @@ void mapped_ariel_enable()
 /* Return the current cycle count from Ariel */
 uint64_t mapped_ariel_cycles()
 {
+    FlushPackedCommands(PIN_ThreadId());
     return tunnel->getCycles();
 }
 
@@ -707,6 +783,7 @@ int mapped_gettimeofday(struct timeval *tp, void *tzp)
     }
 
     if ( tp == NULL ) { errno = EINVAL ; return -1; }
+    FlushPackedCommands(PIN_ThreadId());
     tunnel->getTime(tp);
     tp->tv_sec += offset_tv.tv_sec;
     tp->tv_usec += offset_tv.tv_usec;
@@ -731,6 +808,7 @@ int mapped_clockgettime(clockid_t clock, struct timespec *tp)
     }
 
     if (tp == NULL) { errno = EINVAL; return -1; }
+    FlushPackedCommands(PIN_ThreadId());
     tunnel->getTimeNs(tp);
 
     // Only offset these two clocks -> TODO the others
@@ -753,7 +831,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -763,7 +841,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -817,7 +895,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -845,7 +923,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -897,7 +975,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -952,7 +1030,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -997,7 +1075,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteTunnelMessage(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1049,14 +1127,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteTunnelMessage(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteTunnelMessage(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteTunnelMessage(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1083,7 +1161,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1113,7 +1191,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1154,7 +1232,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1219,7 +1297,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1348,7 +1426,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1396,7 +1474,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1421,7 +1499,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1445,7 +1523,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1468,7 +1546,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1507,7 +1585,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1543,7 +1621,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1571,7 +1649,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteTunnelMessage(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1618,7 +1696,7 @@ void ariel_start_RTL_sim(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteTunnelMessage(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue successfully delivered via ArielTunnel");
     #endif
@@ -1639,7 +1717,7 @@ void ariel_update_RTL_signals(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteTunnelMessage(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue to update RTL signals successfully delivered via ArielTunnel");
     #endif
@@ -1908,6 +1986,13 @@ int main(int argc, char *argv[])
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
 
+    packCommands = PackCommands.Value() > 0;
+    packedWriters = new ArielPackedWriter[core_count];
+
+    if( packCommands && SSTVerbosity.Value() > 0 ) {
+        printf("SSTARIEL: Memory operations will be sent as packed command batches.\n");
+    }
+
 // Pin version specific tunnel attach
     tunnelmgr = new SST::Core::Interprocess::MMAPChild_Pin3<ArielTunnel>(SSTNamedPipe.Value());
     tunnel = tunnelmgr->getTunnel();
@@ -126,7 +126,7 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     appLauncher = params.find<std::string>("launcher", PINTOOL_EXECUTABLE);
 
     const uint32_t launch_param_count = (uint32_t) params.find<uint32_t>("launchparamcount", 0);
-    const uint32_t pin_arg_count = 37 + launch_param_count;
+    const uint32_t pin_arg_count = 39 + launch_param_count;
 
     execute_args = (char**) malloc(sizeof(char*) * (pin_arg_count + app_argc));
 
@@ -184,6 +184,14 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     
     size_t buff8size = sizeof(char)*8;
 
+    execute_args[arg++] = const_cast<char*>("-b");
+
+    if( params.find<int>("packcommands", 0) == 0 ) {
+        execute_args[arg++] = const_cast<char*>("0");
+    } else {
+        execute_args[arg++] = const_cast<char*>("1");
+    }
+
     execute_args[arg++] = const_cast<char*>("-E");
     execute_args[arg++] = (char*) malloc(buff8size);
     snprintf(execute_args[arg-1], buff8size, "%d", instrument_instructions);
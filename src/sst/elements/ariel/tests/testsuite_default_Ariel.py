@@ -3,6 +3,7 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -77,6 +78,11 @@ class testcase_Ariel(SSTTestCase):
     @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
     def test_Ariel_test_snb_mlm(self):
         self.ariel_Template("ariel_snb_mlm", app="stream_mlm")
+
+    @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
+    @unittest.skipIf(testing_check_get_num_ranks() > 1, "Ariel: test_Ariel_blocktrace skipped if ranks > 1")
+    def test_Ariel_blocktrace(self):
+        self.ariel_blocktrace_Template()
 #####
 
     def ariel_Template(self, testcase, app="", testtimeout=480):
@@ -160,6 +166,68 @@ class testcase_Ariel(SSTTestCase):
         if line_count_diff > 15:
             self.assertFalse(line_count_diff > 15, "Line count between output file {0} does not match Reference File {1}; They contain {2} different lines".format(outfile, reffile, line_count_diff))
 
+    def ariel_blocktrace_Template(self, testtimeout=480):
+        # Run stream with ariel.BlockTraceGenerator on core 0, then replay
+        # the block trace with prospero.ProsperoBlockTraceReader. Ariel
+        # traces every request it sends to the cache, so the replay must
+        # issue one request per Ariel request plus one per split request.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        ArielElementDir = os.path.abspath("{0}/../".format(test_path))
+        ArielElementStreamDir = "{0}/frontend/simple/examples/stream".format(ArielElementDir)
+        os.environ["ARIEL_TEST_STREAM_APP"] = "{0}/stream".format(ArielElementStreamDir)
+        os.environ["OMP_EXE"] = "{0}/testopenMP/ompmybarrier/ompmybarrier".format(test_path)
+
+        testDataFileName = "test_Ariel_blocktrace"
+        trace_prefix = "{0}/{1}".format(tmpdir, testDataFileName)
+        os.environ["ARIEL_TEST_TRACE_PREFIX"] = trace_prefix
+        tracefile = "{0}-0.trace.blk".format(trace_prefix)
+        if os.path.isfile(tracefile):
+            os.remove(tracefile)
+
+        sdlfile = "{0}/runstreamBlockTrace.py".format(ArielElementStreamDir)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=ArielElementStreamDir,
+                     mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        self.assertTrue(os.system(cmd) != 0, "Output file {0} contains the word 'FATAL'...".format(outfile))
+        self.assertTrue(os.path.isfile(tracefile), "Block trace {0} was not written".format(tracefile))
+
+        ariel_counts = {}
+        with open(outfile, 'r') as f:
+            for line in f:
+                m = re.search(r"\b(split_read|split_write|read|write)_requests\b[^:]*:\s*Accumulator\s*:\s*Sum\.u64\s*=\s*(\d+)", line)
+                if m:
+                    ariel_counts[m.group(1)] = ariel_counts.get(m.group(1), 0) + int(m.group(2))
+        self.assertEqual(len(ariel_counts), 4, "Output file {0} does not hold the Ariel request statistics".format(outfile))
+
+        replay_sdlfile = os.path.abspath("{0}/../../prospero/tests/array/trace-common.py".format(test_path))
+        replay_outfile = "{0}/{1}_replay.out".format(outdir, testDataFileName)
+        replay_errfile = "{0}/{1}_replay.err".format(outdir, testDataFileName)
+        replay_mpioutfiles = "{0}/{1}_replay.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options=\"--TraceType=block --TraceFile={0}\"'.format(tracefile)
+
+        self.run_sst(replay_sdlfile, replay_outfile, replay_errfile, other_args=otherargs,
+                     mpi_out_files=replay_mpioutfiles, timeout_sec=testtimeout)
+
+        replay_counts = {}
+        with open(replay_outfile, 'r') as f:
+            for line in f:
+                m = re.search(r"- (Reads|Writes) issued:\s*(\d+)", line)
+                if m:
+                    replay_counts[m.group(1)] = int(m.group(2))
+
+        expected_reads = ariel_counts["read"] + ariel_counts["split_read"]
+        expected_writes = ariel_counts["write"] + ariel_counts["split_write"]
+        self.assertEqual(replay_counts.get("Reads"), expected_reads, "Replay of {0} issued {1} reads, Ariel sent {2}".format(tracefile, replay_counts.get("Reads"), expected_reads))
+        self.assertEqual(replay_counts.get("Writes"), expected_writes, "Replay of {0} issued {1} writes, Ariel sent {2}".format(tracefile, replay_counts.get("Writes"), expected_writes))
+
 #######################
 
     def _setup_ariel_test_files(self):
@@ -51,9 +51,41 @@ cacheTracer::cacheTracer( ComponentId_t id, Params& params ): Component( id ) {
     out->debug(CALL_INFO, 1, 0, "Clock registered\n");
 
     string tracePrefix = params.find<std::string>("tracePrefix", "");
+    string traceFormat = params.find<std::string>("traceFormat", "text");
+    writeBlockTrace = false;
+    blockTrace = NULL;
+
+    if("text" != traceFormat && "block" != traceFormat){
+        out->fatal(CALL_INFO, -1, "Unknown traceFormat: %s, must be text or block\n", traceFormat.c_str());
+    }
+
     if("" == tracePrefix){
         out->debug(CALL_INFO, 1, 0, "Tracing Not Enabled.\n");
         writeTrace = false;
+    } else if("block" == traceFormat){
+        uint32_t codec;
+        uint32_t flags;
+
+        string codecName = params.find<std::string>("traceCodec", PROSPERO_BLOCK_DEFAULT_CODEC_NAME);
+        if(!SST::Prospero::prosperoBlockCodecFromName(codecName, codec)){
+            out->fatal(CALL_INFO, -1, "Unknown traceCodec: %s (or codec is not available in this build)\n", codecName.c_str());
+        }
+
+        string layout = params.find<std::string>("traceLayout", "columnar");
+        if(!SST::Prospero::prosperoBlockFlagsFromLayout(layout, flags)){
+            out->fatal(CALL_INFO, -1, "Unknown traceLayout: %s, must be rows or columnar\n", layout.c_str());
+        }
+
+        uint32_t recordsPerBlock = params.find<uint32_t>("traceRecordsPerBlock", PROSPERO_BLOCK_DEFAULT_RECORDS);
+        uint32_t flushBuffers = params.find<uint32_t>("traceFlushBuffers", PROSPERO_BLOCK_DEFAULT_FLUSH_BUFFERS);
+
+        out->output("Writing block trace to file: %s\n", tracePrefix.c_str());
+        blockTrace = new SST::Prospero::ProsperoBlockTraceWriter();
+        if(!blockTrace->open(tracePrefix, codec, recordsPerBlock, flags, flushBuffers)){
+            out->fatal(CALL_INFO, -1, "Unable to open block trace: %s\n", blockTrace->getError().c_str());
+        }
+        writeTrace = false;
+        writeBlockTrace = true;
     } else {
         out->debug(CALL_INFO, 1, 0, "Tracing is Enabled, prefix is set to %s\n", tracePrefix.c_str());
         char* traceFilePath = (char*) malloc( sizeof(char) * (tracePrefix.size()+ 20) );
@@ -97,7 +129,9 @@ cacheTracer::cacheTracer( ComponentId_t id, Params& params ): Component( id ) {
 } // constructor
 
 // destructor
-cacheTracer::~cacheTracer() {}
+cacheTracer::~cacheTracer() {
+    delete blockTrace;
+}
 
 void cacheTracer::init(unsigned int phase) {
     // Since cacheTracer can sit between memH components, it needs to forward init events
@@ -138,6 +172,18 @@ bool cacheTracer::clock(Cycle_t current){
         //InFlightReqQueue[me->getID()] = timestamp;
         InFlightReqQueue[me->getID()] = nanoseconds;
 
+        // Block traces hold the requests travelling towards memory so they
+        // can be replayed by prospero, responses are not recorded
+        if(writeBlockTrace && BasicCommandClassArr[(int)me->getCmd()] == BasicCommandClass::Request){
+             Command cmd = me->getCmd();
+             bool isWrite = (cmd == Command::GetX || cmd == Command::Write || cmd == Command::PutM);
+             uint64_t picoseconds = (uint64_t) picoTimeConv->convertFromCoreTime(getCurrentSimCycle());
+
+             if(!blockTrace->append(picoseconds, addr, me->getSize(), isWrite)){
+                 out->fatal(CALL_INFO, -1, "Error writing block trace: %s\n", blockTrace->getError().c_str());
+             }
+        }
+
         if(writeDebug_8 & writeTrace){
              fprintf(traceFile,"NB: Addr: 0x%" PRIu64, addr);
              fprintf(traceFile, " timestamp: %" PRIu64, timestamp);
@@ -211,6 +257,13 @@ void cacheTracer::finish(){
     if(writeTrace){
        fclose(traceFile);
     }
+    if(writeBlockTrace){
+       if(!blockTrace->close()){
+           out->fatal(CALL_INFO, -1, "Error finishing block trace: %s\n", blockTrace->getError().c_str());
+       }
+       out->debug(CALL_INFO, 1, 0, "Block trace holds %" PRIu64 " requests in %" PRIu64 " blocks\n",
+           blockTrace->getRecordCount(), blockTrace->getBlockCount());
+    }
 } // finish()
 
 
@@ -25,6 +25,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 #include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/prospero/prosblockwriter.h>
 #include <assert.h>
 #include <errno.h>
 #include <execinfo.h>
@@ -60,6 +61,11 @@ public:
 	{ "clock", "Frequency, same as system clock frequency", "1 GHz" },
     	{ "statsPrefix", "writes stats to statsPrefix file", "" },
     	{ "tracePrefix", "writes trace to tracePrefix tracing is enable", "" },
+    	{ "traceFormat", "text writes every event when debug >= 8, block writes requests as a prospero block trace", "text" },
+    	{ "traceCodec", "Block trace compression, none or zlib", PROSPERO_BLOCK_DEFAULT_CODEC_NAME },
+    	{ "traceLayout", "Block trace layout, rows or columnar", "columnar" },
+    	{ "traceRecordsPerBlock", "Number of requests buffered into each block of a block trace", "65536" },
+    	{ "traceFlushBuffers", "Number of full blocks of a block trace which can wait to be compressed and written before tracing stalls", "4" },
     	{ "debug", "Print debug statements with increasing verbosity [0-10]", "0" },
     	{ "statistics", "0-No-stats, 1-print-stats", "0" },
     	{ "pageSize", "Page Size (bytes), used for selecting number of bins for address histogram ", "4096" },
@@ -80,6 +86,7 @@ private:
 
     Output* out;
     FILE* traceFile;
+    SST::Prospero::ProsperoBlockTraceWriter* blockTrace;
     FILE* statsFile;
 
     // Links
@@ -93,6 +100,7 @@ private:
 
     // Flags
     bool writeTrace;
+    bool writeBlockTrace;
     bool writeStats;
     bool writeDebug_8;
 
@@ -50,6 +50,10 @@ class testcase_cacheTracer_Component(SSTTestCase):
     def test_cacheTracer_2(self):
         self.cacheTracer_test_template_2()
 
+    @unittest.skipIf(testing_check_get_num_ranks() > 1, "CacheTracer: test_cacheTracer_3 skipped if ranks > 1")
+    def test_cacheTracer_3(self):
+        self.cacheTracer_test_template_3()
+
 #####
 
     def cacheTracer_test_template_1(self):
@@ -125,3 +129,53 @@ class testcase_cacheTracer_Component(SSTTestCase):
             log_failure(diffdata)
         self.assertTrue(cmp_result, "File {0} does not match Reference File {1} ignoring whitespace".format(out_memRefFile, reffile))
 
+###
+
+    def cacheTracer_test_template_3(self):
+        # Write a block trace with cacheTracer, then replay it with
+        # prospero.ProsperoBlockTraceReader. The replay must issue the
+        # requests which test_cacheTracer_2 sees going to memory.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        testDataFileName="test_cacheTracer_3"
+
+        sdlfile = "{0}/{1}.py".format(test_path, testDataFileName)
+        reffile = "{0}/refFiles/{1}_replay.out".format(test_path, testDataFileName)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        tracefile = "{0}/{1}.trace.blk".format(outdir, testDataFileName)
+
+        replay_sdlfile = os.path.abspath("{0}/../../prospero/tests/array/trace-common.py".format(test_path))
+        replay_outfile = "{0}/{1}_replay.out".format(outdir, testDataFileName)
+        replay_errfile = "{0}/{1}_replay.err".format(outdir, testDataFileName)
+        replay_mpioutfiles = "{0}/{1}_replay.testfile".format(outdir, testDataFileName)
+        replay_cmpfile = "{0}/{1}_replay.cmp".format(tmpdir, testDataFileName)
+
+        if os.path.isfile(tracefile):
+            os.remove(tracefile)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("cacheTracer3 test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+        self.assertTrue(os.path.isfile(tracefile), "Block trace {0} was not written".format(tracefile))
+
+        otherargs = '--model-options=\"--TraceType=block --TraceFile={0}\"'.format(tracefile)
+        self.run_sst(replay_sdlfile, replay_outfile, replay_errfile, other_args=otherargs, mpi_out_files=replay_mpioutfiles)
+
+        if os_test_file(replay_errfile, "-s"):
+            log_testing_note("cacheTracer3 replay {0} has a Non-Empty Error File {1}".format(testDataFileName, replay_errfile))
+
+        # The replay timing depends on the prospero system, only the
+        # requests it issued are compared
+        cmd = 'grep -E "Reads issued|Writes issued|Split reads issued|Split writes issued|Bytes read|Bytes written" {0} > {1}'.format(replay_outfile, replay_cmpfile)
+        os.system(cmd)
+
+        cmp_result = testing_compare_diff(testDataFileName, replay_cmpfile, reffile, ignore_ws=True)
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testDataFileName)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Replay of {0} does not match Reference File {1}".format(tracefile, reffile))
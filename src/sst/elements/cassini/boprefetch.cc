@@ -0,0 +1,229 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "boprefetch.h"
+
+#include <algorithm>
+#include "stdlib.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+BestOffsetPrefetcher::BestOffsetPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    snprintf(new_prefix, sizeof(char)*128, "BestOffsetPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    degree = params.find<uint32_t>("degree", 1);
+    scoreMax = params.find<uint32_t>("score_max", 31);
+    roundMax = params.find<uint32_t>("round_max", 100);
+    badScore = params.find<uint32_t>("bad_score", 1);
+
+    uint32_t overrunPB = params.find<uint32_t>("overrun_page_boundaries", 0);
+    overrunPageBoundary = (overrunPB == 0) ? false : true;
+
+    if(0 == blockSize) {
+        output->fatal(CALL_INFO, -1, "Error: cache_line_size must be greater than zero.\n");
+    }
+
+    const std::string trainOn = params.find<std::string>("train_on", "miss");
+    if(trainOn == "miss") {
+        trainOnMissOnly = true;
+    } else if(trainOn == "all") {
+        trainOnMissOnly = false;
+    } else {
+        output->fatal(CALL_INFO, -1, "Error: train_on must be either miss or all, user specified: %s\n", trainOn.c_str());
+    }
+
+    // Candidate offsets are the numbers whose only prime factors are 2, 3 and 5,
+    // which keeps the list short while covering the common strides
+    const int32_t maxOffset = params.find<int32_t>("max_offset", 63);
+    for(int32_t i = 1; i <= maxOffset; ++i) {
+        int32_t remainder = i;
+        while(remainder % 2 == 0) remainder /= 2;
+        while(remainder % 3 == 0) remainder /= 3;
+        while(remainder % 5 == 0) remainder /= 5;
+
+        if(remainder == 1) {
+            offsets.push_back(i);
+        }
+    }
+
+    if(offsets.empty()) {
+        output->fatal(CALL_INFO, -1, "Error: max_offset must be at least 1, user specified: %" PRId32 "\n", maxOffset);
+    }
+
+    scores.assign(offsets.size(), 0);
+
+    const uint32_t requestedRRSize = params.find<uint32_t>("rr_size", 256);
+    uint64_t rrSize = 1;
+    while(rrSize < requestedRRSize) {
+        rrSize *= 2;
+    }
+
+    recentRequests.assign(rrSize, UINT64_MAX);
+    rrMask = rrSize - 1;
+
+    testIndex = 0;
+    round = 0;
+    bestOffset = 1;
+    prefetchEnabled = true;
+
+    prefetchHistory = new PrefetchFilter(params.find<uint32_t>("history", 64));
+
+    output->verbose(CALL_INFO, 1, 0, "BestOffsetPrefetcher created, cache line: %" PRIu64 ", page size: %" PRIu64 ", candidate offsets: %" PRIu32 "\n",
+        blockSize, pageSize, (uint32_t) offsets.size());
+
+    statPrefetchOpportunities = registerStatistic<uint64_t>("prefetch_opportunities");
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
+    statPrefetchIssueCanceledByHistory = registerStatistic<uint64_t>("prefetches_canceled_by_history");
+    statLearningPhases = registerStatistic<uint64_t>("learning_phases");
+    statDisabledPhases = registerStatistic<uint64_t>("prefetch_disabled_phases");
+}
+
+BestOffsetPrefetcher::~BestOffsetPrefetcher() {
+    delete prefetchHistory;
+    delete output;
+}
+
+void BestOffsetPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const NotifyResultType notifyResType = notify.getResultType();
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    if (trainOnMissOnly && notifyResType != MISS)
+        return;
+
+    const Addr addr = notify.getPhysicalAddress();
+    const uint64_t line = addr / blockSize;
+
+    learn(line);
+
+    if(!prefetchEnabled) {
+        return;
+    }
+
+    for(uint32_t i = 1; i <= degree; ++i) {
+        const Addr target = (line + (uint64_t) bestOffset * i) * blockSize;
+        issuePrefetch(addr, target);
+    }
+}
+
+void BestOffsetPrefetcher::learn(const uint64_t line) {
+    // Test one candidate offset: had it been in use, the prefetch issued
+    // for line - offset would have covered this access
+    const uint64_t offset = (uint64_t) offsets[testIndex];
+
+    if(line >= offset && recentRequests[rrIndex(line - offset)] == (line - offset)) {
+        if(++scores[testIndex] >= scoreMax) {
+            endLearningPhase();
+            recentRequests[rrIndex(line)] = line;
+            return;
+        }
+    }
+
+    // The cache does not report fills to its listeners, so the access itself
+    // stands in for the completed request when populating the table
+    recentRequests[rrIndex(line)] = line;
+
+    if(++testIndex == offsets.size()) {
+        testIndex = 0;
+
+        if(++round >= roundMax) {
+            endLearningPhase();
+        }
+    }
+}
+
+void BestOffsetPrefetcher::endLearningPhase() {
+    uint32_t bestIndex = 0;
+
+    for(uint32_t i = 1; i < scores.size(); ++i) {
+        if(scores[i] > scores[bestIndex]) {
+            bestIndex = i;
+        }
+    }
+
+    const uint32_t bestScore = scores[bestIndex];
+    bestOffset = offsets[bestIndex];
+    prefetchEnabled = bestScore > badScore;
+
+    output->verbose(CALL_INFO, 2, 0, "Learning phase complete, best offset: %" PRId32 ", score: %" PRIu32 ", prefetching %s\n",
+        bestOffset, bestScore, prefetchEnabled ? "enabled" : "disabled");
+
+    statLearningPhases->addData(1);
+    if(!prefetchEnabled) {
+        statDisabledPhases->addData(1);
+    }
+
+    std::fill(scores.begin(), scores.end(), 0);
+    testIndex = 0;
+    round = 0;
+}
+
+void BestOffsetPrefetcher::issuePrefetch(const Addr triggerAddress, const Addr prefetchAddress) {
+    statPrefetchOpportunities->addData(1);
+
+    if(!overrunPageBoundary && (triggerAddress / pageSize) != (prefetchAddress / pageSize)) {
+        output->verbose(CALL_INFO, 2, 0, "Cancel prefetch issue, request exceeds physical page limit\n");
+        output->verbose(CALL_INFO, 4, 0, "Trigger address: %" PRIx64 ", Prefetch address: %" PRIx64 "\n", triggerAddress, prefetchAddress);
+
+        statPrefetchIssueCanceledByPageBoundary->addData(1);
+        return;
+    }
+
+    if(prefetchHistory->checkAndInsert(prefetchAddress / blockSize)) {
+        output->verbose(CALL_INFO, 2, 0, "Prefetch canceled - same cache line is found in the recent prefetch history.\n");
+        statPrefetchIssueCanceledByHistory->addData(1);
+        return;
+    }
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch, trigger address: %" PRIx64 ", prefetch address: %" PRIx64 " (offset=%" PRId32 ")\n",
+        triggerAddress, prefetchAddress, bestOffset);
+
+    statPrefetchEventsIssued->addData(1);
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for(std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin();
+            callbackItr != registeredCallbacks.end(); callbackItr++) {
+        // Create a new read request, we cannot issue a write because the data will get
+        // overwritten and corrupt memory (even if we really do want to do a write)
+        MemEvent* newEv = new MemEvent(getName(), prefetchAddress, prefetchAddress, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+
+        (*(*callbackItr))(newEv);
+    }
+}
+
+void BestOffsetPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void BestOffsetPrefetcher::printStats(Output &out) {
+}
@@ -0,0 +1,135 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_CASSINI_BEST_OFFSET_PREFETCH
+#define _H_SST_CASSINI_BEST_OFFSET_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+#include "prefetchfilter.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Best-offset prefetcher [Michaud 2016]. A learning phase tests one candidate
+ * line offset per access against a small table of recently seen lines and
+ * scores offsets which would have covered the access. At the end of each
+ * round the highest scoring offset becomes the prefetch offset. All tables
+ * are fixed size and every notification is a constant amount of work.
+ */
+class BestOffsetPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    BestOffsetPrefetcher(ComponentId_t id, Params& params);
+    ~BestOffsetPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        BestOffsetPrefetcher,
+            "cassini",
+            "BestOffsetPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Best-Offset Prefetcher [Michaud 2016]",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "max_offset", "Largest offset (in cache lines) considered during learning", "63" },
+        { "rr_size", "Number of entries in the recent requests table (rounded up to a power of two)", "256" },
+        { "score_max", "Score at which an offset is selected before the end of a round", "31" },
+        { "round_max", "Maximum number of rounds in a learning phase", "100" },
+        { "bad_score", "Prefetching is switched off when the best offset scores at or below this value", "1" },
+        { "degree", "Number of lines prefetched (at multiples of the best offset) for each access", "1" },
+        { "train_on", "Train and prefetch on miss or all accesses", "miss" },
+        { "history", "Number of entries in the recently prefetched line filter", "64" },
+        { "page_size", "Page size for this controller", "4096" },
+        { "overrun_page_boundaries", "Allow prefetcher to run over page boundaries, 0 is no, 1 is yes", "0" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
+        { "prefetches_canceled_by_page_boundary",
+                "Prefetches which would not be executed because they span over a page boundary.", "prefetches", 1 },
+        { "prefetches_canceled_by_history",
+                "Prefetches which did not get issued because of a prefetch history in the table", "prefetches", 1 },
+        { "prefetch_opportunities", "Count of opportunities to prefetch", "prefetches", 1 },
+        { "learning_phases", "Number of completed learning phases", "phases", 2 },
+        { "prefetch_disabled_phases", "Number of learning phases which switched prefetching off", "phases", 2 }
+    )
+
+private:
+    void learn(const uint64_t line);
+    void endLearningPhase();
+    void issuePrefetch(const Addr triggerAddress, const Addr prefetchAddress);
+
+    uint32_t rrIndex(const uint64_t line) const {
+        return (uint32_t) ((line ^ (line >> 8)) & rrMask);
+    }
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+
+    std::vector<int32_t> offsets;
+    std::vector<uint32_t> scores;
+    std::vector<uint64_t> recentRequests;
+    uint64_t rrMask;
+
+    uint32_t testIndex;
+    uint32_t round;
+    uint32_t scoreMax;
+    uint32_t roundMax;
+    uint32_t badScore;
+
+    int32_t bestOffset;
+    bool prefetchEnabled;
+
+    PrefetchFilter* prefetchHistory;
+    uint64_t blockSize;
+    uint64_t pageSize;
+    bool overrunPageBoundary;
+    bool trainOnMissOnly;
+    uint32_t degree;
+
+    Statistic<uint64_t>* statPrefetchOpportunities;
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByPageBoundary;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByHistory;
+    Statistic<uint64_t>* statLearningPhases;
+    Statistic<uint64_t>* statDisabledPhases;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,67 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_CASSINI_PREFETCH_FILTER
+#define _H_SST_CASSINI_PREFETCH_FILTER
+
+#include <stdint.h>
+#include <vector>
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Fixed size, direct mapped record of recently prefetched cache lines. A
+ * lookup and an insert are a single slot access, a line which has been
+ * evicted from the filter by a conflict may be prefetched again, which is
+ * what a finite hardware filter does as well.
+ */
+class PrefetchFilter {
+public:
+    PrefetchFilter(const uint32_t entries) {
+        uint32_t size = 1;
+        while(size < entries) {
+            size *= 2;
+        }
+
+        lines.assign(size, UINT64_MAX);
+        mask = size - 1;
+    }
+
+    // Returns true if the line was recently prefetched, otherwise records it
+    bool checkAndInsert(const uint64_t line) {
+        uint64_t& slot = lines[hash(line)];
+
+        if(slot == line) {
+            return true;
+        }
+
+        slot = line;
+        return false;
+    }
+
+private:
+    uint32_t hash(const uint64_t line) const {
+        return (uint32_t) ((line ^ (line >> 13) ^ (line >> 27)) & mask);
+    }
+
+    std::vector<uint64_t> lines;
+    uint64_t mask;
+};
+
+}
+}
+
+#endif
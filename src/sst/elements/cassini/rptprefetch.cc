@@ -0,0 +1,242 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "rptprefetch.h"
+
+#include "stdlib.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+RPTPrefetcher::RPTPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    snprintf(new_prefix, sizeof(char)*128, "RPTPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    degree = params.find<uint32_t>("degree", 2);
+    distance = params.find<uint32_t>("distance", 1);
+
+    uint32_t overrunPB = params.find<uint32_t>("overrun_page_boundaries", 0);
+    overrunPageBoundary = (overrunPB == 0) ? false : true;
+
+    if(0 == blockSize) {
+        output->fatal(CALL_INFO, -1, "Error: cache_line_size must be greater than zero.\n");
+    }
+
+    if(0 == distance) {
+        output->fatal(CALL_INFO, -1, "Error: distance must be at least one stride ahead of the access.\n");
+    }
+
+    const uint64_t regionSize = params.find<uint64_t>("region_size", 4096);
+    if(0 == regionSize || (regionSize & (regionSize - 1)) != 0) {
+        output->fatal(CALL_INFO, -1, "Error: region_size (%" PRIu64 ") must be a power of two.\n", regionSize);
+    }
+
+    regionShift = 0;
+    while((UINT64_C(1) << regionShift) < regionSize) {
+        regionShift++;
+    }
+
+    const std::string indexBy = params.find<std::string>("index_by", "auto");
+    if(indexBy == "auto") {
+        indexAuto = true;
+        indexByPC = true;
+    } else if(indexBy == "pc") {
+        indexAuto = false;
+        indexByPC = true;
+    } else if(indexBy == "region") {
+        indexAuto = false;
+        indexByPC = false;
+    } else {
+        output->fatal(CALL_INFO, -1, "Error: index_by must be one of auto, pc or region, user specified: %s\n", indexBy.c_str());
+    }
+
+    const uint32_t requestedTableSize = params.find<uint32_t>("table_size", 256);
+    uint64_t tableSize = 2;
+    while(tableSize < requestedTableSize) {
+        tableSize *= 2;
+    }
+
+    RPTEntry emptyEntry;
+    emptyEntry.tag = 0;
+    emptyEntry.lastAddress = 0;
+    emptyEntry.stride = 0;
+    emptyEntry.state = RPT_INITIAL;
+    emptyEntry.valid = false;
+
+    table.assign(tableSize, emptyEntry);
+
+    tableShift = 64;
+    while((UINT64_C(1) << (64 - tableShift)) < tableSize) {
+        tableShift--;
+    }
+
+    prefetchHistory = new PrefetchFilter(params.find<uint32_t>("history", 64));
+
+    output->verbose(CALL_INFO, 1, 0, "RPTPrefetcher created, cache line: %" PRIu64 ", page size: %" PRIu64 ", table entries: %" PRIu64 ", index by: %s\n",
+        blockSize, pageSize, tableSize, indexBy.c_str());
+
+    statPrefetchOpportunities = registerStatistic<uint64_t>("prefetch_opportunities");
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
+    statPrefetchIssueCanceledByHistory = registerStatistic<uint64_t>("prefetches_canceled_by_history");
+    statTableReplacements = registerStatistic<uint64_t>("table_replacements");
+}
+
+RPTPrefetcher::~RPTPrefetcher() {
+    delete prefetchHistory;
+    delete output;
+}
+
+void RPTPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    const Addr addr = notify.getPhysicalAddress();
+    const Addr ip = notify.getInstructionPointer();
+
+    // Pick the key identifying the access stream, when running in auto mode
+    // accesses which do not carry an instruction pointer fall back to regions
+    const bool usePC = indexByPC && (!indexAuto || ip != 0);
+    const uint64_t key = usePC ? (uint64_t) ip : (uint64_t) (addr >> regionShift);
+    const uint64_t tag = (key << 1) | (usePC ? 1 : 0);
+
+    // Instruction pointers and regions are both aligned, so use the high bits
+    // of a multiplicative hash rather than the low bits of the key
+    RPTEntry& entry = table[(key * UINT64_C(0x9E3779B97F4A7C15)) >> tableShift];
+
+    if(!entry.valid || entry.tag != tag) {
+        if(entry.valid) {
+            statTableReplacements->addData(1);
+        }
+
+        entry.tag = tag;
+        entry.lastAddress = addr;
+        entry.stride = 0;
+        entry.state = RPT_INITIAL;
+        entry.valid = true;
+        return;
+    }
+
+    const int64_t newStride = (int64_t) (addr - entry.lastAddress);
+    const bool strideMatches = (newStride == entry.stride);
+
+    // State transitions of the reference prediction table, the stride is only
+    // replaced when the entry has not yet settled on a prediction
+    switch(entry.state) {
+    case RPT_INITIAL:
+        if(strideMatches) {
+            entry.state = RPT_STEADY;
+        } else {
+            entry.state = RPT_TRANSIENT;
+            entry.stride = newStride;
+        }
+        break;
+    case RPT_TRANSIENT:
+        if(strideMatches) {
+            entry.state = RPT_STEADY;
+        } else {
+            entry.state = RPT_NO_PREDICTION;
+            entry.stride = newStride;
+        }
+        break;
+    case RPT_STEADY:
+        if(!strideMatches) {
+            entry.state = RPT_INITIAL;
+        }
+        break;
+    case RPT_NO_PREDICTION:
+        if(strideMatches) {
+            entry.state = RPT_TRANSIENT;
+        } else {
+            entry.stride = newStride;
+        }
+        break;
+    }
+
+    entry.lastAddress = addr;
+
+    if(entry.state != RPT_STEADY || entry.stride == 0) {
+        return;
+    }
+
+    // Strides smaller than a cache line would keep targeting the line being
+    // accessed, so advance by at least one line in the direction of the stride
+    int64_t lineStride = entry.stride;
+    if(lineStride > 0 && lineStride < (int64_t) blockSize) {
+        lineStride = (int64_t) blockSize;
+    } else if(lineStride < 0 && -lineStride < (int64_t) blockSize) {
+        lineStride = -((int64_t) blockSize);
+    }
+
+    for(uint32_t i = 0; i < degree; ++i) {
+        const Addr target = addr + (Addr) (lineStride * (int64_t) (distance + i));
+        issuePrefetch(addr, target - (target % blockSize));
+    }
+}
+
+void RPTPrefetcher::issuePrefetch(const Addr triggerAddress, const Addr prefetchAddress) {
+    statPrefetchOpportunities->addData(1);
+
+    if(!overrunPageBoundary && (triggerAddress / pageSize) != (prefetchAddress / pageSize)) {
+        output->verbose(CALL_INFO, 2, 0, "Cancel prefetch issue, request exceeds physical page limit\n");
+        output->verbose(CALL_INFO, 4, 0, "Trigger address: %" PRIx64 ", Prefetch address: %" PRIx64 "\n", triggerAddress, prefetchAddress);
+
+        statPrefetchIssueCanceledByPageBoundary->addData(1);
+        return;
+    }
+
+    if(prefetchHistory->checkAndInsert(prefetchAddress / blockSize)) {
+        output->verbose(CALL_INFO, 2, 0, "Prefetch canceled - same cache line is found in the recent prefetch history.\n");
+        statPrefetchIssueCanceledByHistory->addData(1);
+        return;
+    }
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch, trigger address: %" PRIx64 ", prefetch address: %" PRIx64 "\n",
+        triggerAddress, prefetchAddress);
+
+    statPrefetchEventsIssued->addData(1);
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for(std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin();
+            callbackItr != registeredCallbacks.end(); callbackItr++) {
+        // Create a new read request, we cannot issue a write because the data will get
+        // overwritten and corrupt memory (even if we really do want to do a write)
+        MemEvent* newEv = new MemEvent(getName(), prefetchAddress, prefetchAddress, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+
+        (*(*callbackItr))(newEv);
+    }
+}
+
+void RPTPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void RPTPrefetcher::printStats(Output &out) {
+}
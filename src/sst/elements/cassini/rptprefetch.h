@@ -0,0 +1,127 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_CASSINI_RPT_PREFETCH
+#define _H_SST_CASSINI_RPT_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+#include "prefetchfilter.h"
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+enum RPTEntryState { RPT_INITIAL, RPT_TRANSIENT, RPT_STEADY, RPT_NO_PREDICTION };
+
+struct RPTEntry {
+    uint64_t tag;
+    Addr lastAddress;
+    int64_t stride;
+    RPTEntryState state;
+    bool valid;
+};
+
+/*
+ * Reference prediction table prefetcher [Chen and Baer 1995]. Each access
+ * indexes one table entry by instruction pointer (or by address region when
+ * the cache is not given instruction pointers), compares the new stride to
+ * the one recorded in the entry and issues prefetches once the stride has
+ * been seen twice in a row. Every notification costs a single table lookup.
+ */
+class RPTPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    RPTPrefetcher(ComponentId_t id, Params& params);
+    ~RPTPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        RPTPrefetcher,
+            "cassini",
+            "RPTPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Reference Prediction Table Stride Prefetcher [Chen and Baer 1995]",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "table_size", "Number of entries in the reference prediction table (rounded up to a power of two, at least 2)", "256" },
+        { "index_by", "Index the table by pc, region or auto (pc when the access carries an instruction pointer, otherwise region)", "auto" },
+        { "region_size", "Size in bytes of the address region used to index the table when not indexing by pc", "4096" },
+        { "degree", "Number of prefetches issued for each access with a steady stride", "2" },
+        { "distance", "How many strides ahead of the access the first prefetch is issued", "1" },
+        { "history", "Number of entries in the recently prefetched line filter", "64" },
+        { "page_size", "Page size for this controller", "4096" },
+        { "overrun_page_boundaries", "Allow prefetcher to run over page boundaries, 0 is no, 1 is yes", "0" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
+        { "prefetches_canceled_by_page_boundary",
+                "Prefetches which would not be executed because they span over a page boundary.", "prefetches", 1 },
+        { "prefetches_canceled_by_history",
+                "Prefetches which did not get issued because of a prefetch history in the table", "prefetches", 1 },
+        { "prefetch_opportunities", "Count of opportunities to prefetch", "prefetches", 1 },
+        { "table_replacements", "Number of accesses which replaced a table entry belonging to another pc or region", "accesses", 2 }
+    )
+
+private:
+    void issuePrefetch(const Addr triggerAddress, const Addr prefetchAddress);
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+
+    std::vector<RPTEntry> table;
+    uint32_t tableShift;
+    bool indexByPC;
+    bool indexAuto;
+    uint32_t regionShift;
+
+    PrefetchFilter* prefetchHistory;
+    uint64_t blockSize;
+    uint64_t pageSize;
+    bool overrunPageBoundary;
+    uint32_t degree;
+    uint32_t distance;
+
+    Statistic<uint64_t>* statPrefetchOpportunities;
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByPageBoundary;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByHistory;
+    Statistic<uint64_t>* statTableReplacements;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
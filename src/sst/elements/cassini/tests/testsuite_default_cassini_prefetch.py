@@ -55,9 +55,17 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_rpt skipped if threads > 3")
+    def test_cassini_prefetch_rpt(self):
+        self.cassini_prefetch_test_template("rpt", check_prefetches=True)
+
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_bestoffset skipped if threads > 3")
+    def test_cassini_prefetch_bestoffset(self):
+        self.cassini_prefetch_test_template("bestoffset", check_prefetches=True)
+
 #####
 
-    def cassini_prefetch_test_template(self, testcase, testtimeout=180):
+    def cassini_prefetch_test_template(self, testcase, testtimeout=180, check_prefetches=False):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -79,7 +87,11 @@ class testcase_cassini_prefetch(SSTTestCase):
         #These are warnings/info generated by SST/memH in debug mode
         ignore_lines.append("Notice: memory controller's region is larger than the backend's mem_size")
         ignore_lines.append("Region: start=")
-        
+        # The reference for these holds the lines that do not depend on
+        # prefetch timing, the statistics are checked below instead
+        if check_prefetches:
+            ignore_lines.append("Completed @")
+
         filesAreTheSame, statDiffs, othDiffs = testing_stat_output_diff(outfile, reffile, ignore_lines, {}, True)
 
         # Perform the tests
@@ -93,6 +105,22 @@ class testcase_cassini_prefetch(SSTTestCase):
             log_failure(diffdata)
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
+        if check_prefetches:
+            issued = self._grepStatSum(outfile, "l1cache.prefetches_issued")
+            requests = self._grepStatSum(outfile, "l1cache.Prefetch_requests")
+            hits = self._grepStatSum(outfile, "l1cache.CacheHits")
+            misses = self._grepStatSum(outfile, "l1cache.CacheMisses")
+            self.assertTrue(issued > 0, "cassini_prefetch test {0} issued no prefetches".format(testDataFileName))
+            self.assertEqual(requests, issued, "cassini_prefetch test {0} cache saw {1} prefetch requests for {2} issued".format(testDataFileName, requests, issued))
+            self.assertEqual(hits + misses, 100000, "cassini_prefetch test {0} has {1} hits and {2} misses for 100000 accesses".format(testDataFileName, hits, misses))
+
+    def _grepStatSum(self, outfile, statname):
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                if line.strip().startswith(statname + " :"):
+                    return int(line.split("Sum.u64 =")[1].split(";")[0])
+        return -1
+
     def _prettyPrintDiffs(self, stat_diff, oth_diff):
         out = ""
         if len(stat_diff) != 0:
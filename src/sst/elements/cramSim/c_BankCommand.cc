@@ -42,16 +42,6 @@ c_BankCommand::c_BankCommand(unsigned x_cmdSeqNum,
                  const c_HashedAddress &x_hashedAddr) :
         m_seqNum(x_cmdSeqNum), m_addr(x_addr), m_cmdMnemonic(x_cmdMnemonic),
         m_isResponseReady(false), m_hashedAddr(x_hashedAddr), m_bankId(x_hashedAddr.getBankId()), m_isRefreshType(false) {
-
-    m_cmdToString[e_BankCommandType::ERR] = "ERR";
-    m_cmdToString[e_BankCommandType::ACT] = "ACT";
-    m_cmdToString[e_BankCommandType::READ] = "READ";
-    m_cmdToString[e_BankCommandType::READA] = "READA";
-    m_cmdToString[e_BankCommandType::WRITE] = "WRITE";
-    m_cmdToString[e_BankCommandType::WRITEA] = "WRITEA";
-    m_cmdToString[e_BankCommandType::PRE] = "PRE";
-    m_cmdToString[e_BankCommandType::PREA] = "PREA";
-    m_cmdToString[e_BankCommandType::REF] = "REF";
 }
 
 c_BankCommand::c_BankCommand(unsigned x_cmdSeqNum,
@@ -61,16 +51,6 @@ c_BankCommand::c_BankCommand(unsigned x_cmdSeqNum,
         m_isResponseReady(false), m_bankId(x_bankId), m_isRefreshType(true) {
 
     assert(x_cmdMnemonic == e_BankCommandType::REF ||x_cmdMnemonic == e_BankCommandType::PRE); // This constructor only for REF cmds!
-
-    m_cmdToString[e_BankCommandType::ERR] = "ERR";
-    m_cmdToString[e_BankCommandType::ACT] = "ACT";
-    m_cmdToString[e_BankCommandType::READ] = "READ";
-    m_cmdToString[e_BankCommandType::READA] = "READA";
-    m_cmdToString[e_BankCommandType::WRITE] = "WRITE";
-    m_cmdToString[e_BankCommandType::WRITEA] = "WRITEA";
-    m_cmdToString[e_BankCommandType::PRE] = "PRE";
-    m_cmdToString[e_BankCommandType::PREA] = "PREA";
-    m_cmdToString[e_BankCommandType::REF] = "REF";
 }
 
 c_BankCommand::c_BankCommand(unsigned x_cmdSeqNum,
@@ -83,16 +63,6 @@ c_BankCommand::c_BankCommand(unsigned x_cmdSeqNum,
 
     m_hashedAddr = x_hashedAddr;
     m_bankId = x_bankIdVec.front();
-
-    m_cmdToString[e_BankCommandType::ERR] = "ERR";
-    m_cmdToString[e_BankCommandType::ACT] = "ACT";
-    m_cmdToString[e_BankCommandType::READ] = "READ";
-    m_cmdToString[e_BankCommandType::READA] = "READA";
-    m_cmdToString[e_BankCommandType::WRITE] = "WRITE";
-    m_cmdToString[e_BankCommandType::WRITEA] = "WRITEA";
-    m_cmdToString[e_BankCommandType::PRE] = "PRE";
-    m_cmdToString[e_BankCommandType::PREA] = "PREA";
-    m_cmdToString[e_BankCommandType::REF] = "REF";
 }
 
 ulong c_BankCommand::getAddress() const {
@@ -100,7 +70,19 @@ ulong c_BankCommand::getAddress() const {
 }
 
 std::string c_BankCommand::getCommandString() const {
-  return (m_cmdToString.find(m_cmdMnemonic)->second);
+    // switch rather than a per-command map: commands are created at DRAM command rate
+    switch (m_cmdMnemonic) {
+    case e_BankCommandType::ERR:    return "ERR";
+    case e_BankCommandType::ACT:    return "ACT";
+    case e_BankCommandType::READ:   return "READ";
+    case e_BankCommandType::READA:  return "READA";
+    case e_BankCommandType::WRITE:  return "WRITE";
+    case e_BankCommandType::WRITEA: return "WRITEA";
+    case e_BankCommandType::PRE:    return "PRE";
+    case e_BankCommandType::PREA:   return "PREA";
+    case e_BankCommandType::REF:    return "REF";
+    default:                        return "ERR";
+    }
 }
 
 e_BankCommandType c_BankCommand::getCommandMnemonic() const {
@@ -171,7 +153,6 @@ void c_BankCommand::serialize_order(SST::Core::Serialization::serializer &ser)
     ser & m_bankId;
     ser & m_bankIdVec;
     ser & m_cmdMnemonic;
-    ser & m_cmdToString;
     ser & m_isResponseReady;
     ser & m_isResponseReady;
 
@@ -64,7 +64,6 @@ private:
     unsigned m_bankId;
     std::vector<unsigned> m_bankIdVec;
     e_BankCommandType m_cmdMnemonic;
-    std::map<e_BankCommandType, std::string> m_cmdToString;
     bool m_isResponseReady;
         bool m_isRefreshType; // REF and PRE commands treated specially for printing cmd trace
     c_HashedAddress m_hashedAddr;
@@ -269,15 +269,25 @@ void c_Controller::handleIncomingTransaction(SST::Event *ev){
     c_TxnReqEvent* l_txnReqEventPtr = dynamic_cast<c_TxnReqEvent*>(ev);
 
     if (l_txnReqEventPtr) {
-        c_Transaction* newTxn=l_txnReqEventPtr->m_payload;
+        if (l_txnReqEventPtr->m_batch.empty()) {
+            c_Transaction* newTxn=l_txnReqEventPtr->m_payload;
 
-        #ifdef __SST_DEBUG_OUTPUT__
-        newTxn->print(debug,"[c_Controller.handleIncommingTransaction]",m_simCycle);
-        #endif
+            #ifdef __SST_DEBUG_OUTPUT__
+            newTxn->print(debug,"[c_Controller.handleIncommingTransaction]",m_simCycle);
+            #endif
 
-        m_ReqQ.push_back(newTxn);
-        m_ResQ.push_back(newTxn);
+            m_ReqQ.push_back(newTxn);
+            m_ResQ.push_back(newTxn);
+        } else {
+            for (c_Transaction* newTxn : l_txnReqEventPtr->m_batch) {
+                #ifdef __SST_DEBUG_OUTPUT__
+                newTxn->print(debug,"[c_Controller.handleIncommingTransaction]",m_simCycle);
+                #endif
 
+                m_ReqQ.push_back(newTxn);
+                m_ResQ.push_back(newTxn);
+            }
+        }
 
         delete l_txnReqEventPtr;
     } else {
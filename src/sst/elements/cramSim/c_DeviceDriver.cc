@@ -64,7 +64,14 @@ c_DeviceDriver::c_DeviceDriver(ComponentId_t id, Params& params, Output* out, st
     build(params);
 }
 
-void c_DeviceDriver::build(Params& params) {
+c_DeviceDriver::c_DeviceDriver(ComponentId_t id, Output* out, std::function<void(c_BankCommand*)> sendFunc) : SubComponent(id), debug(out), m_sendCmdFunc(sendFunc) {
+    m_issued_cmd = 0;
+}
+
+/*!
+ * read the device geometry, timing params and cmd trace options
+ */
+void c_DeviceDriver::readParams(Params& params) {
     // read params here
     bool l_found = false;
     
@@ -277,6 +284,34 @@ void c_DeviceDriver::build(Params& params) {
     m_numBankGroups = m_numRanks * k_numBankGroupsPerRank;
     m_numBanks = m_numBankGroups * k_numBanksPerBankGroup;
 
+    // set up cmd trace output
+    k_printCmdTrace = (uint32_t) params.find<uint32_t>("boolPrintCmdTrace", 0, l_found);
+
+    k_cmdTraceFileName = (std::string) params.find<std::string>("strCmdTraceFile", "-", l_found);
+    //k_cmdTraceFileName.pop_back(); // remove trailing newline (??)
+    if (k_printCmdTrace) {
+        if (k_cmdTraceFileName.compare("-") == 0) {// set output to std::cout
+            output->output("Setting cmd trace output to std::cout\n");
+            m_cmdTraceStreamBuf = std::cout.rdbuf();
+        } else { // open the file and direct the cmdTraceStream to it
+            output->output("Setting cmd trace output to %s\n", k_cmdTraceFileName.c_str());
+            m_cmdTraceOFStream.open(k_cmdTraceFileName);
+            if (m_cmdTraceOFStream) {
+                m_cmdTraceStreamBuf = m_cmdTraceOFStream.rdbuf();
+            } else {
+                output->output("Failed to open cmd trace output file %s, redirecting to stdout\n", 
+                                        k_cmdTraceFileName.c_str());
+                m_cmdTraceStreamBuf = std::cout.rdbuf();
+            }
+        }
+        m_cmdTraceStream = new std::ostream(m_cmdTraceStreamBuf);
+    }
+}
+
+void c_DeviceDriver::build(Params& params) {
+    readParams(params);
+    m_issued_cmd = 0;
+
     for (int l_i = 0; l_i != m_numRanks; ++l_i) {
         c_Rank *l_entry = new c_Rank(&m_bankParams);
         m_ranks.push_back(l_entry);
@@ -346,31 +381,6 @@ void c_DeviceDriver::build(Params& params) {
     //init structures for refresh
     initRefresh();
 
-
-
-    // set up cmd trace output
-    k_printCmdTrace = (uint32_t) params.find<uint32_t>("boolPrintCmdTrace", 0, l_found);
-
-    k_cmdTraceFileName = (std::string) params.find<std::string>("strCmdTraceFile", "-", l_found);
-    //k_cmdTraceFileName.pop_back(); // remove trailing newline (??)
-    if (k_printCmdTrace) {
-        if (k_cmdTraceFileName.compare("-") == 0) {// set output to std::cout
-            output->output("Setting cmd trace output to std::cout\n");
-            m_cmdTraceStreamBuf = std::cout.rdbuf();
-        } else { // open the file and direct the cmdTraceStream to it
-            output->output("Setting cmd trace output to %s\n", k_cmdTraceFileName.c_str());
-            m_cmdTraceOFStream.open(k_cmdTraceFileName);
-            if (m_cmdTraceOFStream) {
-                m_cmdTraceStreamBuf = m_cmdTraceOFStream.rdbuf();
-            } else {
-                output->output("Failed to open cmd trace output file %s, redirecting to stdout\n", 
-                                        k_cmdTraceFileName.c_str());
-                m_cmdTraceStreamBuf = std::cout.rdbuf();
-            }
-        }
-        m_cmdTraceStream = new std::ostream(m_cmdTraceStreamBuf);
-    }
-
     m_inflightWrites.clear();
     m_blockBank.clear();
     m_blockBank.resize(m_numBanks, false);
@@ -811,39 +821,7 @@ bool c_DeviceDriver::sendCommand(c_BankCommand* x_bankCommandPtr,
     SimTime_t l_time = m_simCycle;
 
     if (x_bank->isCommandAllowed(x_bankCommandPtr, l_time)) {
-      if(k_printCmdTrace) {
-
-          unsigned l_bankId=0;
-        //if(x_bankCommandPtr->getCommandMnemonic() == e_BankCommandType::REF) {
-          if(x_bankCommandPtr->getBankIdVec().size()>0)
-              l_bankId=x_bankCommandPtr->getSeqNum();
-          else
-              l_bankId=x_bankCommandPtr->getBankId();
-        if(x_bankCommandPtr->isRefreshType()) {
-                (*m_cmdTraceStream) << "@" << std::dec
-                                    << m_simCycle
-                                    << " " << (x_bankCommandPtr)->getCommandString()
-                                    << " " << std::dec << (x_bankCommandPtr)->getSeqNum()
-                                    << " " << std::dec << l_bankId
-                                    << std::endl;
-        } else {
-          (*m_cmdTraceStream) << "@" << std::dec
-                  << m_simCycle
-                  << " " << (x_bankCommandPtr)->getCommandString()
-                  << " " << std::dec << (x_bankCommandPtr)->getSeqNum()
-                  << " 0x" << std::hex << (x_bankCommandPtr)->getAddress()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getChannel()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getPChannel()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getRank()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getBankGroup()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getBank()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getRow()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getCol()
-                  << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getCacheline()
-                  << "\t" << std::dec << x_bankCommandPtr->getBankId()
-                  << std::endl;
-        }
-      }
+        printCmdTrace(x_bankCommandPtr);
 
         #ifdef __SST_DEBUG_OUTPUT__
                 debug->verbose(CALL_INFO,1,0,"Cycle:%lld Cmd:%s CH:%d PCH:%d Rank:%d BG:%d B:%d Row:%d Col:%d BankId:%d CmdSeq:%u\n",
@@ -871,6 +849,46 @@ bool c_DeviceDriver::sendCommand(c_BankCommand* x_bankCommandPtr,
 
 }
 
+/*!
+ *
+ * @param x_bankCommandPtr
+ */
+void c_DeviceDriver::printCmdTrace(c_BankCommand* x_bankCommandPtr) {
+    if(!k_printCmdTrace)
+        return;
+
+    unsigned l_bankId=0;
+    if(x_bankCommandPtr->getBankIdVec().size()>0)
+        l_bankId=x_bankCommandPtr->getSeqNum();
+    else
+        l_bankId=x_bankCommandPtr->getBankId();
+
+    if(x_bankCommandPtr->isRefreshType()) {
+        (*m_cmdTraceStream) << "@" << std::dec
+                            << m_simCycle
+                            << " " << (x_bankCommandPtr)->getCommandString()
+                            << " " << std::dec << (x_bankCommandPtr)->getSeqNum()
+                            << " " << std::dec << l_bankId
+                            << std::endl;
+    } else {
+        (*m_cmdTraceStream) << "@" << std::dec
+                            << m_simCycle
+                            << " " << (x_bankCommandPtr)->getCommandString()
+                            << " " << std::dec << (x_bankCommandPtr)->getSeqNum()
+                            << " 0x" << std::hex << (x_bankCommandPtr)->getAddress()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getChannel()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getPChannel()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getRank()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getBankGroup()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getBank()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getRow()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getCol()
+                            << " " << std::dec << x_bankCommandPtr->getHashedAddress()->getCacheline()
+                            << "\t" << std::dec << x_bankCommandPtr->getBankId()
+                            << std::endl;
+    }
+}
+
 /*!
  *
  */
@@ -135,7 +135,7 @@ public:
     virtual bool push(c_BankCommand* x_cmd);
     virtual bool isCmdAllowed(c_BankCommand* x_bankCommandPtr);
     virtual c_BankInfo* getBankInfo(unsigned x_bankId);
-    void update(SimTime_t simCycle);
+    virtual void update(SimTime_t simCycle);
 
     unsigned getNumChannel(){return k_numChannels;}
     unsigned getNumPChPerChannel(){return k_numPChannelsPerChannel;}
@@ -146,48 +146,19 @@ public:
     unsigned getNumColPerBank(){return k_numColsPerBank;}
     unsigned getTotalNumBank() {return m_numBanks;}
 
-private:
-
-    c_DeviceDriver(); // for serialization only
-    bool sendRefresh(unsigned rank);
+protected:
 
-    void sendRequest(); // send request function that models close bank policy
-    bool sendCommand(c_BankCommand* x_bankCommandPtr, c_BankInfo* x_bank); // helper method to sendRequest
-
-    /// helper methods to check if channel (command bus) is available
-    bool isCommandBusAvailable(c_BankCommand* x_BankCommandPtr);
-    ///Set the occupancy of command bus
-    bool occupyCommandBus(c_BankCommand *x_cmdPtr);
-    ///Release the occupancy of command bus
-    void releaseCommandBus();
-
-    void initACTFAWTracker();
-    void initRefresh();
-    unsigned getNumIssuedACTinFAW(unsigned x_rankid);
-    void createRefreshCmds(unsigned x_rank);
-    bool isRefreshing(const c_HashedAddress *x_addr);
-
-    c_Controller *m_Owner;
+    /// for device models that keep their own bank timing state: build() is not called, use readParams()
+    c_DeviceDriver(ComponentId_t id, Output* out, std::function<void(c_BankCommand*)> sendFunc);
+    void readParams(Params& x_params);
+    void printCmdTrace(c_BankCommand* x_bankCommandPtr);
 
     std::deque<c_BankCommand*> m_inputQ;
-    std::deque<c_BankCommand*> m_outputQ;
-    std::vector<bool> m_blockBank;
-    std::set<unsigned> m_inflightWrites; // track inflight write commands
-    std::deque<unsigned> m_blockRowCmd; //command bus occupancy info
-    std::deque<unsigned> m_blockColCmd; //command bus occupancy info
 
     std::vector<unsigned> m_currentREFICount; //per rank REFICounter
     std::vector<std::vector<c_BankCommand*>> m_refreshCmdQ; //per rank refresh commandQ
     std::vector<unsigned> m_nextBankToRefresh; //for per-bank refresh
 
-    SimTime_t m_lastDataCmdIssueCycle;
-    e_BankCommandType m_lastDataCmdType;
-    unsigned m_lastChannel;
-    unsigned m_lastPseudoChannel;
-    std::vector<std::list<unsigned>> m_cmdACTFAWtrackers; // FIXME: change this to a circular buffer for speed. Could also implement as shift register.
-    std::vector<bool> m_isACTIssued;
-    bool m_issuedACT;
-
         std::function<void(c_BankCommand* cmd)> m_sendCmdFunc; // send command via parent
 
     // params
@@ -204,13 +175,8 @@ private:
     bool k_useRefresh;
     bool k_useSBRefresh;
 
-    std::vector<c_BankInfo*> m_banks;
-    std::vector<c_BankGroup*> m_bankGroups;
-    std::vector<c_Rank*> m_ranks;
-    std::vector<c_Channel*> m_channel;
     std::map<std::string, unsigned> m_bankParams;
 
-
     int m_numChannels;
     int m_numPseudoChannels;
     int m_numRanks;
@@ -230,6 +196,48 @@ private:
     Output *output;
     Output *debug;
     uint64_t m_issued_cmd;
+
+private:
+
+    c_DeviceDriver(); // for serialization only
+    bool sendRefresh(unsigned rank);
+
+    void sendRequest(); // send request function that models close bank policy
+    bool sendCommand(c_BankCommand* x_bankCommandPtr, c_BankInfo* x_bank); // helper method to sendRequest
+
+    /// helper methods to check if channel (command bus) is available
+    bool isCommandBusAvailable(c_BankCommand* x_BankCommandPtr);
+    ///Set the occupancy of command bus
+    bool occupyCommandBus(c_BankCommand *x_cmdPtr);
+    ///Release the occupancy of command bus
+    void releaseCommandBus();
+
+    void initACTFAWTracker();
+    void initRefresh();
+    unsigned getNumIssuedACTinFAW(unsigned x_rankid);
+    void createRefreshCmds(unsigned x_rank);
+    bool isRefreshing(const c_HashedAddress *x_addr);
+
+    c_Controller *m_Owner;
+
+    std::deque<c_BankCommand*> m_outputQ;
+    std::vector<bool> m_blockBank;
+    std::set<unsigned> m_inflightWrites; // track inflight write commands
+    std::deque<unsigned> m_blockRowCmd; //command bus occupancy info
+    std::deque<unsigned> m_blockColCmd; //command bus occupancy info
+
+    SimTime_t m_lastDataCmdIssueCycle;
+    e_BankCommandType m_lastDataCmdType;
+    unsigned m_lastChannel;
+    unsigned m_lastPseudoChannel;
+    std::vector<std::list<unsigned>> m_cmdACTFAWtrackers; // FIXME: change this to a circular buffer for speed. Could also implement as shift register.
+    std::vector<bool> m_isACTIssued;
+    bool m_issuedACT;
+
+    std::vector<c_BankInfo*> m_banks;
+    std::vector<c_BankGroup*> m_bankGroups;
+    std::vector<c_Rank*> m_ranks;
+    std::vector<c_Channel*> m_channel;
 };
 }
 }
@@ -0,0 +1,561 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// SST includes
+#include "sst_config.h"
+
+// C++ includes
+#include <algorithm>
+
+// CramSim includes
+#include "c_FastDeviceDriver.hpp"
+#include "c_HashedAddress.hpp"
+
+using namespace SST;
+using namespace SST::CramSim;
+
+const unsigned c_FastDeviceDriver::k_closedRow;
+const unsigned c_FastDeviceDriver::k_fawDepth;
+
+// command-to-command delays such as nCL+nBL+nRTW-nCWL can go negative for
+// some parameter sets; a command can never follow another in the same cycle
+static inline SimTime_t positiveDelay(int64_t x_delay) {
+    return x_delay > 0 ? (SimTime_t) x_delay : 1;
+}
+
+c_FastDeviceDriver::c_FastDeviceDriver(ComponentId_t id, Params& params, Output* out, std::function<void(c_BankCommand*)> sendFunc) :
+    c_DeviceDriver(id, out, sendFunc) {
+
+    readParams(params);
+
+    k_cmdForwardCycles = params.find<unsigned>("numCmdForwardCycles", 1);
+
+    m_banksPerRank = k_numBankGroupsPerRank * k_numBanksPerBankGroup;
+    m_numCmdBuses = k_numChannels * (k_useDualCommandBus ? 2 : 1);
+
+    // cache the timing params, the per-command path must not do string map lookups
+    const std::map<std::string, unsigned>& l_p = m_bankParams;
+    int64_t l_nBL = l_p.at("nBL");
+    int64_t l_nCL = l_p.at("nCL");
+    int64_t l_nCWL = l_p.at("nCWL");
+    int64_t l_nCCD_L = l_p.at("nCCD_L");
+    int64_t l_nCCD_S = l_p.at("nCCD_S");
+
+    k_nRC   = l_p.at("nRC");
+    k_nRCD  = l_p.at("nRCD");
+    k_nRAS  = l_p.at("nRAS");
+    k_nRP   = l_p.at("nRP");
+    k_nRTP  = l_p.at("nRTP");
+    k_nRFC  = l_p.at("nRFC");
+    k_nREFI = l_p.at("nREFI");
+    k_nFAW  = l_p.at("nFAW");
+    k_nRRD_L = l_p.at("nRRD_L");
+    k_nRRD_S = l_p.at("nRRD_S");
+
+    k_rdToRdL = positiveDelay(std::max(l_nCCD_L, l_nBL));
+    k_rdToRdS = positiveDelay(std::max(l_nCCD_S, l_nBL));
+    k_wrToWrL = k_rdToRdL;
+    k_wrToWrS = k_rdToRdS;
+    k_rdToWr  = positiveDelay(l_nCL + l_nBL + l_p.at("nRTW") - l_nCWL);
+    k_wrToRdL = positiveDelay(l_nCWL + l_nBL + l_p.at("nWTR_L"));
+    k_wrToRdS = positiveDelay(l_nCWL + l_nBL + l_p.at("nWTR_S"));
+    k_wrToPre = positiveDelay(l_nCWL + l_nBL + l_p.at("nWR"));
+
+    // rank-to-rank turnaround on the shared data bus
+    int64_t l_burst = std::max(l_nBL, std::min(l_nCCD_S, l_nCCD_L));
+    k_rdToRdRank = positiveDelay(l_burst + l_p.at("nERTR"));
+    k_rdToWrRank = positiveDelay(l_nCL + l_burst + l_p.at("nERTW") - l_nCWL);
+    k_wrToRdRank = positiveDelay(l_nCWL + l_burst + l_p.at("nEWTR") - l_nCL);
+    k_wrToWrRank = positiveDelay(l_burst + l_p.at("nEWTW"));
+
+    // timing tables
+    m_bankNext.assign(m_numBanks * k_numCmdClasses, 0);
+    m_bankGroupNext.assign(m_numBankGroups * k_numCmdClasses, 0);
+    m_rankNext.assign(m_numRanks * k_numCmdClasses, 0);
+    c_OtherRankBound l_noBound = {0, 0, ~0u};
+    m_pchOtherRank.assign(m_numPseudoChannels * k_numCmdClasses, l_noBound);
+
+    m_bankLocation.resize(m_numBanks);
+    for (int l_i = 0; l_i < m_numBanks; l_i++) {
+        m_bankLocation[l_i].m_bankGroup = l_i / k_numBanksPerBankGroup;
+        m_bankLocation[l_i].m_rank = l_i / m_banksPerRank;
+        m_bankLocation[l_i].m_pch = m_bankLocation[l_i].m_rank / k_numRanksPerChannel;
+    }
+
+    m_openRow.assign(m_numBanks, k_closedRow);
+    m_queuedACTs.assign(m_numBanks, 0);
+    m_bankScanCycle.assign(m_numBanks, ~(SimTime_t) 0);
+    m_fawWindow.assign(m_numRanks * k_fawDepth, 0);
+    m_fawHead.assign(m_numRanks, 0);
+
+    m_rowBusFree.assign(k_numChannels, 0);
+    m_colBusFree.assign(k_numChannels, 0);
+    m_rowBusPushCycle.assign(k_numChannels, ~(SimTime_t) 0);
+    m_colBusPushCycle.assign(k_numChannels, ~(SimTime_t) 0);
+
+    unsigned l_wheelSize = 2;
+    while (l_wheelSize <= k_cmdForwardCycles)
+        l_wheelSize <<= 1;
+    m_timingWheel.resize(l_wheelSize);
+    m_wheelMask = l_wheelSize - 1;
+
+    // refresh commands are timely interleaved to ranks, as in c_DeviceDriver
+    m_currentREFICount.resize(m_numRanks, 0);
+    m_refreshCmdQ.resize(m_numRanks);
+    m_nextBankToRefresh.resize(m_numRanks, 0);
+    for (int l_i = 0; l_i < m_numRanks; l_i++)
+        m_currentREFICount[l_i] = k_nREFI / (l_i + 1);
+}
+
+c_FastDeviceDriver::~c_FastDeviceDriver() {
+    for (auto& l_refreshQ : m_refreshCmdQ)
+        for (auto& l_cmdPtr : l_refreshQ)
+            delete l_cmdPtr;
+}
+
+/*!
+ *
+ */
+void c_FastDeviceDriver::update(SimTime_t simCycle) {
+    // bank state lives in the timing tables, nothing to tick
+    m_simCycle = simCycle;
+}
+
+/*!
+ *
+ */
+void c_FastDeviceDriver::run() {
+
+    if (k_useRefresh) {
+        for (int l_id = 0; l_id < m_numRanks; l_id++) {
+            if (m_currentREFICount[l_id] > 0) {
+                --m_currentREFICount[l_id];
+            } else {
+                createRefreshCmds(l_id);
+                m_currentREFICount[l_id] = k_nREFI;
+            }
+
+            if (!m_refreshCmdQ[l_id].empty())
+                sendRefresh(l_id);
+        }
+    }
+
+    if (!m_inputQ.empty())
+        sendRequest();
+
+    // forward the commands whose issue latency expires this cycle
+    std::vector<c_BankCommand*>& l_slot = m_timingWheel[m_simCycle & m_wheelMask];
+    for (auto& l_cmdPtr : l_slot)
+        m_sendCmdFunc(l_cmdPtr);
+    l_slot.clear();
+}
+
+/*!
+ *
+ * @param x_cmd
+ * @return
+ */
+bool c_FastDeviceDriver::push(c_BankCommand* x_cmd) {
+    if (m_inputQ.size() < 32) {
+        m_inputQ.push_back(x_cmd);
+        if (x_cmd->getCommandMnemonic() == e_BankCommandType::ACT)
+            m_queuedACTs[x_cmd->getBankId()]++;
+
+        // one command per command bus per cycle is accepted from the scheduler
+        unsigned l_ch = x_cmd->getHashedAddress()->getChannel();
+        if (!k_useDualCommandBus || x_cmd->isColCommand())
+            m_colBusPushCycle[l_ch] = m_simCycle;
+        if (!k_useDualCommandBus || !x_cmd->isColCommand())
+            m_rowBusPushCycle[l_ch] = m_simCycle;
+        return true;
+    } else
+        return false;
+}
+
+/*!
+ * check bank timing and bus status
+ * @param x_bankCommandPtr
+ * @return
+ */
+bool c_FastDeviceDriver::isCmdAllowed(c_BankCommand* x_bankCommandPtr) {
+    const c_HashedAddress* l_addr = x_bankCommandPtr->getHashedAddress();
+    unsigned l_bankId = l_addr->getBankId();
+    e_BankCommandType l_type = x_bankCommandPtr->getCommandMnemonic();
+
+    if (k_useRefresh && !m_refreshCmdQ[l_addr->getRankId()].empty())
+        return false;
+
+    //insert active command if the target row is closed (this case can happen due to refresh)
+    if (x_bankCommandPtr->isColCommand() && m_openRow[l_bankId] == k_closedRow) {
+        if (m_queuedACTs[l_bankId] == 0) {
+            c_BankCommand* l_newCmd = new c_BankCommand(0, e_BankCommandType::ACT, x_bankCommandPtr->getAddress(), *l_addr);
+            m_inputQ.push_back(l_newCmd);
+            m_queuedACTs[l_bankId]++;
+        }
+        return false;
+    }
+
+    if (l_type == e_BankCommandType::ACT && m_openRow[l_bankId] != k_closedRow)
+        return false;
+
+    unsigned l_ch = l_addr->getChannel();
+    if (x_bankCommandPtr->isColCommand()) {
+        if (m_colBusPushCycle[l_ch] == m_simCycle)
+            return false;
+    } else if (m_rowBusPushCycle[l_ch] == m_simCycle) {
+        return false;
+    }
+
+    if (!isCommandBusAvailable(x_bankCommandPtr))
+        return false;
+
+    return getEarliestIssueCycle(l_bankId, getCmdClass(l_type)) <= m_simCycle;
+}
+
+/*!
+ *
+ * @param x_bankId
+ * @return always nullptr, bank state is kept in the timing tables
+ */
+c_BankInfo* c_FastDeviceDriver::getBankInfo(unsigned x_bankId) {
+    return nullptr;
+}
+
+unsigned c_FastDeviceDriver::getCmdClass(e_BankCommandType x_type) const {
+    switch (x_type) {
+    case e_BankCommandType::ACT:
+        return k_ACT;
+    case e_BankCommandType::READ:
+    case e_BankCommandType::READA:
+        return k_RD;
+    case e_BankCommandType::WRITE:
+    case e_BankCommandType::WRITEA:
+        return k_WR;
+    case e_BankCommandType::PRE:
+    case e_BankCommandType::PREA:
+        return k_PRE;
+    case e_BankCommandType::REF:
+        return k_REF;
+    default:
+        output->fatal(CALL_INFO, -1, "c_FastDeviceDriver: unsupported command type %d\n", (int) x_type);
+    }
+    return k_ACT;
+}
+
+/*!
+ * Earliest cycle a command of class x_cmdClass may be issued to the bank
+ */
+SimTime_t c_FastDeviceDriver::getEarliestIssueCycle(unsigned x_bankId, unsigned x_cmdClass) const {
+    const c_BankLocation& l_loc = m_bankLocation[x_bankId];
+    unsigned l_rankId = l_loc.m_rank;
+    SimTime_t l_cycle = m_bankNext[x_bankId * k_numCmdClasses + x_cmdClass];
+
+    l_cycle = std::max(l_cycle, m_bankGroupNext[l_loc.m_bankGroup * k_numCmdClasses + x_cmdClass]);
+    l_cycle = std::max(l_cycle, m_rankNext[l_rankId * k_numCmdClasses + x_cmdClass]);
+
+    const c_OtherRankBound& l_other = m_pchOtherRank[l_loc.m_pch * k_numCmdClasses + x_cmdClass];
+    l_cycle = std::max(l_cycle, l_other.m_firstRank == l_rankId ? l_other.m_second : l_other.m_first);
+
+    if (x_cmdClass == k_ACT)
+        l_cycle = std::max(l_cycle, m_fawWindow[l_rankId * k_fawDepth + m_fawHead[l_rankId]]);
+
+    return l_cycle;
+}
+
+bool c_FastDeviceDriver::isCommandBusAvailable(c_BankCommand* x_cmdPtr) const {
+    unsigned l_ch = x_cmdPtr->getHashedAddress()->getChannel();
+    if (x_cmdPtr->isColCommand())
+        return m_colBusFree[l_ch] <= m_simCycle;
+    else
+        return m_rowBusFree[l_ch] <= m_simCycle;
+}
+
+void c_FastDeviceDriver::occupyCommandBus(c_BankCommand* x_cmdPtr) {
+    unsigned l_ch = x_cmdPtr->getHashedAddress()->getChannel();
+
+    if (k_useDualCommandBus) {
+        //HBM requires two cycles for the active command
+        SimTime_t l_cmdCycle = (x_cmdPtr->getCommandMnemonic() == e_BankCommandType::ACT && k_multiCycleACT) ? 2 : 1;
+        if (x_cmdPtr->isColCommand())
+            m_colBusFree[l_ch] = m_simCycle + l_cmdCycle;
+        else
+            m_rowBusFree[l_ch] = m_simCycle + l_cmdCycle;
+    } else {
+        m_colBusFree[l_ch] = m_simCycle + 1;
+        m_rowBusFree[l_ch] = m_simCycle + 1;
+    }
+}
+
+void c_FastDeviceDriver::raise(std::vector<SimTime_t>& x_table, unsigned x_idx, unsigned x_cmdClass, SimTime_t x_cycle) {
+    SimTime_t& l_entry = x_table[x_idx * k_numCmdClasses + x_cmdClass];
+    if (l_entry < x_cycle)
+        l_entry = x_cycle;
+}
+
+/*!
+ * Raise the bound seen by every rank of the pseudo channel except x_rankId
+ */
+void c_FastDeviceDriver::raiseOtherRanks(unsigned x_pch, unsigned x_cmdClass, unsigned x_rankId, SimTime_t x_cycle) {
+    c_OtherRankBound& l_bound = m_pchOtherRank[x_pch * k_numCmdClasses + x_cmdClass];
+
+    if (l_bound.m_firstRank == x_rankId) {
+        l_bound.m_first = std::max(l_bound.m_first, x_cycle);
+    } else if (x_cycle >= l_bound.m_first) {
+        l_bound.m_second = l_bound.m_first;
+        l_bound.m_first = x_cycle;
+        l_bound.m_firstRank = x_rankId;
+    } else {
+        l_bound.m_second = std::max(l_bound.m_second, x_cycle);
+    }
+}
+
+void c_FastDeviceDriver::closeBank(unsigned x_bankId, SimTime_t x_preCycle) {
+    m_openRow[x_bankId] = k_closedRow;
+    raise(m_bankNext, x_bankId, k_ACT, x_preCycle + k_nRP);
+    raise(m_bankNext, x_bankId, k_REF, x_preCycle + k_nRP);
+}
+
+/*!
+ * Update the timing tables for a command issued this cycle
+ */
+void c_FastDeviceDriver::applyTiming(unsigned x_bankId, e_BankCommandType x_type, unsigned x_row) {
+    SimTime_t l_time = m_simCycle;
+    const c_BankLocation& l_loc = m_bankLocation[x_bankId];
+    unsigned l_bg = l_loc.m_bankGroup;
+    unsigned l_rankId = l_loc.m_rank;
+    unsigned l_pch = l_loc.m_pch;
+
+    switch (x_type) {
+    case e_BankCommandType::ACT:
+        raise(m_bankNext, x_bankId, k_RD, l_time + k_nRCD);
+        raise(m_bankNext, x_bankId, k_WR, l_time + k_nRCD);
+        raise(m_bankNext, x_bankId, k_PRE, l_time + k_nRAS);
+        raise(m_bankNext, x_bankId, k_ACT, l_time + k_nRC);
+        raise(m_bankNext, x_bankId, k_REF, l_time + k_nRC);
+        raise(m_bankGroupNext, l_bg, k_ACT, l_time + k_nRRD_L);
+        raise(m_rankNext, l_rankId, k_ACT, l_time + k_nRRD_S);
+
+        m_fawWindow[l_rankId * k_fawDepth + m_fawHead[l_rankId]] = l_time + k_nFAW;
+        m_fawHead[l_rankId] = (m_fawHead[l_rankId] + 1) % k_fawDepth;
+        m_openRow[x_bankId] = x_row;
+        break;
+
+    case e_BankCommandType::READ:
+    case e_BankCommandType::READA:
+        raise(m_bankNext, x_bankId, k_PRE, l_time + k_nRTP);
+        raise(m_bankGroupNext, l_bg, k_RD, l_time + k_rdToRdL);
+        raise(m_bankGroupNext, l_bg, k_WR, l_time + k_rdToWr);
+        raise(m_rankNext, l_rankId, k_RD, l_time + k_rdToRdS);
+        raise(m_rankNext, l_rankId, k_WR, l_time + k_rdToWr);
+        raiseOtherRanks(l_pch, k_RD, l_rankId, l_time + k_rdToRdRank);
+        raiseOtherRanks(l_pch, k_WR, l_rankId, l_time + k_rdToWrRank);
+
+        if (x_type == e_BankCommandType::READA)
+            closeBank(x_bankId, m_bankNext[x_bankId * k_numCmdClasses + k_PRE]);
+        break;
+
+    case e_BankCommandType::WRITE:
+    case e_BankCommandType::WRITEA:
+        raise(m_bankNext, x_bankId, k_PRE, l_time + k_wrToPre);
+        raise(m_bankGroupNext, l_bg, k_RD, l_time + k_wrToRdL);
+        raise(m_bankGroupNext, l_bg, k_WR, l_time + k_wrToWrL);
+        raise(m_rankNext, l_rankId, k_RD, l_time + k_wrToRdS);
+        raise(m_rankNext, l_rankId, k_WR, l_time + k_wrToWrS);
+        raiseOtherRanks(l_pch, k_RD, l_rankId, l_time + k_wrToRdRank);
+        raiseOtherRanks(l_pch, k_WR, l_rankId, l_time + k_wrToWrRank);
+
+        if (x_type == e_BankCommandType::WRITEA)
+            closeBank(x_bankId, m_bankNext[x_bankId * k_numCmdClasses + k_PRE]);
+        break;
+
+    case e_BankCommandType::PRE:
+    case e_BankCommandType::PREA:
+        closeBank(x_bankId, l_time);
+        break;
+
+    case e_BankCommandType::REF:
+        raise(m_bankNext, x_bankId, k_ACT, l_time + k_nRFC);
+        raise(m_bankNext, x_bankId, k_PRE, l_time + k_nRFC);
+        raise(m_bankNext, x_bankId, k_REF, l_time + k_nRFC);
+        break;
+
+    default:
+        output->fatal(CALL_INFO, -1, "c_FastDeviceDriver: unsupported command type %d\n", (int) x_type);
+    }
+}
+
+/*!
+ * Issue ready commands from the input queue, in order per bank
+ */
+void c_FastDeviceDriver::sendRequest() {
+    SimTime_t l_time = m_simCycle;
+    unsigned l_numIssued = 0;
+
+    for (auto l_cmdPtrItr = m_inputQ.begin(); l_cmdPtrItr != m_inputQ.end();) {
+        c_BankCommand* l_cmdPtr = (*l_cmdPtrItr);
+        const c_HashedAddress* l_addr = l_cmdPtr->getHashedAddress();
+        unsigned l_bankId = l_addr->getBankId();
+        e_BankCommandType l_type = l_cmdPtr->getCommandMnemonic();
+
+        if (k_useRefresh && !m_refreshCmdQ[l_addr->getRankId()].empty()) {
+            ++l_cmdPtrItr;
+            continue;
+        }
+
+        //requests to same bank should be executed sequentially.
+        bool l_blocked = (m_bankScanCycle[l_bankId] == l_time);
+        m_bankScanCycle[l_bankId] = l_time;
+
+        if (l_type == e_BankCommandType::REF)
+            break;
+
+        if (l_blocked) {
+            ++l_cmdPtrItr;
+            continue;
+        }
+
+        bool l_isOpen = (m_openRow[l_bankId] != k_closedRow);
+
+        //skip a precharge command if the bank is already precharged
+        if (l_type == e_BankCommandType::PRE && !l_isOpen) {
+            l_cmdPtrItr = m_inputQ.erase(l_cmdPtrItr);
+            continue;
+        }
+
+        if ((l_cmdPtr->isColCommand() && !l_isOpen)
+            || (l_type == e_BankCommandType::ACT && l_isOpen)
+            || !isCommandBusAvailable(l_cmdPtr)
+            || getEarliestIssueCycle(l_bankId, getCmdClass(l_type)) > l_time) {
+            ++l_cmdPtrItr;
+            continue;
+        }
+
+        issue(l_cmdPtr);
+        l_cmdPtrItr = m_inputQ.erase(l_cmdPtrItr);
+        if (l_type == e_BankCommandType::ACT)
+            m_queuedACTs[l_bankId]--;
+
+        if (++l_numIssued == m_numCmdBuses)
+            break; // all command buses are occupied, so stop
+    }
+}
+
+/*!
+ *
+ * @param x_rankId
+ * @return
+ */
+bool c_FastDeviceDriver::sendRefresh(unsigned x_rankId) {
+    std::vector<c_BankCommand*>& l_cmdQ = m_refreshCmdQ[x_rankId];
+    c_BankCommand* l_cmdPtr = l_cmdQ.front();
+    unsigned l_cmdClass = getCmdClass(l_cmdPtr->getCommandMnemonic());
+
+    //check if the target banks are ready for the current command
+    for (auto& l_bankId : l_cmdPtr->getBankIdVec()) {
+        if (getEarliestIssueCycle(l_bankId, l_cmdClass) > m_simCycle)
+            return false;
+    }
+
+    if (!isCommandBusAvailable(l_cmdPtr))
+        return false;
+
+    printCmdTrace(l_cmdPtr);
+    for (auto& l_bankId : l_cmdPtr->getBankIdVec())
+        applyTiming(l_bankId, l_cmdPtr->getCommandMnemonic(), k_closedRow);
+    occupyCommandBus(l_cmdPtr);
+    m_issued_cmd++;
+
+    // a single command carries the bank list to the DIMM
+    forward(l_cmdPtr);
+    l_cmdQ.erase(l_cmdQ.begin());
+
+    return true;
+}
+
+/*!
+ *
+ * @param x_rankId
+ */
+void c_FastDeviceDriver::createRefreshCmds(unsigned x_rankId) {
+    unsigned l_firstBank = x_rankId * m_banksPerRank;
+    std::vector<unsigned> l_refreshBanks;
+
+    if (k_useSBRefresh) { // per-bank refresh (single bank refresh)
+        unsigned& l_nextBankToRefresh = m_nextBankToRefresh[x_rankId];
+        l_refreshBanks.push_back(l_firstBank + l_nextBankToRefresh);
+        l_nextBankToRefresh = (l_nextBankToRefresh + 1) % m_banksPerRank;
+    } else { // per-rank refresh (all bank refresh)
+        for (unsigned l_i = 0; l_i < m_banksPerRank; l_i++)
+            l_refreshBanks.push_back(l_firstBank + l_i);
+    }
+
+    //get channel id --> used for the command bus arbitration
+    unsigned l_pch = x_rankId / k_numRanksPerChannel;
+    c_HashedAddress l_hashedAddress(l_pch / k_numPChannelsPerChannel, l_pch % k_numPChannelsPerChannel,
+                                    x_rankId % k_numRanksPerChannel, 0, 0, 0, 0, l_firstBank);
+    l_hashedAddress.setRankId(x_rankId);
+
+    for (auto& l_cmdPtr : m_refreshCmdQ[x_rankId])
+        delete l_cmdPtr;
+    m_refreshCmdQ[x_rankId].clear();
+
+    //add precharge commands if the bank is open
+    std::vector<unsigned> l_bankVec;
+    for (auto& l_bankId : l_refreshBanks) {
+        if (m_openRow[l_bankId] != k_closedRow)
+            l_bankVec.push_back(l_bankId);
+    }
+    if (!l_bankVec.empty())
+        m_refreshCmdQ[x_rankId].push_back(
+                new c_BankCommand(l_bankVec.front(), e_BankCommandType::PRE, 0, l_hashedAddress, l_bankVec));
+
+    //add refresh commands
+    m_refreshCmdQ[x_rankId].push_back(
+            new c_BankCommand(l_refreshBanks.front(), e_BankCommandType::REF, 0, l_hashedAddress, l_refreshBanks));
+
+    //add active commands if there is a column command going to a bank closed by the refresh operation.
+    for (auto& l_bankId : l_refreshBanks) {
+        for (auto& l_cmd : m_inputQ) {
+            if (l_bankId == l_cmd->getBankId()) {
+                if (l_cmd->isColCommand()) {
+                    c_BankCommand* l_newCmd = new c_BankCommand(0, e_BankCommandType::ACT, l_cmd->getAddress(), *l_cmd->getHashedAddress());
+                    m_inputQ.push_front(l_newCmd);
+                    m_queuedACTs[l_bankId]++;
+                }
+                break; // stop at the first command to the bank
+            }
+        }
+    }
+}
+
+void c_FastDeviceDriver::issue(c_BankCommand* x_cmdPtr) {
+    printCmdTrace(x_cmdPtr);
+
+    applyTiming(x_cmdPtr->getBankId(), x_cmdPtr->getCommandMnemonic(), x_cmdPtr->getHashedAddress()->getRow());
+    occupyCommandBus(x_cmdPtr);
+    m_issued_cmd++;
+
+    forward(x_cmdPtr);
+}
+
+/*!
+ * Hand an issued command to the timing wheel slot of the cycle it reaches the DIMM
+ */
+void c_FastDeviceDriver::forward(c_BankCommand* x_cmdPtr) {
+    if (k_cmdForwardCycles == 0)
+        m_sendCmdFunc(x_cmdPtr);
+    else
+        m_timingWheel[(m_simCycle + k_cmdForwardCycles) & m_wheelMask].push_back(x_cmdPtr);
+}
@@ -0,0 +1,192 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef C_FASTDEVICEDRIVER_HPP
+#define C_FASTDEVICEDRIVER_HPP
+
+#include <vector>
+#include <deque>
+
+// SST includes
+#include <sst/core/subcomponent.h>
+
+// local includes
+#include "c_BankCommand.hpp"
+#include "c_DeviceDriver.hpp"
+
+namespace SST {
+namespace CramSim {
+
+/*
+ * Device driver that replaces the per-bank state machines of c_DeviceDriver
+ * with flat earliest-issue-cycle tables. Every issued command raises the
+ * earliest cycle at which each command class may next be issued to its bank,
+ * bank group, rank and to the other ranks of its (pseudo) channel, so checking
+ * a command is a handful of table lookups and update() no longer ticks every
+ * bank. Issued commands are forwarded to the DIMM through a timing wheel.
+ *
+ * Timing follows the JEDEC constraint set (nRCD, nRAS, nRC, nRP, nRTP, nWR,
+ * nCCD_L/S, nRRD_L/S, nWTR_L/S, nRTW, nERTR/nERTW/nEWTR/nEWTW rank switching, nFAW, nRFC) rather
+ * than reproducing the cycle adjustments of the c_BankState classes, so
+ * command traces can differ by a cycle or two from c_DeviceDriver.
+ */
+class c_FastDeviceDriver : public c_DeviceDriver {
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        c_FastDeviceDriver,
+        "cramSim",
+        "c_FastDeviceDriver",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Dram Control Unit using flat bank timing tables",
+        SST::CramSim::c_DeviceDriver
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"numChannels", "Total number of channels per DIMM", NULL},
+        {"numPChannelsPerChannel", "Total number of channels per pseudo channel (added to support HBM)", NULL},
+        {"numRanksPerChannel", "Total number of ranks per (p)channel", NULL},
+        {"numBankGroupsPerRank", "Total number of bank groups per rank", NULL},
+        {"numBanksPerBankGroup", "Total number of banks per group", NULL},
+        {"numRowsPerBank", "Number of rows in every bank", NULL},
+        {"numColsPerBank", "Number of cols in every bank", NULL},
+        {"boolPrintCmdTrace", "Print a command trace", NULL},
+        {"strCmdTraceFile", "Filename to print the command trace, or - for stdout", NULL},
+        {"boolUseRefresh", "Whether to use REF or not", NULL},
+        {"boolUseSBRefresh", "Whether to refresh one bank at a time instead of the whole rank", NULL},
+        {"boolDualCommandBus", "Whether to use dual command bus (added to support HBM)", NULL},
+        {"boolMultiCycleACT", "Whether to use multi-cycle (two cycles) active command (added to support HBM)", NULL},
+        {"numCmdForwardCycles", "Cycles between issuing a command and forwarding it to the DIMM", "1"},
+        {"nRC", "Bank Param", NULL},
+        {"nRRD", "Bank Param", NULL},
+        {"nRRD_L", "Bank Param", NULL},
+        {"nRRD_S", "Bank Param", NULL},
+        {"nRCD", "Bank Param", NULL},
+        {"nCCD", "Bank Param", NULL},
+        {"nCCD_L", "Bank Param", NULL},
+        {"nCCD_L_WR", "Bank Param", NULL},
+        {"nCCD_S", "Bank Param", NULL},
+        {"nAL", "Bank Param", NULL},
+        {"nCL", "Bank Param", NULL},
+        {"nCWL", "Bank Param", NULL},
+        {"nWR", "Bank Param", NULL},
+        {"nWTR", "Bank Param", NULL},
+        {"nWTR_L", "Bank Param", NULL},
+        {"nWTR_S", "Bank Param", NULL},
+        {"nRTW", "Bank Param", NULL},
+        {"nEWTR", "Bank Param", NULL},
+        {"nERTW", "Bank Param", NULL},
+        {"nEWTW", "Bank Param", NULL},
+        {"nERTR", "Bank Param", NULL},
+        {"nRAS", "Bank Param", NULL},
+        {"nRTP", "Bank Param", NULL},
+        {"nRP", "Bank Param", NULL},
+        {"nRFC", "Bank Param", NULL},
+        {"nREFI", "Bank Param", NULL},
+        {"nFAW", "Bank Param", NULL},
+        {"nBL", "Bank Param", NULL},
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+    )
+
+    c_FastDeviceDriver(ComponentId_t id, Params& x_params, Output* out, std::function<void(c_BankCommand*)> sendFunc);
+    virtual ~c_FastDeviceDriver();
+
+    virtual void run() override;
+    virtual bool push(c_BankCommand* x_cmd) override;
+    virtual bool isCmdAllowed(c_BankCommand* x_bankCommandPtr) override;
+    virtual c_BankInfo* getBankInfo(unsigned x_bankId) override; // no per-bank state objects, returns nullptr
+    virtual void update(SimTime_t simCycle) override;
+
+private:
+
+    // command classes tracked by the timing tables; READA/WRITEA use READ/WRITE
+    enum e_CmdClass { k_ACT = 0, k_RD, k_WR, k_PRE, k_REF, k_numCmdClasses };
+
+    // latest bound set by a column command, kept as the top two (value, rank)
+    // pairs so the "other ranks" bound can be read in O(1)
+    struct c_OtherRankBound {
+        SimTime_t m_first;
+        SimTime_t m_second;
+        unsigned m_firstRank;
+    };
+
+    // bank group, rank and pseudo channel of a bank, precomputed to keep divisions off the check path
+    struct c_BankLocation {
+        unsigned m_bankGroup;
+        unsigned m_rank;
+        unsigned m_pch;
+    };
+
+    static const unsigned k_closedRow = ~0u;
+    static const unsigned k_fawDepth = 4;
+
+    unsigned getCmdClass(e_BankCommandType x_type) const;
+
+    SimTime_t getEarliestIssueCycle(unsigned x_bankId, unsigned x_cmdClass) const;
+    bool isCommandBusAvailable(c_BankCommand* x_cmdPtr) const;
+    void occupyCommandBus(c_BankCommand* x_cmdPtr);
+    void raise(std::vector<SimTime_t>& x_table, unsigned x_idx, unsigned x_cmdClass, SimTime_t x_cycle);
+    void raiseOtherRanks(unsigned x_pch, unsigned x_cmdClass, unsigned x_rankId, SimTime_t x_cycle);
+    void closeBank(unsigned x_bankId, SimTime_t x_preCycle);
+    void applyTiming(unsigned x_bankId, e_BankCommandType x_type, unsigned x_row);
+
+    void sendRequest();
+    bool sendRefresh(unsigned x_rankId);
+    void createRefreshCmds(unsigned x_rankId);
+    void issue(c_BankCommand* x_cmdPtr);
+    void forward(c_BankCommand* x_cmdPtr);
+
+    // earliest-issue tables, indexed [id * k_numCmdClasses + class]
+    std::vector<SimTime_t> m_bankNext;
+    std::vector<SimTime_t> m_bankGroupNext;
+    std::vector<SimTime_t> m_rankNext;
+    std::vector<c_OtherRankBound> m_pchOtherRank; // [pch * k_numCmdClasses + class]
+
+    std::vector<c_BankLocation> m_bankLocation;
+    std::vector<unsigned> m_openRow;          // per bank, k_closedRow if precharged
+    std::vector<unsigned> m_queuedACTs;       // per bank ACT commands waiting in m_inputQ
+    std::vector<SimTime_t> m_bankScanCycle;   // in-order issue per bank within a cycle
+    std::vector<SimTime_t> m_fawWindow;       // per rank ring of the last 4 ACT cycles + nFAW
+    std::vector<unsigned> m_fawHead;
+    std::vector<SimTime_t> m_rowBusFree;      // per channel command bus
+    std::vector<SimTime_t> m_colBusFree;
+    std::vector<SimTime_t> m_rowBusPushCycle; // cycle the scheduler last pushed a command for the bus
+    std::vector<SimTime_t> m_colBusPushCycle;
+
+    // issued commands waiting to be forwarded to the DIMM
+    std::vector<std::vector<c_BankCommand*>> m_timingWheel;
+    unsigned m_wheelMask;
+    unsigned k_cmdForwardCycles;
+
+    unsigned m_banksPerRank;
+    unsigned m_numCmdBuses;
+
+    // cached timing params
+    SimTime_t k_nRC, k_nRCD, k_nRAS, k_nRP, k_nRTP, k_nRFC, k_nREFI, k_nFAW;
+    SimTime_t k_nRRD_L, k_nRRD_S;
+    SimTime_t k_rdToRdL, k_rdToRdS, k_wrToWrL, k_wrToWrS;
+    SimTime_t k_rdToWr, k_wrToRdL, k_wrToRdS, k_wrToPre;
+    SimTime_t k_rdToRdRank, k_rdToWrRank, k_wrToRdRank, k_wrToWrRank;
+};
+
+}
+}
+
+#endif // C_FASTDEVICEDRIVER_HPP
@@ -0,0 +1,110 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef C_TRACEFILEFORMAT_HPP
+#define C_TRACEFILEFORMAT_HPP
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/*
+ * Binary transaction trace read by c_TraceFileReader (traceFileType = BINARY)
+ * and written by sst-cramsim-trace-convert. The file is a c_BinaryTraceHeader
+ * followed by m_numRecords fixed-size little-endian c_BinaryTraceRecords, so it
+ * can be memory-mapped and replayed without parsing.
+ */
+
+#define CRAMSIM_TRACE_MAGIC            "CRAMTRC1"
+#define CRAMSIM_TRACE_VERSION          1
+
+// m_cycle is relative to the cycle the record is read (USIMM), not absolute (DRAMSim2)
+#define CRAMSIM_TRACE_RELATIVE_CYCLES  0x1
+
+// the write flag lives in the top bit of c_BinaryTraceRecord::m_cycle
+#define CRAMSIM_TRACE_WRITE_BIT        (UINT64_C(1) << 63)
+
+namespace SST {
+namespace CramSim {
+
+struct c_BinaryTraceHeader {
+    char     m_magic[8];
+    uint32_t m_version;
+    uint32_t m_flags;
+    uint64_t m_numRecords;
+    uint64_t m_reserved;
+};
+
+struct c_BinaryTraceRecord {
+    uint64_t m_address;
+    uint64_t m_cycle;
+
+    bool isWrite() const { return 0 != (m_cycle & CRAMSIM_TRACE_WRITE_BIT); }
+    uint64_t getCycle() const { return m_cycle & ~CRAMSIM_TRACE_WRITE_BIT; }
+};
+
+static_assert(sizeof(c_BinaryTraceHeader) == 32, "c_BinaryTraceHeader must be 32 bytes");
+static_assert(sizeof(c_BinaryTraceRecord) == 16, "c_BinaryTraceRecord must be 16 bytes");
+
+/*
+ * Parse one line of a text trace with the same field rules as c_TraceFileReader:
+ *   DRAMSim2: <address> <type, "WR" means write> <cycle>
+ *   USIMM:    <cycle delta> <type, "W" means write> <address> [pc]
+ * Returns false for blank lines and lines with too few fields.
+ */
+inline bool parseTextTraceLine(const char* x_line, bool x_isUSIMM, c_BinaryTraceRecord* x_record) {
+    const char* l_tokens[4];
+    size_t l_lengths[4];
+    unsigned l_numTokens = 0;
+    const char* l_cur = x_line;
+
+    while (*l_cur != '\0' && *l_cur != '\n' && l_numTokens < 4) {
+        while (*l_cur == ' ' || *l_cur == '\t' || *l_cur == '\r')
+            l_cur++;
+        if (*l_cur == '\0' || *l_cur == '\n')
+            break;
+        l_tokens[l_numTokens] = l_cur;
+        while (*l_cur != '\0' && *l_cur != '\n' && *l_cur != ' ' && *l_cur != '\t' && *l_cur != '\r')
+            l_cur++;
+        l_lengths[l_numTokens] = l_cur - l_tokens[l_numTokens];
+        l_numTokens++;
+    }
+
+    if (l_numTokens < 3)
+        return false;
+
+    std::string l_type(l_tokens[1], l_lengths[1]);
+    uint64_t l_cycle;
+    bool l_isWrite;
+
+    if (x_isUSIMM) {
+        l_cycle = strtoull(l_tokens[0], NULL, 10);
+        l_isWrite = (l_type.find("W") != std::string::npos);
+        x_record->m_address = strtoull(l_tokens[2], NULL, 0);
+    } else {
+        x_record->m_address = strtoull(l_tokens[0], NULL, 0);
+        l_isWrite = (l_type.find("WR") != std::string::npos);
+        l_cycle = strtoull(l_tokens[2], NULL, 10);
+    }
+
+    x_record->m_cycle = (l_cycle & ~CRAMSIM_TRACE_WRITE_BIT) | (l_isWrite ? CRAMSIM_TRACE_WRITE_BIT : 0);
+    return true;
+}
+
+}
+}
+
+#endif // C_TRACEFILEFORMAT_HPP
@@ -20,6 +20,10 @@
 #include <assert.h>
 #include <iostream>
 #include <stdlib.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <sst/core/stringize.h>
 
@@ -37,6 +41,15 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
     // trace file param
     bool l_found=false;
 
+    m_traceFileStream = nullptr;
+    m_binaryFd = -1;
+    m_binaryMap = nullptr;
+    m_binaryMapLen = 0;
+    m_binaryRecords = nullptr;
+    m_numBinaryRecords = 0;
+    m_nextBinaryRecord = 0;
+    m_binaryRelativeCycles = false;
+
     // get trace file name
     m_traceFileName = x_params.find<std::string>("traceFile", "nil", l_found);
     if (!l_found)
@@ -47,12 +60,6 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
     {
         output->output("TraceFileReader: tracefile name is %s\n", m_traceFileName.c_str());
     }
-    m_traceFileStream = new std::ifstream(m_traceFileName, std::ifstream::in);
-    if(!(*m_traceFileStream))
-    {
-        output->fatal(CALL_INFO, -1, "Unable to open trace file %s Aborting!\n", m_traceFileName.c_str());
-    }
-
     // get trace file type
     std::string l_traceFileType= x_params.find<std::string>("traceFileType", "DEFAULT", l_found);
     if (!l_found)
@@ -67,11 +74,28 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
     {
         m_traceType=e_TracefileType ::USIMM;
     }
+    else if(l_traceFileType=="BINARY")
+    {
+        m_traceType=e_TracefileType::BINARY;
+    }
     else
     {
         output->fatal(CALL_INFO, -1, "TraceFileReader: trace file type error!!\n");
     }
 
+    if(m_traceType==e_TracefileType::BINARY)
+    {
+        openBinaryTrace();
+    }
+    else
+    {
+        m_traceFileStream = new std::ifstream(m_traceFileName, std::ifstream::in);
+        if(!(*m_traceFileStream))
+        {
+            output->fatal(CALL_INFO, -1, "Unable to open trace file %s Aborting!\n", m_traceFileName.c_str());
+        }
+    }
+
     // tell the simulator not to end without us
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -79,8 +103,104 @@ c_TraceFileReader::c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_par
 }
 
 
+c_TraceFileReader::~c_TraceFileReader()
+{
+    if(m_binaryMap != nullptr)
+        munmap(m_binaryMap, m_binaryMapLen);
+    if(m_binaryFd >= 0)
+        close(m_binaryFd);
+    delete m_traceFileStream;
+}
+
+
+void c_TraceFileReader::openBinaryTrace()
+{
+    m_binaryFd = open(m_traceFileName.c_str(), O_RDONLY);
+    if(m_binaryFd < 0)
+    {
+        output->fatal(CALL_INFO, -1, "Unable to open trace file %s Aborting!\n", m_traceFileName.c_str());
+    }
+
+    struct stat l_stat;
+    if(fstat(m_binaryFd, &l_stat) != 0)
+    {
+        output->fatal(CALL_INFO, -1, "TraceFileReader: unable to stat trace file %s\n", m_traceFileName.c_str());
+    }
+
+    m_binaryMapLen = l_stat.st_size;
+    if(m_binaryMapLen < sizeof(c_BinaryTraceHeader))
+    {
+        output->fatal(CALL_INFO, -1, "TraceFileReader: %s is too small to be a binary trace\n", m_traceFileName.c_str());
+    }
+
+    m_binaryMap = mmap(nullptr, m_binaryMapLen, PROT_READ, MAP_PRIVATE, m_binaryFd, 0);
+    if(m_binaryMap == MAP_FAILED)
+    {
+        m_binaryMap = nullptr;
+        output->fatal(CALL_INFO, -1, "TraceFileReader: unable to map trace file %s\n", m_traceFileName.c_str());
+    }
+    posix_madvise(m_binaryMap, m_binaryMapLen, POSIX_MADV_SEQUENTIAL);
+
+    const c_BinaryTraceHeader* l_header = static_cast<const c_BinaryTraceHeader*>(m_binaryMap);
+    if(memcmp(l_header->m_magic, CRAMSIM_TRACE_MAGIC, sizeof(l_header->m_magic)) != 0)
+    {
+        output->fatal(CALL_INFO, -1, "TraceFileReader: %s is not a binary cramSim trace\n", m_traceFileName.c_str());
+    }
+    if(l_header->m_version != CRAMSIM_TRACE_VERSION)
+    {
+        output->fatal(CALL_INFO, -1, "TraceFileReader: %s has trace version %" PRIu32 ", expected %d\n",
+                      m_traceFileName.c_str(), l_header->m_version, CRAMSIM_TRACE_VERSION);
+    }
+
+    m_numBinaryRecords = l_header->m_numRecords;
+    if(m_numBinaryRecords > (m_binaryMapLen - sizeof(c_BinaryTraceHeader)) / sizeof(c_BinaryTraceRecord))
+    {
+        output->fatal(CALL_INFO, -1, "TraceFileReader: %s is truncated (%" PRIu64 " records declared)\n",
+                      m_traceFileName.c_str(), m_numBinaryRecords);
+    }
+
+    m_binaryRecords = reinterpret_cast<const c_BinaryTraceRecord*>(static_cast<const char*>(m_binaryMap) + sizeof(c_BinaryTraceHeader));
+    m_binaryRelativeCycles = (l_header->m_flags & CRAMSIM_TRACE_RELATIVE_CYCLES) != 0;
+
+    output->output("TraceFileReader: mapped %" PRIu64 " binary trace records\n", m_numBinaryRecords);
+}
+
+
+void c_TraceFileReader::createBinaryTxn()
+{
+    while(m_txnReqQ.size()<k_numTxnPerCycle)
+    {
+        if(m_nextBinaryRecord == m_numBinaryRecords)
+        {
+            primaryComponentOKToEndSim();
+            output->output("TraceFileReader: Ran out of txn's to read\n");
+            m_nextBinaryRecord++;
+            break;
+        }
+        else if(m_nextBinaryRecord > m_numBinaryRecords)
+        {
+            break;
+        }
+
+        const c_BinaryTraceRecord& l_record = m_binaryRecords[m_nextBinaryRecord++];
+        e_TransactionType l_txnType = l_record.isWrite() ? e_TransactionType::WRITE : e_TransactionType::READ;
+        uint64_t l_txnInterval = m_binaryRelativeCycles ? m_simCycle + l_record.getCycle() : l_record.getCycle();
+
+        c_Transaction* l_txn = new c_Transaction(m_seqNum, l_txnType, l_record.m_address, 1);
+        m_txnReqQ.push_back(std::make_pair(l_txn, l_txnInterval));
+        m_seqNum++;
+    }
+}
+
+
 void c_TraceFileReader::createTxn()
 {
+    if(m_traceType==e_TracefileType::BINARY)
+    {
+        createBinaryTxn();
+        return;
+    }
+
 // check if txn can fit inside Req q
     while(m_txnReqQ.size()<k_numTxnPerCycle)
     {
@@ -30,6 +30,7 @@
 //local includes
 #include "c_Transaction.hpp"
 #include "c_TxnGen.hpp"
+#include "c_TraceFileFormat.hpp"
 
 
 namespace SST {
@@ -50,7 +51,8 @@ namespace SST {
                 {"maxOutstandingReqs", "Maximum number of the outstanding requests", NULL},
                 {"numTxnPerCycle", "The number of transactions generated per cycle", NULL},
                 {"traceFile", "Location of trace file to read", NULL},
-                {"traceFileType", "Trace file type (DEFAULT or USIMM)",NULL},
+                {"traceFileType", "Trace file type (DEFAULT, USIMM or BINARY). BINARY traces are produced by sst-cramsim-trace-convert",NULL},
+                {"batchInjection", "Send all transactions issued in a cycle as one event (1) instead of one event per transaction (0)", "0"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -69,19 +71,31 @@ namespace SST {
             )
 
             c_TraceFileReader(SST::ComponentId_t x_id, SST::Params& x_params);
-            ~c_TraceFileReader(){}
+            ~c_TraceFileReader();
         private:
             enum e_TracefileType{
                 DEFAULT,   //DRAMsim2 type
-                USIMM
+                USIMM,
+                BINARY     //memory-mapped c_BinaryTraceRecords
             };
             virtual void createTxn();
+            void openBinaryTrace();
+            void createBinaryTxn();
 
             //params for internal microarcitecture
             std::string m_traceFileName;
             std::ifstream *m_traceFileStream;
 
             e_TracefileType m_traceType;
+
+            //binary trace mapping
+            int m_binaryFd;
+            void* m_binaryMap;
+            size_t m_binaryMapLen;
+            const c_BinaryTraceRecord* m_binaryRecords;
+            uint64_t m_numBinaryRecords;
+            uint64_t m_nextBinaryRecord;
+            bool m_binaryRelativeCycles;
         };
     }
 }
@@ -142,7 +142,11 @@ void c_TxnDispatcher::handleTxnGenEvent(SST::Event *ev)
     m_reqQ.push_back(l_newReq);
 
     #ifdef __SST_DEBUG_OUTPUT__
-    l_newReq->m_payload->print(&dbg,"[c_TxnDispatcher.handleTxnGenEvent]",m_simCycle);
+    if (l_newReq->m_batch.empty())
+        l_newReq->m_payload->print(&dbg,"[c_TxnDispatcher.handleTxnGenEvent]",m_simCycle);
+    else
+        for (c_Transaction* l_txn : l_newReq->m_batch)
+            l_txn->print(&dbg,"[c_TxnDispatcher.handleTxnGenEvent]",m_simCycle);
     #endif
 }
 
@@ -165,6 +169,37 @@ uint32_t c_TxnDispatcher::getLaneIdx(uint64_t x_addr)
 
 void c_TxnDispatcher::sendRequest(c_TxnReqEvent* x_newReq)
 {
+    if (!x_newReq->m_batch.empty())
+    {
+        // a batch can go through untouched when there is only one lane,
+        // otherwise regroup its transactions into one event per lane
+        if (k_numLanes == 1)
+        {
+            m_laneLinks[0]->send(x_newReq);
+            return;
+        }
+
+        std::vector<c_TxnReqEvent*> l_laneReqs(m_laneLinks.size(), nullptr);
+        for (c_Transaction* l_txn : x_newReq->m_batch)
+        {
+            uint32_t l_laneIdx = getLaneIdx(l_txn->getAddress());
+            assert(l_laneIdx < m_laneLinks.size());
+
+            if (l_laneReqs[l_laneIdx] == nullptr)
+                l_laneReqs[l_laneIdx] = new c_TxnReqEvent();
+            l_laneReqs[l_laneIdx]->m_batch.push_back(l_txn);
+        }
+
+        for (uint32_t l_laneIdx = 0; l_laneIdx < l_laneReqs.size(); l_laneIdx++)
+        {
+            if (l_laneReqs[l_laneIdx] != nullptr)
+                m_laneLinks[l_laneIdx]->send(l_laneReqs[l_laneIdx]);
+        }
+
+        delete x_newReq;
+        return;
+    }
+
     uint64_t l_addr = x_newReq->m_payload->getAddress();
     uint32_t l_laneIdx = getLaneIdx(l_addr);
 
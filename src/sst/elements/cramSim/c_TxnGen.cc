@@ -77,6 +77,8 @@ c_TxnGenBase::c_TxnGenBase(ComponentId_t x_id, Params& x_params) :
     }
     m_sizeOffset = (uint)log2(k_numBytesPerTransaction);
 
+    k_batchInjection = x_params.find<bool>("batchInjection", false);
+
     /*---- CONFIGURE LINKS ----*/
 
     // request-related links
@@ -154,10 +156,15 @@ bool c_TxnGenBase::clockTic(Cycle_t) {
         }
     }
 
+    // with batch injection, every transaction released this cycle rides in one event
+    c_TxnReqEvent* l_batchEv = nullptr;
+    if (k_batchInjection && !m_txnReqQ.empty() && m_txnReqQ.front().second <= m_simCycle)
+        l_batchEv = new c_TxnReqEvent();
+
     for(int i=0;i<k_numTxnPerCycle;i++) {
         if(k_maxOutstandingReqs==0 || m_numOutstandingReqs<k_maxOutstandingReqs) {
 
-            if(sendRequest()==false)
+            if(sendRequest(l_batchEv)==false)
                 break;
 
             m_numOutstandingReqs++;
@@ -165,6 +172,18 @@ bool c_TxnGenBase::clockTic(Cycle_t) {
             break;
 
     }
+
+    if (l_batchEv != nullptr) {
+        if (l_batchEv->m_batch.empty()) {
+            delete l_batchEv;
+        } else {
+            if (l_batchEv->m_batch.size() == 1) {
+                l_batchEv->m_payload = l_batchEv->m_batch.front();
+                l_batchEv->m_batch.clear();
+            }
+            m_memLink->send(l_batchEv);
+        }
+    }
     return false;
 }
 
@@ -225,7 +244,7 @@ void c_TxnGenBase::handleResEvent(SST::Event* ev) {
 
 
 
-bool c_TxnGenBase::sendRequest()
+bool c_TxnGenBase::sendRequest(c_TxnReqEvent* x_batchEv)
 {
     assert(k_maxOutstandingReqs==0 || m_numOutstandingReqs<=k_maxOutstandingReqs);
     if(!m_txnReqQ.empty())
@@ -255,15 +274,19 @@ bool c_TxnGenBase::sendRequest()
             m_reqWriteCount++;
         }
 
-        c_TxnReqEvent* l_txnReqEvPtr = new c_TxnReqEvent();
-        l_txnReqEvPtr->m_payload = m_txnReqQ.front().first;
+        c_Transaction *l_txn=m_txnReqQ.front().first;
         m_txnReqQ.pop_front();
 
-        assert(m_memLink!=NULL);
-        m_memLink->send(l_txnReqEvPtr);
+        if (x_batchEv != nullptr) {
+            x_batchEv->m_batch.push_back(l_txn);
+        } else {
+            c_TxnReqEvent* l_txnReqEvPtr = new c_TxnReqEvent();
+            l_txnReqEvPtr->m_payload = l_txn;
 
+            assert(m_memLink!=NULL);
+            m_memLink->send(l_txnReqEvPtr);
+        }
 
-        c_Transaction *l_txn=l_txnReqEvPtr->m_payload;
     #ifdef __SST_DEBUG_OUTPUT__
         debug->verbose(CALL_INFO,1,0,"[cycle:%lld] addr: 0x%lx isRead:%d seqNum:%lu\n",l_cycle,l_txn->getAddress(),l_txn->isRead(),l_txn->getSeqNum());
     #endif
@@ -19,6 +19,7 @@
 
 #include <stdint.h>
 #include <queue>
+#include <unordered_map>
 
 //SST includes
 #include <sst/core/component.h>
@@ -29,6 +30,8 @@
 
 namespace SST {
     namespace CramSim {
+        class c_TxnReqEvent;
+
         class c_TxnGenBase: public SST::Component {
 
         public:
@@ -43,7 +46,7 @@ namespace SST {
             c_TxnGenBase(); //for serialization only
             virtual void createTxn()=0;
             virtual void handleResEvent(SST::Event *ev); //handleEvent
-            virtual bool sendRequest(); //send out txn req ptr to Transaction unit
+            virtual bool sendRequest(c_TxnReqEvent* x_batchEv = nullptr); //send out txn req ptr to Transaction unit, or append it to x_batchEv
             virtual bool readResponse(); //read from res q to output
             virtual bool clockTic(SST::Cycle_t); //called every cycle
 
@@ -53,7 +56,7 @@ namespace SST {
             //internal microarchitecture
             std::deque<std::pair<c_Transaction*, uint64_t>> m_txnReqQ;
             std::deque<c_Transaction*> m_txnResQ;
-            std::map<uint64_t, uint64_t> m_outstandingReqs; //(txn_id, birth time)
+            std::unordered_map<uint64_t, uint64_t> m_outstandingReqs; //(txn_id, birth time)
             uint32_t m_numOutstandingReqs;
             uint64_t m_numTxns;
             uint32_t m_seqNum;
@@ -66,6 +69,7 @@ namespace SST {
             uint32_t k_numTxnPerCycle;
             uint32_t k_maxOutstandingReqs;
             uint64_t k_maxTxns;
+            bool k_batchInjection;
 
             // used to keep track of the response types being received
             uint64_t m_resReadCount;
@@ -112,6 +116,7 @@ namespace SST {
                 {"strControllerClockFrequency", "Clock frequency", "1GHz"},
                 {"maxTxns", "Maximum number of transactions to generate. Unspecified means no limit.", NULL},
                 {"numBytesPerTransaction", "Number of bytes per transaction", "32"},
+                {"batchInjection", "Send all transactions issued in a cycle as one event (1) instead of one event per transaction (0)", "0"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
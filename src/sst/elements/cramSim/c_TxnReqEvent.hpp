@@ -34,6 +34,8 @@
 #ifndef C_TXNREQEVENT_HPP_
 #define C_TXNREQEVENT_HPP_
 
+#include <vector>
+
 #include "c_Transaction.hpp"
 
 namespace SST {
@@ -42,13 +44,18 @@ class c_TxnReqEvent: public SST::Event {
 public:
     c_Transaction *m_payload; // FIXME: change this pointer to a unique_ptr
 
+    // transactions injected in the same cycle when batchInjection is enabled;
+    // m_payload is null when the batch is used
+    std::vector<c_Transaction*> m_batch;
+
     c_TxnReqEvent() :
-            SST::Event() {
+            SST::Event(), m_payload(nullptr) {
     }
 
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
         Event::serialize_order(ser);
         ser & m_payload;
+        ser & m_batch;
     }
 
     ImplementSerializable (SST::CramSim::c_TxnReqEvent);
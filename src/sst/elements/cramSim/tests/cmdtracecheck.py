@@ -0,0 +1,164 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Copyright 2009-2023 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2023, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Brute-force JEDEC timing checker for the command trace written by the
+# cramSim device drivers (boolPrintCmdTrace=1).  Every issued command is
+# checked against the commands before it on the same bank, bank group, rank
+# and on the other ranks of the channel, and ACTs against the nFAW window.
+#
+# Usage: cmdtracecheck.py <config file> <cmd trace> [<cmd trace> ...]
+
+import sys
+
+ACT, READ, WRITE, PRE, REF = range(5)
+
+_cmdClass = {
+    "ACT": ACT,
+    "READ": READ, "READA": READ,
+    "WRITE": WRITE, "WRITEA": WRITE,
+    "PRE": PRE, "PREA": PRE,
+    "REF": REF,
+}
+
+
+class Command(object):
+    def __init__(self, cycle, name, channel, pchannel, rank, bankgroup, bank):
+        self.cycle = cycle
+        self.name = name
+        self.cls = _cmdClass[name]
+        self.rank = (channel, pchannel, rank)
+        self.bankgroup = self.rank + (bankgroup,)
+        self.bank = self.bankgroup + (bank,)
+
+
+def read_config(config_file):
+    params = {}
+    with open(config_file, 'r') as f:
+        for line in f:
+            tokens = line.split()
+            if len(tokens) >= 2:
+                params[tokens[0]] = tokens[1]
+    return params
+
+
+def read_trace(trace_file):
+    # "@<cycle> <cmd> <seq> 0x<addr> <ch> <pch> <rank> <bg> <bank> <row> <col> <cl>"
+    # refresh lines carry no address, they are counted but not checked
+    commands = []
+    refreshes = 0
+    with open(trace_file, 'r') as f:
+        for line in f:
+            tokens = line.split()
+            if len(tokens) == 0 or not tokens[0].startswith("@"):
+                continue
+            if tokens[1] not in _cmdClass:
+                continue
+            if _cmdClass[tokens[1]] == REF:
+                refreshes += 1
+                continue
+            commands.append(Command(int(tokens[0][1:]), tokens[1],
+                                    *[int(t) for t in tokens[4:9]]))
+    return commands, refreshes
+
+
+def _required_gap(prev, cur, t):
+    need = 0
+    pc = prev.cls
+    cc = cur.cls
+    if prev.bank == cur.bank:
+        if pc == ACT and cc in (READ, WRITE): need = t["nRCD"]
+        if pc == ACT and cc == PRE: need = t["nRAS"]
+        if pc == ACT and cc == ACT: need = t["nRC"]
+        if pc == READ and cc == PRE: need = t["nRTP"]
+        if pc == WRITE and cc == PRE: need = t["nCWL"] + t["nBL"] + t["nWR"]
+        if pc == PRE and cc == ACT: need = t["nRP"]
+
+    if prev.bankgroup == cur.bankgroup:
+        if pc == ACT and cc == ACT and prev.bank != cur.bank: need = max(need, t["nRRD_L"])
+        if pc == READ and cc == READ: need = max(need, t["ccdL"])
+        if pc == WRITE and cc == WRITE: need = max(need, t["ccdL"])
+        if pc == READ and cc == WRITE: need = max(need, t["nCL"] + t["nBL"] + t["nRTW"] - t["nCWL"])
+        if pc == WRITE and cc == READ: need = max(need, t["nCWL"] + t["nBL"] + t["nWTR_L"])
+    elif prev.rank == cur.rank:
+        if pc == ACT and cc == ACT: need = max(need, t["nRRD_S"])
+        if pc == READ and cc == READ: need = max(need, t["ccdS"])
+        if pc == WRITE and cc == WRITE: need = max(need, t["ccdS"])
+        if pc == READ and cc == WRITE: need = max(need, t["nCL"] + t["nBL"] + t["nRTW"] - t["nCWL"])
+        if pc == WRITE and cc == READ: need = max(need, t["nCWL"] + t["nBL"] + t["nWTR_S"])
+    elif prev.rank[:2] == cur.rank[:2]:
+        if pc == READ and cc == READ: need = t["burst"] + t["nERTR"]
+        if pc == READ and cc == WRITE: need = t["nCL"] + t["burst"] + t["nERTW"] - t["nCWL"]
+        if pc == WRITE and cc == READ: need = t["nCWL"] + t["burst"] + t["nEWTR"] - t["nCL"]
+        if pc == WRITE and cc == WRITE: need = t["burst"] + t["nEWTW"]
+    return need
+
+
+def check_trace(commands, params):
+    t = dict((k, int(v)) for k, v in params.items() if k.startswith("n") and v.isdigit())
+    t["ccdL"] = max(t["nCCD_L"], t["nBL"])
+    t["ccdS"] = max(t["nCCD_S"], t["nBL"])
+    t["burst"] = max(t["nBL"], min(t["nCCD_S"], t["nCCD_L"]))
+
+    # the trace is in issue order, so only commands within the longest
+    # constraint of the current one can conflict with it
+    horizon = max(t["nRC"], t["nRAS"], t["nFAW"],
+                  t["nCWL"] + t["nBL"] + t["nWR"],
+                  t["nCWL"] + t["nBL"] + t["nWTR_L"],
+                  t["nCL"] + t["nBL"] + t["nRTW"] - t["nCWL"],
+                  t["nCL"] + t["burst"] + t["nERTW"] - t["nCWL"],
+                  t["nCWL"] + t["burst"] + t["nEWTR"] - t["nCL"],
+                  t["burst"] + max(t["nERTR"], t["nEWTW"]))
+
+    violations = []
+    acts = {}
+    for i, cur in enumerate(commands):
+        if cur.cls == ACT:
+            rank_acts = acts.setdefault(cur.rank, [])
+            rank_acts.append(cur.cycle)
+            if len(rank_acts) >= 5 and cur.cycle - rank_acts[-5] < t["nFAW"]:
+                violations.append("nFAW: ACT @{0} rank {1}".format(cur.cycle, cur.rank))
+        for j in range(i - 1, -1, -1):
+            prev = commands[j]
+            if cur.cycle - prev.cycle >= horizon:
+                break
+            need = _required_gap(prev, cur, t)
+            if need > 0 and cur.cycle - prev.cycle < need:
+                violations.append("{0} @{1} -> {2} @{3}: need {4} cycles".format(
+                    prev.name, prev.cycle, cur.name, cur.cycle, need))
+    return violations
+
+
+def command_counts(commands):
+    counts = {}
+    for cmd in commands:
+        counts[cmd.name] = counts.get(cmd.name, 0) + 1
+    return counts
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        print("Usage: {0} <config file> <cmd trace> [<cmd trace> ...]".format(sys.argv[0]))
+        sys.exit(2)
+
+    params = read_config(sys.argv[1])
+    failed = False
+    for trace_file in sys.argv[2:]:
+        commands, refreshes = read_trace(trace_file)
+        violations = check_trace(commands, params)
+        for v in violations[:10]:
+            print("  " + v)
+        print("{0}: commands={1} refreshes={2} violations={3}".format(
+            trace_file, len(commands), refreshes, len(violations)))
+        failed = failed or len(violations) > 0
+    sys.exit(1 if failed else 0)
@@ -67,10 +67,19 @@ if "dumpConfig" in g_params and int(g_params["dumpConfig"]):
         print(key + " " + g_params[key])
     print("###########################\n")
 
+# device driver subcomponent, e.g. deviceDriver=c_FastDeviceDriver
+deviceDriver = g_params.pop("deviceDriver", "c_DeviceDriver")
+
+# numLanes>1 puts a c_TxnDispatcher between the trace reader and one
+# controller and dimm per lane, laneIdxPos picks the lane address bits
+numLanes = int(g_params.pop("numLanes", "1"))
+laneIdxPos = g_params.pop("laneIdxPos", "5:5")
+
 numChannels = int(g_params["numChannels"])
-maxOutstandingReqs = numChannels*128
-numTxnPerCycle = numChannels
-maxTxns = 100000 * numChannels
+totalChannels = numChannels*numLanes
+maxOutstandingReqs = totalChannels*128
+numTxnPerCycle = totalChannels
+maxTxns = 100000 * totalChannels
 
 
 # Define SST core options
@@ -93,37 +102,55 @@ comp_txnGen.addParams({
 comp_txnGen.enableAllStatistics()
 
 
-# controller
-comp_controller = sst.Component("MemController"+"0", "cramSim.c_Controller")
-comp_controller.addParams(g_params)
-c0 = comp_controller.setSubComponent("TxnScheduler", "cramSim.c_TxnScheduler")
-c1 = comp_controller.setSubComponent("TxnConverter", "cramSim.c_TxnConverter")
-c2 = comp_controller.setSubComponent("AddrMapper", "cramSim.c_AddressHasher")
-c3 = comp_controller.setSubComponent("CmdScheduler", "cramSim.c_CmdScheduler")
-c4 = comp_controller.setSubComponent("DeviceDriver", "cramSim.c_DeviceDriver")
-c0.addParams(g_params)
-c1.addParams(g_params)
-c2.addParams(g_params)
-c3.addParams(g_params)
-c4.addParams(g_params)
-
-# device
-comp_dimm = sst.Component("Dimm"+"0", "cramSim.c_Dimm")
-comp_dimm.addParams(g_params)
-
-# TXNGEN / Controller LINKS
-# TxnGen <-> Controller (Txn)
-txnReqLink_0 = sst.Link("txnReqLink_0_"+"0")
-txnReqLink_0.connect((comp_txnGen, "memLink", g_params["clockCycle"]), (comp_controller, "txngenLink", g_params["clockCycle"]) )
-
-
-# Controller <-> Dimm
-cmdReqLink_1 = sst.Link("cmdReqLink_1_"+"0")
-cmdReqLink_1.connect( (comp_controller, "memLink", g_params["clockCycle"]), (comp_dimm, "ctrlLink", g_params["clockCycle"]) )
-
-
-# enable all statistics
-comp_controller.enableAllStatistics()
-#comp_txnUnit0.enableAllStatistics({ "type":"sst.AccumulatorStatistic",
-#                                    "rate":"1 us"})
-#comp_dimm.enableAllStatistics()
+if numLanes > 1:
+    comp_txnDispatcher = sst.Component("txnDispatcher", "cramSim.c_TxnDispatcher")
+    comp_txnDispatcher.addParams({
+        "numLanes" : numLanes,
+        "laneIdxPos" : laneIdxPos
+        })
+
+    txnGenLink = sst.Link("txnGenLink")
+    txnGenLink.connect((comp_txnGen, "memLink", g_params["clockCycle"]), (comp_txnDispatcher, "txnGen", g_params["clockCycle"]))
+
+
+for chid in range(numLanes):
+
+    # controller
+    comp_controller = sst.Component("MemController"+str(chid), "cramSim.c_Controller")
+    comp_controller.addParams(g_params)
+    c0 = comp_controller.setSubComponent("TxnScheduler", "cramSim.c_TxnScheduler")
+    c1 = comp_controller.setSubComponent("TxnConverter", "cramSim.c_TxnConverter")
+    c2 = comp_controller.setSubComponent("AddrMapper", "cramSim.c_AddressHasher")
+    c3 = comp_controller.setSubComponent("CmdScheduler", "cramSim.c_CmdScheduler")
+    c4 = comp_controller.setSubComponent("DeviceDriver", "cramSim." + deviceDriver)
+    c0.addParams(g_params)
+    c1.addParams(g_params)
+    c2.addParams(g_params)
+    c3.addParams(g_params)
+    c4.addParams(g_params)
+
+    # device
+    comp_dimm = sst.Component("Dimm"+str(chid), "cramSim.c_Dimm")
+    comp_dimm.addParams(g_params)
+
+    # TXNGEN / Controller LINKS
+    # TxnGen <-> Controller (Txn), through the dispatcher lane when there is more than one
+    txnReqLink_0 = sst.Link("txnReqLink_0_"+str(chid))
+    if numLanes > 1:
+        txnReqLink_0.connect((comp_txnDispatcher, "lane_"+str(chid), g_params["clockCycle"]), (comp_controller, "txngenLink", g_params["clockCycle"]) )
+        # per lane transaction counts
+        c1.enableAllStatistics()
+    else:
+        txnReqLink_0.connect((comp_txnGen, "memLink", g_params["clockCycle"]), (comp_controller, "txngenLink", g_params["clockCycle"]) )
+
+
+    # Controller <-> Dimm
+    cmdReqLink_1 = sst.Link("cmdReqLink_1_"+str(chid))
+    cmdReqLink_1.connect( (comp_controller, "memLink", g_params["clockCycle"]), (comp_dimm, "ctrlLink", g_params["clockCycle"]) )
+
+
+    # enable all statistics
+    comp_controller.enableAllStatistics()
+    #comp_txnUnit0.enableAllStatistics({ "type":"sst.AccumulatorStatistic",
+    #                                    "rate":"1 us"})
+    #comp_dimm.enableAllStatistics()
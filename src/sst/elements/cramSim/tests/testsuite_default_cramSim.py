@@ -4,6 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 
 import os
+import sys
 import shutil
 
 ################################################################################
@@ -80,6 +81,15 @@ class testcase_cramSim_Component(SSTTestCase):
     def test_cramSim_6_W(self):
         self.cramSim_test_template("6_W")
 
+    def test_cramSim_FastDeviceDriver_1_RW(self):
+        self.cramSim_fastdriver_template("1_RW")
+
+    def test_cramSim_FastDeviceDriver_4_W(self):
+        self.cramSim_fastdriver_template("4_W")
+
+    def test_cramSim_BinaryTrace_1_RW(self):
+        self.cramSim_binarytrace_template("1_RW")
+
 #####
 
     def cramSim_test_template(self, testcase):
@@ -137,6 +147,131 @@ class testcase_cramSim_Component(SSTTestCase):
         else:
             self.assertTrue(cmp_result, "Output file {0} does not match Reference File {1}".format(outfile, reffile))
 
+    def cramSim_fastdriver_template(self, testcase):
+        # Run the same verimem trace through c_DeviceDriver and
+        # c_FastDeviceDriver with the command trace enabled, check both
+        # command traces against the JEDEC timing rules and compare them.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        self.testcramSimDir = "{0}/testcramSim".format(tmpdir)
+        self.testcramSimTestsDir = "{0}/tests".format(self.testcramSimDir)
+
+        sys.path.insert(0, test_path)
+        import cmdtracecheck
+
+        sdlfile    = "{0}/test_txntrace.py".format(self.testcramSimTestsDir)
+        tracefile  = "{0}/sst-CramSim-trace_verimem_{1}.trc".format(self.testcramSimTestsDir, testcase)
+        configfile = "{0}/ddr4_verimem.cfg".format(self.testcramSimDir)
+        params = cmdtracecheck.read_config(configfile)
+
+        traces = {}
+        for driver in ["c_DeviceDriver", "c_FastDeviceDriver"]:
+            testDataFileName = "test_cramSim_{0}_{1}".format(driver, testcase)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            cmdtracefile = "{0}/{1}.cmdtrc".format(tmpdir, testDataFileName)
+
+            otherargs = '--model-options=\"--configfile={0} --traceFile={1} deviceDriver={2} boolPrintCmdTrace=1 strCmdTraceFile={3}\"'.format(configfile, tracefile, driver, cmdtracefile)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("cramSim test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            cmd = 'grep -q "Simulation is complete" {0} '.format(outfile)
+            self.assertTrue(os.system(cmd) == 0, "Output file {0} does not contain a simulation complete message".format(outfile))
+
+            commands, refreshes = cmdtracecheck.read_trace(cmdtracefile)
+            self.assertTrue(len(commands) > 0, "Command trace {0} is empty".format(cmdtracefile))
+            violations = cmdtracecheck.check_trace(commands, params)
+            self.assertEqual(len(violations), 0, "{0} issued {1} commands violating JEDEC timing, first: {2}".format(driver, len(violations), violations[:1]))
+            traces[driver] = commands
+
+        # the fast driver applies the JEDEC constraints directly instead of
+        # the bank state machine adjustments, so a command can issue a cycle
+        # or two apart, but the command mix and the run length must agree
+        base = traces["c_DeviceDriver"]
+        fast = traces["c_FastDeviceDriver"]
+        baseCounts = cmdtracecheck.command_counts(base)
+        fastCounts = cmdtracecheck.command_counts(fast)
+        for name in set(baseCounts) | set(fastCounts):
+            b = baseCounts.get(name, 0)
+            f = fastCounts.get(name, 0)
+            self.assertTrue(abs(f - b) <= max(2, b // 20), "{0} count differs: c_DeviceDriver {1}, c_FastDeviceDriver {2}".format(name, b, f))
+
+        b = base[-1].cycle
+        f = fast[-1].cycle
+        self.assertTrue(abs(f - b) <= max(10, b // 10), "Last command cycle differs: c_DeviceDriver {0}, c_FastDeviceDriver {1}".format(b, f))
+
+    def cramSim_binarytrace_template(self, testcase):
+        # Convert the verimem text trace with sst-cramsim-trace-convert and
+        # replay both through a two lane dispatcher, the binary trace with
+        # batched injection. The report and statistics must be identical.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        self.testcramSimDir = "{0}/testcramSim".format(tmpdir)
+        self.testcramSimTestsDir = "{0}/tests".format(self.testcramSimDir)
+
+        sdlfile    = "{0}/test_txntrace.py".format(self.testcramSimTestsDir)
+        tracefile  = "{0}/sst-CramSim-trace_verimem_{1}.trc".format(self.testcramSimTestsDir, testcase)
+        binfile    = "{0}/sst-CramSim-trace_verimem_{1}.bin".format(tmpdir, testcase)
+        configfile = "{0}/ddr4_verimem.cfg".format(self.testcramSimDir)
+        numLanes   = 2
+
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        convert_app = "{0}/sst-cramsim-trace-convert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(convert_app), "cramSim - {0} not found".format(convert_app))
+
+        cmd = "{0} -t DRAMSIM2 -i {1} -o {2}".format(convert_app, tracefile, binfile)
+        rtn = OSCommand(cmd).run()
+        log_debug("cramSim trace convert result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-cramsim-trace-convert failed to convert {0}".format(tracefile))
+
+        results = {}
+        for tracetype in ["DEFAULT", "BINARY"]:
+            testDataFileName = "test_cramSim_BinaryTrace_{0}_{1}".format(tracetype, testcase)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+            if tracetype == "BINARY":
+                traceargs = "--traceFile={0} traceFileType=BINARY batchInjection=1".format(binfile)
+            else:
+                traceargs = "--traceFile={0} traceFileType=DEFAULT".format(tracefile)
+            otherargs = '--model-options=\"--configfile={0} {1} numLanes={2} laneIdxPos=5:5\"'.format(configfile, traceargs, numLanes)
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("cramSim test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+            cmd = 'grep -q "Simulation is complete" {0} '.format(outfile)
+            self.assertTrue(os.system(cmd) == 0, "Output file {0} does not contain a simulation complete message".format(outfile))
+            results[tracetype] = self._grepReportLines(outfile)
+
+        # every lane must have seen transactions or the batches were never split
+        for lane in range(numLanes):
+            recvd = [line for line in results["BINARY"] if "MemController{0}".format(lane) in line and "totalTxnsRecvd" in line]
+            self.assertTrue(len(recvd) > 0, "No totalTxnsRecvd statistic for lane {0}".format(lane))
+            count = int(recvd[0].split("Sum.u64 =")[1].split(";")[0])
+            self.assertTrue(count > 0, "Lane {0} received no transactions".format(lane))
+
+        self.assertEqual(results["DEFAULT"], results["BINARY"], "Binary trace with batched injection does not match the text trace report and statistics")
+
+    def _grepReportLines(self, outfile):
+        # the transaction generator report, the statistics and the end time,
+        # none of which name the trace file
+        found = []
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                if line.startswith("Total ") or line.startswith("Cycles Per Transaction") or \
+                   "Sum." in line or "Simulation is complete" in line:
+                    found.append(line)
+        return found
+
 #####
 
     def _setupcramSimTestFiles(self):
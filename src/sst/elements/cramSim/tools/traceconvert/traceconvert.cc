@@ -0,0 +1,137 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Converts a DRAMSim2 or USIMM text trace into the binary trace format that
+// c_TraceFileReader memory-maps when traceFileType is BINARY.
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "c_TraceFileFormat.hpp"
+
+using namespace SST::CramSim;
+
+static void usage(const char* x_prog) {
+    fprintf(stderr, "usage: %s [-t DRAMSIM2|USIMM] -i <text trace> -o <binary trace>\n", x_prog);
+    exit(1);
+}
+
+int main(int argc, char* argv[]) {
+    const char* l_inPath = NULL;
+    const char* l_outPath = NULL;
+    bool l_isUSIMM = false;
+
+    for (int l_i = 1; l_i < argc; l_i++) {
+        if (0 == strcmp(argv[l_i], "-i") && l_i + 1 < argc) {
+            l_inPath = argv[++l_i];
+        } else if (0 == strcmp(argv[l_i], "-o") && l_i + 1 < argc) {
+            l_outPath = argv[++l_i];
+        } else if (0 == strcmp(argv[l_i], "-t") && l_i + 1 < argc) {
+            std::string l_type(argv[++l_i]);
+            if (l_type == "USIMM") {
+                l_isUSIMM = true;
+            } else if (l_type == "DEFAULT" || l_type == "DRAMSIM2") {
+                l_isUSIMM = false;
+            } else {
+                fprintf(stderr, "Unknown trace type: %s\n", l_type.c_str());
+                usage(argv[0]);
+            }
+        } else {
+            usage(argv[0]);
+        }
+    }
+
+    if (NULL == l_inPath || NULL == l_outPath)
+        usage(argv[0]);
+
+    FILE* l_inFile = fopen(l_inPath, "rt");
+    if (NULL == l_inFile) {
+        fprintf(stderr, "File: %s cannot be opened.\n", l_inPath);
+        exit(1);
+    }
+
+    FILE* l_outFile = fopen(l_outPath, "wb");
+    if (NULL == l_outFile) {
+        fprintf(stderr, "File: %s cannot be opened.\n", l_outPath);
+        exit(1);
+    }
+
+    c_BinaryTraceHeader l_header;
+    memset(&l_header, 0, sizeof(l_header));
+    memcpy(l_header.m_magic, CRAMSIM_TRACE_MAGIC, sizeof(l_header.m_magic));
+    l_header.m_version = CRAMSIM_TRACE_VERSION;
+    l_header.m_flags = l_isUSIMM ? CRAMSIM_TRACE_RELATIVE_CYCLES : 0;
+
+    // header is rewritten with the record count once the input is consumed
+    if (1 != fwrite(&l_header, sizeof(l_header), 1, l_outFile)) {
+        fprintf(stderr, "Unable to write to %s\n", l_outPath);
+        exit(1);
+    }
+
+    const size_t l_batchSize = 4096;
+    std::vector<c_BinaryTraceRecord> l_batch;
+    l_batch.reserve(l_batchSize);
+
+    std::vector<char> l_line(4096);
+    uint64_t l_lineNum = 0;
+    uint64_t l_skipped = 0;
+
+    while (NULL != fgets(l_line.data(), l_line.size(), l_inFile)) {
+        l_lineNum++;
+
+        c_BinaryTraceRecord l_record;
+        if (!parseTextTraceLine(l_line.data(), l_isUSIMM, &l_record)) {
+            l_skipped++;
+            continue;
+        }
+
+        l_batch.push_back(l_record);
+        if (l_batch.size() == l_batchSize) {
+            if (l_batchSize != fwrite(l_batch.data(), sizeof(c_BinaryTraceRecord), l_batchSize, l_outFile)) {
+                fprintf(stderr, "Unable to write to %s\n", l_outPath);
+                exit(1);
+            }
+            l_header.m_numRecords += l_batch.size();
+            l_batch.clear();
+        }
+    }
+
+    if (!l_batch.empty()) {
+        if (l_batch.size() != fwrite(l_batch.data(), sizeof(c_BinaryTraceRecord), l_batch.size(), l_outFile)) {
+            fprintf(stderr, "Unable to write to %s\n", l_outPath);
+            exit(1);
+        }
+        l_header.m_numRecords += l_batch.size();
+    }
+
+    if (0 != fseek(l_outFile, 0, SEEK_SET) || 1 != fwrite(&l_header, sizeof(l_header), 1, l_outFile)) {
+        fprintf(stderr, "Unable to finalize header of %s\n", l_outPath);
+        exit(1);
+    }
+
+    fclose(l_inFile);
+    if (0 != fclose(l_outFile)) {
+        fprintf(stderr, "Unable to close %s\n", l_outPath);
+        exit(1);
+    }
+
+    printf("Converted %" PRIu64 " transactions from %" PRIu64 " lines (%" PRIu64 " skipped)\n",
+        (uint64_t) l_header.m_numRecords, l_lineNum, l_skipped);
+    return 0;
+}
@@ -29,9 +29,7 @@ using namespace SST::Hermes;
 
 EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
     Component( id ),
-	currentMotif(0),
-	m_motifDone(false),
-	m_detailedCompute(NULL)
+	m_numPrimary(0)
 {
 	// Get the level of verbosity the user is asking to print out, default is 1
 	// which means don't print much.
@@ -45,27 +43,18 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 
 	output.init( prefix.str(), verbosity, mask, Output::STDOUT);
 
-    std::ostringstream tmp;
-    tmp << m_jobId;
-
-    m_os  = loadUserSubComponent<OS>( "OS" );
-    assert( m_os );
-
-    m_nodePerf = m_os->getNodePerf();
-    m_detailedCompute = m_os->getDetailedCompute();
-    m_memHeapLink = m_os->getMemHeapLink();
+    int numRanks = params.find<int>("ranksPerEngine", 1);
+    if ( numRanks < 1 ) {
+        output.fatal(CALL_INFO, -1, "Error: ranksPerEngine must be at least 1\n");
+    }
 
-    std::string motifLogFile = params.find<std::string>("motifLog", "");
-    if("" != motifLogFile) {
-        m_motifLogger = loadComponentExtension<EmberMotifLog>(motifLogFile, m_jobId);
-    } else {
-        m_motifLogger = nullptr;
+    SubComponentSlotInfo* osSlots = getSubComponentSlotInfo( "OS" );
+    if ( NULL == osSlots || osSlots->getMaxPopulatedSlotNumber() + 1 != numRanks ) {
+        output.fatal(CALL_INFO, -1, "Error: an engine hosting %d ranks needs an OS in slots 0 to %d\n",
+                            numRanks, numRanks - 1 );
     }
-	output.verbose(CALL_INFO, 2, ENGINE_MASK, "\n");
 
-	// create a map of all the available API's
-	m_apiMap = createApiMap( m_os, this, params );
-    assert( ! m_apiMap.empty() );
+    std::string motifLogFile = params.find<std::string>("motifLog", "");
 
 	motifParams.resize( params.find("motif_count", 1) );
 	output.verbose(CALL_INFO, 2, ENGINE_MASK, "Identified %ld motifs "
@@ -87,29 +76,65 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 
     registerAsPrimaryComponent();
 
-    // Init the first Motif
-    m_generator = initMotif( motifParams[0], m_apiMap, m_jobId,
-                        currentMotif, m_nodePerf );
-    assert( m_generator );
+    for ( int slot = 0; slot < numRanks; slot++ ) {
+        if ( ! osSlots->isPopulated( slot ) ) {
+            output.fatal(CALL_INFO, -1, "Error: OS slot %d is empty\n", slot );
+        }
 
-	// Configure self link to handle event timing
-	selfEventLink = configureSelfLink("self", "1ps",
-		new Event::Handler<EmberEngine>(this, &EmberEngine::handleEvent));
-    assert(selfEventLink);
+        Rank* rank = new Rank( slot );
+        m_ranks.push_back( rank );
+
+        rank->output.init( prefix.str(), verbosity, mask, Output::STDOUT);
+
+        rank->os = osSlots->create<OS>( slot, ComponentInfo::SHARE_NONE );
+        assert( rank->os );
+
+        rank->nodePerf = rank->os->getNodePerf();
+        rank->detailedCompute = rank->os->getDetailedCompute();
+        rank->memHeapLink = rank->os->getMemHeapLink();
+
+        if("" != motifLogFile) {
+            rank->motifLogger = loadComponentExtension<EmberMotifLog>(motifLogFile, m_jobId);
+        }
+        output.verbose(CALL_INFO, 2, ENGINE_MASK, "slot=%d\n", slot);
+
+        // create a map of all the available API's
+        rank->apiMap = createApiMap( rank->os, this, params );
+        assert( ! rank->apiMap.empty() );
+
+        // a lone rank keeps the statistic names it always had
+        std::string subId = numRanks > 1 ? std::to_string( slot ) : "";
+        rank->eventsIssuedStat = registerStatistic<uint64_t>("eventsIssued", subId);
+        rank->eventRateStat = registerStatistic<uint64_t>("eventsPerWallSecond", subId);
+
+        // Init the first Motif
+        rank->generator = initMotif( motifParams[0], *rank, m_jobId, rank->currentMotif );
+        assert( rank->generator );
+
+        // Configure self link to handle event timing
+        rank->selfEventLink = configureSelfLink( 0 == slot ? "self" : "self" + std::to_string( slot ), "1ps",
+            new Event::Handler<EmberEngine,int>(this, &EmberEngine::handleEvent, slot));
+        assert(rank->selfEventLink);
+    }
 
 	// Create a time converter for our compute events
 	nanoTimeConverter = getTimeConverter("1ns");
 }
 
 EmberEngine::~EmberEngine() {
-	ApiMap::iterator iter = m_apiMap.begin();
-	for ( ; iter != m_apiMap.end(); ++ iter ) {
-		delete iter->second;
-	}
+    for ( unsigned int i = 0; i < m_ranks.size(); i++ ) {
+        Rank* rank = m_ranks[i];
 
-	if(NULL != m_motifLogger) {
-		delete m_motifLogger;
-	}
+        ApiMap::iterator iter = rank->apiMap.begin();
+        for ( ; iter != rank->apiMap.end(); ++ iter ) {
+            delete iter->second;
+        }
+
+        if(NULL != rank->motifLogger) {
+            delete rank->motifLogger;
+        }
+        delete rank;
+    }
 }
 
 EmberEngine::ApiMap EmberEngine::createApiMap( OS* os,
@@ -167,7 +192,7 @@ EmberEngine::ApiMap EmberEngine::createApiMap( OS* os,
 }
 
 EmberGenerator* EmberEngine::initMotif( SST::Params params,
-	const ApiMap& apiMap, int jobId, int motifNum, NodePerf* nodePerf )
+	Rank& rank, int jobId, int motifNum )
 {
     EmberGenerator* gen = NULL;
 
@@ -189,6 +214,7 @@ EmberGenerator* EmberEngine::initMotif( SST::Params params,
 		params.insert("_motifNum", std::to_string( motifNum ), true);
 		assert( sizeof(this) == sizeof(uint64_t) );
 		params.insert("_enginePtr", std::to_string( reinterpret_cast<uint64_t>( this ) ), true);
+		params.insert("_engineSlot", std::to_string( rank.slot ), true);
 
 		gen = loadAnonymousSubComponent<EmberGenerator>( gentype, "", 0, ComponentInfo::SHARE_NONE, params );
 
@@ -200,8 +226,9 @@ EmberGenerator* EmberEngine::initMotif( SST::Params params,
                 gen->setup();
 	}
 
-	// Make sure we don't stop the simulation until we are ready
-    if ( gen->primary() ) {
+	// Make sure we don't stop the simulation until we are ready, the
+	// engine stays primary while any of its ranks runs a primary motif
+    if ( gen->primary() && 0 == m_numPrimary++ ) {
         primaryComponentDoNotEndSim();
     }
 
@@ -210,109 +237,147 @@ EmberGenerator* EmberEngine::initMotif( SST::Params params,
 
 void EmberEngine::init(unsigned int phase) {
 	// Pass the init phases through to the OS layer
-	m_os->_componentInit(phase);
+    for ( unsigned int i = 0; i < m_ranks.size(); i++ ) {
+        m_ranks[i]->os->_componentInit(phase);
+    }
 }
 
 void EmberEngine::finish() {
-    ApiMap::iterator iter = m_apiMap.begin();
-    for ( ; iter != m_apiMap.end(); ++ iter ) {
-        iter->second->api->finish();
-    }
+    WallClock::time_point now = WallClock::now();
+
+    for ( unsigned int i = 0; i < m_ranks.size(); i++ ) {
+        Rank* rank = m_ranks[i];
+
+        ApiMap::iterator iter = rank->apiMap.begin();
+        for ( ; iter != rank->apiMap.end(); ++ iter ) {
+            iter->second->api->finish();
+        }
+
+        rank->os->finish();
 
-	m_os->finish();
+        if ( ! rank->wallStopped ) {
+            rank->wallStop = now;
+        }
+        double seconds = std::chrono::duration<double>( rank->wallStop - m_wallStart ).count();
+
+        rank->eventsIssuedStat->addData( rank->eventsIssued );
+        if ( seconds > 0 ) {
+            rank->eventRateStat->addData( (uint64_t) ( rank->eventsIssued / seconds ) );
+        }
+    }
 }
 
 void EmberEngine::setup() {
 	// Notify OS layer we are done with init phase
 	// and are now in final bring up state
 
-    m_os->_componentSetup();
+    for ( unsigned int i = 0; i < m_ranks.size(); i++ ) {
+        Rank* rank = m_ranks[i];
 
-    ApiMap::iterator iter = m_apiMap.begin();
-    for ( ; iter != m_apiMap.end(); ++ iter ) {
-        iter->second->api->setup();
-    }
+        rank->os->_componentSetup();
 
-    std::ostringstream prefix;
-    prefix << "@t:" << m_jobId << ":" << m_os->getRank() << ":EmberEngine:@p:@l: ";
-    //std::cout << "@t:" << m_jobId << ":" << m_os->getRank() << ":EmberEngine:@p:@l: " << std::endl; //NetworkSim
+        ApiMap::iterator iter = rank->apiMap.begin();
+        for ( ; iter != rank->apiMap.end(); ++ iter ) {
+            iter->second->api->setup();
+        }
 
-    output.setPrefix( prefix.str() );
+        std::ostringstream prefix;
+        prefix << "@t:" << m_jobId << ":" << rank->os->getRank() << ":EmberEngine:@p:@l: ";
+        //std::cout << "@t:" << m_jobId << ":" << rank->os->getRank() << ":EmberEngine:@p:@l: " << std::endl; //NetworkSim
+
+        rank->output.setPrefix( prefix.str() );
+        if ( 0 == i ) {
+            output.setPrefix( prefix.str() );
+        }
 
-    if (NULL != m_motifLogger) {
-        m_motifLogger->setRank(m_os->getRank());
+        if (NULL != rank->motifLogger) {
+            rank->motifLogger->setRank(rank->os->getRank());
+        }
     }
 
-	// Prime the event queue
-	issueNextEvent(0);
+    m_wallStart = WallClock::now();
+
+	// Prime the event queues
+    for ( unsigned int i = 0; i < m_ranks.size(); i++ ) {
+        issueNextEvent(*m_ranks[i], 0);
+    }
 }
 
-void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
+void EmberEngine::issueNextEvent(Rank& rank, uint64_t nanoDelay) {
 
-    output.debug(CALL_INFO, 8, ENGINE_MASK, "Engine issuing next event with delay %" PRIu64 "\n", nanoDelay);
+    rank.output.debug(CALL_INFO, 8, ENGINE_MASK, "Engine issuing next event with delay %" PRIu64 "\n", nanoDelay);
 
-    while ( evQueue.empty() ) {
+    while ( rank.evQueue.empty() ) {
 
-        if ( ! m_motifDone ) {
-            m_motifDone = refillQueue();
+        if ( ! rank.motifDone ) {
+            rank.motifDone = refillQueue( rank );
         }
 
         // if the event Queue is empty after a refill the motif is done
-        if (  evQueue.empty() ) {
-            if (NULL != m_motifLogger) {
-                m_motifLogger->logMotifEnd(m_generator->getMotifName(),currentMotif);
+        if (  rank.evQueue.empty() ) {
+            if (NULL != rank.motifLogger) {
+                rank.motifLogger->logMotifEnd(rank.generator->getMotifName(),rank.currentMotif);
             }
-            // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif finished: %s\n",m_generator->getMotifName().c_str());
-            m_generator->completed( &output, getCurrentSimTimeNano() );
-            if ( m_generator->primary() ) {
+            // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif finished: %s\n",rank.generator->getMotifName().c_str());
+            rank.generator->completed( &rank.output, getCurrentSimTimeNano() );
+            if ( rank.generator->primary() && 0 == --m_numPrimary ) {
 	            primaryComponentOKToEndSim();
             }
-            delete m_generator;
+            delete rank.generator;
+            rank.generator = NULL;
 
-            if ( ++currentMotif == motifParams.size() ) {
+            if ( ++rank.currentMotif == motifParams.size() ) {
+                rank.wallStop = WallClock::now();
+                rank.wallStopped = true;
                 return;
             } else {
-                m_generator = initMotif( motifParams[currentMotif],
-								m_apiMap, m_jobId, currentMotif, m_nodePerf );
-                assert( m_generator );
-                if (NULL != m_motifLogger) {
-                    m_motifLogger->logMotifStart(currentMotif);
+                rank.generator = initMotif( motifParams[rank.currentMotif],
+								rank, m_jobId, rank.currentMotif );
+                assert( rank.generator );
+                if (NULL != rank.motifLogger) {
+                    rank.motifLogger->logMotifStart(rank.currentMotif);
                 }
-                // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif starting: %s\n",m_generator->getMotifName().c_str());
+                // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif starting: %s\n",rank.generator->getMotifName().c_str());
 
-                m_motifDone = refillQueue();
+                rank.motifDone = refillQueue( rank );
             }
         }
     }
 
-	EmberEvent* nextEv = evQueue.front();
-	evQueue.pop();
+	EmberEvent* nextEv = rank.evQueue.front();
+	rank.evQueue.pop();
+    ++rank.eventsIssued;
 
 	// issue the next event to the engine for deliver later
-	selfEventLink->send(nanoDelay, nanoTimeConverter, nextEv);
+	rank.selfEventLink->send(nanoDelay, nanoTimeConverter, nextEv);
 }
 
-bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
+bool EmberEngine::completeFunctor( int retval, RankEvent rankEv )
 {
-    output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
+    Rank& rank = *rankEv.first;
+    EmberEvent* ev = rankEv.second;
+
+    rank.output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
 
     if ( ev->complete( getCurrentSimTimeNano(), retval ) ) {
         delete ev;
     }
 
-	issueNextEvent(0);
+	issueNextEvent(rank, 0);
 
     return true;
 }
 
-void EmberEngine::handleEvent(Event* ev) {
+void EmberEngine::handleEvent(Event* ev, int slot) {
+
+    Rank& rank = *m_ranks[slot];
 
 	// Cast out the event we are processing and then hand off to whatever
 	// handlers we have created
 	EmberEvent* eEv = static_cast<EmberEvent*>(ev);
 
-    output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
+    rank.output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               eEv->stateName( eEv->state() ).c_str(), eEv->getName().c_str());
 
     switch ( eEv->state() ) {
@@ -320,24 +385,24 @@ void EmberEngine::handleEvent(Event* ev) {
 
         eEv->issue( getCurrentSimTimeNano() );
 
-	    selfEventLink->send( eEv->completeDelayNS() * 1000, ev );
+	    rank.selfEventLink->send( eEv->completeDelayNS() * 1000, ev );
         break;
 
       case EmberEvent::IssueFunctor:
         eEv->issue( getCurrentSimTimeNano(),
-                new ArgStatic_Functor< EmberEngine, int, EmberEvent*, bool >(
-                            this, &EmberEngine::completeFunctor, eEv ) );
+                new ArgStatic_Functor< EmberEngine, int, RankEvent, bool >(
+                            this, &EmberEngine::completeFunctor, RankEvent( &rank, eEv ) ) );
         break;
 
       case EmberEvent::IssueCallback:
         eEv->issue( getCurrentSimTimeNano(),
-                    std::bind( &EmberEngine::completeCallback, this, eEv, std::placeholders::_1 ) );
+                    std::bind( &EmberEngine::completeCallback, this, &rank, eEv, std::placeholders::_1 ) );
         break;
 
       case EmberEvent::IssueCallbackPtr:
 		{
 		    Callback* callback = new Callback;
-		    *callback = std::bind( &EmberEngine::completeCallback, this, eEv, std::placeholders::_1 );
+		    *callback = std::bind( &EmberEngine::completeCallback, this, &rank, eEv, std::placeholders::_1 );
             eEv->issue( getCurrentSimTimeNano(), callback );
 		}
         break;
@@ -346,7 +411,7 @@ void EmberEngine::handleEvent(Event* ev) {
         if ( eEv->complete( getCurrentSimTimeNano() ) ) {
             delete ev;
         }
-	    issueNextEvent(0);
+	    issueNextEvent(rank, 0);
         break;
     }
 }
@@ -17,6 +17,7 @@
 #ifndef _H_EMBER_ENGINE
 #define _H_EMBER_ENGINE
 
+#include <chrono>
 #include <queue>
 
 #include <sst/core/sst_types.h>
@@ -56,6 +57,7 @@ public:
         { "mapFile", "Sets the name of the input file for custom map", "mapFile.txt" },
 
         { "motif%(motif_count)d", "Sets the event generator or motif for the engine", "ember.EmberPingPongGenerator" },
+        { "ranksPerEngine", "Sets the number of ranks hosted by this engine, each rank needs its own OS in slots 0 to ranksPerEngine-1", "1" },
     )
 	/* PARAMS
 		api.*
@@ -64,6 +66,15 @@ public:
 		distribParams.*
 	*/
 
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "eventsIssued", "Number of ember events issued by this rank, the subid is the rank's OS slot when the engine hosts more than one rank", "events", 1 },
+        { "eventsPerWallSecond", "Ember events issued by this rank per second of wall clock time from setup until its last motif completed", "events/s", 1 },
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        { "OS", "Operating system of each hosted rank, one per slot", "SST::Hermes::OS" },
+    )
+
     SST_ELI_DOCUMENT_PORTS(
         {"detailed%(num_vNics)d", "Port connected to the detailed model", {}},
         {"nic", "Port connected to the nic", {}},
@@ -78,50 +89,32 @@ public:
 	void finish();
 	void init( unsigned int phase );
 
-	Output* getOutput() { return &output; }
-	Hermes::Interface* getAPI(std::string name) {
-        if ( m_apiMap.find(name) == m_apiMap.end() ) {
+	Output* getOutput( int slot = 0 ) { return &m_ranks[slot]->output; }
+	Hermes::Interface* getAPI(std::string name, int slot = 0 ) {
+        ApiMap& apiMap = m_ranks[slot]->apiMap;
+        if ( apiMap.find(name) == apiMap.end() ) {
             return NULL;
         }
-        return m_apiMap[name]->api;
+        return apiMap[name]->api;
     }
-	Hermes::NodePerf* getNodePerf( ) { return m_nodePerf; }
-	Thornhill::DetailedCompute* getDetailedCompute() {
-		return m_detailedCompute;
+	Hermes::NodePerf* getNodePerf( int slot = 0 ) { return m_ranks[slot]->nodePerf; }
+	Thornhill::DetailedCompute* getDetailedCompute( int slot = 0 ) {
+		return m_ranks[slot]->detailedCompute;
 	}
 
-	Thornhill::MemoryHeapLink* getMemHeapLink() {
-		return m_memHeapLink;
+	Thornhill::MemoryHeapLink* getMemHeapLink( int slot = 0 ) {
+		return m_ranks[slot]->memHeapLink;
 	}
 
-    EmberLib* getLib( std::string name ) {
-        if( m_apiMap.find( name ) == m_apiMap.end() ) {
+    EmberLib* getLib( std::string name, int slot = 0 ) {
+        ApiMap& apiMap = m_ranks[slot]->apiMap;
+        if( apiMap.find( name ) == apiMap.end() ) {
             output.fatal(CALL_INFO, -1, "Error: could not find %s\n",name.c_str() );
         }
-        return m_apiMap[name]->lib;
+        return apiMap[name]->lib;
     }
 
 private:
-	bool refillQueue() {
-		return m_generator->generate( evQueue );
-	}
-
-    std::string getComputeModelName() {
-       if ( m_detailedCompute ) {
-           return m_detailedCompute->getModelName();
-       }
-       return "";
-    }
-
-	void handleEvent(SST::Event* ev);
-	void issueNextEvent(uint64_t nanoSecDelay);
-
-    void completeCallback( EmberEvent* ev, int retval ) {
-        completeFunctor(retval, ev);
-    }
-    bool completeFunctor( int retval, EmberEvent* ev );
-
-	Hermes::OS*	m_os;
 
     struct ApiInfo {
         Hermes::Interface* api;
@@ -129,28 +122,68 @@ private:
     };
 
     typedef std::map< std::string, ApiInfo* > ApiMap;
+    typedef std::chrono::steady_clock WallClock;
+
+    // Everything one hosted rank owns. Ranks share the engine component
+    // and take turns through their own self link, a rank only has one
+    // event in flight so its motif runs exactly as it would stand alone.
+    struct Rank {
+        Rank( int slot ) :
+            slot( slot ), os( NULL ), nodePerf( NULL ), detailedCompute( NULL ),
+            memHeapLink( NULL ), currentMotif( 0 ), motifDone( false ),
+            generator( NULL ), selfEventLink( NULL ), motifLogger( nullptr ),
+            eventsIssued( 0 ), wallStopped( false )
+        {}
+
+        int                         slot;
+        Hermes::OS*                 os;
+        Hermes::NodePerf*           nodePerf;
+        Thornhill::DetailedCompute* detailedCompute;
+        Thornhill::MemoryHeapLink*  memHeapLink;
+        ApiMap                      apiMap;
+        Output                      output;
+
+        uint32_t                    currentMotif;
+        bool                        motifDone;
+        std::queue<EmberEvent*>     evQueue;
+        EmberGenerator*             generator;
+        SST::Link*                  selfEventLink;
+        EmberMotifLog*              motifLogger;
+
+        uint64_t                    eventsIssued;
+        WallClock::time_point       wallStop;
+        bool                        wallStopped;
+        Statistic<uint64_t>*        eventsIssuedStat;
+        Statistic<uint64_t>*        eventRateStat;
+    };
+
+    typedef std::pair< Rank*, EmberEvent* > RankEvent;
+
+	bool refillQueue( Rank& rank ) {
+		return rank.generator->generate( rank.evQueue );
+	}
+
+	void handleEvent( SST::Event* ev, int slot );
+	void issueNextEvent( Rank&, uint64_t nanoSecDelay );
+
+    void completeCallback( Rank* rank, EmberEvent* ev, int retval ) {
+        completeFunctor( retval, RankEvent( rank, ev ) );
+    }
+    bool completeFunctor( int retval, RankEvent );
 
     ApiMap createApiMap( Hermes::OS* os, SST::Component*, SST::Params );
-    EmberGenerator* initMotif( SST::Params, const ApiMap&,
-					int jobId, int motifNum, Hermes::NodePerf* nodePerf );
+    EmberGenerator* initMotif( SST::Params, Rank&, int jobId, int motifNum );
 
 	int         m_jobId;
-	uint32_t    currentMotif;
-    bool        m_motifDone;
-    ApiMap      m_apiMap;
 	Output      output;
+    int         m_numPrimary;
 
-	std::queue<EmberEvent*> evQueue;
+    std::vector<Rank*>      m_ranks;
+    WallClock::time_point   m_wallStart;
 
-    Hermes::NodePerf*   m_nodePerf;
-	EmberGenerator*     m_generator;
-	SST::Link*          selfEventLink;
 	SST::TimeConverter* nanoTimeConverter;
-	EmberMotifLog*      m_motifLogger;
 
 	std::vector<SST::Params> motifParams;
-	Thornhill::DetailedCompute* m_detailedCompute;
-	Thornhill::MemoryHeapLink*  m_memHeapLink;
 
 	EmberEngine();			    		// For serialization
 	EmberEngine(const EmberEngine&);    // Do not implement
@@ -43,6 +43,71 @@ typedef Hermes::Callback Callback;
 
 typedef Statistic<uint32_t> EmberEventTimeStatistic;
 
+/*
+ * Thread local free lists of recycled event blocks, bucketed by size.
+ * Motifs allocate an event for every call they make and the engine
+ * deletes it once it completes, with many short message ranks on a
+ * thread that churn dominates the allocator.
+ */
+class EmberEventPool {
+  public:
+    static void* allocate( size_t size ) {
+        if ( size > MaxBlockSize ) {
+            return ::operator new( size );
+        }
+
+        FreeList& pool = freeList( size );
+        if ( NULL == pool.head ) {
+            return ::operator new( blockSize( size ) );
+        }
+
+        FreeBlock* block = pool.head;
+        pool.head = block->next;
+        return block;
+    }
+
+    static void release( void* ptr, size_t size ) {
+        if ( size > MaxBlockSize ) {
+            ::operator delete( ptr );
+            return;
+        }
+
+        FreeList& pool = freeList( size );
+        FreeBlock* block = static_cast<FreeBlock*>( ptr );
+        block->next = pool.head;
+        pool.head = block;
+    }
+
+  private:
+    enum { Granularity = 16, MaxBlockSize = 512 };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct FreeList {
+        FreeList() : head(NULL) {}
+        ~FreeList() {
+            while ( NULL != head ) {
+                FreeBlock* next = head->next;
+                ::operator delete( head );
+                head = next;
+            }
+        }
+
+        FreeBlock* head;
+    };
+
+    static size_t blockSize( size_t size ) {
+        return ( ( size + Granularity - 1 ) / Granularity ) * Granularity;
+    }
+
+    static FreeList& freeList( size_t size ) {
+        static thread_local FreeList pools[ MaxBlockSize / Granularity ];
+        return pools[ ( size - 1 ) / Granularity ];
+    }
+};
+
 class EmberEvent : public SST::Event {
 
 public:
@@ -61,6 +126,16 @@ public:
         m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL) {}
 	~EmberEvent() {}
 
+    // the engine deletes events through the base class, the virtual
+    // destructor hands the size of the derived event to operator delete
+    static void* operator new( size_t size ) {
+        return EmberEventPool::allocate( size );
+    }
+
+    static void operator delete( void* ptr, size_t size ) {
+        EmberEventPool::release( ptr, size );
+    }
+
 	virtual std::string getName() { return "?????"; };
 
     State state() { return m_state; }
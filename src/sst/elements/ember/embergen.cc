@@ -25,6 +25,7 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
     m_dataMode( NoBacking ),
     m_motifName( name ),
     m_ee(NULL),
+    m_eeSlot(0),
     m_curVirtAddr( 0x1000 )
 {
     m_primary = params.find<bool>("primary",true);
@@ -33,7 +34,8 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
     uint64_t parentPtr = params.find<uint64_t>("_enginePtr",0 );
     assert( parentPtr != 0 );
 
-    setEngine( reinterpret_cast< EmberEngine* >( parentPtr ) );
+    setEngine( reinterpret_cast< EmberEngine* >( parentPtr ),
+                params.find<int>( "_engineSlot", 0 ) );
 
     setVerbosePrefix();
 
@@ -50,18 +52,19 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
 }
 
 
-void EmberGenerator::setEngine( EmberEngine* ee ) {
+void EmberGenerator::setEngine( EmberEngine* ee, int slot ) {
 
 	m_ee = ee;
-    m_output = m_ee->getOutput();
-    m_nodePerf = m_ee->getNodePerf();
-    m_detailedCompute = m_ee->getDetailedCompute();
-	m_memHeapLink = m_ee->getMemHeapLink();
+	m_eeSlot = slot;
+    m_output = m_ee->getOutput( slot );
+    m_nodePerf = m_ee->getNodePerf( slot );
+    m_detailedCompute = m_ee->getDetailedCompute( slot );
+	m_memHeapLink = m_ee->getMemHeapLink( slot );
 }
 
 EmberLib* EmberGenerator::getLib(std::string name )
 {
-    return m_ee->getLib( name );
+    return m_ee->getLib( name, m_eeSlot );
 }
 
 #if defined(__clang__)
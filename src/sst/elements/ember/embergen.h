@@ -60,13 +60,14 @@ class EmberGenerator : public SubComponent {
         { "_motifNum", "used internally", "-1"},
         { "_jobId", "used internally", "-1"},
         { "_enginePtr", "used internally", "-1"},
+        { "_engineSlot", "used internally", "0"},
 		{ "distribModule", "Sets the distribution SST module for compute modeling, default is a constant distribution of mean 1", "1.0"},
 	)
 
     EmberGenerator( ComponentId_t id, Params& params ) : SubComponent(id) { assert(0); }
     EmberGenerator( ComponentId_t id, Params& params, std::string name ="" );
 
-	void setEngine( EmberEngine* );
+	void setEngine( EmberEngine*, int slot );
 
 	~EmberGenerator(){ };
 
@@ -134,6 +135,7 @@ class EmberGenerator : public SubComponent {
 
   private:
     EmberEngine*            m_ee;
+    int                     m_eeSlot;
     Output* 	        	m_output;
     enum { NoBacking, Backing, BackingZeroed  } m_dataMode;
     std::string				m_motifName;
@@ -0,0 +1,139 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include "embermatchqueue.h"
+
+// rank 1 waits for this before sending, so every receive is posted first.
+// There is no barrier while the AnyTag receives are posted, they would
+// take the barrier's messages.
+#define GO_TAG          0xf00d
+// sent to a queue whose last receive is an AnyTag one, no exact receive uses it
+#define LEFTOVER_TAG    0xbeef
+#define NUM_TAGS        61
+
+using namespace SST::Ember;
+
+EmberMatchQueueGenerator::EmberMatchQueueGenerator(SST::ComponentId_t id, Params& params) :
+	EmberMessagePassingGenerator(id, params, "MatchQueue"),
+    m_loopIndex( 0 ),
+    m_mismatched( 0 ),
+    m_startTime( 0 ),
+    m_stopTime( 0 ),
+    m_totalTime( 0 )
+{
+	m_numRecvs   = (uint32_t) params.find("arg.numRecvs", 2048);
+	m_iterations = (uint32_t) params.find("arg.iterations", 1);
+    m_reqs.resize( m_numRecvs );
+    m_resp.resize( m_numRecvs );
+
+    buildSchedule();
+}
+
+// every fourth receive is AnySrc and every fourth AnyTag, the rest are exact
+uint32_t EmberMatchQueueGenerator::recvTag( uint32_t i )
+{
+    return 2 == i % 4 ? AnyTag : 1 + i % NUM_TAGS;
+}
+
+RankID EmberMatchQueueGenerator::recvSrc( uint32_t i )
+{
+    return 1 == i % 4 ? AnySrc : 1;
+}
+
+// Each message is addressed to the last receive still posted, which makes
+// the earlier AnyTag receives take most of them. The receive a message
+// lands in is the first one it matches in a linear walk of the queue.
+void EmberMatchQueueGenerator::buildSchedule()
+{
+    std::vector<uint32_t> posted( m_numRecvs );
+    for ( uint32_t i = 0; i < m_numRecvs; i++ ) {
+        posted[i] = i;
+    }
+
+    m_expectedTags.resize( m_numRecvs );
+    while ( ! posted.empty() ) {
+        uint32_t tag = recvTag( posted.back() );
+        if ( AnyTag == tag ) {
+            tag = LEFTOVER_TAG;
+        }
+        m_sendTags.push_back( tag );
+
+        for ( auto iter = posted.begin(); iter != posted.end(); ++iter ) {
+            uint32_t want = recvTag( *iter );
+            if ( AnyTag == want || tag == want ) {
+                m_expectedTags[*iter] = tag;
+                posted.erase( iter );
+                break;
+            }
+        }
+    }
+}
+
+void EmberMatchQueueGenerator::checkResponses()
+{
+    for ( uint32_t i = 0; i < m_numRecvs; i++ ) {
+        if ( m_resp[i].tag != m_expectedTags[i] || m_resp[i].src != 1 ) {
+            if ( 0 == m_mismatched ) {
+                output("MatchQueue: receive %" PRIu32 " expected tag %#" PRIx32 " from 1, got tag %#" PRIx32 " from %d\n",
+                        i, m_expectedTags[i], m_resp[i].tag, (int) m_resp[i].src );
+            }
+            ++m_mismatched;
+        }
+    }
+}
+
+bool EmberMatchQueueGenerator::generate( std::queue<EmberEvent*>& evQ)
+{
+    assert( 2 == size() );
+
+    // note that the first time through start and stop are 0
+    m_totalTime += m_stopTime - m_startTime;
+    if ( 0 == rank() && m_loopIndex > 0 ) {
+        checkResponses();
+    }
+
+    if ( m_loopIndex == m_iterations ) {
+        if ( 0 == rank() ) {
+            output("MatchQueue: %" PRIu32 " receives, %" PRIu32 " iterations, %" PRIu32 " matched out of order\n",
+                    m_numRecvs, m_iterations, m_mismatched );
+            output("MatchQueue: total time %.3f us\n", (double) m_totalTime / 1000.0 );
+        }
+        return true;
+    }
+
+    if ( 0 == rank() ) {
+        enQ_getTime( evQ, &m_startTime );
+        for ( uint32_t i = 0; i < m_numRecvs; i++ ) {
+            enQ_irecv( evQ, NULL, 1, CHAR, recvSrc( i ), recvTag( i ),
+                                                GroupWorld, &m_reqs[i] );
+        }
+        enQ_send( evQ, NULL, 0, CHAR, 1, GO_TAG, GroupWorld );
+        enQ_waitall( evQ, m_numRecvs, &m_reqs[0],
+                                        (MessageResponse**)&m_resp[0] );
+        enQ_getTime( evQ, &m_stopTime );
+    } else {
+        enQ_recv( evQ, NULL, 0, CHAR, 0, GO_TAG, GroupWorld );
+        enQ_getTime( evQ, &m_startTime );
+        for ( uint32_t i = 0; i < m_sendTags.size(); i++ ) {
+            enQ_send( evQ, NULL, 1, CHAR, 0, m_sendTags[i], GroupWorld );
+        }
+        enQ_getTime( evQ, &m_stopTime );
+    }
+
+    ++m_loopIndex;
+    return false;
+}
@@ -0,0 +1,99 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_MATCHQUEUE
+#define _H_EMBER_MATCHQUEUE
+
+#include "mpi/embermpigen.h"
+
+namespace SST {
+namespace Ember {
+
+// Rank 0 posts a long queue of exact, AnySrc and AnyTag receives, then rank 1
+// sends one message per receive. The send order is chosen so that wildcard
+// receives compete with exact ones for most messages, and both ranks work
+// out which receive each message must land in by walking a linear queue.
+// Rank 0 checks the tag of every completed receive against that.
+
+class EmberMatchQueueGenerator : public EmberMessagePassingGenerator {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        EmberMatchQueueGenerator,
+        "ember",
+        "MatchQueueMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Checks MPI ordering of a long posted receive queue with wildcards.",
+        SST::Ember::EmberGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "arg.numRecvs",     "Sets the number of receives posted at once",   "2048"},
+        {   "arg.iterations",   "Sets the number of times the queue is posted", "1"},
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberMatchQueueGenerator(SST::ComponentId_t, Params& params);
+    bool generate( std::queue<EmberEvent*>& evQ);
+
+private:
+    uint32_t recvTag( uint32_t i );
+    RankID recvSrc( uint32_t i );
+    void buildSchedule();
+    void checkResponses();
+
+    uint32_t m_numRecvs;
+    uint32_t m_iterations;
+    uint32_t m_loopIndex;
+    uint32_t m_mismatched;
+    uint64_t m_startTime;
+    uint64_t m_stopTime;
+    uint64_t m_totalTime;
+
+    std::vector<uint32_t>           m_sendTags;
+    std::vector<uint32_t>           m_expectedTags;
+    std::vector<MessageRequest>     m_reqs;
+    std::vector<MessageResponse>    m_resp;
+};
+
+}
+}
+
+#endif
@@ -1,4 +1,5 @@
 
+import sys
 import sst
 from sst.merlin import *
 
@@ -122,10 +123,17 @@ class EmberEP( EndPoint ):
         logCreatedforFirstCore = False
         # end
 
+        # one engine can host several of this NIC's ranks, each in its own OS slot
+        ranksPerEngine = int(self.driverParams.get('ranksPerEngine', 1))
+        if (self.numCores//self.nicsPerNode) % ranksPerEngine:
+            sys.exit("ERROR: ranksPerEngine {0} does not divide the {1} cores per NIC".format(ranksPerEngine, self.numCores//self.nicsPerNode))
+
         for x in range(self.numCores//self.nicsPerNode):
-            ep = sst.Component("nic" + str(nodeID) + "core" + str(x) + "_EmberEP", "ember.EmberEngine")
+            slot = x % ranksPerEngine
+            if slot == 0:
+                ep = sst.Component("nic" + str(nodeID) + "core" + str(x) + "_EmberEP", "ember.EmberEngine")
 
-            os = ep.setSubComponent( "OS", "firefly.hades" )
+            os = ep.setSubComponent( "OS", "firefly.hades", slot )
             for key, value in list(self.driverParams.items()):
                 if key.startswith("hermesParams."):
                     key = key[key.find('.')+1:] 
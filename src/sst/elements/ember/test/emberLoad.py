@@ -14,6 +14,7 @@ debug    = 0
 emberVerbose = 0
 embermotifLog = ''
 emberrankmapper = ''
+ranksPerEngine = 1
 
 useSimpleMemoryModel=False
 
@@ -77,7 +78,7 @@ try:
                  "simConfig=","platParams=","debug=","platform=","numNodes=",
                  "numCores=","loadFile=","loadFileVar=","cmdLine=","printStats=","randomPlacement=",
                  "emberVerbose=","netBW=","netPktSize=","netFlitSize=",
-                 "rtrArb=","embermotifLog=","rankmapper=", "motifAPI=",
+                 "rtrArb=","embermotifLog=","rankmapper=", "motifAPI=","ranksPerEngine=",
                  "bgPercentage=","bgMean=","bgStddev=","bgMsgSize=","netInspect=",
                  "detailedModelName=","detailedModelParams=","detailedModelNodes=",
                  "useSimpleMemoryModel","param=","paramDir=","statsModule=","statsFile="])
@@ -118,6 +119,8 @@ for o, a in opts:
         emberVerbose = a
     elif o in ("--embermotifLog"):
         embermotifLog = a
+    elif o in ("--ranksPerEngine"):
+        ranksPerEngine = int(a)
     elif o in ("--rankmapper"):
         emberrankmapper = a
     elif o in ("--netBW"):
@@ -388,6 +391,8 @@ if embermotifLog:
     emberParams['motifLog'] = embermotifLog
 if emberrankmapper:
     emberParams['rankmapper'] = emberrankmapper
+if ranksPerEngine > 1:
+    emberParams['ranksPerEngine'] = ranksPerEngine
 
 for a in params['network']:
     key, value = a.split("=")
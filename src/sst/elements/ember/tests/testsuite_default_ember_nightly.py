@@ -52,6 +52,48 @@ class testcase_EmberNightly(SSTTestCase):
         otherargs = '--verbose --model-options \"--topo=torus --shape=4x4x4 --cmdLine=\"Init\" --cmdLine=\"Allreduce\" --cmdLine=\"Fini\" \"'
         self.Ember_test_template("test_emberparams", otherargs = otherargs, testoutput = False)
 
+    def test_Ember_RanksPerEngine(self):
+        # Two ranks sharing an engine must run the same motifs in the same
+        # simulated time as two single rank engines
+        results = []
+        for ranks in ["1", "2"]:
+            otherargs = '--model-options \"--topo=torus --shape=2x2 --numCores=2 --ranksPerEngine={0} --cmdLine=\"Init\" --cmdLine=\"Allreduce iterations=4 count=16\" --cmdLine=\"Halo2D iterations=2\" --cmdLine=\"Fini\" \"'.format(ranks)
+            testcase = "test_emberranksperengine_{0}".format(ranks)
+            self.Ember_test_template(testcase, otherargs = otherargs, testoutput = False)
+            results.append(self._grepResultLines("{0}/{1}.out".format(self.get_test_output_run_dir(), testcase)))
+
+        self.assertTrue(len(results[0]) > 0, "Ember ranksPerEngine=1 run produced no motif results")
+        self.assertEqual(results[0], results[1], "Ember ranksPerEngine=2 results differ from ranksPerEngine=1")
+
+    def test_Ember_BulkMemoryModel(self):
+        # A large DMA modeled analytically (bulkMinBytes) should land close
+        # to the same transfer modeled a cache line at a time
+        times = []
+        for minbytes in ["0", "65536"]:
+            otherargs = '--model-options \"--useSimpleMemoryModel --topo=torus --shape=2 --param=nic:simpleMemoryModel.bulkMinBytes={0} --cmdLine=\"Init\" --cmdLine=\"PingPong messageSize=1048576 iterations=2\" --cmdLine=\"Fini\" \"'.format(minbytes)
+            testcase = "test_emberbulkmemory_{0}".format(minbytes)
+            self.Ember_test_template(testcase, otherargs = otherargs, testoutput = False)
+            times.append(self._grepTotalTime("{0}/{1}.out".format(self.get_test_output_run_dir(), testcase)))
+
+        self.assertTrue(times[0] > 0 and times[1] > 0, "Ember PingPong did not report a total time")
+        self.assertTrue(abs(times[1] - times[0]) <= 0.25 * times[0],
+            "Bulk PingPong time {0} us is not within 25% of per-line time {1} us".format(times[1], times[0]))
+
+    def test_Ember_MatchQueue(self):
+        # 2048 exact and wildcard receives posted at once, past the point
+        # where the posted receive list renumbers its sequence numbers. Both
+        # match unit timing models must match every message the same way.
+        results = []
+        for hwmatch in ["0", "1"]:
+            otherargs = '--model-options \"--topo=torus --shape=2 --param=hermes:hermesParams.ctrlMsg.pqs.hwMatchUnit={0} --cmdLine=\"Init\" --cmdLine=\"MatchQueue numRecvs=2048 iterations=2\" --cmdLine=\"Fini\" \"'.format(hwmatch)
+            testcase = "test_embermatchqueue_{0}".format(hwmatch)
+            self.Ember_test_template(testcase, otherargs = otherargs, testoutput = False)
+            results.append(self._grepMatchQueueLines("{0}/{1}.out".format(self.get_test_output_run_dir(), testcase)))
+
+        self.assertTrue(len(results[0]) > 0, "Ember MatchQueue run produced no result")
+        self.assertTrue(" 0 matched out of order" in results[0][-1], "Ember MatchQueue hwMatchUnit=0: {0}".format("".join(results[0])))
+        self.assertEqual(results[0], results[1], "Ember MatchQueue results differ between hwMatchUnit=0 and hwMatchUnit=1")
+
 
 #####
 
@@ -95,6 +137,30 @@ class testcase_EmberNightly(SSTTestCase):
             log_testing_note("Ember Nightly test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
 
 
+    def _grepResultLines(self, outfile):
+        found = []
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                if "latency" in line or "Simulation is complete" in line:
+                    found.append(line)
+        return found
+
+    def _grepMatchQueueLines(self, outfile):
+        # the total time line differs between the match unit models
+        found = []
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                if "MatchQueue:" in line and "total time" not in line:
+                    found.append(line)
+        return found
+
+    def _grepTotalTime(self, outfile):
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                if "total time" in line:
+                    return float(line.split("total time")[1].split()[0])
+        return 0.0
+
 ###############################################
 
     def _setupEmberTestFiles(self):
@@ -0,0 +1,227 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_CTRL_MSG_POSTED_RECV_LIST_H
+#define COMPONENTS_FIREFLY_CTRL_MSG_POSTED_RECV_LIST_H
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Firefly {
+namespace CtrlMsg {
+
+// Posted receive queue with hashed matching.
+//
+// Receives with a fully specified (tag,rank,group) are kept in a bucket per
+// key, receives that use AnySrc, AnyTag or a tag ignore mask are kept in a
+// single wildcard list. Every receive carries a post sequence number and
+// the earliest posted receive that matches wins, which preserves MPI
+// ordering across the buckets and the wildcard list.
+//
+// The position the match would have had in a single linear queue is
+// tracked with a Fenwick tree over the sequence numbers so the modeled
+// search length does not depend on how the queue is stored.
+
+class PostedRecvList {
+
+    struct Entry {
+        Entry( uint64_t seq, _CommReq* req ) : seq(seq), req(req) {}
+        uint64_t    seq;
+        _CommReq*   req;
+    };
+
+    struct Key {
+        Key( MatchHdr& hdr ) : tag(hdr.tag), rank(hdr.rank), group(hdr.group) {}
+        bool operator==( const Key& rhs ) const {
+            return tag == rhs.tag && rank == rhs.rank && group == rhs.group;
+        }
+        uint64_t            tag;
+        MP::RankID          rank;
+        MP::Communicator    group;
+    };
+
+    struct KeyHash {
+        size_t operator()( const Key& key ) const {
+            uint64_t tmp = key.tag * 0x9e3779b97f4a7c15ULL;
+            tmp ^= ( (uint64_t) key.rank << 32 | key.group ) + ( tmp << 6 ) + ( tmp >> 2 );
+            return tmp;
+        }
+    };
+
+    typedef std::deque<Entry> List;
+
+  public:
+    typedef std::function<bool(_CommReq*)> MatchFunc;
+
+    PostedRecvList() : m_size(0), m_nextSeq(0), m_tree( MinTreeSize + 1, 0 ) {}
+
+    size_t size() const { return m_size; }
+    bool empty() const { return 0 == m_size; }
+
+    void push_back( _CommReq* req ) {
+        if ( m_nextSeq == m_tree.size() - 1 ) {
+            renumber();
+        }
+        uint64_t seq = m_nextSeq++;
+        treeAdd( seq, 1 );
+        ++m_size;
+
+        if ( isWildcard( req ) ) {
+            m_wildcard.push_back( Entry( seq, req ) );
+        } else {
+            m_buckets[ Key( req->hdr() ) ].push_back( Entry( seq, req ) );
+        }
+    }
+
+    // Removes and returns the earliest posted receive for which match()
+    // is true. position is set to the number of receives a linear walk of
+    // the queue would have visited, examined to the number this list did.
+    _CommReq* find( MatchHdr& hdr, MatchFunc match, int& position, int& examined ) {
+        List* bucket = NULL;
+        List::iterator bucketIter;
+        auto found = m_buckets.find( Key( hdr ) );
+        if ( found != m_buckets.end() ) {
+            for ( bucketIter = found->second.begin(); bucketIter != found->second.end(); ++bucketIter ) {
+                ++examined;
+                if ( match( bucketIter->req ) ) {
+                    bucket = &found->second;
+                    break;
+                }
+            }
+        }
+
+        // a wildcard receive only wins if it was posted before the bucket match
+        List::iterator wildIter = m_wildcard.begin();
+        for ( ; wildIter != m_wildcard.end(); ++wildIter ) {
+            if ( bucket && wildIter->seq > bucketIter->seq ) {
+                wildIter = m_wildcard.end();
+                break;
+            }
+            ++examined;
+            if ( match( wildIter->req ) ) {
+                break;
+            }
+        }
+
+        Entry entry( 0, NULL );
+        if ( wildIter != m_wildcard.end() ) {
+            entry = *wildIter;
+            m_wildcard.erase( wildIter );
+        } else if ( bucket ) {
+            entry = *bucketIter;
+            bucket->erase( bucketIter );
+            if ( bucket->empty() ) {
+                m_buckets.erase( found );
+            }
+        } else {
+            position += m_size;
+            return NULL;
+        }
+
+        position += treePrefix( entry.seq );
+        treeAdd( entry.seq, -1 );
+        --m_size;
+        return entry.req;
+    }
+
+    bool remove( _CommReq* req ) {
+        if ( removeFrom( m_wildcard, req ) ) {
+            return true;
+        }
+        for ( auto iter = m_buckets.begin(); iter != m_buckets.end(); ++iter ) {
+            if ( removeFrom( iter->second, req ) ) {
+                if ( iter->second.empty() ) {
+                    m_buckets.erase( iter );
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    static const size_t MinTreeSize = 1024;
+
+    static bool isWildcard( _CommReq* req ) {
+        return 0 != req->ignore() || AnyTag == req->hdr().tag || MP::AnySrc == req->hdr().rank;
+    }
+
+    bool removeFrom( List& list, _CommReq* req ) {
+        for ( auto iter = list.begin(); iter != list.end(); ++iter ) {
+            if ( iter->req == req ) {
+                treeAdd( iter->seq, -1 );
+                --m_size;
+                list.erase( iter );
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 1 based Fenwick tree indexed by seq
+    void treeAdd( uint64_t seq, int value ) {
+        for ( size_t i = seq + 1; i < m_tree.size(); i += i & -i ) {
+            m_tree[i] += value;
+        }
+    }
+
+    int treePrefix( uint64_t seq ) {
+        int sum = 0;
+        for ( size_t i = seq + 1; i > 0; i -= i & -i ) {
+            sum += m_tree[i];
+        }
+        return sum;
+    }
+
+    // The tree is full, give the live receives the sequence numbers
+    // 0..size-1 (keeping their order) and size the tree for twice that.
+    void renumber() {
+        std::vector<Entry*> live;
+        live.reserve( m_size );
+        for ( auto& entry : m_wildcard ) {
+            live.push_back( &entry );
+        }
+        for ( auto& kv : m_buckets ) {
+            for ( auto& entry : kv.second ) {
+                live.push_back( &entry );
+            }
+        }
+        std::sort( live.begin(), live.end(), []( Entry* a, Entry* b ) { return a->seq < b->seq; } );
+
+        m_nextSeq = live.size();
+        size_t treeSize = 2 * live.size() < MinTreeSize ? MinTreeSize : 2 * live.size();
+        m_tree.assign( treeSize + 1, 0 );
+        for ( size_t i = 0; i < live.size(); i++ ) {
+            live[i]->seq = i;
+            treeAdd( i, 1 );
+        }
+    }
+
+    size_t                                  m_size;
+    uint64_t                                m_nextSeq;
+    std::vector<int>                        m_tree;
+    List                                    m_wildcard;
+    std::unordered_map<Key, List, KeyHash>  m_buckets;
+};
+
+}
+}
+}
+
+#endif
@@ -47,6 +47,7 @@ ProcessQueuesState::ProcessQueuesState( ComponentId_t id, Params& params ) :
     m_maxUnexpectedMsg = params.find<int32_t>("pqs.maxUnexpectedMsg",32);
     m_maxPostedShortBuffers = params.find<int32_t>("pqs.maxPostedShortBuffers",512); 
     m_minPostedShortBuffers = params.find<int32_t>("pqs.minPostedShortBuffers",5); 
+    m_hwMatchUnit = params.find<bool>("pqs.hwMatchUnit",false);
 
     m_dbg.init("", level, mask, Output::STDOUT );
 
@@ -408,15 +409,10 @@ void ProcessQueuesState::processMakeProgress( Stack* stack )
 
 void ProcessQueuesState::enterCancel( MP::MessageRequest req, uint64_t exitDelay ) {
 
-    std::deque< _CommReq* >:: iterator iter = m_pstdRcvQ.begin();
-    for ( ; iter != m_pstdRcvQ.end(); ++iter ) {
-
-		if ( *iter == req ) {
-    		dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",*iter);
-			delete( *iter );
-        	m_pstdRcvQ.erase(iter);
-			break;
-		}
+    _CommReq* commReq = static_cast<_CommReq*>( req );
+    if ( m_pstdRcvQ.remove( commReq ) ) {
+        dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"found req=%p\n",commReq);
+        delete commReq;
     }
     enterMakeProgress(m_exitDelay);
 }
@@ -1007,6 +1003,24 @@ _CommReq* ProcessQueuesState::searchPostedRecv( std::deque< _CommReq* >& pstd, M
     return req;
 }
 
+_CommReq* ProcessQueuesState::searchPostedRecv( PostedRecvList& pstd, MatchHdr& hdr, int& count )
+{
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"posted size %lu\n",pstd.size());
+
+    int position = 0;
+    int examined = 0;
+    _CommReq* req = pstd.find( hdr,
+        [&]( _CommReq* posted ) { return checkMatchHdr( hdr, posted->hdr(), posted->ignore() ); },
+        position, examined );
+
+    // a match unit still costs one lookup when nothing is posted
+    count += m_hwMatchUnit ? std::max( examined, 1 ) : position;
+
+    dbg().debug(CALL_INFO,2,DBG_MSK_PQS_Q,"req=%p position=%d examined=%d\n",req,position,examined);
+
+    return req;
+}
+
 bool ProcessQueuesState::checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr,
                                     uint64_t ignore )
 {
@@ -27,6 +27,7 @@
 #include "loopBack.h"
 
 #include "ctrlMsgCommReq.h"
+#include "ctrlMsgPostedRecvList.h"
 #include "ctrlMsgWaitReq.h"
 
 #define DBG_MSK_PQS_APP_SIDE 1 << 0
@@ -74,6 +75,7 @@ class ProcessQueuesState : public SubComponent
         {"pqs.maxUnexpectedMsg","Sets the maximum unexpected messages","32" },
         {"pqs.maxPostedShortBuffers","Sets the maximum posted short buffers","512" },
         {"pqs.minPostedShortBuffers","Sets the minimum posted short buffers","5"},
+        {"pqs.hwMatchUnit","Model a hashed hardware match unit, the posted receive search costs the entries it examines rather than the position in the posted receive queue","0"},
         {"loopBackPortName","Sets port name to use when connecting to the loopBack component","loop"},
         {"ackVN","Sets the VN to use for acks","0"},
         {"rendezvousVN","Sets the VN to use for rendezvous","0"},
@@ -380,6 +382,7 @@ class ProcessQueuesState : public SubComponent
 
     bool        checkMatchHdr( MatchHdr& hdr, MatchHdr& wantHdr, uint64_t ignore );
     _CommReq*	searchPostedRecv( std::deque< _CommReq* >& pstd, MatchHdr& hdr, int& delay );
+    _CommReq*	searchPostedRecv( PostedRecvList& pstd, MatchHdr& hdr, int& delay );
 
     void exit( int delay = 0 ) {
         dbg().debug(CALL_INFO,2,DBG_MSK_PQS_APP_SIDE,"exit ProcessQueuesState\n");
@@ -480,7 +483,7 @@ class ProcessQueuesState : public SubComponent
     int     m_numRecvLooped;
     bool    m_missedInt;
 
-    std::deque< _CommReq* >         m_pstdRcvQ;
+    PostedRecvList                  m_pstdRcvQ;
     std::deque< _CommReq* >         m_pstdRcvPreQ;
     std::vector<std::deque< Msg* >> m_recvdMsgQ;
 	int m_recvdMsgQpos;
@@ -511,6 +514,7 @@ class ProcessQueuesState : public SubComponent
     int m_nicsPerNode;
     int m_rendezvousVN;
     int m_ackVN;
+    bool m_hwMatchUnit;
 };
 
 }
@@ -0,0 +1,142 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+    // Models a whole contiguous MemOp at once instead of issuing it an access
+    // at a time through the load/store, TLB, bus and cache units. Memory
+    // and each direction of the bus are reserved first come first served by
+    // bulk transfers, the TLB and host cache are consulted for hit estimates
+    // and left holding what the transfer would have brought in.
+    class BulkUnit {
+      public:
+        BulkUnit( SimpleMemoryModel& model, Output& dbg, int id, CacheUnit* cache, SharedTlb* tlb,
+                int memReadLat_ns, int memWriteLat_ns, int memNumSlots, int cacheLineSize,
+                bool useBus, double busBandwidth, int busNumLinks, int busLatency, int TLP_overhead, int DLL_bytes ) :
+            m_model(model), m_dbg(dbg), m_cache(cache), m_tlb(tlb),
+            m_memReadLat_ns(memReadLat_ns), m_memWriteLat_ns(memWriteLat_ns), m_memNumSlots(memNumSlots),
+            m_cacheLineSize(cacheLineSize), m_useBus(useBus), m_busBandwidth_GB(busBandwidth), m_busNumLinks(busNumLinks),
+            m_busLatency(busLatency), m_TLP_overhead(TLP_overhead), m_DLL_bytes(DLL_bytes), m_memFreeAt(0), m_busFreeAt(2,0)
+        {
+            m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::BulkUnit::@p():@l ";
+        }
+
+        static bool canModel( MemOp* op ) {
+            switch ( op->getType() ) {
+              case MemOp::HostLoad:
+              case MemOp::HostStore:
+              case MemOp::HostCopy:
+              case MemOp::BusLoad:
+              case MemOp::BusStore:
+              case MemOp::BusDmaToHost:
+              case MemOp::BusDmaFromHost:
+                return true;
+              default:
+                return false;
+            }
+        }
+
+        // returns the time until the whole op is complete
+        SimTime_t transfer( MemOp* op, int pid, int accessSize, bool nic ) {
+            SimTime_t now = m_model.getCurrentSimTimeNano();
+            SimTime_t done;
+
+            if ( MemOp::HostCopy == op->getType() ) {
+                // a NIC copy (shmem) reads the source and writes the dest across the bus
+                done = std::max( side( op->src, op->length, true, pid, accessSize, nic, now ),
+                                 side( op->dest, op->length, false, pid, accessSize, nic, now ) );
+            } else {
+                done = side( op->addr, op->length, op->isLoad(), pid, accessSize, nic, now );
+            }
+
+            m_dbg.verbosePrefix(prefix(),CALL_INFO,1,THREAD_MASK,"%s addr=%#" PRIx64 " length=%zu delay=%" PRIu64 "\n",
+                                op->getName(), op->addr, op->length, done - now );
+            return done - now;
+        }
+
+      private:
+
+        // One direction of a transfer, a NIC access pays for its TLB misses
+        // and crosses the bus, a host access only sees memory.
+        SimTime_t side( Hermes::Vaddr addr, size_t length, bool load, int pid, int accessSize, bool nic, SimTime_t now ) {
+            SimTime_t start = now;
+            SimTime_t walks = 0;
+            if ( nic ) {
+                // page walks overlap the transfer, only the first one delays its start
+                int misses = m_tlb->bulkLookup( addr, length, pid );
+                walks = (SimTime_t) ( ( misses + m_tlb->numWalkers() - 1 ) / m_tlb->numWalkers() ) * m_tlb->missLatency();
+                start += misses ? m_tlb->missLatency() : 0;
+            }
+            SimTime_t done = std::max( now + walks, memory( addr, length, load, pid, start ) );
+            if ( nic && m_useBus ) {
+                done = std::max( done, bus( length, accessSize, load, start ) ) + m_busLatency;
+            }
+            return done;
+        }
+
+        // Every line that misses in the host cache costs a memory access (and,
+        // with a cache, the write back of the line it displaces). Accesses
+        // occupy one of the memory slots for the full memory latency.
+        SimTime_t memory( Hermes::Vaddr addr, size_t length, bool load, int pid, SimTime_t start ) {
+            addr |= (uint64_t) pid << 56;
+            uint64_t first = addr & ~( (uint64_t) m_cacheLineSize - 1 );
+            uint64_t numLines = ( addr + length - first + m_cacheLineSize - 1 ) / m_cacheLineSize;
+            uint64_t numAccesses = numLines;
+            int latency = load ? m_memReadLat_ns : m_memWriteLat_ns;
+
+            if ( m_cache ) {
+                numAccesses = 2 * ( numLines - m_cache->bulkAccess( first, numLines ) );
+                latency = m_memReadLat_ns;
+            }
+
+            if ( 0 == numAccesses ) {
+                return start;
+            }
+
+            start = std::max( start, m_memFreeAt );
+            m_memFreeAt = start + ( numAccesses + m_memNumSlots - 1 ) / m_memNumSlots * latency;
+            return m_memFreeAt;
+        }
+
+        // the data plus the per TLP overhead of each accessSize chunk,
+        // stores go to the host on one side of the bus, load data comes back on the other
+        SimTime_t bus( size_t length, int accessSize, bool load, SimTime_t start ) {
+            uint64_t numTLPs = ( length + accessSize - 1 ) / accessSize;
+            uint64_t numBytes = length + numTLPs * ( m_TLP_overhead + m_DLL_bytes );
+            SimTime_t& freeAt = m_busFreeAt[ load ? 1 : 0 ];
+
+            start = std::max( start, freeAt );
+            freeAt = start + round( ( numBytes / ( m_busNumLinks / 8 ) ) / m_busBandwidth_GB );
+            return freeAt;
+        }
+
+        const char* prefix() { return m_prefix.c_str(); }
+
+        std::string m_prefix;
+        SimpleMemoryModel& m_model;
+        Output& m_dbg;
+        CacheUnit* m_cache;
+        SharedTlb* m_tlb;
+        int m_memReadLat_ns;
+        int m_memWriteLat_ns;
+        int m_memNumSlots;
+        int m_cacheLineSize;
+        bool m_useBus;
+        double m_busBandwidth_GB;
+        int m_busNumLinks;
+        int m_busLatency;
+        int m_TLP_overhead;
+        int m_DLL_bytes;
+        SimTime_t m_memFreeAt;
+        std::vector<SimTime_t> m_busFreeAt;
+    };
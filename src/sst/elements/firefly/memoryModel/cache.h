@@ -32,6 +32,29 @@ class Cache {
         return m_addrMap.find(addr) != m_addrMap.end();
     }
 
+    int size() { return m_cacheSize; }
+
+    // number of valid entries in [start,end)
+    uint64_t countInRange( Hermes::Vaddr start, Hermes::Vaddr end ) {
+        uint64_t count = 0;
+        for ( auto& kv : m_addrMap ) {
+            if ( kv.first >= start && kv.first < end ) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    // make addr the most recently used entry, evicting the oldest if it is not present
+    void touch( Hermes::Vaddr addr ) {
+        if ( isValid( addr ) ) {
+            updateAge( addr );
+        } else {
+            evict();
+            insert( addr );
+        }
+    }
+
     void updateAge( Hermes::Vaddr addr ) {
         m_ageList.move_to_back( m_addrMap.find(addr)->second );
         m_addrMap.find( addr )->second = m_ageList.end();
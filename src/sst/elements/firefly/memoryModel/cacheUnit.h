@@ -71,6 +71,26 @@
 			return addEntry( new Entry( Entry::Load, src, req, m_model.getCurrentSimTimeNano(), callback ) );
 		}
 
+        // Cache state for a transfer modeled as a whole by the BulkUnit, returns
+        // how many of the numLines lines starting at addr hit. Only the tail of
+        // the transfer can still be resident when it is done, lines with a load
+        // outstanding are left for the load to insert.
+        uint64_t bulkAccess( Hermes::Vaddr addr, uint64_t numLines ) {
+            uint64_t hits = m_cache.countInRange( addr, addr + numLines * m_cacheLineSize );
+            m_hitCnt->addDataNTimes( hits, 1 );
+            m_totalCnt->addDataNTimes( numLines, 1 );
+
+            uint64_t numResident = std::min( numLines, (uint64_t) m_cache.size() );
+            for ( uint64_t i = numLines - numResident; i < numLines; i++ ) {
+                Hermes::Vaddr line = addr + i * m_cacheLineSize;
+                if ( ! isPending( line ) ) {
+                    m_cache.touch( line );
+                }
+            }
+            m_dbg.verbosePrefix(prefix(),CALL_INFO,1,CACHE_MASK,"addr=%#" PRIx64 " numLines=%" PRIu64 " hits=%" PRIu64 "\n",addr,numLines,hits);
+            return hits;
+        }
+
 		void resume( UnitBase* src = NULL ) {
             m_blockedOnMemUnit = false;
             m_dbg.verbosePrefix(prefix(),CALL_INFO,1,CACHE_MASK,"blocked=%lu bockedDone=%lu numPending=%d\n",
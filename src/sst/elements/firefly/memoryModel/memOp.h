@@ -88,6 +88,12 @@
 			}
 		}
 
+		// issue all of the Op as a single request
+		void issueAll() {
+			offset = length;
+			++m_pending;
+		}
+
         void decPending() {
             --m_pending;
         }
@@ -97,6 +103,10 @@
 		bool isDone() {
 			return offset == length;
 		}
+		Op getType() {
+			return type;
+		}
+
 		Op getOp( ) {
 
 			if ( HostCopy == type ) {
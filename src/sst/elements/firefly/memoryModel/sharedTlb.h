@@ -73,6 +73,36 @@ public:
         return -1;
     }
 
+    // Lookup of every page of a transfer modeled as a whole by the BulkUnit,
+    // returns the number of misses. Missing pages are inserted right away
+    // unless a walk for them is already outstanding.
+    int bulkLookup( Hermes::Vaddr addr, size_t length, int pid ) {
+        if ( 0 == m_cacheSize ) {
+            return 0;
+        }
+
+        int misses = 0;
+        uint64_t pageSize = ~m_pageMask + 1;
+        for ( Hermes::Vaddr page = getPageAddr( addr ); page < addr + length; page += pageSize ) {
+            uint64_t pageAddr = page | (uint64_t) pid << 56;
+            m_totalCnt->addData( 1 );
+            if ( m_cache.isValid( pageAddr ) ) {
+                m_hitCnt->addData( 1 );
+            } else {
+                ++misses;
+                if ( m_pendingMap.find(pageAddr) == m_pendingMap.end() ) {
+                    m_cache.evict();
+                    m_cache.insert( pageAddr );
+                }
+            }
+        }
+        m_dbg.verbosePrefix(prefix(),CALL_INFO,1,SHARED_TLB_MASK,"addr=%#" PRIx64 " length=%zu misses=%d\n", addr, length, misses );
+        return misses;
+    }
+
+    int numWalkers() { return m_numWalkers; }
+    int missLatency() { return m_tlbMissLat_ns; }
+
 private:
 
     std::queue< std::pair< MemReq*, Callback > > m_pendingLookups;
@@ -74,6 +74,7 @@ public:
 		{"useDetailedModel",    "Sets whether or not a detailed memory model is used","no"},
 		{"useBusBridge",        "Sets whether or not a bus is used between the NIC and host","yes"},
 		{"printConfig",         "Print the config","no"},
+		{"bulkMinBytes",        "MemOps of at least this many bytes are modeled analytically rather than an access at a time, 0 disables","0"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -129,6 +130,7 @@ public:
 #include "memUnit.h"
 #include "cacheUnit.h"
 #include "detailedUnit.h"
+#include "bulkUnit.h"
 
 
     class SelfEvent : public SST::Event {
@@ -150,7 +152,7 @@ public:
 	enum NIC_Thread { Send, Recv };
 
     SimpleMemoryModel( ComponentId_t compId, Params& params ) :
-		MemoryModel( compId ), m_hostCacheUnit(NULL), m_busBridgeUnit(NULL)
+		MemoryModel( compId ), m_hostCacheUnit(NULL), m_busBridgeUnit(NULL), m_bulkUnit(NULL)
 	{
 		int id = params.find<int32_t>( "id", -1 );
 		assert( id > -1 );
@@ -189,6 +191,7 @@ public:
 		int numWalkers = params.find<int>( "numWalkers", 1 );
 		int numTlbSlots = params.find<int>( "numTlbSlots", 1 );
         int nicToHostMTU = params.find<int>( "nicToHostMTU", 256 );
+		m_bulkMinBytes = params.find<size_t>( "bulkMinBytes", 0 );
 		std::string tmp = params.find<std::string>( "useHostCache", "yes" );
 		bool useHostCache;
 		if ( 0 == tmp.compare("yes" ) ) {
@@ -248,6 +251,12 @@ public:
 
 		m_nicUnit = new NicUnit( *this, m_dbg, id );
 
+		// the detailed model has its own memory timing, leave it to see every access
+		if ( m_bulkMinBytes && ! m_detailedUnit ) {
+			m_bulkUnit = new BulkUnit( *this, m_dbg, id, m_hostCacheUnit, m_sharedTlb, memReadLat_ns, memWriteLat_ns, memNumSlots,
+					hostCacheLineSize, useBusBridge, busBandwidth, busNumLinks, busLatency, TLP_overhead, DLL_bytes );
+		}
+
 		std::stringstream tlbName;
 		std::stringstream threadName;
 		for ( int i = 0; i < m_numNicThreads; i++ ) {
@@ -290,6 +299,9 @@ public:
         }
 		delete m_sharedTlb;
 		delete m_nicUnit;
+		if ( m_bulkUnit ) {
+			delete m_bulkUnit;
+		}
     }
 
 	ThingHeap<SelfEvent> m_eventHeap;
@@ -364,6 +376,11 @@ public:
 
 	NicUnit& nicUnit() { return *m_nicUnit; }
 
+	bool useBulkUnit( MemOp* op ) {
+		return m_bulkUnit && 0 == op->offset && op->length >= m_bulkMinBytes && BulkUnit::canModel( op );
+	}
+	BulkUnit& bulkUnit() { return *m_bulkUnit; }
+
 	bool busUnitWrite( UnitBase* src, MemReq* req, Callback* callback ) {
 		if ( m_busBridgeUnit ) {
 			return m_busBridgeUnit->write( src, req, callback );
@@ -399,6 +416,8 @@ public:
 	NicUnit* 		m_nicUnit;
 	CacheUnit* 		m_nicCacheUnit;
     SharedTlb*      m_sharedTlb;
+	BulkUnit*		m_bulkUnit;
+	size_t			m_bulkMinBytes;
 
 	std::vector<Thread*> m_threads;
 
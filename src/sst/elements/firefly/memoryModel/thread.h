@@ -96,7 +96,8 @@ class Thread : public UnitBase {
   public:
      Thread( SimpleMemoryModel& model, std::string name, Output& output, int id, int thread_id , int accessSize, Unit* load, Unit* store ) :
 			m_model(model), m_name(name), m_dbg(output), m_id(id), m_loadUnit(load), m_storeUnit(store),
-			m_maxAccessSize( accessSize ), m_nextOp(NULL), m_waitingOnOp(NULL), m_blocked(false), m_curWorkNum(0),m_lastDelete(0)
+			m_maxAccessSize( accessSize ), m_nextOp(NULL), m_waitingOnOp(NULL), m_blocked(false), m_curWorkNum(0),m_lastDelete(0),
+			m_isNic( 0 == name.compare("nic") )
 	{
 		m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::" + name +"::@p():@l ";
         m_dbg.verbosePrefix( prefix(), CALL_INFO,1,THREAD_MASK,"this=%p\n",this );
@@ -171,8 +172,15 @@ class Thread : public UnitBase {
         }
 
         Hermes::Vaddr addr = op->getCurrentAddr();
-        size_t length = op->getCurrentLength( m_maxAccessSize );
-		op->incOffset( length );
+        size_t length;
+        bool bulk = m_model.useBulkUnit( op );
+        if ( bulk ) {
+            length = op->length;
+            op->issueAll();
+        } else {
+            length = op->getCurrentLength( m_maxAccessSize );
+		    op->incOffset( length );
+        }
 
         m_dbg.verbosePrefix(prefix(),CALL_INFO,2,THREAD_MASK,"op=%s op.length=%lu offset=%lu addr=%#" PRIx64 " length=%lu\n",
                             op->getName(), op->length, op->offset, addr, length );
@@ -194,40 +202,44 @@ class Thread : public UnitBase {
     	Callback* callback = new Callback;
 		*callback = std::bind(&Thread::opCallback,this, work, op, deleteWork );
 
-        switch( op->getOp() ) {
-          case MemOp::NoOp:
-	        m_model.schedCallback( 0, callback );
-            break;
-
-		  case MemOp::HostBusWrite:
-            m_blocked = m_model.busUnitWrite( this, new MemReq( addr, length ), callback );
-		    break;
-
-          case MemOp::LocalLoad:
-			m_blocked = m_model.nicUnit().load( this, new MemReq( 0, 0), callback );
-            break;
-
-          case MemOp::LocalStore:
-			m_blocked = m_model.nicUnit().storeCB( this, new MemReq( 0, 0), callback );
-            break;
-
-          case MemOp::HostStore:
-          case MemOp::BusStore:
-          case MemOp::BusDmaToHost:
-            addr |= (uint64_t) pid << 56;
-			m_blocked = m_storeUnit->storeCB( this, new MemReq( addr, length, pid ), callback );
-            break;
-
-          case MemOp::HostLoad:
-          case MemOp::BusLoad:
-          case MemOp::BusDmaFromHost:
-            addr |= (uint64_t) pid << 56;
-			m_blocked = m_loadUnit->load( this, new MemReq( addr, length, pid ), callback );
-            break;
-
-          default:
-			printf("%d\n",op->getOp() );
-            assert(0);
+        if ( bulk ) {
+            m_model.schedCallback( m_model.bulkUnit().transfer( op, pid, m_maxAccessSize, m_isNic ), callback );
+        } else {
+            switch( op->getOp() ) {
+              case MemOp::NoOp:
+    	        m_model.schedCallback( 0, callback );
+                break;
+
+    		  case MemOp::HostBusWrite:
+                m_blocked = m_model.busUnitWrite( this, new MemReq( addr, length ), callback );
+    		    break;
+
+              case MemOp::LocalLoad:
+    			m_blocked = m_model.nicUnit().load( this, new MemReq( 0, 0), callback );
+                break;
+
+              case MemOp::LocalStore:
+    			m_blocked = m_model.nicUnit().storeCB( this, new MemReq( 0, 0), callback );
+                break;
+
+              case MemOp::HostStore:
+              case MemOp::BusStore:
+              case MemOp::BusDmaToHost:
+                addr |= (uint64_t) pid << 56;
+    			m_blocked = m_storeUnit->storeCB( this, new MemReq( addr, length, pid ), callback );
+                break;
+
+              case MemOp::HostLoad:
+              case MemOp::BusLoad:
+              case MemOp::BusDmaFromHost:
+                addr |= (uint64_t) pid << 56;
+    			m_blocked = m_loadUnit->load( this, new MemReq( addr, length, pid ), callback );
+                break;
+
+              default:
+    			printf("%d\n",op->getOp() );
+                assert(0);
+            }
         }
 
         // if the Op is done it means we are issing the last chunk of this Op
@@ -332,6 +344,7 @@ class Thread : public UnitBase {
     int                 m_curWorkNum;
     int                 m_lastDelete;
     int                 m_id;
+    bool                m_isNic;
     std::map<int,Work*> m_OOOwork;
 	Statistic<uint64_t>* m_workQdepth;
 };
@@ -45,6 +45,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/allgather.h>
 #include <iris/sumi/transport.h>
 #include <iris/sumi/communicator.h>
+#include <mercury/common/null_buffer.h>
 #include <output.h>
 #include <cstring>
 
@@ -174,7 +175,7 @@ BruckActor::finalize()
 {
   // rank 0 need not reorder
   // or no buffers
-  if (dom_me_ == 0 || result_buffer_ == 0){
+  if (dom_me_ == 0 || isNullBuffer(result_buffer_)){
     return;
   }
 
@@ -182,6 +183,7 @@ BruckActor::finalize()
   //first, copy everything out
   int total_nelems = nelems_* dom_nproc_;
   int total_size = total_nelems * type_size_;
+  trackPayloadAlloc(total_size);
   char* tmp = new char[total_size];
   my_api_->memcopy(tmp, result_buffer_, total_size);
 
@@ -207,6 +209,14 @@ BruckActor::finalize()
 void
 RingAllgatherActor::initBuffers()
 {
+  //the ring starts by forwarding my own block from its final position
+  void* dst = result_buffer_;
+  void* src = send_buffer_;
+  if (src != dst && isNonNullBuffer(dst)){
+    int block_size = nelems_ * type_size_;
+    my_api_->memcopy(((char*)dst) + dom_me_ * block_size, src, block_size);
+  }
+  send_buffer_ = result_buffer_;
   recv_buffer_ = result_buffer_;
 }
 
@@ -103,6 +103,12 @@ class BruckActor : public DagCollectiveActor
   void initDag() override;
   void bufferAction(void *dst_buffer, void *msg_buffer, Action* ac) override;
 
+  bool dagCacheKey(uint64_t& key) const override {
+    //allgather and barrier share this actor
+    key = (uint64_t(type_) << 32) | uint32_t(nelems_);
+    return true;
+  }
+
   int nelems_;
 
 };
@@ -176,6 +182,11 @@ class RingAllgatherActor : public DagCollectiveActor
   void initDag() override;
   void bufferAction(void *dst_buffer, void *msg_buffer, Action* ac) override;
 
+  bool dagCacheKey(uint64_t& key) const override {
+    key = nelems_;
+    return true;
+  }
+
   int nelems_;
 
 };
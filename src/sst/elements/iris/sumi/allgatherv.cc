@@ -45,6 +45,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/allgatherv.h>
 #include <iris/sumi/transport.h>
 #include <iris/sumi/communicator.h>
+#include <mercury/common/null_buffer.h>
 //#include <sprockit/output.h>
 #include <cstring>
 
@@ -191,13 +192,14 @@ BruckAllgathervActor::finalize()
 {
   // rank 0 need not reorder
   // or no buffers
-  if (dom_me_ == 0 || result_buffer_ == 0){
+  if (dom_me_ == 0 || isNullBuffer(result_buffer_)){
     return;
   }
 
   //we need to reorder things a bit
   //first, copy everything out
   int total_size = total_nelems_ * type_size_;
+  trackPayloadAlloc(total_size);
   char* tmp = new char[total_size];
   my_api_->memcopy(tmp, result_buffer_, total_size);
 
@@ -48,6 +48,7 @@ Questions? Contact sst-macro-help@sandia.gov
 //#include <sprockit/output.h>
 #include <mercury/common/stl_string.h>
 #include <cstring>
+#include <algorithm>
 
 #define divide_by_2_round_up(x) ((x/2) + (x%2))
 
@@ -240,4 +241,122 @@ WilkeAllreduceActor::bufferAction(void *dst_buffer, void *msg_buffer, Action* ac
   }
 }
 
+int
+RingAllreduceActor::numSegments(int nproc, int nelems, int requested)
+{
+  //both phases take nproc-1 steps of num_segments rounds each
+  int max_segments = (Action::max_round - 1) / (2*(nproc - 1));
+  int segments = std::min(requested, max_segments);
+  segments = std::min(segments, nelems / nproc);
+  return std::max(segments, 1);
+}
+
+void
+RingAllreduceActor::segment(int chunk, int seg, int& offset, int& nelems) const
+{
+  //chunks and segments within a chunk differ by at most one element
+  int chunk_nelems = nelems_ / dom_nproc_;
+  int chunk_extra = nelems_ % dom_nproc_;
+  int chunk_offset = chunk * chunk_nelems + std::min(chunk, chunk_extra);
+  if (chunk < chunk_extra) ++chunk_nelems;
+
+  int seg_nelems = chunk_nelems / num_segments_;
+  int seg_extra = chunk_nelems % num_segments_;
+  offset = chunk_offset + seg * seg_nelems + std::min(seg, seg_extra);
+  nelems = seg < seg_extra ? seg_nelems + 1 : seg_nelems;
+}
+
+void
+RingAllreduceActor::finalizeBuffers()
+{
+  long buffer_size = nelems_ * type_size_;
+  my_api_->freeWorkspace(recv_buffer_, buffer_size);
+}
+
+void
+RingAllreduceActor::initBuffers()
+{
+  void* dst = result_buffer_;
+  void* src = send_buffer_;
+  int size = nelems_ * type_size_;
+
+  if (src != dst)
+    my_api_->memcopy(dst, src, size);
+  //reduced chunks land in a temp buffer before being combined into the result
+  recv_buffer_ = my_api_->allocateWorkspace(size, src);
+  send_buffer_ = result_buffer_;
+}
+
+void
+RingAllreduceActor::initDag()
+{
+  slicer_->fxn = fxn_;
+
+  int send_partner = (dom_me_ + 1) % dom_nproc_;
+  int recv_partner = (dom_me_ + dom_nproc_ - 1) % dom_nproc_;
+  int num_steps = dom_nproc_ - 1;
+  num_reducing_rounds_ = num_steps * num_segments_;
+
+  output.output("Rank %s configured ring allreduce for tag=%d for nproc=%d with %d segments",
+    rankStr().c_str(), tag_, dom_nproc_, num_segments_);
+
+  for (int seg=0; seg < num_segments_; ++seg){
+    Action* prev_recv = nullptr;
+    std::vector<Action*> reduce_sends(num_steps);
+    /**
+     * Reduce-scatter: at step k send chunk me-k and reduce chunk me-k-1
+     * into the result. The chunk received at step k is the one sent at step k+1,
+     * so a send only waits on the previous receive, never on the previous send.
+     */
+    for (int k=0; k < num_steps; ++k){
+      int rnd = k * num_segments_ + seg;
+      int send_chunk = (dom_me_ - k + dom_nproc_) % dom_nproc_;
+      int recv_chunk = (dom_me_ - k - 1 + 2*dom_nproc_) % dom_nproc_;
+
+      Action* send_ac = new SendAction(rnd, send_partner, SendAction::in_place);
+      segment(send_chunk, seg, send_ac->offset, send_ac->nelems);
+      Action* recv_ac = new RecvAction(rnd, recv_partner, RecvAction::reduce);
+      segment(recv_chunk, seg, recv_ac->offset, recv_ac->nelems);
+
+      addDependency(prev_recv, send_ac);
+      addDependency(prev_recv, recv_ac);
+
+      reduce_sends[k] = send_ac;
+      prev_recv = recv_ac;
+    }
+
+    /**
+     * Allgather: after the reduce-scatter I own the finished chunk me+1.
+     * At step k send chunk me+1-k and receive chunk me-k in place. That chunk
+     * was read by the reduce-scatter send of step k, which must be done first.
+     */
+    for (int k=0; k < num_steps; ++k){
+      int rnd = num_reducing_rounds_ + k * num_segments_ + seg;
+      int send_chunk = (dom_me_ + 1 - k + dom_nproc_) % dom_nproc_;
+      int recv_chunk = (dom_me_ - k + dom_nproc_) % dom_nproc_;
+
+      Action* send_ac = new SendAction(rnd, send_partner, SendAction::in_place);
+      segment(send_chunk, seg, send_ac->offset, send_ac->nelems);
+      Action* recv_ac = new RecvAction(rnd, recv_partner, RecvAction::in_place);
+      segment(recv_chunk, seg, recv_ac->offset, recv_ac->nelems);
+
+      addDependency(prev_recv, send_ac);
+      addDependency(prev_recv, recv_ac);
+      addDependency(reduce_sends[k], recv_ac);
+
+      prev_recv = recv_ac;
+    }
+  }
+}
+
+void
+RingAllreduceActor::bufferAction(void *dst_buffer, void *msg_buffer, Action* ac)
+{
+  if (ac->round < num_reducing_rounds_){
+    (fxn_)(dst_buffer, msg_buffer, ac->nelems);
+  } else {
+    my_api_->memcopy(dst_buffer, msg_buffer, ac->nelems * type_size_);
+  }
+}
+
 }
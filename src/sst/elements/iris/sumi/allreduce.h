@@ -116,4 +116,81 @@ class WilkeHalvingAllreduce :
 
 };
 
+/**
+ * Bandwidth optimal ring allreduce: a ring reduce-scatter followed by a
+ * ring allgather, each rank moves 2(P-1)/P of the buffer. Every chunk is
+ * further cut into segments that advance around the ring independently,
+ * so a segment can be forwarded while later segments are still arriving.
+ */
+class RingAllreduceActor :
+  public DagCollectiveActor
+{
+
+ public:
+  RingAllreduceActor(CollectiveEngine* engine, void* dst, void* src,
+                     int nelems, int type_size, int tag, reduce_fxn fxn,
+                     int num_segments, int cq_id, Communicator* comm) :
+    DagCollectiveActor(Collective::allreduce, engine, dst, src, type_size, tag, cq_id, comm, fxn),
+    fxn_(fxn), nelems_(nelems), num_segments_(num_segments)
+  {
+  }
+
+  std::string toString() const override {
+    return "ring all reduce actor";
+  }
+
+  void bufferAction(void *dst_buffer, void *msg_buffer, Action* ac) override;
+
+  /**
+   * @brief The number of segments actually used, bounded so that every
+   *        segment holds at least one element and all rounds fit in a message id
+   */
+  static int numSegments(int nproc, int nelems, int requested);
+
+ private:
+  void finalizeBuffers() override;
+  void initBuffers() override;
+  void initDag() override;
+
+  void segment(int chunk, int seg, int& offset, int& nelems) const;
+
+ private:
+  reduce_fxn fxn_;
+
+  int nelems_;
+
+  int num_segments_;
+
+  int num_reducing_rounds_;
+
+};
+
+class RingAllreduce :
+  public DagCollective
+{
+ public:
+  RingAllreduce(CollectiveEngine* engine, void* dst, void* src,
+                int nelems, int type_size, int tag, reduce_fxn fxn,
+                int num_segments, int cq_id, Communicator* comm)
+    : DagCollective(allreduce, engine, dst, src, type_size, tag, cq_id, comm),
+      fxn_(fxn), nelems_(nelems), num_segments_(num_segments)
+  {
+  }
+
+  std::string toString() const override {
+    return "sumi ring allreduce";
+  }
+
+  DagCollectiveActor* newActor() const override {
+    return new RingAllreduceActor(engine_, dst_buffer_, src_buffer_,
+                                  nelems_, type_size_, tag_, fxn_, num_segments_, cq_id_, comm_);
+  }
+
+ private:
+  reduce_fxn fxn_;
+  int nelems_;
+  int num_segments_;
+
+};
+
 }
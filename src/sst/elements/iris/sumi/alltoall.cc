@@ -46,6 +46,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/allgather.h>
 #include <iris/sumi/transport.h>
 #include <iris/sumi/communicator.h>
+#include <mercury/common/null_buffer.h>
 //#include <sprockit/output.h>
 #include <cstring>
 
@@ -121,7 +122,7 @@ BruckAlltoallActor::shuffle(Action *ac, void* tmpBuf, void* mainBuf, bool copyTo
 void
 BruckAlltoallActor::startShuffle(Action *ac)
 {
-  if (result_buffer_ == nullptr) return;
+  if (isNullBuffer(result_buffer_)) return;
 
   if (ac->partner == SEND_SHUFFLE){
     //shuffle to get ready for a send
@@ -204,12 +205,13 @@ BruckAlltoallActor::bufferAction(void *dst_buffer, void *msg_buffer, Action* ac)
 void
 BruckAlltoallActor::finalize()
 {
-  if (result_buffer_ == 0){
+  if (isNullBuffer(result_buffer_)){
     return;
   }
 
   int total_size = dom_nproc_ * nelems_ * type_size_;
   int block_size = nelems_ * type_size_;
+  trackPayloadAlloc(total_size);
   char* tmp = new char[total_size];
   char* result = (char*) result_buffer_;
   for (int i=0; i < dom_nproc_; ++i){
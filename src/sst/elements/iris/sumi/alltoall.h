@@ -93,6 +93,11 @@ class BruckAlltoallActor : public DagCollectiveActor
   void initBuffers() override;
   void initDag() override;
 
+  bool dagCacheKey(uint64_t& key) const override {
+    key = nelems_;
+    return true;
+  }
+
   void bufferAction(void *dst_buffer, void *msg_buffer, Action* ac) override;
 
   void startShuffle(Action* ac) override;
@@ -157,6 +162,11 @@ class DirectAlltoallActor :
 
   void initDag() override;
 
+  bool dagCacheKey(uint64_t& key) const override {
+    key = nelems_;
+    return true;
+  }
+
  private:
   void addAction(
     const std::vector<Action*>& actions,
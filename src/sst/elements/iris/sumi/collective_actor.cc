@@ -47,7 +47,11 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/communicator.h>
 //#include <sprockit/output.h>
 #include <mercury/common/null_buffer.h>
+#include <algorithm>
 #include <cstring>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 //RegisterDebugSlot(sumi_collective_buffer);
@@ -56,6 +60,9 @@ namespace SST::Iris::sumi {
 
 reduce_fxn Slicer::null_reduce_fxn = [](void*,const void*,int){};
 
+static_assert(std::is_trivially_copyable<CollectiveDag::Slot>::value,
+              "flattened DAG actions are copied as plain data");
+
 //using namespace sprockit::dbg;
 
 std::string
@@ -141,18 +148,63 @@ CollectiveActor::domToGlobalDst(int dom_dst)
   return global_physical_dst;
 }
 
+void
+DagCollectiveActor::init()
+{
+  initTree();
+
+  uint64_t key = 0;
+  bool reusable = dagCacheKey(key);
+  if (reusable){
+    dag_ = comm_->cachedDag(typeid(*this), key);
+  }
+
+  if (!dag_){
+    initDag();
+    std::shared_ptr<CollectiveDag> dag = flattenDag();
+    if (reusable && !dag->needs_resolve){
+      comm_->cacheDag(typeid(*this), key, dag);
+    }
+    dag_ = std::move(dag);
+  } else {
+    output.output("Rank %s, collective %s reusing DAG of %lu actions on tag=%d",
+      rankStr().c_str(), Collective::tostr(type_), dag_->actions.size(), tag_);
+  }
+
+  actions_ = dag_->actions;
+  states_.assign(actions_.size(), waiting);
+  ready_.reserve(actions_.size());
+  num_pending_deps_ = dag_->succ.size();
+
+  initBuffers();
+}
+
 void
 DagCollectiveActor::start()
 {
 #if SSTMAC_COMM_DELAY_STATS
   my_api_->startCollectiveMessageLog();
 #endif
-  while (!initial_actions_.empty()){
-    auto iter = initial_actions_.begin();
-    Action* ac = *iter;
-    initial_actions_.erase(iter);
+  for (uint32_t idx : dag_->initial){
+    states_[idx] = ready;
+    ready_.push_back(idx);
+  }
+  drainReady();
+}
+
+void
+DagCollectiveActor::drainReady()
+{
+  //starting an action can complete others and make more ready,
+  //the outermost caller starts everything in queue order
+  if (draining_) return;
+
+  draining_ = true;
+  while (ready_head_ < ready_.size()){
+    Action* ac = action(ready_[ready_head_++]);
     startAction(ac);
   }
+  draining_ = false;
 }
 
 void
@@ -215,12 +267,11 @@ DagCollectiveActor::startShuffle(Action * /*ac*/)
 void
 DagCollectiveActor::clearDependencies(Action* ac)
 {
-  std::multimap<uint32_t, Action*>::iterator it = pending_comms_.find(ac->id);
-  std::list<Action*> pending_actions;
-  while (it != pending_comms_.end()){
-    Action* pending = it->second;
-    pending_actions.push_back(pending);
-    pending_comms_.erase(it);
+  uint32_t first = dag_->succ_offsets[ac->dag_index];
+  uint32_t last = dag_->succ_offsets[ac->dag_index + 1];
+  for (uint32_t i=first; i < last; ++i){
+    Action* pending = action(dag_->succ[i]);
+    --num_pending_deps_;
 
     pending->join_counter--;
     output.output("Rank %s satisfying dependency to join counter %d for action %s to partner %s on round %d with action %u tag=%d",
@@ -231,20 +282,46 @@ DagCollectiveActor::clearDependencies(Action* ac)
     }
 
     if (pending->join_counter == 0){
-      startAction(pending);
+      states_[pending->dag_index] = ready;
+      ready_.push_back(pending->dag_index);
     }
-
-    it = pending_comms_.find(ac->id);
   }
+  drainReady();
 }
 
 void
 DagCollectiveActor::clearAction(Action* ac)
 {
-  active_comms_.erase(ac->id);
+  uint8_t& state = states_[ac->dag_index];
+  if (state == active){
+    --num_active_;
+  }
+  state = done;
   checkCollectiveDone();
   clearDependencies(ac);
-  completed_actions_.push_back(ac);
+}
+
+void
+DagCollectiveActor::activate(Action* ac)
+{
+  uint8_t& state = states_[ac->dag_index];
+  if (state != active){
+    state = active;
+    ++num_active_;
+  }
+}
+
+Action*
+DagCollectiveActor::activeAction(uint32_t id)
+{
+  uint32_t idx = dag_->find(id);
+  while (idx != Action::no_index){
+    if (states_[idx] == active){
+      return action(idx);
+    }
+    idx = dag_->next_same_id[idx];
+  }
+  return nullptr;
 }
 
 void
@@ -310,16 +387,24 @@ DagCollectiveActor::addAction(Action* ac)
 {
   addDependency(0, ac);
 }
+uint32_t
+DagCollectiveActor::registerAction(Action* ac)
+{
+  if (ac->dag_index == Action::no_index){
+    ac->dag_index = dag_build_.size();
+    dag_build_.push_back(ac);
+  }
+  return ac->dag_index;
+}
+
 void
-DagCollectiveActor::addDependencyToMap(uint32_t id, Action* ac)
+DagCollectiveActor::addDependencyEdge(Action* precursor, Action* ac)
 {
-  //in case this accidentally got added to initial set
-  //make sure it gets removed
-  initial_actions_.erase(ac);
   output.output("Rank %s, collective %s adding dependency %u to %s tag=%d",
-    rankStr().c_str(), Collective::tostr(type_), id, ac->toString().c_str(), tag_);
-  pending_comms_.insert(std::make_pair(id, ac));
-  ac->join_counter++;
+    rankStr().c_str(), Collective::tostr(type_), precursor->id, ac->toString().c_str(), tag_);
+  uint32_t from = registerAction(precursor);
+  uint32_t to = registerAction(ac);
+  dag_edges_.emplace_back(from, to);
 }
 
 void
@@ -331,19 +416,19 @@ DagCollectiveActor::addCommDependency(Action* precursor, Action *ac)
   if (physical_rank == Communicator::unresolved_rank){
     //uh oh - need to wait on this
     uint32_t resolve_id = Action::messageId(Action::resolve, 0, ac->partner);
-     comm_->registerRankCallback(this);
-    addDependencyToMap(resolve_id, ac);
-    if (precursor) addDependencyToMap(precursor->id, ac);
+    comm_->registerRankCallback(this);
+    Action*& resolve = resolve_actions_[resolve_id];
+    if (!resolve){
+      resolve = new Action(Action::resolve, 0, ac->partner);
+    }
+    addDependencyEdge(resolve, ac);
+    if (precursor) addDependencyEdge(precursor, ac);
   } else {
     ac->phys_partner = physical_rank;
     if (precursor){
-      addDependencyToMap(precursor->id, ac);
-    } else if (ac->join_counter == 0){
-      output.output("Rank %s, collective %s adding initial %s on tag=%d",
-        rankStr().c_str(), Collective::tostr(type_), ac->toString().c_str(), tag_);
-      initial_actions_.insert(ac);
+      addDependencyEdge(precursor, ac);
     } else {
-      //no new dependency, but not an initial action
+      registerAction(ac);
     }
   }
 }
@@ -351,9 +436,14 @@ DagCollectiveActor::addCommDependency(Action* precursor, Action *ac)
 void
 DagCollectiveActor::rankResolved(int global_rank, int comm_rank)
 {
-  Action ac(Action::resolve, 0, comm_rank);
-  ac.phys_partner = global_rank;
-  clearDependencies(&ac);
+  uint32_t idx = dag_->find(Action::messageId(Action::resolve, 0, comm_rank));
+  if (idx == Action::no_index || states_[idx] == done){
+    return;
+  }
+  Action* ac = action(idx);
+  ac->phys_partner = global_rank;
+  states_[idx] = done;
+  clearDependencies(ac);
 }
 
 void
@@ -366,33 +456,121 @@ DagCollectiveActor::addDependency(Action* precursor, Action *ac)
       break;
     default:
       if (precursor){
-        addDependencyToMap(precursor->id, ac);
-      } else if (ac->join_counter == 0){
-        initial_actions_.insert(ac);
+        addDependencyEdge(precursor, ac);
       } else {
-        //no new dependency, but not an initial action
+        registerAction(ac);
       }
     break;
   }
 }
 
+static void
+deleteAction(Action* ac)
+{
+  switch (ac->type){
+    case Action::send:
+      delete static_cast<SendAction*>(ac);
+      break;
+    case Action::recv:
+      delete static_cast<RecvAction*>(ac);
+      break;
+    case Action::shuffle:
+      delete static_cast<ShuffleAction*>(ac);
+      break;
+    default:
+      delete ac;
+      break;
+  }
+}
+
+std::shared_ptr<CollectiveDag>
+DagCollectiveActor::flattenDag()
+{
+  auto dag = std::make_shared<CollectiveDag>();
+  uint32_t num_actions = dag_build_.size();
+  dag->needs_resolve = !resolve_actions_.empty();
+
+  //bucket the edges by precursor so successors are contiguous
+  dag->succ_offsets.assign(num_actions + 1, 0);
+  for (auto& edge : dag_edges_){
+    dag->succ_offsets[edge.first + 1]++;
+  }
+  for (uint32_t i=0; i < num_actions; ++i){
+    dag->succ_offsets[i+1] += dag->succ_offsets[i];
+  }
+  dag->succ.resize(dag_edges_.size());
+  std::vector<uint32_t> next_succ(dag->succ_offsets.begin(), dag->succ_offsets.end() - 1);
+  for (auto& edge : dag_edges_){
+    dag->succ[next_succ[edge.first]++] = edge.second;
+  }
+
+  dag->actions.resize(num_actions);
+  dag->next_same_id.assign(num_actions, Action::no_index);
+  for (uint32_t i=0; i < num_actions; ++i){
+    Action* ac = dag_build_[i];
+    CollectiveDag::Slot& slot = dag->actions[i];
+    switch (ac->type){
+      case Action::send:
+        new (&slot.send) SendAction(*static_cast<SendAction*>(ac));
+        break;
+      case Action::recv:
+        new (&slot.recv) RecvAction(*static_cast<RecvAction*>(ac));
+        break;
+      case Action::shuffle:
+        new (&slot.shuffle) ShuffleAction(*static_cast<ShuffleAction*>(ac));
+        break;
+      default:
+        new (&slot.base) Action(*ac);
+        break;
+    }
+    slot.base.join_counter = 0;
+
+    auto inserted = dag->id_index.emplace(ac->id, i);
+    if (!inserted.second){
+      dag->next_same_id[i] = inserted.first->second;
+      inserted.first->second = i;
+    }
+    deleteAction(ac);
+  }
+
+  for (auto& edge : dag_edges_){
+    dag->actions[edge.second].base.join_counter++;
+  }
+
+  for (uint32_t i=0; i < num_actions; ++i){
+    const Action& ac = dag->actions[i].base;
+    if (ac.join_counter == 0 && ac.type != Action::resolve){
+      output.output("Rank %s, collective %s adding initial %s on tag=%d",
+        rankStr().c_str(), Collective::tostr(type_), ac.toString().c_str(), tag_);
+      dag->initial.push_back(i);
+    }
+  }
+  std::sort(dag->initial.begin(), dag->initial.end(),
+            [&](uint32_t l, uint32_t r){
+    return dag->actions[l].base.id < dag->actions[r].base.id;
+  });
+
+  dag_build_.clear();
+  dag_edges_.clear();
+  resolve_actions_.clear();
+  return dag;
+}
+
 DagCollectiveActor::~DagCollectiveActor()
 {
-  std::list<Action*>::iterator it, end = completed_actions_.end();
-  for (it=completed_actions_.begin(); it != end; ++it){
-    Action* ac = *it;
-    delete ac;
+  //only left over if init never finished
+  for (Action* ac : dag_build_){
+    deleteAction(ac);
   }
-  completed_actions_.clear();
   if (slicer_) delete slicer_;
 }
 
 void
 DagCollectiveActor::checkCollectiveDone()
 {
-  output.output("Rank %s has %lu active comms, %lu pending comms, %lu initial comms",
-    rankStr().c_str(), active_comms_.size(), pending_comms_.size(), initial_actions_.size());
-  if (active_comms_.empty() && pending_comms_.empty() && initial_actions_.empty()){
+  output.output("Rank %s has %d active comms, %lu pending dependencies, %lu ready actions",
+    rankStr().c_str(), num_active_, num_pending_deps_, ready_.size() - ready_head_);
+  if (num_active_ == 0 && num_pending_deps_ == 0 && ready_head_ == ready_.size()){
     finalize();
     putDoneNotification();
   }
@@ -401,7 +579,7 @@ DagCollectiveActor::checkCollectiveDone()
 void
 DagCollectiveActor::startSend(Action* ac)
 {
-  active_comms_[ac->id] = ac;
+  activate(ac);
   reputPending(ac->id, pending_send_headers_);
   doSend(ac);
 }
@@ -445,7 +623,7 @@ DagCollectiveActor::startRecv(Action* ac)
 void
 DagCollectiveActor::doRecv(Action* ac)
 {
-  active_comms_[ac->id] = ac;
+  activate(ac);
   uint64_t byte_length = ac->nelems*type_size_;
   if (engine_->useEagerProtocol(byte_length) || engine_->useGetProtocol()){
     //I need to wait for the sender to contact me
@@ -461,33 +639,26 @@ DagCollectiveActor::deadlockCheck() const
   std::cout << SST::Hg::sprintf("  deadlocked actor %d of %d on tag %d",
     dom_me_, dom_nproc_, tag_) << std::endl;
 
-  for (Action* ac : completed_actions_){
-    std::cout << SST::Hg::sprintf("    Rank %s: completed action %s partner %d round %d",
-                      rankStr().c_str(), Action::tostr(ac->type), ac->partner, ac->round) << std::endl;
-  }
-
-  for (auto& pair : active_comms_){
-    Action* ac = pair.second;
-    std::cout << SST::Hg::sprintf("    Rank %s: active %s",
-                    rankStr().c_str(), ac->toString().c_str()) << std::endl;
-  }
-
-  for (auto& pair  : pending_comms_){
-    uint32_t id = pair.first;
-    Action::type_t ty;
-    int r, p;
-    Action::details(id, ty, r, p);
-    auto range = pending_comms_.equal_range(id);
-    if (range.first != range.second){
-      std::cout << SST::Hg::sprintf("    Rank %s: waiting on action %s partner %d round %d",
-                      rankStr().c_str(), Action::tostr(ty), p, r) << std::endl;
-    }
-
-    for (auto rit=range.first; rit != range.second; ++rit){
-      Action* ac = rit->second;
-      std::cout << SST::Hg::sprintf("      Rank %s: pending %s partner %d round %d join counter %d",
-                    rankStr().c_str(), Action::tostr(ac->type), ac->partner, ac->round, ac->join_counter)
-                << std::endl;
+  for (uint32_t i=0; i < actions_.size(); ++i){
+    const Action& ac = actions_[i].base;
+    switch (states_[i]){
+      case done:
+        std::cout << SST::Hg::sprintf("    Rank %s: completed action %s partner %d round %d",
+                          rankStr().c_str(), Action::tostr(ac.type), ac.partner, ac.round) << std::endl;
+        break;
+      case active:
+        std::cout << SST::Hg::sprintf("    Rank %s: active %s",
+                        rankStr().c_str(), ac.toString().c_str()) << std::endl;
+        break;
+      case ready:
+        std::cout << SST::Hg::sprintf("    Rank %s: ready %s",
+                        rankStr().c_str(), ac.toString().c_str()) << std::endl;
+        break;
+      default:
+        std::cout << SST::Hg::sprintf("      Rank %s: pending %s partner %d round %d join counter %d",
+                      rankStr().c_str(), Action::tostr(ac.type), ac.partner, ac.round, ac.join_counter)
+                  << std::endl;
+        break;
     }
   }
 }
@@ -527,12 +698,11 @@ DagCollectiveActor::commActionDone(Action::type_t ty, int round, int partner)
 {
   uint32_t id = Action::messageId(ty, round, partner);
 
-  active_map::iterator it = active_comms_.find(id);
-  if (it == active_comms_.end()){
+  Action* ac = activeAction(id);
+  if (ac == nullptr){
     sst_hg_abort_printf("Rank %d=%d invalid action %s for round %d, partner %d",
      my_api_->rank(), dom_me_, Action::tostr(ty), round, partner);
   }
-  Action* ac = it->second;
   commActionDone(ac);
   return ac;
 }
@@ -614,7 +784,7 @@ DagCollectiveActor::dataRecved(
     rankStr().c_str(), toString().c_str(), this, msg->round(), tag_, (void*) recv_buffer_, msg);
 
   uint32_t id = Action::messageId(Action::recv, msg->round(), msg->domSender());
-  Action* ac = active_comms_[id];
+  Action* ac = activeAction(id);
   if (ac == nullptr){
     sst_hg_throw_printf(SST::Hg::ValueError,
       "on %d, received data for unknown receive %u from %d on round %d\n%s",
@@ -631,7 +801,7 @@ DagCollectiveActor::getRecvbuffer(Action* ac_)
   RecvAction* ac = static_cast<RecvAction*>(ac_);
   void* recv_buf = ac->buf_type != RecvAction::in_place
                 ? recv_buffer_ : result_buffer_;
-  if (result_buffer_ && recv_buf == nullptr){
+  if (isNonNullBuffer(result_buffer_) && recv_buf == nullptr){
     SST::Hg::abort("working with real payload, but somehow getting a null buffer");
   }
   return sumi::Message::offset_ptr(recv_buf,ac->offset*type_size_);
@@ -714,8 +884,7 @@ DagCollectiveActor::incomingHeader(CollectiveWorkMessage* msg)
   switch(msg->protocol()){
     case CollectiveWorkMessage::eager: {
       uint32_t mid = Action::messageId(Action::recv, msg->round(), msg->domSender());
-      active_map::iterator it = active_comms_.find(mid);
-      if (it == active_comms_.end()){
+      if (activeAction(mid) == nullptr){
         output.output("Rank %s not yet ready for recv message from %s on round %d tag %d",
           rankStr().c_str(), rankStr(msg->domSender()).c_str(), msg->round(), msg->tag());
         pending_recv_headers_.insert(std::make_pair(mid, msg));
@@ -733,24 +902,22 @@ DagCollectiveActor::incomingHeader(CollectiveWorkMessage* msg)
     }
     case CollectiveWorkMessage::get: {
       uint32_t mid = Action::messageId(Action::recv, msg->round(), msg->domSender());
-      auto it = active_comms_.find(mid);
-      if (it == active_comms_.end()){
+      Action* ac = activeAction(mid);
+      if (ac == nullptr){
         output.output("Rank %s not yet ready for recv message from %s on round %d",
           rankStr().c_str(), rankStr(msg->domSender()).c_str(), msg->round());
        pending_recv_headers_.insert(std::make_pair(mid, msg));
       } else {
-        Action* ac = it->second;
         nextRoundReadyToGet(ac, msg);
       }
       break;
     }
     case CollectiveWorkMessage::put: {
       uint32_t mid = Action::messageId(Action::send, msg->round(), msg->domSender());
-      auto it = active_comms_.find(mid);
-      if (it == active_comms_.end()){
+      Action* ac = activeAction(mid);
+      if (ac == nullptr){
         pending_send_headers_.insert(std::make_pair(mid, msg));
       } else {
-        Action* ac = it->second;
         nextRoundReadyToPut(ac, msg);
       }
       break;
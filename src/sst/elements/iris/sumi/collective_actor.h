@@ -50,6 +50,9 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/communicator.h>
 #include <set>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include <stdint.h>
 //#include <sstmac/common/sstmac_config.h>
 #include <mercury/common/allocator.h>
@@ -81,6 +84,7 @@ struct Action
   int offset;
   int nelems;
   uint32_t id;
+  uint32_t dag_index;
   SST::Hg::Timestamp start;
 
   static const char*
@@ -102,6 +106,8 @@ struct Action
 
   static const uint32_t max_round = 500;
 
+  static constexpr uint32_t no_index = uint32_t(-1);
+
   static uint32_t messageId(type_t ty, int r, int p){
     //factor of two is for send or receive
     const int num_enums = 6;
@@ -124,7 +130,8 @@ struct Action
     type(ty), 
     partner(p),
     join_counter(0),
-    round(r)
+    round(r),
+    dag_index(no_index)
   {
     id = messageId(ty, r, p);
   }
@@ -207,6 +214,56 @@ struct ShuffleAction : public Action
   }
 };
 
+/**
+ * @brief Flattened form of a collective DAG. All actions live in one
+ *        contiguous array and the successors of each action are an index
+ *        range into a single edge array, so starting a collective copies
+ *        one array instead of allocating actions and filling maps.
+ *        Once built, the DAG is immutable and can be shared by every
+ *        invocation of the same collective on the same communicator.
+ */
+struct CollectiveDag
+{
+  union Slot {
+    Action base;
+    SendAction send;
+    RecvAction recv;
+    ShuffleAction shuffle;
+    Slot(){}
+  };
+
+  std::vector<Slot> actions;
+
+  /**
+   * Successors of action i are succ[succ_offsets[i]] up to succ[succ_offsets[i+1]]
+   */
+  std::vector<uint32_t> succ_offsets;
+  std::vector<uint32_t> succ;
+
+  /**
+   * Actions with no dependencies, in message id order
+   */
+  std::vector<uint32_t> initial;
+
+  /**
+   * Message id to action index. Actions sharing an id are
+   * chained through next_same_id.
+   */
+  std::unordered_map<uint32_t,uint32_t> id_index;
+  std::vector<uint32_t> next_same_id;
+
+  /**
+   * Whether any action waits on a communicator rank resolution,
+   * which ties the DAG to the actor that registered the callback
+   */
+  bool needs_resolve;
+
+  uint32_t find(uint32_t id) const {
+    auto iter = id_index.find(id);
+    return iter == id_index.end() ? Action::no_index : iter->second;
+  }
+};
+
 /**
  * @class collective_actor
  * Object that actually does the work (the actor)
@@ -363,18 +420,10 @@ class DagCollectiveActor :
 
   CollectiveDoneMessage* doneMsg() const;
 
-  void init() override {
-    initTree();
-    initDag();
-    initBuffers();
-  }
+  void init() override;
 
  private:
   template <class T, class U> using alloc = SST::Hg::threadSafeAllocator<std::pair<const T,U>>;
-  typedef std::map<uint32_t, Action*, std::less<uint32_t>,
-                   alloc<uint32_t,Action*>> active_map;
-  typedef std::multimap<uint32_t, Action*, std::less<uint32_t>,
-                   alloc<uint32_t,Action*>> pending_map;
   typedef std::multimap<uint32_t, CollectiveWorkMessage*, std::less<uint32_t>,
                    alloc<uint32_t,CollectiveWorkMessage*>> pending_msg_map;
 
@@ -388,13 +437,30 @@ class DagCollectiveActor :
     recv_buffer_(nullptr),
     result_buffer_(dst),
     type_(ty),
-    slicer_(new DefaultSlicer(type_size, fxn))
+    slicer_(new DefaultSlicer(type_size, fxn)),
+    ready_head_(0),
+    num_active_(0),
+    num_pending_deps_(0),
+    draining_(false)
   {
   }
 
   void addDependency(Action* precursor, Action* ac);
   void addAction(Action* ac);
 
+  /**
+   * @brief Actors whose DAG is fully determined by their communicator
+   *        and the value written to key return true. The flattened DAG
+   *        is then cached on the communicator and initDag only runs
+   *        for the first invocation. Any state besides the DAG itself
+   *        must be set up in initTree or initBuffers.
+   * @param key  Everything other than the communicator the DAG depends on
+   * @return Whether the DAG can be reused
+   */
+  virtual bool dagCacheKey(uint64_t& /*key*/) const {
+    return false;
+  }
+
   static bool isSharedRole(int role, int num_roles, int* my_roles){
     for (int r=0; r < num_roles; ++r){
       if (role == my_roles[r]){
@@ -412,9 +478,24 @@ class DagCollectiveActor :
 
 
   void addCommDependency(Action* precursor, Action* ac);
-  void addDependencyToMap(uint32_t id, Action* ac);
+  void addDependencyEdge(Action* precursor, Action* ac);
+  uint32_t registerAction(Action* ac);
+  std::shared_ptr<CollectiveDag> flattenDag();
   void rankResolved(int globalRank, int comm_rank) override;
 
+  Action* action(uint32_t idx) {
+    return &actions_[idx].base;
+  }
+
+  /**
+   * @return The started, not yet completed action with the given id or null
+   */
+  Action* activeAction(uint32_t id);
+
+  void activate(Action* ac);
+
+  void drainReady();
+
   void checkCollectiveDone();
 
   void putDoneNotification();
@@ -507,21 +588,27 @@ class DagCollectiveActor :
   DefaultSlicer* slicer_;
 
  private:
-  active_map active_comms_;
-  pending_map pending_comms_;
-  std::list<Action*> completed_actions_;
-  std::list<Action*> ready_actions_;
+  typedef enum { waiting=0, ready=1, active=2, done=3 } action_state_t;
 
-  pending_msg_map pending_send_headers_;
-  pending_msg_map pending_recv_headers_;
+  /** Heap actions and edges handed over by initDag, consumed by flattenDag */
+  std::vector<Action*> dag_build_;
+  std::vector<std::pair<uint32_t,uint32_t>> dag_edges_;
+  std::map<uint32_t, Action*> resolve_actions_;
 
-  struct action_compare {
-    bool operator()(Action* l, Action* r) const {
-      return l->id < r->id;
-    }
-  };
+  std::shared_ptr<const CollectiveDag> dag_;
+  std::vector<CollectiveDag::Slot> actions_;
+  std::vector<uint8_t> states_;
+
+  /** Indices of actions whose dependencies are met, started in FIFO order */
+  std::vector<uint32_t> ready_;
+  size_t ready_head_;
+
+  int num_active_;
+  size_t num_pending_deps_;
+  bool draining_;
 
-  std::set<Action*, action_compare> initial_actions_;
+  pending_msg_map pending_send_headers_;
+  pending_msg_map pending_recv_headers_;
 
 #ifdef FEATURE_TAG_SUMI_RESILIENCE
   void dense_partner_ping_failed(int dense_rank);
@@ -48,5 +48,6 @@ namespace SST::Iris::sumi {
 
 class CollectiveActor;
 class DagCollectiveActor;
+struct CollectiveDag;
 
 }
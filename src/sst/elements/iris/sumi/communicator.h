@@ -43,8 +43,11 @@ Questions? Contact sst-macro-help@sandia.gov
 */
 
 #include <iris/sumi/transport_fwd.h>
+#include <iris/sumi/collective_actor_fwd.h>
 #include <set>
 #include <map>
+#include <memory>
+#include <typeindex>
 #include <vector>
 
 #pragma once
@@ -109,6 +112,21 @@ class Communicator {
     rank_callbacks_.erase(cback);
   }
 
+  /**
+   * @brief cachedDag
+   * @param actor The type of actor that built the DAG
+   * @param key   The actor-specific shape of the DAG
+   * @return A DAG flattened by an earlier collective on this communicator, or null
+   */
+  std::shared_ptr<const CollectiveDag> cachedDag(std::type_index actor, uint64_t key) const {
+    auto iter = dag_cache_.find(std::make_pair(actor, key));
+    return iter == dag_cache_.end() ? nullptr : iter->second;
+  }
+
+  void cacheDag(std::type_index actor, uint64_t key, std::shared_ptr<const CollectiveDag> dag){
+    dag_cache_[std::make_pair(actor, key)] = std::move(dag);
+  }
+
  protected:
   Communicator(int comm_rank) :
     my_comm_rank_(comm_rank),
@@ -128,6 +146,8 @@ class Communicator {
   */
   std::set<RankCallback*> rank_callbacks_;
 
+  std::map<std::pair<std::type_index,uint64_t>, std::shared_ptr<const CollectiveDag>> dag_cache_;
+
   Communicator* smp_comm_;
   Communicator* owner_comm_;
   bool smp_balanced_;
@@ -45,6 +45,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/gather.h>
 #include <iris/sumi/communicator.h>
 #include <iris/sumi/transport.h>
+#include <mercury/common/null_buffer.h>
 
 namespace SST::Iris::sumi {
 
@@ -100,7 +101,7 @@ BtreeGatherActor::finalizeBuffers()
 void
 BtreeGatherActor::startShuffle(Action *ac)
 {
-  if (result_buffer_){
+  if (isNonNullBuffer(result_buffer_)){
     //only ever arises in weird midpoint scenarios
     int copy_size = ac->nelems * type_size_;
     int copy_offset = ac->offset * type_size_;
@@ -62,9 +62,15 @@ extern void* sst_hg_nullptr_recv;
 // all pointers between sst_hg_nullptr and this
 // are not real data
 extern void* sst_hg_nullptr_range_max;
+// skeleton mode: when set, every buffer is treated as a null buffer
+// and message payloads are never allocated, packed or copied
+extern int sst_hg_null_payloads;
+// payload allocations that still happened with sst_hg_null_payloads set
+extern uint64_t sst_hg_null_payload_allocs;
+extern uint64_t sst_hg_null_payload_alloc_bytes;
 
 static inline bool isNonNullBuffer(const void* buf){
-  if (buf){
+  if (buf && !sst_hg_null_payloads){
     //see if buffer falls in the reserved "null buffer" range
     return ( (buf < sst_hg_nullptr) || (buf >= sst_hg_nullptr_range_max) );
   } else {
@@ -76,6 +82,15 @@ static inline bool isNullBuffer(const void* buf){
   return !(isNonNullBuffer(buf));
 }
 
+// call wherever a payload buffer is allocated so that
+// allocations that escape skeleton mode can be reported
+static inline void trackPayloadAlloc(uint64_t bytes){
+  if (sst_hg_null_payloads){
+    __atomic_fetch_add(&sst_hg_null_payload_allocs, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&sst_hg_null_payload_alloc_bytes, bytes, __ATOMIC_RELAXED);
+  }
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,6 +45,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <iris/sumi/scan.h>
 #include <iris/sumi/transport.h>
 #include <iris/sumi/communicator.h>
+#include <mercury/common/null_buffer.h>
 //#include <sprockit/output.h>
 #include <mercury/common/stl_string.h>
 #include <cstring>
@@ -147,6 +148,8 @@ SimultaneousBtreeScanActor::bufferAction(void *dst_buffer, void *msg_buffer, Act
 void
 SimultaneousBtreeScanActor::startShuffle(Action * /*ac*/)
 {
+  if (isNullBuffer(result_buffer_)) return;
+
   int size = type_size_ * nelems_;
   ::memcpy(send_buffer_, result_buffer_, size);
 }
@@ -253,9 +253,12 @@ SimTransport::SimTransport(SST::Params& params, SST::Hg::App* parent, SST::Compo
   pin_delay_ = rdma_pin_latency_.ticks() || rdma_page_delay_.ticks();
   page_size_ = params.find<SST::UnitAlgebra>("rdma_page_size", "4096").getRoundedValue();
 
-//  rank_mapper_ = sstmac::sw::TaskMapping::globalMapping(sid().app_);
-//  nproc_ = rank_mapper_->nproc();
-  nproc_ = 2;
+  // mercury runs one rank per node, the job builder passes the number of
+  // nodes in the job to every app as its size
+  nproc_ = parent->params().find<int>("size", 0);
+  if (nproc_ < 1) {
+    sst_hg_abort_printf("SimTransport: app %d has no size, was it built by an HgJob?", int(sid().app_));
+  }
 
   auto qos_params = params.get_scoped_params("qos");
   auto qos_name = qos_params.find<std::string>("name", "null");
@@ -520,6 +523,7 @@ void*
 SimTransport::allocateWorkspace(uint64_t size, void* parent)
 {
   if (isNonNullBuffer(parent)){
+    trackPayloadAlloc(size);
     return ::malloc(size);
   } else {
     return sst_hg_nullptr;
@@ -545,7 +549,11 @@ CollectiveEngine::CollectiveEngine(SST::Params& params, Transport *tport) :
   eager_cutoff_ = params.find<int>("eager_cutoff", 512);
   use_put_protocol_ = params.find<bool>("use_put_protocol", false);
   alltoall_type_ = params.find<std::string>("alltoall", "bruck");
-  allgather_type_ = params.find<std::string>("allgather", "bruck");
+  allgather_type_ = params.find<std::string>("allgather", "auto");
+  allreduce_type_ = params.find<std::string>("allreduce", "auto");
+  allreduce_ring_cutoff_ = params.find<uint64_t>("allreduce_ring_cutoff", 1048576);
+  allreduce_ring_segments_ = params.find<int>("allreduce_ring_segments", 4);
+  allgather_ring_cutoff_ = params.find<uint64_t>("allgather_ring_cutoff", 131072);
 
   int default_qos = params.find<int>("default_qos", 0);
   rdma_get_qos_ = params.find<int>("collective_rdma_get_qos", default_qos);
@@ -649,12 +657,41 @@ CollectiveEngine::allreduce(void* dst, void *src, int nelems, int type_size, int
     coll = new DoNothingCollective(this, tag, cq_id, comm);
     intra_bcast->setSubsequent(coll);
   } else {
-    coll = new WilkeHalvingAllreduce(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+    coll = newAllreduce(dst, src, nelems, type_size, tag, fxn, cq_id, comm);
   }
 
   return startCollective(coll);
 }
 
+DagCollective*
+CollectiveEngine::newAllreduce(void* dst, void* src, int nelems, int type_size, int tag,
+                               reduce_fxn fxn, int cq_id, Communicator* comm)
+{
+  //the ring needs every rank to own at least one element and all of its
+  //rounds to fit in an action id, below that halving/doubling always wins
+  int nproc = comm->nproc();
+  bool ring_ok = nproc > 2 && nelems >= nproc
+      && 2*(nproc - 1) < int(Action::max_round);
+
+  bool use_ring = false;
+  if (allreduce_type_ == "ring"){
+    use_ring = ring_ok;
+  } else if (allreduce_type_ == "auto"){
+    uint64_t bytes = uint64_t(nelems) * type_size;
+    use_ring = ring_ok && bytes >= allreduce_ring_cutoff_;
+  } else if (allreduce_type_ != "wilke" && allreduce_type_ != "rabenseifner"){
+    sst_hg_abort_printf("invalid allreduce type requested: %s", allreduce_type_.c_str());
+  }
+
+  if (use_ring){
+    int segments = RingAllreduceActor::numSegments(nproc, nelems, allreduce_ring_segments_);
+    return new RingAllreduce(this, dst, src, nelems, type_size, tag, fxn, segments, cq_id, comm);
+  } else {
+    //recursive halving reduce-scatter + recursive doubling allgather (Rabenseifner)
+    return new WilkeHalvingAllreduce(this, dst, src, nelems, type_size, tag, fxn, cq_id, comm);
+  }
+}
+
 sumi::CollectiveDoneMessage*
 CollectiveEngine::reduceScatter(void* dst, void *src, int nelems, int type_size, int tag, reduce_fxn fxn,
                                   int cq_id, Communicator* comm)
@@ -759,48 +796,15 @@ CollectiveDoneMessage*
 CollectiveEngine::alltoall(void *dst, void *src, int nelems, int type_size, int tag,
                             int cq_id, Communicator* comm)
 {
-//  auto* msg = skipCollective(Collective::alltoall, cq_id, comm, dst, src, nelems, type_size, tag);
-//  if (msg) return msg;
-
-//  if (!comm) comm = global_domain_;
-
-//  //FIXME
-//  auto* fact = AllToAllCollective::getBuilderLibrary("macro");
-//  auto* builder = fact->getBuilder(alltoall_type_);
-//  if (!builder){
-//    sst_hg_abort_printf("invalid alltoall type requested: %s", allgather_type_.c_str());
-//  }
+  auto* msg = skipCollective(Collective::alltoall, cq_id, comm, dst, src, nelems, type_size, tag);
+  if (msg) return msg;
 
-//  if (comm->smpComm() && comm->smpBalanced()){
-//    int smpSize = comm->smpComm()->nproc();
-//    void* intraDst = dst ? new char[nelems*type_size*smpSize] : nullptr;
-//    int intra_tag = 1<<28 | tag;
-
-//    BtreeGather* intra = new BtreeGather(this, 0, intraDst, src, smpSize*nelems,
-//                                         type_size, intra_tag, cq_id, comm->smpComm());
-//    DagCollective* prev;
-//    if (comm->ownerComm()){
-//      int inter_tag = 2<<28 | tag;
-//      AllToAllCollective* inter = builder->create(this, dst, intraDst, smpSize*nelems,
-//                                                  type_size, inter_tag, cq_id, comm->ownerComm());
-//      intra->setSubsequent(inter);
-//      prev = inter;
-//    } else {
-//      prev = intra;
-//    }
-//    int bcast_tag = 3<<28 | tag;
-//    auto* bcast = new BinaryTreeBcastCollective(this, 0, dst, comm->nproc()*nelems,
-//                                                type_size, bcast_tag, cq_id, comm->smpComm());
-//    prev->setSubsequent(bcast);
-//    auto* final = new DoNothingCollective(this, tag, cq_id, comm);
-//    bcast->setSubsequent(final);
-//    return startCollective(intra);
-//  } else {
-//    AllToAllCollective* coll = builder->create(this, dst, src, nelems, type_size, tag, cq_id, comm);
-//    return startCollective(coll);
-//  }
-  sst_hg_abort_printf("unimplemented\n");
-  return nullptr;
+  if (!comm) comm = global_domain_;
+  if (alltoall_type_ != "bruck"){
+    sst_hg_abort_printf("invalid alltoall type requested: %s", alltoall_type_.c_str());
+  }
+  DagCollective* coll = new BruckAlltoallCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
+  return startCollective(coll);
 }
 
 CollectiveDoneMessage*
@@ -819,57 +823,32 @@ CollectiveDoneMessage*
 CollectiveEngine::allgather(void *dst, void *src, int nelems, int type_size, int tag,
                              int cq_id, Communicator* comm)
 {
-// auto* msg = skipCollective(Collective::allgather, cq_id, comm, dst, src, nelems, type_size, tag);
-// if (msg) return msg;
-
-//  if (!comm) comm = global_domain_;
-
-//  //FIXME
-//  auto* fact = AllgatherCollective::getBuilderLibrary("macro");
-//  if (!fact){
-//    sst_hg_abort_printf("No allgather collective algorithms registered!");
-//  }
-
-//  auto* builder = fact->getBuilder(allgather_type_);
-//  if (!builder){
-//    sst_hg_abort_printf("invalid allgather type requested: %s", allgather_type_.c_str());
-//  }
-
-//  if (comm->smpComm() && comm->smpBalanced()){
-//    int smpSize = comm->smpComm()->nproc();
-//    void* intraDst = dst ? new char[nelems*type_size*smpSize] : nullptr;
-
-//    int intra_tag = 1<<28 | tag;
-
-
+  auto* msg = skipCollective(Collective::allgather, cq_id, comm, dst, src, nelems, type_size, tag);
+  if (msg) return msg;
 
-//    AllgatherCollective* intra = builder->create(this, intraDst, src, nelems,
-//                                                 type_size, intra_tag, cq_id, comm->smpComm());
+  if (!comm) comm = global_domain_;
 
-//    DagCollective* prev;
-//    if (comm->ownerComm()){
-//      int inter_tag = 2<<28 | tag;
+  //Bruck takes log(P) rounds but forwards data several times, the ring
+  //moves every byte once and only talks to neighbors
+  int nproc = comm->nproc();
+  bool ring_ok = nproc - 1 < int(Action::max_round);
+  bool use_ring = false;
+  if (allgather_type_ == "ring"){
+    use_ring = ring_ok;
+  } else if (allgather_type_ == "auto"){
+    uint64_t bytes = uint64_t(nelems) * type_size * nproc;
+    use_ring = ring_ok && bytes >= allgather_ring_cutoff_;
+  } else if (allgather_type_ != "bruck"){
+    sst_hg_abort_printf("invalid allgather type requested: %s", allgather_type_.c_str());
+  }
 
-//      AllgatherCollective* inter = builder->create(this, dst, intraDst, smpSize*nelems, type_size,
-//                                                   inter_tag, cq_id, comm->ownerComm());
-//      intra->setSubsequent(inter);
-//      prev = inter;
-//    } else {
-//      prev = intra;
-//    }
-//    int bcast_tag = 3<<28 | tag;
-//    auto* bcast = new BinaryTreeBcastCollective(this, 0, dst, comm->nproc()*nelems,
-//                                                type_size, bcast_tag, cq_id, comm->smpComm());
-//    prev->setSubsequent(bcast);
-//    auto* final = new DoNothingCollective(this, tag, cq_id, comm);
-//    bcast->setSubsequent(final);
-//    return startCollective(intra);
-//  } else {
-//    AllgatherCollective* coll = builder->create(this, dst, src, nelems, type_size, tag, cq_id, comm);
-//    return startCollective(coll);
-//  }
-  sst_hg_abort_printf("unimplemented\n");
-  return nullptr;
+  DagCollective* coll;
+  if (use_ring){
+    coll = new RingAllgatherCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
+  } else {
+    coll = new BruckAllgatherCollective(this, dst, src, nelems, type_size, tag, cq_id, comm);
+  }
+  return startCollective(coll);
 }
 
 CollectiveDoneMessage*
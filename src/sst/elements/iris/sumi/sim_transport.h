@@ -104,7 +104,7 @@ class SimTransport : public Transport, public SST::Hg::API {
     SST_ELI_ELEMENT_VERSION(1,0,0),
     "provides the SUMI transport API")
 
-  using DefaultProgressQueue = SST::Hg::MultiProgressQueue<Message>;
+  using DefaultProgressQueue = SST::Hg::IndexedProgressQueue<Message>;
 
   SimTransport(SST::Params& params, SST::Hg::App* parent, SST::Component* comp);
 
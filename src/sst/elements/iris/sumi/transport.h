@@ -530,6 +530,9 @@ class CollectiveEngine
 
   CollectiveDoneMessage* deliverPending(Collective* coll, int tag, Collective::type_t ty);
 
+  DagCollective* newAllreduce(void* dst, void* src, int nelems, int type_size, int tag,
+                              reduce_fxn fxn, int cq_id, Communicator* comm);
+
  private:
   Transport* tport_;
 
@@ -557,6 +560,15 @@ class CollectiveEngine
   std::string alltoall_type_;
   std::string allgather_type_;
 
+  /** wilke (recursive halving/doubling), ring, or auto to pick by size */
+  std::string allreduce_type_;
+  /** in auto mode, allreduce buffers of at least this many bytes use the ring */
+  uint64_t allreduce_ring_cutoff_;
+  /** pieces each ring chunk is cut into so neighbors can forward while receiving */
+  int allreduce_ring_segments_;
+  /** in auto mode, allgather results of at least this many bytes use the ring */
+  uint64_t allgather_ring_cutoff_;
+
   int rdma_header_qos_;
   int rdma_get_qos_;
   int smsg_qos_;
@@ -98,6 +98,8 @@ extern "C" int mask_mpi_irecv(void *buf, int count, MPI_Datatype datatype, int s
 extern "C" int mask_mpi_recv_init(void *buf, int count, MPI_Datatype datatype,
       int source, int tag, MPI_Comm comm, MPI_Request *request){ return SST::MASKMPI::mask_mpi()->recvInit(buf,count,datatype,source,tag,comm,request); }
 extern "C" int mask_mpi_request_free(MPI_Request* req){ return SST::MASKMPI::mask_mpi()->request_free(req); }
+extern "C" int mask_mpi_cancel(MPI_Request* req){ return SST::MASKMPI::mask_mpi()->cancel(req); }
+extern "C" int mask_mpi_test_cancelled(const MPI_Status* status, int* flag){ return SST::MASKMPI::mask_mpi()->testCancelled(status,flag); }
 extern "C" int mask_mpi_start(MPI_Request* req){ return SST::MASKMPI::mask_mpi()->start(req); }
 extern "C" int mask_mpi_startall(int count, MPI_Request* req){ return SST::MASKMPI::mask_mpi()->startall(count,req); }
 extern "C" int mask_mpi_wait(MPI_Request *request, MPI_Status *status){ return SST::MASKMPI::mask_mpi()->wait(request,status); }
@@ -260,6 +260,10 @@ class MpiApi : public SST::Iris::sumi::SimTransport
 
   int request_free(MPI_Request* req);
 
+  int cancel(MPI_Request* req);
+
+  int testCancelled(const MPI_Status* status, int* flag);
+
   int start(MPI_Request* req);
 
   int startall(int count, MPI_Request* req);
@@ -142,7 +142,7 @@ MpiApi::startMpiCollective(Iris::sumi::Collective::type_t ty,
   op->packed_recv = false;
   op->packed_send = false;
 
-  if (op->sendbuf && !op->sendtype->contiguous()){
+  if (isNonNullBuffer(op->sendbuf) && !op->sendtype->contiguous()){
     void* newbuf = allocateTempPackBuffer(op->sendcnt, op->sendtype);
     op->sendtype->packSend(op->sendbuf, newbuf, op->sendcnt);
     op->tmp_sendbuf = newbuf;
@@ -151,7 +151,7 @@ MpiApi::startMpiCollective(Iris::sumi::Collective::type_t ty,
     op->tmp_sendbuf = op->sendbuf;
   }
 
-  if (op->recvbuf && !op->recvtype->contiguous()){
+  if (isNonNullBuffer(op->recvbuf) && !op->recvtype->contiguous()){
     void* newbuf = allocateTempPackBuffer(op->recvcnt, op->recvtype);
     op->tmp_recvbuf = newbuf;
     op->packed_recv = true;
@@ -165,6 +165,7 @@ MpiApi::startMpiCollective(Iris::sumi::Collective::type_t ty,
 void*
 MpiApi::allocateTempPackBuffer(int count, MpiType* type)
 {
+  trackPayloadAlloc(type->packed_size()*count);
   char* newbuf = new char[type->packed_size()*count];
   return newbuf;
 }
@@ -44,6 +44,7 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <mpi_api.h>
 #include <mpi_queue/mpi_queue.h>
+#include <mpi_queue/mpi_queue_recv_request.h>
 //#include <sumi-mpi/otf2_output_stat.h>
 #include <mercury/components/operating_system.h>
 #include <mercury/operating_system/process/thread.h>
@@ -66,7 +67,7 @@ Questions? Contact sst-macro-help@sandia.gov
 namespace SST::MASKMPI {
 
 static struct MPI_Status proc_null_status = {
-  MPI_PROC_NULL, MPI_ANY_TAG, 0, 0, 0
+  MPI_PROC_NULL, MPI_ANY_TAG, 0, 0, 0, 0
 };
 
 int
@@ -171,6 +172,28 @@ MpiApi::request_free(MPI_Request *req)
   return MPI_SUCCESS;
 }
 
+int
+MpiApi::cancel(MPI_Request *req)
+{
+  //only a receive still waiting in the posted queue can be cancelled,
+  //anything already matched or sent completes normally
+  MpiRequest* reqPtr = getRequest(*req);
+  MpiQueueRecvRequest* posted = reqPtr ? reqPtr->postedRecv() : nullptr;
+  if (posted){
+    posted->cancel();
+    reqPtr->setPostedRecv(nullptr);
+    reqPtr->cancel();
+  }
+  return MPI_SUCCESS;
+}
+
+int
+MpiApi::testCancelled(const MPI_Status *status, int *flag)
+{
+  *flag = status->cancelled;
+  return MPI_SUCCESS;
+}
+
 void
 MpiApi::doStart(MPI_Request req)
 {
@@ -207,6 +207,10 @@ MpiCommFactory::commSplit(MpiComm* caller, int my_color, int my_key)
   //       caller->rank(), next_id_, my_color, my_key);
 
 #if SST_HG_DISTRIBUTED_MEMORY && !SST_HG_MMAP_COLLECTIVES
+  //the split keys only exist in the payload of this allgather
+  if (sst_hg_null_payloads){
+    sst_hg_abort_printf("MPI_Comm_split cannot exchange keys across processes with null_payloads set");
+  }
   int* result = new int[3*caller->size()];
   parent_->allgather(&mydata, 3, MPI_INT,
                      result, 3, MPI_INT,
@@ -79,6 +79,7 @@ MpiMessage::buildStatus(MPI_Status* stat) const
   stat->MPI_TAG = tag_;
   stat->count = count();
   stat->bytes_received = payloadSize();
+  stat->cancelled = 0;
 }
 
 std::string
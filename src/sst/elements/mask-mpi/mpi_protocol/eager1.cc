@@ -83,7 +83,8 @@ Eager1::incomingHeader(MpiMessage* msg)
 {
   char* send_buf = (char*) msg->partnerBuffer();
   char* recv_buf = nullptr;
-  if (send_buf){
+  if (isNonNullBuffer(send_buf)){
+    trackPayloadAlloc(msg->payloadSize());
     recv_buf = new char[msg->payloadSize()];
   }
   msg->advanceStage();
@@ -59,6 +59,7 @@ void*
 MpiProtocol::fillSendBuffer(int count, void* buffer, MpiType* typeobj)
 {
   uint64_t length = count * typeobj->packed_size();
+  trackPayloadAlloc(length);
   void* eager_buf = new char[length];
   if (typeobj->contiguous()){
     ::memcpy(eager_buf, buffer, length);
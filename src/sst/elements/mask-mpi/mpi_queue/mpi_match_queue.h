@@ -0,0 +1,224 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#include <mpi_types.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#pragma once
+
+namespace SST::MASKMPI {
+
+struct MpiMatchKey {
+  MPI_Comm comm;
+  int src;
+  int tag;
+
+  bool operator==(const MpiMatchKey& other) const {
+    return comm == other.comm && src == other.src && tag == other.tag;
+  }
+};
+
+struct MpiMatchKeyHash {
+  size_t operator()(const MpiMatchKey& key) const {
+    uint64_t h = (uint64_t(uint32_t(key.src)) << 32) | uint32_t(key.tag);
+    h ^= uint64_t(uint32_t(key.comm)) * 0x9e3779b97f4a7c15ULL;
+    return h ^ (h >> 29);
+  }
+};
+
+/**
+ * Entries that match on a (comm, source, tag) which may use MPI_ANY_SOURCE
+ * or MPI_ANY_TAG, i.e. posted receives and probes. Each entry lives in the
+ * bucket for its own key and carries a post sequence number. An incoming
+ * message can only match the four buckets for its exact, any-source,
+ * any-tag and fully wildcarded keys, and among those the earliest posted
+ * entry wins so MPI ordering is preserved.
+ */
+template <class T>
+class MpiPostedMatchQueue
+{
+ public:
+  MpiPostedMatchQueue() : next_seq_(0), size_(0) {}
+
+  void push(T t, MPI_Comm comm, int src, int tag) {
+    buckets_[MpiMatchKey{comm, src, tag}].emplace_back(next_seq_++, t);
+    ++size_;
+  }
+
+  /**
+   * @brief popFirst Remove the earliest entry matching a message
+   * @param stale Entries for which this returns true are dropped rather than matched
+   * @return The matched entry or nullptr
+   */
+  template <class Stale>
+  T popFirst(MPI_Comm comm, int src, int tag, Stale stale) {
+    bucket_t* best = nullptr;
+    MpiMatchKey best_key;
+    for (auto& key : candidates(comm, src, tag)) {
+      auto it = buckets_.find(key);
+      if (it == buckets_.end()) continue;
+      bucket_t& bucket = it->second;
+      while (!bucket.empty() && stale(bucket.front().second)) {
+        bucket.pop_front();
+        --size_;
+      }
+      if (bucket.empty()) {
+        buckets_.erase(it);
+      } else if (!best || bucket.front().first < best->front().first) {
+        best = &bucket;
+        best_key = key;
+      }
+    }
+    if (!best) return nullptr;
+
+    T t = best->front().second;
+    best->pop_front();
+    --size_;
+    if (best->empty()) buckets_.erase(best_key);
+    return t;
+  }
+
+  /**
+   * @brief popAll Remove every entry matching a message and pass them,
+   *        in the order they were posted, to fn
+   */
+  template <class Fn>
+  void popAll(MPI_Comm comm, int src, int tag, Fn fn) {
+    if (size_ == 0) return;
+    std::vector<std::pair<uint64_t,T>> matched;
+    for (auto& key : candidates(comm, src, tag)) {
+      auto it = buckets_.find(key);
+      if (it == buckets_.end()) continue;
+      matched.insert(matched.end(), it->second.begin(), it->second.end());
+      buckets_.erase(it);
+    }
+    size_ -= matched.size();
+    std::sort(matched.begin(), matched.end(),
+      [](const std::pair<uint64_t,T>& a, const std::pair<uint64_t,T>& b){ return a.first < b.first; });
+    for (auto& pair : matched) {
+      fn(pair.second);
+    }
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  typedef std::deque<std::pair<uint64_t,T>> bucket_t;
+
+  static std::array<MpiMatchKey,4> candidates(MPI_Comm comm, int src, int tag) {
+    return {{ MpiMatchKey{comm, src, tag}, MpiMatchKey{comm, MPI_ANY_SOURCE, tag},
+             MpiMatchKey{comm, src, MPI_ANY_TAG}, MpiMatchKey{comm, MPI_ANY_SOURCE, MPI_ANY_TAG} }};
+  }
+
+  uint64_t next_seq_;
+  size_t size_;
+  std::unordered_map<MpiMatchKey, bucket_t, MpiMatchKeyHash> buckets_;
+};
+
+/**
+ * Entries with a concrete (comm, source, tag), i.e. unexpected messages,
+ * searched by patterns that may use MPI_ANY_SOURCE or MPI_ANY_TAG. Each
+ * entry is indexed under its exact key and the three wildcard keys that
+ * cover it, each index ordered by arrival, so any receive or probe finds
+ * its earliest match with a single lookup.
+ */
+template <class T>
+class MpiUnexpectedMatchQueue
+{
+ public:
+  MpiUnexpectedMatchQueue() : next_seq_(0) {}
+
+  void push(T t, MPI_Comm comm, int src, int tag) {
+    uint64_t seq = next_seq_++;
+    seqnums_[t] = seq;
+    for (auto& key : indices(comm, src, tag)) {
+      index_[key].emplace(seq, t);
+    }
+  }
+
+  /**
+   * @brief front The earliest entry matching a (possibly wildcarded) pattern
+   * @return The entry or nullptr
+   */
+  T front(MPI_Comm comm, int src, int tag) const {
+    auto it = index_.find(MpiMatchKey{comm, src, tag});
+    return it == index_.end() ? nullptr : it->second.begin()->second;
+  }
+
+  void erase(T t, MPI_Comm comm, int src, int tag) {
+    auto seq_it = seqnums_.find(t);
+    for (auto& key : indices(comm, src, tag)) {
+      auto it = index_.find(key);
+      it->second.erase(seq_it->second);
+      if (it->second.empty()) index_.erase(it);
+    }
+    seqnums_.erase(seq_it);
+  }
+
+  size_t size() const {
+    return seqnums_.size();
+  }
+
+ private:
+  static std::array<MpiMatchKey,4> indices(MPI_Comm comm, int src, int tag) {
+    return {{ MpiMatchKey{comm, src, tag}, MpiMatchKey{comm, MPI_ANY_SOURCE, tag},
+             MpiMatchKey{comm, src, MPI_ANY_TAG}, MpiMatchKey{comm, MPI_ANY_SOURCE, MPI_ANY_TAG} }};
+  }
+
+  uint64_t next_seq_;
+  std::unordered_map<T, uint64_t> seqnums_;
+  std::unordered_map<MpiMatchKey, std::map<uint64_t,T>, MpiMatchKeyHash> index_;
+};
+
+}
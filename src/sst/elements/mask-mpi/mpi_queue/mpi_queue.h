@@ -60,6 +60,7 @@ Questions? Contact sst-macro-help@sandia.gov
 
 #include <mpi_queue/mpi_queue_recv_request_fwd.h>
 #include <mpi_queue/mpi_queue_probe_request.h>
+#include <mpi_queue/mpi_match_queue.h>
 
 #include <sst/core/params.h>
 
@@ -81,7 +82,7 @@ class MpiQueue
   friend class DirectPut;
   friend class MpiQueueRecvRequest;
 
-  using progress_queue = SST::Hg::MultiProgressQueue<SST::Iris::sumi::Message>;
+  using progress_queue = SST::Hg::IndexedProgressQueue<SST::Iris::sumi::Message>;
 
  public:
   MpiQueue(SST::Params& params, int TaskId,
@@ -190,13 +191,14 @@ class MpiQueue
   std::unordered_map<TaskId, hold_list_t> held_;
 
   /// Inbound messages waiting for a matching receive request.
-  std::list<MpiMessage*> need_recv_match_;
-  std::list<MpiQueueRecvRequest*> need_send_match_;
+  MpiUnexpectedMatchQueue<MpiMessage*> need_recv_match_;
+  /// Posted receive requests waiting for a matching message.
+  MpiPostedMatchQueue<MpiQueueRecvRequest*> need_send_match_;
 
   std::vector<MpiProtocol*> protocols_;
 
   /// Probe requests watching
-  std::list<SST::MASKMPI::mpi_queue_probe_request*> probelist_;
+  MpiPostedMatchQueue<SST::MASKMPI::mpi_queue_probe_request*> probelist_;
 
   progress_queue queue_;
 
@@ -71,9 +71,13 @@ MpiQueueRecvRequest::MpiQueueRecvRequest(
   count_(count), 
   type_(queue->api()->typeFromId(type)),
   key_(key), 
-  start_(start) 
+  start_(start),
+  cancelled_(false)
 {
-  if (isNonNullBuffer(buffer) && !type_->contiguous()){
+  if (isNullBuffer(buffer)){
+    //nothing will be copied in, leave recv_buffer_ null
+  } else if (!type_->contiguous()){
+    trackPayloadAlloc(count*type_->packed_size());
     recv_buffer_ = new char[count*type_->packed_size()];
   } else {
     recv_buffer_ = (char*) final_buffer_;
@@ -84,11 +88,6 @@ MpiQueueRecvRequest::~MpiQueueRecvRequest()
 {
 }
 
-bool
-MpiQueueRecvRequest::isCancelled() const {
-  return key_ && key_->isCancelled();
-}
-
 bool
 MpiQueueRecvRequest::matches(MpiMessage* msg)
 {
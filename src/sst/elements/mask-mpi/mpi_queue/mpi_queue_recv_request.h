@@ -81,7 +81,18 @@ class MpiQueueRecvRequest  {
     return start_;
   }
 
-  bool isCancelled() const;
+  /**
+   * @brief cancel Detach from the MPI request, which completes as cancelled.
+   *        The queue drops this receive when it next reaches it.
+   */
+  void cancel() {
+    cancelled_ = true;
+    key_ = nullptr;
+  }
+
+  bool isCancelled() const {
+    return cancelled_;
+  }
 
  private:
   /// The queue to whom we belong.
@@ -104,6 +115,7 @@ class MpiQueueRecvRequest  {
   MpiType* type_;
   MpiRequest* key_;
   SST::Hg::Timestamp start_;
+  bool cancelled_;
 };
 
 }
@@ -46,6 +46,7 @@ Questions? Contact sst-macro-help@sandia.gov
 #include <mpi_status.h>
 #include <mpi_message.h>
 #include <mpi_comm/mpi_comm_fwd.h>
+#include <mpi_queue/mpi_queue_recv_request_fwd.h>
 //#include <sstmac/common/sstmac_config.h>
 
 #pragma once
@@ -157,6 +158,7 @@ class MpiRequest :
    complete_(false),
    cancelled_(false),
    optype_(ty),
+   posted_recv_(nullptr),
    persistent_op_(nullptr),
    collective_op_(nullptr)
   {
@@ -182,6 +184,7 @@ class MpiRequest :
 
   void cancel() {
     cancelled_ = true;
+    stat_.cancelled = 1;
     complete();
   }
 
@@ -222,6 +225,15 @@ class MpiRequest :
     return cancelled_;
   }
 
+  /** The receive sitting in the posted queue for this request, if it is still unmatched */
+  MpiQueueRecvRequest* postedRecv() const {
+    return posted_recv_;
+  }
+
+  void setPostedRecv(MpiQueueRecvRequest* req) {
+    posted_recv_ = req;
+  }
+
   bool isPersistent() const {
     return persistent_op_;
   }
@@ -252,6 +264,7 @@ class MpiRequest :
   bool cancelled_;
   op_type_t optype_;
 
+  MpiQueueRecvRequest* posted_recv_;
   PersistentOp* persistent_op_;
   CollectiveOpBase::ptr collective_op_;
 
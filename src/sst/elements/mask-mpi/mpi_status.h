@@ -54,6 +54,7 @@ typedef struct {
   int MPI_ERROR;
   int count;
   int bytes_received;
+  int cancelled;
 #ifdef __cplusplus
 };
 #else
@@ -0,0 +1,160 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+
+#define ssthg_app_name collectives
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mask_mpi.h>
+#include <mercury/common/skeleton.h>
+
+// Checks collective results on both sides of the algorithm cutoffs. The
+// test config runs four ranks with the ring cutoffs at 4 KiB, so SMALL
+// runs recursive halving and Bruck while LARGE runs the allreduce and
+// allgather rings. Every collective runs again at the same sizes with
+// different data, so a DAG or buffer reused from the first call must
+// still give the right answer.
+
+#define SMALL 16
+#define LARGE 2048
+#define CALLS 2
+
+static void report(int rank, const char* what, int n, int call, int bad, int expected, int got)
+{
+  if (bad < 0){
+    printf("PASS: rank %d %s count %d call %d\n", rank, what, n, call);
+  } else {
+    printf("FAIL: rank %d %s count %d call %d element %d expected %d got %d\n",
+           rank, what, n, call, bad, expected, got);
+  }
+}
+
+static void allreduce(int rank, int size, int n, int call)
+{
+  int* send = (int*) malloc(n*sizeof(int));
+  int* recv = (int*) malloc(n*sizeof(int));
+  for (int i=0; i < n; ++i){
+    send[i] = (rank + 1) * (i + 1) + call;
+    recv[i] = -1;
+  }
+  MPI_Allreduce(send, recv, n, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  int bad = -1, expected = 0;
+  for (int i=0; i < n && bad < 0; ++i){
+    expected = size * (size + 1) / 2 * (i + 1) + size * call;
+    if (recv[i] != expected) bad = i;
+  }
+  report(rank, "MPI_Allreduce", n, call, bad, expected, bad < 0 ? 0 : recv[bad]);
+  free(send);
+  free(recv);
+}
+
+static void allgather(int rank, int size, int n, int call)
+{
+  int* send = (int*) malloc(n*sizeof(int));
+  int* recv = (int*) malloc(n*size*sizeof(int));
+  for (int i=0; i < n; ++i){
+    send[i] = (call*size + rank) * n + i;
+  }
+  for (int i=0; i < n*size; ++i){
+    recv[i] = -1;
+  }
+  MPI_Allgather(send, n, MPI_INT, recv, n, MPI_INT, MPI_COMM_WORLD);
+
+  //block r holds rank r's data, so element i of the result is i past the call's base
+  int bad = -1;
+  for (int i=0; i < n*size && bad < 0; ++i){
+    if (recv[i] != call*n*size + i) bad = i;
+  }
+  report(rank, "MPI_Allgather", n, call, bad, call*n*size + bad, bad < 0 ? 0 : recv[bad]);
+  free(send);
+  free(recv);
+}
+
+static void alltoall(int rank, int size, int n, int call)
+{
+  int* send = (int*) malloc(n*size*sizeof(int));
+  int* recv = (int*) malloc(n*size*sizeof(int));
+  for (int dst=0; dst < size; ++dst){
+    for (int i=0; i < n; ++i){
+      send[dst*n + i] = ((call*size + rank)*size + dst)*n + i;
+      recv[dst*n + i] = -1;
+    }
+  }
+  MPI_Alltoall(send, n, MPI_INT, recv, n, MPI_INT, MPI_COMM_WORLD);
+
+  int bad = -1, expected = 0;
+  for (int src=0; src < size && bad < 0; ++src){
+    for (int i=0; i < n && bad < 0; ++i){
+      expected = ((call*size + src)*size + rank)*n + i;
+      if (recv[src*n + i] != expected) bad = src*n + i;
+    }
+  }
+  report(rank, "MPI_Alltoall", n, call, bad, expected, bad < 0 ? 0 : recv[bad]);
+  free(send);
+  free(recv);
+}
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  for (int call=0; call < CALLS; ++call){
+    allreduce(rank, size, SMALL, call);
+    allreduce(rank, size, LARGE, call);
+    allgather(rank, size, SMALL, call);
+    allgather(rank, size, LARGE, call);
+    alltoall(rank, size, SMALL, call);
+    alltoall(rank, size, LARGE, call);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,124 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+/*
+ * Matching microbenchmark: rank 0 posts a large number of receives with
+ * distinct tags and rank 1 sends them in reverse order, so every arriving
+ * message matches the most recently posted receive. The second phase does
+ * the same against the unexpected queue. Run with increasing counts, e.g.
+ *   time sst test_irecv_scaling.py --model-options="100000"
+ * to see how simulator run time scales with queue depth.
+ */
+
+#define ssthg_app_name irecv_scaling
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+#include <mask_mpi.h>
+#include <mercury/common/skeleton.h>
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  int nmsgs = argc > 1 ? atoi(argv[1]) : 10000;
+  void* buf = sst_hg_nullptr;
+  std::vector<MPI_Request> reqs(nmsgs);
+
+  // phase 1: deep posted receive queue
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start = MPI_Wtime();
+  if (rank == 0){
+    for (int i=0; i < nmsgs; ++i){
+      MPI_Irecv(buf, 1, MPI_INT, 1, i, MPI_COMM_WORLD, &reqs[i]);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(nmsgs, reqs.data(), MPI_STATUSES_IGNORE);
+  } else if (rank == 1){
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (int i=nmsgs-1; i >= 0; --i){
+      MPI_Send(buf, 1, MPI_INT, 0, i, MPI_COMM_WORLD);
+    }
+  } else {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+  double posted = MPI_Wtime() - start;
+
+  // phase 2: deep unexpected queue, drained with a mix of exact and wildcard receives
+  MPI_Barrier(MPI_COMM_WORLD);
+  start = MPI_Wtime();
+  if (rank == 0){
+    MPI_Barrier(MPI_COMM_WORLD);
+    for (int i=nmsgs-1; i >= 0; --i){
+      int src = i % 2 ? MPI_ANY_SOURCE : 1;
+      MPI_Recv(buf, 1, MPI_INT, src, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+  } else if (rank == 1){
+    for (int i=0; i < nmsgs; ++i){
+      MPI_Isend(buf, 1, MPI_INT, 0, i, MPI_COMM_WORLD, &reqs[i]);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(nmsgs, reqs.data(), MPI_STATUSES_IGNORE);
+  } else {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+  double unexpected = MPI_Wtime() - start;
+
+  if (rank == 0){
+    printf("%d messages: posted queue %8.4f ms, unexpected queue %8.4f ms\n",
+           nmsgs, posted*1e3, unexpected*1e3);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  MPI_Finalize();
+
+  return 0;
+}
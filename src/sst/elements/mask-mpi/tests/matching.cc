@@ -0,0 +1,217 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+#define ssthg_app_name matching
+
+#include <stdio.h>
+
+#include <mask_mpi.h>
+#include <mercury/common/skeleton.h>
+
+// Checks the MPI matching rules on the posted and unexpected queues. Rank 0
+// posts mixed exact and wildcard receives and ranks 1 and 2 send messages
+// whose payload says which receive they must land in. Receives are posted
+// before a barrier, so every message arrives with all of them posted.
+// Blocking probes are checked one at a time, an app thread cannot have
+// more than one outstanding.
+
+#define NONE -1
+
+static int check(const char* what, int n, const int* got, const int* expected)
+{
+  for (int i=0; i < n; ++i){
+    if (got[i] != expected[i]){
+      printf("FAIL: %s receive %d expected %d got %d\n", what, i, expected[i], got[i]);
+      return 1;
+    }
+  }
+  printf("PASS: %s\n", what);
+  return 0;
+}
+
+static void postAll(int n, const int* srcs, const int* tags, int* bufs, MPI_Request* reqs)
+{
+  for (int i=0; i < n; ++i){
+    bufs[i] = NONE;
+    MPI_Irecv(&bufs[i], 1, MPI_INT, srcs[i], tags[i], MPI_COMM_WORLD, &reqs[i]);
+  }
+}
+
+static void sendAll(int n, const int* tags, const int* payloads)
+{
+  for (int i=0; i < n; ++i){
+    MPI_Send(&payloads[i], 1, MPI_INT, 0, tags[i], MPI_COMM_WORLD);
+  }
+}
+
+// A message goes to the earliest posted receive it matches, whichever of
+// the exact, any-source, any-tag or fully wildcarded buckets holds it
+static void earliestPosted(int rank)
+{
+  const int n = 5;
+  int srcs[n] = { 1, MPI_ANY_SOURCE, 1, MPI_ANY_SOURCE, 1 };
+  int tags[n] = { 5, 5, MPI_ANY_TAG, MPI_ANY_TAG, 5 };
+  int sent_tags[n] = { 5, 5, 5, 5, 5 };
+  int payloads[n] = { 100, 101, 102, 103, 104 };
+  int bufs[n];
+  MPI_Request reqs[n];
+
+  if (rank == 0) postAll(n, srcs, tags, bufs, reqs);
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (rank == 1) sendAll(n, sent_tags, payloads);
+  if (rank == 0){
+    MPI_Waitall(n, reqs, MPI_STATUSES_IGNORE);
+    check("earliest posted receive wins", n, bufs, payloads);
+  }
+}
+
+// Messages with different tags skip receives they do not match, and the
+// ones they do match are still taken in post order
+static void mixedTags(int rank)
+{
+  const int n = 4;
+  int srcs[n] = { MPI_ANY_SOURCE, 1, 1, MPI_ANY_SOURCE };
+  int tags[n] = { 7, MPI_ANY_TAG, 7, MPI_ANY_TAG };
+  int sent_tags[n] = { 8, 7, 7, 9 };
+  int payloads[n] = { 200, 201, 202, 203 };
+  //tag 8 skips the tag 7 receive, the two tag 7 messages fill 0 and 2 in order
+  int expected[n] = { 201, 200, 202, 203 };
+  int bufs[n];
+  MPI_Request reqs[n];
+
+  if (rank == 0) postAll(n, srcs, tags, bufs, reqs);
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (rank == 1) sendAll(n, sent_tags, payloads);
+  if (rank == 0){
+    MPI_Waitall(n, reqs, MPI_STATUSES_IGNORE);
+    check("mixed tags match in post order", n, bufs, expected);
+  }
+}
+
+// A cancelled receive completes as cancelled, is never matched, and the
+// message goes to the next receive, in the same bucket or another one
+static void cancelled(int rank)
+{
+  const int n = 4;
+  int srcs[n] = { 1, MPI_ANY_SOURCE, MPI_ANY_SOURCE, 1 };
+  int tags[n] = { 11, 11, MPI_ANY_TAG, 12 };
+  int sent_tags[2] = { 11, 12 };
+  int payloads[2] = { 300, 301 };
+  int expected[n] = { NONE, 300, NONE, 301 };
+  int bufs[n];
+  MPI_Request reqs[n];
+
+  if (rank == 0){
+    postAll(n, srcs, tags, bufs, reqs);
+    MPI_Cancel(&reqs[0]);
+    MPI_Cancel(&reqs[2]);
+    int flags[n];
+    for (int i=0; i < n; i += 2){
+      MPI_Status status;
+      MPI_Wait(&reqs[i], &status);
+      MPI_Test_cancelled(&status, &flags[i]);
+      if (!flags[i]){
+        printf("FAIL: cancelled receive %d did not complete as cancelled\n", i);
+      }
+    }
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (rank == 1) sendAll(2, sent_tags, payloads);
+  if (rank == 0){
+    MPI_Wait(&reqs[1], MPI_STATUS_IGNORE);
+    MPI_Wait(&reqs[3], MPI_STATUS_IGNORE);
+    check("cancelled receives are dropped", n, bufs, expected);
+  }
+}
+
+// Unexpected messages are matched and probed in arrival order per sender,
+// through both the exact and the wildcard indices
+static void unexpected(int rank)
+{
+  int sent_tags[3] = { 21, 22, 21 };
+  int payloads[3] = { 400, 401, 402 };
+  int other = 403;
+
+  if (rank == 1) sendAll(3, sent_tags, payloads);
+  if (rank == 2) MPI_Send(&other, 1, MPI_INT, 0, 21, MPI_COMM_WORLD);
+  if (rank == 0){
+    const int n = 8;
+    int got[n];
+    int expected[n] = { 21, 401, 21, 400, 402, 21, 2, 403 };
+    MPI_Status status;
+
+    MPI_Probe(1, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+    got[0] = status.MPI_TAG;
+    MPI_Recv(&got[1], 1, MPI_INT, 1, 22, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Probe(MPI_ANY_SOURCE, 21, MPI_COMM_WORLD, &status);
+    got[2] = status.MPI_TAG;
+    //rank 2's message may have arrived first, receive rank 1's in order by source
+    MPI_Recv(&got[3], 1, MPI_INT, 1, MPI_ANY_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(&got[4], 1, MPI_INT, 1, 21, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+    got[5] = status.MPI_TAG;
+    got[6] = status.MPI_SOURCE;
+    MPI_Recv(&got[7], 1, MPI_INT, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    check("unexpected messages match and probe in order", n, got, expected);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  earliestPosted(rank);
+  MPI_Barrier(MPI_COMM_WORLD);
+  mixedTags(rank);
+  MPI_Barrier(MPI_COMM_WORLD);
+  cancelled(rank);
+  MPI_Barrier(MPI_COMM_WORLD);
+  unexpected(rank);
+
+  MPI_Finalize();
+  return 0;
+}
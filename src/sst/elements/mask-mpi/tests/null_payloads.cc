@@ -0,0 +1,148 @@
+/**
+Copyright 2009-2023 National Technology and Engineering Solutions of Sandia,
+LLC (NTESS).  Under the terms of Contract DE-NA-0003525, the U.S. Government
+retains certain rights in this software.
+
+Sandia National Laboratories is a multimission laboratory managed and operated
+by National Technology and Engineering Solutions of Sandia, LLC., a wholly
+owned subsidiary of Honeywell International, Inc., for the U.S. Department of
+Energy's National Nuclear Security Administration under contract DE-NA0003525.
+
+Copyright (c) 2009-2023, NTESS
+
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    * Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+    * Redistributions in binary form must reproduce the above
+      copyright notice, this list of conditions and the following
+      disclaimer in the documentation and/or other materials provided
+      with the distribution.
+
+    * Neither the name of the copyright holder nor the names of its
+      contributors may be used to endorse or promote products derived
+      from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+Questions? Contact sst-macro-help@sandia.gov
+*/
+
+
+#define ssthg_app_name null_payloads
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include <mask_mpi.h>
+#include <mercury/common/skeleton.h>
+
+// Run with null_payloads set on the OS: every receive buffer below
+// starts out as a sentinel and must come back untouched, while the
+// communication pattern (and the comm split keys) still go through.
+
+#define NELEMS 8
+#define SENTINEL -7
+
+static void fill(int* buf, int n, int val)
+{
+  for (int i=0; i < n; ++i){
+    buf[i] = val;
+  }
+}
+
+static void check(int rank, const int* buf, int n, const char* what)
+{
+  for (int i=0; i < n; ++i){
+    if (buf[i] != SENTINEL){
+      printf("FAIL: rank %d %s wrote element %d = %d\n", rank, what, i, buf[i]);
+      return;
+    }
+  }
+  printf("PASS: rank %d %s left the buffer untouched\n", rank, what);
+}
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  int send[NELEMS*4];
+  int recv[NELEMS*4];
+  int tag = 42;
+
+  //contiguous eager send
+  fill(send, NELEMS, rank);
+  fill(recv, NELEMS, SENTINEL);
+  if (rank == 0){
+    MPI_Send(send, NELEMS, MPI_INT, 1, tag, MPI_COMM_WORLD);
+  } else if (rank == 1){
+    MPI_Recv(recv, NELEMS, MPI_INT, 0, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    check(rank, recv, NELEMS, "MPI_Recv");
+  }
+
+  //strided type, would otherwise be packed and unpacked
+  MPI_Datatype strided;
+  MPI_Type_vector(NELEMS, 1, 2, MPI_INT, &strided);
+  MPI_Type_commit(&strided);
+  fill(send, NELEMS*2, rank);
+  fill(recv, NELEMS*2, SENTINEL);
+  if (rank == 0){
+    MPI_Send(send, 1, strided, 1, tag, MPI_COMM_WORLD);
+  } else if (rank == 1){
+    MPI_Recv(recv, 1, strided, 0, tag, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    check(rank, recv, NELEMS*2, "MPI_Recv(vector)");
+  }
+
+  fill(send, NELEMS, rank + 1);
+  fill(recv, NELEMS, SENTINEL);
+  MPI_Allreduce(send, recv, NELEMS, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  check(rank, recv, NELEMS, "MPI_Allreduce");
+
+  fill(recv, NELEMS, rank == 0 ? 0 : SENTINEL);
+  MPI_Bcast(recv, NELEMS, MPI_INT, 0, MPI_COMM_WORLD);
+  if (rank != 0){
+    check(rank, recv, NELEMS, "MPI_Bcast");
+  }
+
+  fill(send, NELEMS, rank);
+  fill(recv, NELEMS*size, SENTINEL);
+  MPI_Allgather(send, NELEMS, MPI_INT, recv, NELEMS, MPI_INT, MPI_COMM_WORLD);
+  check(rank, recv, NELEMS*size, "MPI_Allgather");
+
+  fill(send, NELEMS*size, rank);
+  fill(recv, NELEMS*size, SENTINEL);
+  MPI_Alltoall(send, NELEMS, MPI_INT, recv, NELEMS, MPI_INT, MPI_COMM_WORLD);
+  check(rank, recv, NELEMS*size, "MPI_Alltoall");
+
+  //split keys are control data, not payload, and must still arrive
+  MPI_Comm split;
+  MPI_Comm_split(MPI_COMM_WORLD, rank % 2, rank, &split);
+  int split_size;
+  MPI_Comm_size(split, &split_size);
+  int expected = size / 2 + (rank % 2 == 0 ? size % 2 : 0);
+  printf("%s: rank %d MPI_Comm_split sized %d\n",
+         split_size == expected ? "PASS" : "FAIL", rank, split_size);
+  MPI_Comm_free(&split);
+
+  MPI_Type_free(&strided);
+  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Finalize();
+  return 0;
+}
@@ -21,6 +21,26 @@ class testcase_mask_mpi(SSTTestCase):
 #####
 
     def test_testme(self):
+        self.add_test_lib_path()
+        self.mask_mpi_template("test_sendrecv")
+
+    def test_null_payloads(self):
+        # any payload allocation that escapes null_payloads is reported
+        # by the OS at finish and shows up as an extra line in the diff
+        self.add_test_lib_path()
+        self.mask_mpi_template("test_null_payloads", grepfor="PASS\\|FAIL\\|null_payloads")
+
+    def test_collectives(self):
+        self.add_test_lib_path()
+        self.mask_mpi_template("test_collectives", grepfor="PASS\\|FAIL")
+
+    def test_matching(self):
+        self.add_test_lib_path()
+        self.mask_mpi_template("test_matching", grepfor="PASS\\|FAIL")
+
+#####
+
+    def add_test_lib_path(self):
         lib_dir = subprocess.run(["sst-config", "SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_LIBDIR"],
             stdout=subprocess.PIPE, stderr=subprocess.PIPE)
         lib_dir = lib_dir.stdout.rstrip().decode()
@@ -36,11 +56,9 @@ class testcase_mask_mpi(SSTTestCase):
         else:
             os.environ["SST_LIB_PATH"] = paths + ":" + sst_lib_path
 
-        self.mask_mpi_template("test_sendrecv")
-
 #####
 
-    def mask_mpi_template(self, testcase, striptotail=0):
+    def mask_mpi_template(self, testcase, striptotail=0, grepfor=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -69,6 +87,10 @@ class testcase_mask_mpi(SSTTestCase):
             os.system("grep Random {0} > {1}".format(outfile, tmpfile))
             os.system("tail -5 {0} > {1}".format(tmpfile, cmpfile))
 
+        if grepfor is not None:
+            # Only compare the lines the test app prints about itself
+            os.system("grep '{0}' {1} > {2}".format(grepfor, outfile, cmpfile))
+
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
         #       DEVELOPER AGAINST THE LATEST VERSION OF SST TO SEE IF THE
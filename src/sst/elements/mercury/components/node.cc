@@ -75,6 +75,13 @@ Node::setup()
   if (nic_) nic_->setup();
 }
 
+void
+Node::finish()
+{
+  //SST core only calls finish on components, pass it on to the OS
+  os_->finish();
+}
+
 void
 Node::handle(Request* req)
 {
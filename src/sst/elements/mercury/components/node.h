@@ -76,6 +76,8 @@ public:
 
   void setup() override;
 
+  void finish() override;
+
   void endSim() {
     primaryComponentOKToEndSim();
   }
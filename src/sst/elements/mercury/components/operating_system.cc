@@ -17,6 +17,7 @@
 
 #include <sst/core/params.h>
 #include <mercury/common/events.h>
+#include <mercury/common/null_buffer.h>
 #include <mercury/common/factory.h>
 #include <sst/core/eli/elementbuilder.h>
 #include <mercury/common/request.h>
@@ -26,6 +27,8 @@
 #include <mercury/operating_system/process/thread_id.h>
 #include <mercury/operating_system/threading/stack_alloc.h>
 #include <mercury/operating_system/libraries/unblock_event.h>
+#include <atomic>
+#include <cinttypes>
 #include <stdlib.h>
 #include <sys/mman.h>
 
@@ -34,6 +37,9 @@ extern "C" void* sst_hg_nullptr_send = nullptr;
 extern "C" void* sst_hg_nullptr_recv = nullptr;
 extern "C" void* sst_hg_nullptr_range_max = nullptr;
 static uintptr_t sst_hg_nullptr_range = 0;
+extern "C" int sst_hg_null_payloads = 0;
+extern "C" uint64_t sst_hg_null_payload_allocs = 0;
+extern "C" uint64_t sst_hg_null_payload_alloc_bytes = 0;
 
 namespace SST {
 namespace Hg {
@@ -100,6 +106,12 @@ OperatingSystem::OperatingSystem(SST::ComponentId_t id, SST::Params& params, Nod
     sst_hg_nullptr_range_max = ((char*)sst_hg_nullptr) + sst_hg_nullptr_range;
   }
 
+  //skeleton apps never look at message contents, so
+  //the whole process can run without payloads
+  if (params.find<bool>("null_payloads", false)){
+    sst_hg_null_payloads = 1;
+  }
+
   //eventSize = params.find<std::int64_t>("eventSize", 16);
   if (!time_converter_){
       time_converter_ = SST::BaseComponent::getTimeConverter(tickIntervalString());
@@ -148,6 +160,24 @@ OperatingSystem::setup() {
     selfEventLink_->send(r);
 }
 
+void
+OperatingSystem::finish() {
+  const StackAlloc::stats_t& st = stacks_.stats();
+  out_->verbose(CALL_INFO, 1, 0,
+                "stacks: %" PRIu64 " allocated, %" PRIu64 " reused, %" PRIu64 " chunks, "
+                "%" PRIu64 " peak in use, %" PRIu64 " still in use\n",
+                st.allocs, st.reuses, st.chunks, st.peak_in_use, st.in_use);
+
+  //the payload counters are process wide, only report once per process
+  static std::atomic<bool> payloads_reported(false);
+  if (sst_hg_null_payloads && sst_hg_null_payload_allocs
+      && !payloads_reported.exchange(true)){
+    out_->output("null_payloads: %" PRIu64 " payload buffers totaling %" PRIu64
+                 " bytes were still allocated\n",
+                 sst_hg_null_payload_allocs, sst_hg_null_payload_alloc_bytes);
+  }
+}
+
 void
 OperatingSystem::initThreading(SST::Params& params)
 {
@@ -161,6 +191,29 @@ OperatingSystem::initThreading(SST::Params& params)
   des_context_->initContext();
 
   active_thread_ = nullptr;
+
+  int benchmark_iterations = params.find<int>("context_switch_benchmark", 0);
+  if (benchmark_iterations > 0){
+    benchmarkThreading(benchmark_iterations);
+  }
+}
+
+void
+OperatingSystem::benchmarkThreading(int iterations)
+{
+  //every node would report the same numbers, only report once per process
+  static std::atomic<bool> reported(false);
+  if (reported.exchange(true)){
+    return;
+  }
+
+  void* stack = stacks_.alloc();
+  for (const std::string& name : ThreadContext::availableThreading()){
+    double ns = ThreadContext::switchCost(name, iterations, stack, StackAlloc::stacksize());
+    out_->output("context switch benchmark: %s takes %.1f ns per switch over %d round trips\n",
+                 name.c_str(), ns, iterations);
+  }
+  stacks_.free(stack);
 }
 
 void
@@ -173,7 +226,7 @@ OperatingSystem::startThread(Thread* t)
       active_thread_ = t;
       activeOs() = this;
       App* parent = t->parentApp();
-      void* stack = StackAlloc::alloc();
+      void* stack = stacks_.alloc();
       t->initThread(
             parent->params(),
             threadId(),
@@ -23,6 +23,7 @@
 #include <sst/core/eli/elementbuilder.h>
 #include <mercury/components/node_fwd.h>
 #include <mercury/operating_system/threading/threading_interface.h>
+#include <mercury/operating_system/threading/stack_alloc.h>
 #include <mercury/operating_system/launch/app_launcher_fwd.h>
 #include <mercury/operating_system/launch/app_launch_request.h>
 #include <mercury/operating_system/process/app.h>
@@ -66,6 +67,8 @@ public:
 
   void setup() override;
 
+  void finish() override;
+
   void handleEvent(SST::Event *ev);
 
   bool clockTic(SST::Cycle_t) {
@@ -77,6 +80,17 @@ public:
     return sst_hg_global_stacksize;
   }
 
+  /**
+   * @return A stack of stacksize() bytes from this OS's free list
+   */
+  void* allocStack() {
+    return stacks_.alloc();
+  }
+
+  void freeStack(void* stack) {
+    stacks_.free(stack);
+  }
+
   std::function<void(NetworkMessage*)> nicDataIoctl();
 
   std::function<void(NetworkMessage*)> nicCtrlIoctl();
@@ -133,6 +147,8 @@ public:
 
   void initThreading(SST::Params& params);
 
+  void benchmarkThreading(int iterations);
+
   const std::string& tickIntervalString()
   {
     return _tick_spacing_string_;
@@ -158,6 +174,7 @@ public:
   AppLauncher* app_launcher_;
   std::map<uint32_t, Thread*> running_threads_;
   ComputeScheduler* compute_sched_;
+  StackAlloc stacks_;
 
   std::unordered_map<std::string, Library*> libs_;
   std::unordered_map<Library*, int> lib_refcounts_;
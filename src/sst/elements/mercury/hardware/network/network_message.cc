@@ -74,6 +74,7 @@ void
 NetworkMessage::putBufferOnWire(void* buf, uint64_t sz)
 {
   if (isNonNullBuffer(buf)){
+    trackPayloadAlloc(sz);
     wire_buffer_ = new char[sz];
     ::memcpy(wire_buffer_, buf, sz);
   }
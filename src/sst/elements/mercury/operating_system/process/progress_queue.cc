@@ -51,13 +51,13 @@ namespace Hg {
 void
 ProgressQueue::block(std::list<Thread*>& q, double timeout){
   Thread* thr = os->activeThread();
-  q.push_back(thr);
+  auto pos = q.insert(q.end(), thr);
   if (timeout > 0){
     os->blockTimeout(TimeDelta(timeout));
   } else {
     os->block();
   }
-  q.remove(thr);
+  q.erase(pos);
 }
 
 void
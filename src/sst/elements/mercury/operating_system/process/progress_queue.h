@@ -45,8 +45,12 @@ Questions? Contact sst-macro-help@sandia.gov
 #pragma once
 
 #include <queue>
+#include <deque>
 #include <map>
 #include <list>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <mercury/common/errors.h>
 #include <mercury/common/timestamp.h>
 #include <mercury/operating_system/process/thread_fwd.h>
@@ -261,6 +265,110 @@ struct MultiProgressQueue : public ProgressQueue {
 
 };
 
+/**
+ * Same interface as MultiProgressQueue for completion queue ids that are
+ * small dense integers (as handed out by the transports). Items and blocked
+ * threads are kept in containers indexed by CQ, and a bitmask of non-empty
+ * CQs lets find_any jump straight to a queue holding items instead of
+ * walking every CQ.
+ */
+template <class Item>
+struct IndexedProgressQueue : public ProgressQueue {
+  std::list<Thread*> any_threads;
+  std::vector<std::queue<Item*>> queues;
+  //a blocked thread holds a reference to its wait list while other
+  //CQs get allocated, so growing must not move the existing lists
+  std::deque<std::list<Thread*>> pending_threads;
+  std::vector<uint64_t> nonempty;
+
+  IndexedProgressQueue(OperatingSystem* os) : ProgressQueue(os)
+  {
+  }
+
+  Item* find_any(bool blocking = true, double timeout = -1){
+    Item* it = popAny();
+    if (it || !blocking){
+      return it;
+    }
+
+    block(any_threads, timeout);
+
+    it = popAny();
+#if SST_HG_SANITY_CHECK
+    if (!it && timeout <= 0){
+      spkt_abort_printf("unblocked on CQ without timeout, but there are no messages");
+    }
+#endif
+    return it;
+  }
+
+  Item* find(int cq, bool blocking = true, double timeout = -1){
+    reserve(cq);
+    if (queues[cq].empty()){
+      if (blocking){
+        block(pending_threads[cq], timeout);
+      } else {
+        return nullptr;
+      }
+    }
+
+    if (queues[cq].empty()){
+#if SST_HG_SANITY_CHECK
+      if (timeout <= 0){
+        spkt_abort_printf("unblocked on CQ with no timeout, but there are no items");
+      }
+#endif
+      return nullptr;
+    } else {
+      return pop(cq);
+    }
+  }
+
+  void incoming(int cq, Item* it){
+    reserve(cq);
+    queues[cq].push(it);
+    nonempty[cq / 64] |= uint64_t(1) << (cq % 64);
+    if (!pending_threads[cq].empty()){
+      unblock(pending_threads[cq]);
+    } else if (!any_threads.empty()){
+      unblock(any_threads);
+    } else {
+      //pass, nothing to do
+    }
+  }
+
+ private:
+  void reserve(int cq){
+    if (cq >= int(queues.size())){
+      queues.resize(cq + 1);
+      pending_threads.resize(cq + 1);
+      nonempty.resize(cq / 64 + 1, 0);
+    }
+  }
+
+  Item* pop(int cq){
+    std::queue<Item*>& q = queues[cq];
+    Item* it = q.front();
+    q.pop();
+    if (q.empty()){
+      nonempty[cq / 64] &= ~(uint64_t(1) << (cq % 64));
+    }
+    return it;
+  }
+
+  Item* popAny(){
+    //lowest CQ first, matching MultiProgressQueue
+    for (size_t word=0; word < nonempty.size(); ++word){
+      if (nonempty[word]){
+        int cq = word*64 + __builtin_ctzll(nonempty[word]);
+        return pop(cq);
+      }
+    }
+    return nullptr;
+  }
+
+};
+
 }
 }
 
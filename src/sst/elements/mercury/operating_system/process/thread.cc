@@ -159,6 +159,7 @@ Thread::Thread(SST::Params& params, SoftwareId sid, OperatingSystem* os) :
   last_bt_collect_nfxn_(0),
   bt_nfxn_(0),
   timed_out_(false),
+  stack_(nullptr),
   tls_storage_(nullptr),
   thread_id_(Thread::main_thread),
   context_(nullptr),
@@ -276,7 +277,11 @@ Thread::now()
 Thread::~Thread()
 {
   active_cores_.clear();
- // if (stack_) StackAlloc::free(stack_);
+  //the context has completed or will never resume, the stack can be reused
+  //threads are only deleted by their own OS (delete event on its self link,
+  //join, or unblocking a canceled thread), so os_ still owns the pool here;
+  //threads alive at teardown are never deleted and keep their stacks mapped
+  if (stack_) os_->freeStack(stack_);
   if (context_) {
     context_->destroyContext();
     delete context_;
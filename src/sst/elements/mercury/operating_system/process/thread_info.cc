@@ -74,15 +74,14 @@ extern "C" void* sst_hg_alloc_stack(int sz, int md_sz)
     sst_hg_abort_printf("Cannot allocate stack larger than %d - requested %d",
                       SST::Hg::OperatingSystem::stacksize(), sz);
   }
-  void* stack = SST::Hg::StackAlloc::alloc();
+  void* stack = SST::Hg::OperatingSystem::currentOs()->allocStack();
   //configureStack(get_sst_hg_tls_thread_id(), stack, get_sst_hg_global_data(), get_sst_hg_tls_data());
   return stack;
 }
 
 extern "C" void sst_hg_free_stack(void* ptr)
 {
-  abort("sst_hg_free_stack");
-//  SST::Hg::StackAlloc::free(ptr);
+  SST::Hg::OperatingSystem::currentOs()->freeStack(ptr);
 }
 
 void
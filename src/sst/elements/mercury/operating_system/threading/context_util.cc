@@ -14,10 +14,12 @@
 // distribution.
 
 #include <mercury/common/errors.h>
+#include <mercury/common/factory.h>
 #include <mercury/operating_system/threading/context_util.h>
 #include <mercury/operating_system/threading/threading_interface.h>
 #include <mercury/operating_system/threading/thread_lock.h>
 
+#include <chrono>
 #include <vector>
 
 namespace SST {
@@ -78,6 +80,70 @@ ThreadContext::defaultThreading()
   return default_threading;
 }
 
+std::vector<std::string>
+ThreadContext::availableThreading()
+{
+  static thread_lock fill_lock;
+  fill_lock.lock();
+  if (valid_threading_contexts.empty()){
+    fill_valid_threading_contexts(valid_threading_contexts);
+  }
+  fill_lock.unlock();
+
+  //configure may detect a backend whose sources are not compiled in
+  std::vector<std::string> names;
+  auto* lib = ThreadContext::getBuilderLibrary("hg");
+  for (auto& pair : valid_threading_contexts){
+    if (lib && lib->getBuilder(pair.first)){
+      names.push_back(pair.first);
+    }
+  }
+  return names;
+}
+
+struct SwitchBenchmark {
+  ThreadContext* des;
+  ThreadContext* ctx;
+  int iterations;
+};
+
+static void switch_benchmark_loop(void* args)
+{
+  SwitchBenchmark* bench = (SwitchBenchmark*) args;
+  for (int i=0; i < bench->iterations; ++i){
+    bench->ctx->pauseContext(bench->des);
+  }
+  bench->ctx->completeContext(bench->des);
+}
+
+double
+ThreadContext::switchCost(const std::string& threading, int iterations,
+                          void* stack, size_t stacksize)
+{
+  ThreadContext* des = SST::Hg::create<ThreadContext>("hg", threading);
+  des->initContext();
+  ThreadContext* ctx = des->copy();
+
+  SwitchBenchmark bench{des, ctx, iterations};
+  //the context runs up to its first pause before this returns
+  ctx->startContext(stack, stacksize, switch_benchmark_loop, &bench, des);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i=0; i < iterations; ++i){
+    ctx->resumeContext(des);
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  ctx->destroyContext();
+  delete ctx;
+  des->destroyContext();
+  delete des;
+
+  //every round trip is one switch in and one switch out
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  return ns / (2.0 * iterations);
+}
+
 
 // Intermediary to get around the brain-damaged prototype for makecontext.
 void context_springboard(int func_ptr_a, int func_ptr_b,
@@ -20,14 +20,13 @@
 #include <mercury/operating_system/process/thread_info.h>
 #include <mercury/operating_system/threading/stack_alloc.h>
 #include <mercury/operating_system/threading/stack_alloc_chunk.h>
-#include <mercury/operating_system/threading/thread_lock.h>
 
+#include <algorithm>
 #include <unistd.h>
 
 namespace SST {
 namespace Hg {
 
-StackAlloc::chunk_set StackAlloc::chunks_;
 size_t StackAlloc::suggested_chunk_ = 0;
 size_t StackAlloc::stacksize_ = 0;
 bool StackAlloc::protect_stacks_ = false;
@@ -49,7 +48,8 @@ StackAlloc::init(SST::Params& params)
   if (stack_rem != 0){
     sst_hg_global_stacksize += (4096 - stack_rem);
   }
-  std::string chunk = Hg::sprintf("%dB", 8*sst_hg_global_stacksize);
+  //chunks only reserve address space, so carving many stacks per mmap is cheap
+  std::string chunk = Hg::sprintf("%dB", 64*sst_hg_global_stacksize);
   suggested_chunk_ = params.find<SST::UnitAlgebra>("stack_chunk_size", chunk).getRoundedValue();
   stacksize_ = sst_hg_global_stacksize;
 
@@ -60,22 +60,27 @@ void
 StackAlloc::chunk_set::clear()
 {
   for (chunk* ch : allocations){
-    //this leads to an munmap during cxa_finalize
-    //which segfaults for no apparent reason
-    //delete ch;
+    delete ch;
   }
   allocations.clear();
   available.clear();
 }
 
+StackAlloc::~StackAlloc()
+{
+  if (stats_.in_use != 0){
+    //threads that never finished may still point into these chunks,
+    //leave the mappings alone rather than risk a fault during teardown
+    chunks_.allocations.clear();
+  }
+}
+
 //
 // Get a stack memory region.
 //
 void*
 StackAlloc::alloc()
 {
-  static thread_lock lock;
-  lock.lock();
   if (stacksize_ == 0) {
     sst_hg_throw_printf(ValueError, "stackalloc::stacksize was not initialized");
   }
@@ -84,6 +89,7 @@ StackAlloc::alloc()
     // grab a new chunk.
     chunk* new_chunk = new chunk(stacksize_, suggested_chunk_, protect_stacks_);
     chunks_.allocations.push_back(new_chunk);
+    ++stats_.chunks;
     void* buf = new_chunk->getNextStack();
     while (buf != nullptr){
       chunks_.available.push_back(buf);
@@ -92,7 +98,14 @@ StackAlloc::alloc()
   }
   void *buf = chunks_.available.back();
   chunks_.available.pop_back();
-  lock.unlock();
+  //freed stacks sit on top of the free list, so they go out first
+  if (recycled_ > 0){
+    --recycled_;
+    ++stats_.reuses;
+  }
+  ++stats_.allocs;
+  ++stats_.in_use;
+  stats_.peak_in_use = std::max(stats_.peak_in_use, stats_.in_use);
   return buf;
 }
 
@@ -101,10 +114,9 @@ StackAlloc::alloc()
 //
 void StackAlloc::free(void* buf)
 {
-  static thread_lock lock; 
-  lock.lock();
   chunks_.available.push_back(buf);
-  lock.unlock();
+  ++recycled_;
+  --stats_.in_use;
 }
 
 
@@ -17,6 +17,7 @@
 
 #include <sst/core/params.h>
 
+#include <cstdint>
 #include <cstring>
 #include <vector>
 
@@ -29,6 +30,10 @@ namespace Hg {
  * which allocates uniform-size chunks (with the NX bit unset)
  * and sets guard pages on each side of the allocated stacks.
  *
+ * Chunks only reserve address space, pages are committed by the kernel
+ * the first time a stack touches them. Each operating system owns its
+ * own allocator so freed stacks are reused without locking.
+ *
  * This allocator does not return memory to the system until it is
  * deleted, but regions can be allocated and free-d repeatedly.
  */
@@ -44,8 +49,25 @@ class StackAlloc
     }
     void clear();
   };
+
+  struct stats_t {
+    /// Total number of stacks handed out
+    uint64_t allocs = 0;
+    /// Number of those satisfied from the free list
+    uint64_t reuses = 0;
+    /// Number of chunks mapped
+    uint64_t chunks = 0;
+    /// Stacks currently handed out
+    uint64_t in_use = 0;
+    /// Largest number of stacks handed out at once
+    uint64_t peak_in_use = 0;
+  };
+
  private:
-  static chunk_set chunks_;
+  chunk_set chunks_;
+  stats_t stats_;
+  /// Number of freed stacks on the free list
+  size_t recycled_ = 0;
   /// Each chunk is of this suggested size.
   static size_t suggested_chunk_;
   /// Each stack request is of this size:
@@ -58,9 +80,7 @@ class StackAlloc
     return stacksize_;
   }
 
-  ~StackAlloc(){
-    clear();
-  }
+  ~StackAlloc();
 
   static size_t chunksize() {
     return suggested_chunk_;
@@ -68,11 +88,13 @@ class StackAlloc
 
   static void init(SST::Params& params);
 
-  static void* alloc();
+  void* alloc();
 
-  static void free(void*);
+  void free(void*);
 
-  static void clear();
+  const stats_t& stats() const {
+    return stats_;
+  }
 
 };
 
@@ -20,6 +20,8 @@
 #include <errno.h>
 #include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace SST {
 namespace Hg {
@@ -77,6 +79,23 @@ class ThreadContext
 
   static std::string defaultThreading();
 
+  /**
+   * @return The names of the threading backends built into this library
+   */
+  static std::vector<std::string> availableThreading();
+
+  /**
+   * @brief switchCost Ping-pong between a DES context and one
+   *        user-level context of the given backend
+   * @param threading   The backend to measure
+   * @param iterations  The number of round trips
+   * @param stack       A stack of at least stacksize bytes
+   * @param stacksize
+   * @return The average wall-clock nanoseconds per context switch
+   */
+  static double switchCost(const std::string& threading, int iterations,
+                           void* stack, size_t stacksize);
+
  protected:
   ThreadContext() {}
 
@@ -37,6 +37,8 @@ class HgJob(Job):
     def build(self, nodeID, extraKeys):
         node = self.node.build(nodeID)
         os = self.os.build(node,"os_slot") 
+        # one rank per node, the apps size their world from the job
+        os.addParam("app1.size", self.size)
         nic = node.setSubComponent("nic_slot", "hg.nic")
 
         # Build NetworkInterface
@@ -0,0 +1,69 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#define ssthg_app_name pqtest
+#include <iostream>
+#include <mercury/common/skeleton.h>
+#include <mercury/operating_system/process/app.h>
+#include <mercury/operating_system/process/thread.h>
+#include <mercury/operating_system/process/progress_queue.h>
+
+using SST::Hg::Thread;
+using SST::Hg::IndexedProgressQueue;
+
+// Delivers to a CQ the queue has not seen yet, then to the CQ
+// the main thread is blocked on.
+class Deliverer : public Thread {
+ public:
+  Deliverer(Thread* parent, IndexedProgressQueue<int>* q, int* on_cq0, int* on_cq1) :
+    Thread(parent->parentApp()->params(), parent->sid(), parent->os()),
+    q_(q), on_cq0_(on_cq0), on_cq1_(on_cq1)
+  {
+    setDetachState(DETACHED);
+  }
+
+  void run() override {
+    q_->incoming(1, on_cq1_);
+    q_->incoming(0, on_cq0_);
+  }
+
+ private:
+  IndexedProgressQueue<int>* q_;
+  int* on_cq0_;
+  int* on_cq1_;
+};
+
+static void check(bool passed, const char* what)
+{
+  std::cout << (passed ? "PASS: " : "FAIL: ") << what << "\n";
+}
+
+int main(int argc, char** argv) {
+  Thread* self = Thread::current();
+  IndexedProgressQueue<int> q(self->os());
+  int on_cq0 = 0;
+  int on_cq1 = 1;
+
+  //only CQ 0 exists when the main thread blocks
+  check(q.find(0, false) == nullptr, "CQ 0 starts empty");
+
+  self->spawn(new Deliverer(self, &q, &on_cq0, &on_cq1));
+
+  //CQ 1 is allocated while this thread waits on CQ 0
+  check(q.find(0) == &on_cq0, "woke on CQ 0 after CQ 1 was allocated");
+  check(q.find(1, false) == &on_cq1, "CQ 1 kept its item");
+  check(q.find_any(false) == nullptr, "no items left");
+  return 0;
+}
@@ -0,0 +1,15 @@
+import sst
+import sst.hg
+
+node0 = sst.Component("Node0", "hg.node")
+node1 = sst.Component("Node1", "hg.node")
+os0 = node0.setSubComponent("os_slot", "hg.operating_system")
+os1 = node1.setSubComponent("os_slot", "hg.operating_system")
+
+link0 = sst.Link("link0")
+link0.connect( (node0,"network","1ns"), (node1,"network","1ns") )
+
+os0.addParams({ "app1.name" : "pqtest"})
+os1.addParams({ "app1.name" : "pqtest"})
+os0.addParams({ "app1.exe" : "pqtest.so"})
+os1.addParams({ "app1.exe" : "pqtest.so"})
@@ -27,6 +27,16 @@ class testcase_hg(SSTTestCase):
 #####
 
     def test_testme(self):
+        self.add_test_lib_path()
+        self.simple_components_template("ostest")
+
+    def test_progress_queue(self):
+        self.add_test_lib_path()
+        self.simple_components_template("pqtest", grepfor="PASS\\|FAIL")
+
+#####
+
+    def add_test_lib_path(self):
         lib_dir = subprocess.run(["sst-config", "SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_LIBDIR"],
             stdout=subprocess.PIPE, stderr=subprocess.PIPE)
         lib_dir = lib_dir.stdout.rstrip().decode()
@@ -42,11 +52,9 @@ class testcase_hg(SSTTestCase):
         else:
             os.environ["SST_LIB_PATH"] = paths + ":" + sst_lib_path
 
-        self.simple_components_template("ostest")
-
 #####
 
-    def simple_components_template(self, testcase, striptotail=0):
+    def simple_components_template(self, testcase, striptotail=0, grepfor=None):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -75,6 +83,10 @@ class testcase_hg(SSTTestCase):
             os.system("grep Random {0} > {1}".format(outfile, tmpfile))
             os.system("tail -5 {0} > {1}".format(tmpfile, cmpfile))
 
+        if grepfor is not None:
+            # Only compare the lines the test app prints about itself
+            os.system("grep '{0}' {1} > {2}".format(grepfor, outfile, cmpfile))
+
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
         #       DEVELOPER AGAINST THE LATEST VERSION OF SST TO SEE IF THE
@@ -0,0 +1,191 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/compositegen.h>
+
+using namespace SST::Miranda;
+
+
+CompositeGenerator::CompositeGenerator( ComponentId_t id, Params& params ) :
+	RequestGenerator(id, params) {
+		build(params);
+	}
+
+void CompositeGenerator::build(Params& params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+
+	out = new Output("CompositeGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string modeName = params.find<std::string>("mode", "interleave");
+
+	if("interleave" == modeName) {
+		mode = COMPOSITE_INTERLEAVE;
+	} else if("sequence" == modeName) {
+		mode = COMPOSITE_SEQUENCE;
+	} else if("phase" == modeName) {
+		mode = COMPOSITE_PHASE;
+	} else {
+		out->fatal(CALL_INFO, -1, "Unknown composite mode: %s, use interleave, sequence or phase\n", modeName.c_str());
+	}
+
+	const uint32_t generatorCount = params.find<uint32_t>("generator_count", 1);
+	char key[64];
+
+	for(uint32_t i = 0; i < generatorCount; ++i) {
+		snprintf(key, 64, "generator%" PRIu32, i);
+		const std::string genName = params.find<std::string>(key, "");
+
+		if("" == genName) {
+			out->fatal(CALL_INFO, -1, "Composite generator slot %" PRIu32 " has no generator, set %s\n", i, key);
+		}
+
+		snprintf(key, 64, "generator%" PRIu32 "Params", i);
+		Params genParams = params.get_scoped_params(key);
+
+		RequestGenerator* gen = loadAnonymousSubComponent<RequestGenerator>(genName, "generator", i,
+			ComponentInfo::INSERT_STATS, genParams);
+
+		if(NULL == gen) {
+			out->fatal(CALL_INFO, -1, "Failed to load generator: %s\n", genName.c_str());
+		}
+
+		snprintf(key, 64, "weight%" PRIu32, i);
+		const uint64_t weight = params.find<uint64_t>(key, 1);
+
+		if(0 == weight) {
+			out->fatal(CALL_INFO, -1, "Generator %" PRIu32 " (%s) must have a weight of at least 1\n", i, genName.c_str());
+		}
+
+		out->verbose(CALL_INFO, 1, 0, "Generator %" PRIu32 ": %s, weight %" PRIu64 "\n", i, genName.c_str(), weight);
+
+		generators.push_back(gen);
+		weights.push_back(weight);
+		credit.push_back(0);
+	}
+
+	if(generators.empty()) {
+		out->fatal(CALL_INFO, -1, "Composite generator needs at least one generator\n");
+	}
+
+	out->verbose(CALL_INFO, 1, 0, "Composing %" PRIu32 " generators in %s mode\n", generatorCount, modeName.c_str());
+
+	current = 0;
+	phaseStepsLeft = weights[0];
+}
+
+CompositeGenerator::~CompositeGenerator() {
+	// Generators are subcomponents, the core deletes them with us
+	delete out;
+}
+
+uint32_t CompositeGenerator::pickInterleaved() {
+	// Smooth weighted round robin, spreads each generator's steps evenly
+	// through the mix rather than issuing them in bursts
+	int64_t activeWeight = 0;
+	uint32_t pick = generators.size();
+
+	for(uint32_t i = 0; i < generators.size(); ++i) {
+		if(generators[i]->isFinished()) {
+			continue;
+		}
+
+		credit[i] += (int64_t) weights[i];
+		activeWeight += (int64_t) weights[i];
+
+		if(pick == generators.size() || credit[i] > credit[pick]) {
+			pick = i;
+		}
+	}
+
+	if(pick < generators.size()) {
+		credit[pick] -= activeWeight;
+	}
+
+	return pick;
+}
+
+bool CompositeGenerator::advancePhase() {
+	// Move to the next generator which still has work, false if none remain
+	for(uint32_t i = 1; i <= generators.size(); ++i) {
+		const uint32_t next = (current + i) % generators.size();
+
+		if(! generators[next]->isFinished()) {
+			current = next;
+			phaseStepsLeft = weights[next];
+
+			out->verbose(CALL_INFO, 2, 0, "Switching to generator %" PRIu32 "\n", current);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void CompositeGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	generate(q, 1);
+}
+
+void CompositeGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count) {
+	uint32_t steps = 0;
+
+	while(steps < count && ! isFinished()) {
+		if(COMPOSITE_INTERLEAVE == mode) {
+			const uint32_t pick = pickInterleaved();
+
+			if(pick == generators.size()) {
+				break;
+			}
+
+			generators[pick]->generate(q, 1);
+			steps++;
+		} else {
+			if(generators[current]->isFinished() ||
+				(COMPOSITE_PHASE == mode && 0 == phaseStepsLeft)) {
+
+				if(! advancePhase()) {
+					break;
+				}
+			}
+
+			// Hand the rest of this phase to the generator in one call
+			uint32_t run = count - steps;
+			if(COMPOSITE_PHASE == mode) {
+				run = (uint32_t) std::min((uint64_t) run, phaseStepsLeft);
+				phaseStepsLeft -= run;
+			}
+
+			generators[current]->generate(q, run);
+			steps += run;
+		}
+	}
+}
+
+bool CompositeGenerator::isFinished() {
+	for(uint32_t i = 0; i < generators.size(); ++i) {
+		if(! generators[i]->isFinished()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void CompositeGenerator::completed() {
+	for(uint32_t i = 0; i < generators.size(); ++i) {
+		generators[i]->completed();
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_COMPOSITE_GEN
+#define _H_SST_MIRANDA_COMPOSITE_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+typedef enum {
+	COMPOSITE_INTERLEAVE,
+	COMPOSITE_SEQUENCE,
+	COMPOSITE_PHASE
+} CompositeMode;
+
+class CompositeGenerator : public RequestGenerator {
+
+public:
+	CompositeGenerator( ComponentId_t id, Params& params );
+	void build(Params& params);
+	~CompositeGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		CompositeGenerator,
+		"miranda",
+		"CompositeGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Interleaves or sequences a set of generators by phase with configurable weights",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "generator_count",  "Number of generators to compose", "1" },
+		{ "generator%(generator_count)d", "Generator to load in slot n, e.g. generator0=miranda.GUPSGenerator", "" },
+		{ "generator%(generator_count)dParams", "Scoped parameters for the generator in slot n", "" },
+		{ "weight%(generator_count)d", "Weight of the generator in slot n, steps per phase in phase mode", "1" },
+		{ "mode",             "interleave (weighted round robin per step), sequence (each generator runs until finished) or phase (each generator runs for weight steps in turn)", "interleave" }
+	)
+
+	SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+		{ "generator", "Composed generators, loaded from the generator%(generator_count)d parameters", "SST::Miranda::RequestGenerator" }
+	)
+
+private:
+	uint32_t pickInterleaved();
+	bool advancePhase();
+
+	Output* out;
+	CompositeMode mode;
+
+	std::vector<RequestGenerator*> generators;
+	std::vector<uint64_t> weights;
+	std::vector<int64_t> credit;
+
+	uint32_t current;
+	uint64_t phaseStepsLeft;
+};
+
+}
+}
+
+#endif
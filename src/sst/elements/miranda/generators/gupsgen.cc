@@ -54,25 +54,35 @@ GUPSGenerator::~GUPSGenerator() {
 }
 
 void GUPSGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+    generate(q, 1);
+}
+
+void GUPSGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count) {
+    const uint64_t steps = std::min((uint64_t) count, issueCount);
+
+    // Each update is a read followed by a dependent write
+    q->reserve(2 * steps);
 
-    const uint64_t rand_addr = rng->generateNextUInt64();
-    // Ensure we have a reqLength aligned request
+    for(uint64_t step = 0; step < steps; ++step) {
+        const uint64_t rand_addr = rng->generateNextUInt64();
+        // Ensure we have a reqLength aligned request
 
-    uint64_t addr = (rand_addr % ( memLength / reqLength ) );
-    addr *= reqLength;
-    addr += memStart;
+        uint64_t addr = (rand_addr % ( memLength / reqLength ) );
+        addr *= reqLength;
+        addr += memStart;
 
-    out->verbose(CALL_INFO, 4, 0, "Generating next request number: %" PRIu64 " at address %" PRIu64 "\n", issueCount, addr);
+        out->verbose(CALL_INFO, 4, 0, "Generating next request number: %" PRIu64 " at address %" PRIu64 "\n", issueCount, addr);
 
-    MemoryOpRequest* readAddr = new MemoryOpRequest(addr, reqLength, READ);
-    MemoryOpRequest* writeAddr = new MemoryOpRequest(addr, reqLength, WRITE);
+        MemoryOpRequest* readAddr = new MemoryOpRequest(addr, reqLength, READ);
+        MemoryOpRequest* writeAddr = new MemoryOpRequest(addr, reqLength, WRITE);
 
-    writeAddr->addDependency(readAddr->getRequestID());
+        writeAddr->addDependency(readAddr->getRequestID());
 
-    q->push_back(readAddr);
-    q->push_back(writeAddr);
+        q->push_back(readAddr);
+        q->push_back(writeAddr);
 
-    issueCount--;
+        issueCount--;
+    }
 }
 
 bool GUPSGenerator::isFinished() {
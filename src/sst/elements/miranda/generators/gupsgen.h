@@ -35,6 +35,7 @@ public:
         void build(Params &params);
 	~GUPSGenerator();
 	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count);
 	bool isFinished();
 	void completed();
 
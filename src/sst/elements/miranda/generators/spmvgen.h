@@ -131,6 +131,17 @@ public:
 		iterations--;
 	}
 
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count) {
+		// Every iteration sweeps the whole local matrix so size the window
+		// once rather than growing it while the rows are generated
+		const uint64_t perIteration = (localRowEnd - localRowStart) * (4 + (3 * matrixNNZPerRow));
+
+		for(uint32_t i = 0; i < count && ! isFinished(); ++i) {
+			q->reserve((uint32_t) std::min(perIteration, (uint64_t) UINT32_MAX - q->size()));
+			generate(q);
+		}
+	}
+
 	bool isFinished() {
 		return (0 == iterations);
 	}
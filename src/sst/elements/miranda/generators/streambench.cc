@@ -61,7 +61,16 @@ STREAMBenchGenerator::~STREAMBenchGenerator() {
 }
 
 void STREAMBenchGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
-	for(uint64_t j = 0; j < n_per_call; ++j) {
+	generate(q, 1);
+}
+
+void STREAMBenchGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count) {
+	const uint64_t iterations = std::min(((uint64_t) count) * n_per_call, n - i);
+
+	// Two reads and a dependent write per array element
+	q->reserve(3 * iterations);
+
+	for(uint64_t j = 0; j < iterations; ++j) {
 		out->verbose(CALL_INFO, 4, 0, "Array index: %" PRIu64 "\n", i);
 
 		// If we reached our limit then step out of the generation
@@ -32,6 +32,7 @@ public:
         void build(Params& params);
 	~STREAMBenchGenerator();
 	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count);
 	bool isFinished();
 	void completed();
 
@@ -0,0 +1,212 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/tracereplay.h>
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Miranda;
+
+
+TraceReplayGenerator::TraceReplayGenerator( ComponentId_t id, Params& params ) :
+	RequestGenerator(id, params), traceFD(-1), mapBase(NULL), mapLength(0) {
+		build(params);
+	}
+
+void TraceReplayGenerator::build(Params& params) {
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+
+	out = new Output("TraceReplayGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	iterations    = params.find<uint64_t>("iterations", 1);
+	addressOffset = params.find<uint64_t>("address_offset", 0);
+
+	uint64_t window = params.find<uint64_t>("dependency_window", 64);
+	uint64_t windowSize = 1;
+	while(windowSize < window) {
+		windowSize *= 2;
+	}
+
+	recentIDs.resize(windowSize, 0);
+	recentMask = windowSize - 1;
+
+	nextRecord = 0;
+	replayStartNano = 0;
+	replayStarted = false;
+
+	mapTrace(params.find<std::string>("file", ""));
+
+	if(0 == header.recordCount) {
+		iterations = 0;
+	}
+
+	out->verbose(CALL_INFO, 1, 0, "Replaying %" PRIu64 " records, %" PRIu64 " iterations\n", header.recordCount, iterations);
+	out->verbose(CALL_INFO, 1, 0, "Record size:       %" PRIu64 " bytes\n", (uint64_t) recordSize);
+	out->verbose(CALL_INFO, 1, 0, "Dependencies:      %s\n", (header.flags & MIRANDA_TRACE_HAS_DEPENDENCY) ? "yes" : "no");
+	out->verbose(CALL_INFO, 1, 0, "Timing:            %s\n", (header.flags & MIRANDA_TRACE_HAS_TIMING) ? "yes" : "no");
+}
+
+void TraceReplayGenerator::mapTrace(const std::string& traceFile) {
+	traceFD = open(traceFile.c_str(), O_RDONLY);
+
+	if(traceFD < 0) {
+		out->fatal(CALL_INFO, -1, "Unable to open trace file: %s\n", traceFile.c_str());
+	}
+
+	struct stat traceStat;
+	if(0 != fstat(traceFD, &traceStat) || (size_t) traceStat.st_size < sizeof(MirandaTraceHeader)) {
+		out->fatal(CALL_INFO, -1, "Trace file: %s is too small to hold a trace header\n", traceFile.c_str());
+	}
+
+	mapLength = (size_t) traceStat.st_size;
+	void* mapped = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, traceFD, 0);
+
+	if(MAP_FAILED == mapped) {
+		out->fatal(CALL_INFO, -1, "Unable to map trace file: %s\n", traceFile.c_str());
+	}
+
+	mapBase = (const uint8_t*) mapped;
+	posix_madvise(mapped, mapLength, POSIX_MADV_SEQUENTIAL);
+
+	memcpy(&header, mapBase, sizeof(MirandaTraceHeader));
+
+	if(0 != memcmp(header.magic, MIRANDA_TRACE_MAGIC, 8) || MIRANDA_TRACE_VERSION != header.version) {
+		out->fatal(CALL_INFO, -1, "Trace file: %s is not a version %d Miranda address stream\n",
+			traceFile.c_str(), MIRANDA_TRACE_VERSION);
+	}
+
+	recordSize = sizeof(MirandaTraceRecord);
+
+	if(header.flags & MIRANDA_TRACE_HAS_DEPENDENCY) {
+		recordSize += sizeof(uint32_t);
+	}
+
+	if(header.flags & MIRANDA_TRACE_HAS_TIMING) {
+		recordSize += sizeof(uint64_t);
+	}
+
+	if(header.recordCount > (mapLength - sizeof(MirandaTraceHeader)) / recordSize) {
+		out->fatal(CALL_INFO, -1, "Trace file: %s holds fewer than the %" PRIu64 " records in its header, is it truncated?\n",
+			traceFile.c_str(), header.recordCount);
+	}
+
+	records = mapBase + sizeof(MirandaTraceHeader);
+}
+
+TraceReplayGenerator::~TraceReplayGenerator() {
+	if(NULL != mapBase) {
+		munmap((void*) mapBase, mapLength);
+	}
+
+	if(traceFD >= 0) {
+		close(traceFD);
+	}
+
+	delete out;
+}
+
+void TraceReplayGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+	generate(q, 1);
+}
+
+void TraceReplayGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count) {
+	if(! replayStarted) {
+		replayStartNano = getCurrentSimTimeNano();
+		replayStarted = true;
+	}
+
+	const bool hasDependency = (header.flags & MIRANDA_TRACE_HAS_DEPENDENCY);
+	const bool hasTiming = (header.flags & MIRANDA_TRACE_HAS_TIMING);
+	uint64_t nowNano = getCurrentSimTimeNano() - replayStartNano;
+
+	q->reserve(count);
+
+	for(uint32_t i = 0; i < count && ! isFinished(); ++i) {
+		const uint8_t* next = records + (nextRecord * recordSize);
+		const uint8_t* fields = next + sizeof(MirandaTraceRecord);
+
+		MirandaTraceRecord record;
+		memcpy(&record, next, sizeof(MirandaTraceRecord));
+
+		uint32_t dependency = 0;
+		if(hasDependency) {
+			memcpy(&dependency, fields, sizeof(uint32_t));
+			fields += sizeof(uint32_t);
+		}
+
+		if(hasTiming) {
+			uint64_t issueNano = 0;
+			memcpy(&issueNano, fields, sizeof(uint64_t));
+
+			// Not due yet, the CPU asks again next cycle
+			if(issueNano > nowNano) {
+				break;
+			}
+		}
+
+		GeneratorRequest* req;
+
+		switch(record.op) {
+		case MIRANDA_TRACE_READ:
+			req = new MemoryOpRequest(record.address + addressOffset, record.length, READ);
+			break;
+		case MIRANDA_TRACE_WRITE:
+			req = new MemoryOpRequest(record.address + addressOffset, record.length, WRITE);
+			break;
+		case MIRANDA_TRACE_FENCE:
+			req = new FenceOpRequest();
+			break;
+		default:
+			out->fatal(CALL_INFO, -1, "Record %" PRIu64 " has unknown operation %" PRIu32 "\n",
+				nextRecord, (uint32_t) record.op);
+			return;
+		}
+
+		// The producer may have been generated by an earlier call and be
+		// complete already, the CPU drops dependencies on retired requests
+		if(dependency > 0 && dependency <= nextRecord && dependency <= recentIDs.size()) {
+			req->addDependency(recentIDs[(nextRecord - dependency) & recentMask]);
+		}
+
+		recentIDs[nextRecord & recentMask] = req->getRequestID();
+
+		q->push_back(req);
+
+		nextRecord++;
+
+		if(nextRecord == header.recordCount) {
+			out->verbose(CALL_INFO, 2, 0, "Completed replay iteration, %" PRIu64 " remaining\n", iterations - 1);
+
+			nextRecord = 0;
+			iterations--;
+			replayStartNano = getCurrentSimTimeNano();
+			nowNano = 0;
+		}
+	}
+}
+
+bool TraceReplayGenerator::isFinished() {
+	return (0 == iterations);
+}
+
+void TraceReplayGenerator::completed() {
+
+}
@@ -0,0 +1,120 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_TRACE_REPLAY_GEN
+#define _H_SST_MIRANDA_TRACE_REPLAY_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Miranda address stream format
+ *
+ *   MirandaTraceHeader
+ *   record 0 .. record N-1
+ *
+ * Every record starts with a MirandaTraceRecord. If the header sets
+ * MIRANDA_TRACE_HAS_DEPENDENCY a uint32_t dependency distance follows
+ * (0 = none, k = depends on the k-th previous record) and if it sets
+ * MIRANDA_TRACE_HAS_TIMING a uint64_t issue time in nanoseconds, relative
+ * to the start of the replay, follows that. Values are little endian.
+ */
+#define MIRANDA_TRACE_MAGIC            "MIRTRC01"
+#define MIRANDA_TRACE_VERSION          1
+#define MIRANDA_TRACE_HAS_DEPENDENCY   0x1
+#define MIRANDA_TRACE_HAS_TIMING       0x2
+
+typedef enum {
+	MIRANDA_TRACE_READ  = 0,
+	MIRANDA_TRACE_WRITE = 1,
+	MIRANDA_TRACE_FENCE = 2
+} MirandaTraceOperation;
+
+typedef struct {
+	char     magic[8];
+	uint32_t version;
+	uint32_t flags;
+	uint64_t recordCount;
+} MirandaTraceHeader;
+
+typedef struct {
+	uint64_t address;
+	uint32_t length;
+	uint8_t  op;
+	uint8_t  padding[3];
+} MirandaTraceRecord;
+
+class TraceReplayGenerator : public RequestGenerator {
+
+public:
+	TraceReplayGenerator( ComponentId_t id, Params& params );
+	void build(Params& params);
+	~TraceReplayGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		TraceReplayGenerator,
+		"miranda",
+		"TraceReplayGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Replays a memory mapped binary address stream with optional dependency and timing fields",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+		{ "file",             "Binary address stream to replay (see tracereplay.h for the format)", "" },
+		{ "iterations",       "Number of times to replay the stream", "1" },
+		{ "address_offset",   "Added to every address in the stream", "0" },
+		{ "dependency_window", "Number of previous records a dependency may refer to, dependencies further back are treated as satisfied", "64" }
+	)
+
+private:
+	void mapTrace(const std::string& traceFile);
+
+	Output* out;
+
+	int traceFD;
+	const uint8_t* mapBase;
+	size_t mapLength;
+	MirandaTraceHeader header;
+
+	const uint8_t* records;
+	size_t recordSize;
+	uint64_t nextRecord;
+	uint64_t iterations;
+	uint64_t addressOffset;
+
+	// Request IDs of the most recent records, indexed by record number
+	std::vector<uint64_t> recentIDs;
+	uint64_t recentMask;
+
+	uint64_t replayStartNano;
+	bool replayStarted;
+};
+
+}
+}
+
+#endif
@@ -216,18 +216,17 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 	out->verbose(CALL_INFO, 2, 0, "Recv event for processing from interface\n");
 
         Interfaces::StandardMem::Request::id_t reqID = ev->getID();
-	std::map<Interfaces::StandardMem::Request::id_t, CPURequest*>::iterator reqFind = requestsInFlight.find(reqID);
+	CPURequest* cpuReq = requestsInFlight.find(reqID);
 
-	if(reqFind == requestsInFlight.end()) {
+	if(NULL == cpuReq) {
 		out->fatal(CALL_INFO, -1, "Unable to find request %" PRIu64 " in request map.\n", reqID);
 	} else{
-		CPURequest* cpuReq = reqFind->second;
 
 		out->verbose(CALL_INFO, 4, 0, "Miranda request located ID=%" PRIu64 ", contains %" PRIu32 " parts, issue time=%" PRIu64 ", time now=%" PRIu64 "\n",
 			cpuReq->getOriginalReqID(), cpuReq->countParts(), cpuReq->getIssueTime(), getCurrentSimTimeNano());
 
 		statReqLatency->addData((getCurrentSimTimeNano() - cpuReq->getIssueTime()));
-		requestsInFlight.erase(reqFind);
+		requestsInFlight.erase(reqID);
 
 		// Tell the CPU request one more of its parts are satisfied
 		cpuReq->decPartCount();
@@ -246,7 +245,9 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
 			}
 
-			delete cpuReq;
+			outstandingRequests.erase(cpuReq->getOriginalReqID());
+
+			requestsInFlight.release(cpuReq);
 		}
 
 		delete ev;
@@ -279,11 +280,11 @@ void RequestGenCPU::issueCustomRequest(CustomOpRequest* req) {
     
     Interfaces::StandardMem::CustomReq* request = new Interfaces::StandardMem::CustomReq(req->getPayload());
         
-    CPURequest* newCPUReq = new CPURequest(req->getRequestID());
+    CPURequest* newCPUReq = requestsInFlight.allocate(req->getRequestID());
     newCPUReq->incPartCount();
     newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-    requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(request->getID(), newCPUReq) );
+    requestsInFlight.insert(request->getID(), newCPUReq);
     cache_link->send(request);
         
     requestsPending[CUSTOM]++;
@@ -337,13 +338,13 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
             reqUpper = new Interfaces::StandardMem::Write(upperAddress, upperLength, data);
         }
 
-        CPURequest* newCPUReq = new CPURequest(req->getRequestID());
+        CPURequest* newCPUReq = requestsInFlight.allocate(req->getRequestID());
     	newCPUReq->incPartCount();
         newCPUReq->incPartCount();
     	newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-    	requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(reqLower->getID(), newCPUReq) );
-        requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(reqUpper->getID(), newCPUReq) );
+    	requestsInFlight.insert(reqLower->getID(), newCPUReq);
+        requestsInFlight.insert(reqUpper->getID(), newCPUReq);
 
     	out->verbose(CALL_INFO, 4, 0, "Issuing requesting into cache link...\n");
         cache_link->send(reqLower);
@@ -368,11 +369,11 @@ void RequestGenCPU::issueRequest(MemoryOpRequest* req) {
             request = new Interfaces::StandardMem::Write(addr, reqLength, data, false, 0, addr);
         }
 
-        CPURequest* newCPUReq = new CPURequest(req->getRequestID());
+        CPURequest* newCPUReq = requestsInFlight.allocate(req->getRequestID());
         newCPUReq->incPartCount();
         newCPUReq->setIssueTime(getCurrentSimTimeNano());
 
-        requestsInFlight.insert( std::pair<Interfaces::StandardMem::Request::id_t, CPURequest*>(request->getID(), newCPUReq) );
+        requestsInFlight.insert(request->getID(), newCPUReq);
         cache_link->send(request);
 
         requestsPending[operation]++;
@@ -437,16 +438,24 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
+    std::vector<uint32_t>& delReqs = retiredRequests;
+    delReqs.clear();
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
-    for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
-        if( reqGen->isFinished()) {
-            break;
-    	} else {
-            reqGen->generate(&pendingRequests);
-    	}
+    if(pendingRequests.size() < maxOpLookup && ! reqGen->isFinished()) {
+        const uint32_t firstGenerated = pendingRequests.size();
+        reqGen->generate(&pendingRequests, maxOpLookup - pendingRequests.size());
+
+        // Generators may depend on requests from an earlier call, some of
+        // which have completed already and will not notify anyone again
+        for(uint32_t i = firstGenerated; i < pendingRequests.size(); ++i) {
+            outstandingRequests.insert(pendingRequests.at(i)->getRequestID());
+        }
+
+        for(uint32_t i = firstGenerated; i < pendingRequests.size(); ++i) {
+            pendingRequests.at(i)->satisfyRetiredDependencies(outstandingRequests);
+        }
     }
 
     for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
@@ -463,7 +472,6 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
             break;
     	}
 
-        MemoryOpRequest* memOpReq;
 	GeneratorRequest* nxtRq = pendingRequests.at(i);
 
 	if(nxtRq->getOperation() == REQ_FENCE) {
@@ -472,6 +480,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
                 // Keep record we will delete fence at i
     		delReqs.push_back(i);
+                outstandingRequests.erase(nxtRq->getRequestID());
 
                 // Delete the fence
     		delete nxtRq;
@@ -501,7 +510,8 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
                     delete nxtRq;
                 }
             }
-        } else if ( ( memOpReq = dynamic_cast<MemoryOpRequest*>(nxtRq) ) ) {
+        } else if (nxtRq->getOperation() == READ || nxtRq->getOperation() == WRITE) {
+            MemoryOpRequest* memOpReq = static_cast<MemoryOpRequest*>(nxtRq);
 
             if( requestsPending[memOpReq->getOperation()] < maxRequestsPending[memOpReq->getOperation()] ) {
                 out->verbose(CALL_INFO, 4, 0, "Will attempt to issue as free slots in the load/store unit.\n");
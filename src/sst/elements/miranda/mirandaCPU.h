@@ -24,6 +24,9 @@
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
 
+#include <deque>
+#include <unordered_set>
+
 using namespace SST;
 using namespace SST::Interfaces;
 using namespace SST::Statistics;
@@ -33,6 +36,8 @@ namespace Miranda {
 
 class CPURequest {
 public:
+    CPURequest() :
+        originalID(0), issueTime(0), outstandingParts(0) {}
     CPURequest(const uint64_t origID) :
         originalID(origID), issueTime(0), outstandingParts(0) {}
     void incPartCount() { outstandingParts++; }
@@ -48,6 +53,129 @@ protected:
     uint32_t outstandingParts;
 };
 
+/*
+ * Requests in flight to the memory system, keyed by StandardMem request ID.
+ * CPURequests are held by value in a pool of slots which are reused as
+ * requests complete, and the ID lookup is an open addressed table so
+ * issue and completion do not allocate.
+ */
+class CPURequestTable {
+public:
+    CPURequestTable() : entryCount(0) {
+        resizeTable(64);
+    }
+
+    CPURequest* allocate(const uint64_t origID) {
+        CPURequest* req;
+
+        if(freeRequests.empty()) {
+            requests.push_back(CPURequest(origID));
+            req = &requests.back();
+        } else {
+            req = freeRequests.back();
+            freeRequests.pop_back();
+            *req = CPURequest(origID);
+        }
+
+        return req;
+    }
+
+    void release(CPURequest* req) {
+        freeRequests.push_back(req);
+    }
+
+    void insert(const StandardMem::Request::id_t id, CPURequest* req) {
+        if((entryCount + 1) * 2 > keys.size()) {
+            resizeTable(keys.size() * 2);
+        }
+
+        size_t slot = hash(id);
+        while(NULL != values[slot]) {
+            slot = (slot + 1) & mask;
+        }
+
+        keys[slot] = id;
+        values[slot] = req;
+        entryCount++;
+    }
+
+    CPURequest* find(const StandardMem::Request::id_t id) const {
+        for(size_t slot = hash(id); NULL != values[slot]; slot = (slot + 1) & mask) {
+            if(keys[slot] == id) {
+                return values[slot];
+            }
+        }
+
+        return NULL;
+    }
+
+    void erase(const StandardMem::Request::id_t id) {
+        size_t slot = hash(id);
+
+        while(NULL != values[slot] && keys[slot] != id) {
+            slot = (slot + 1) & mask;
+        }
+
+        if(NULL == values[slot]) {
+            return;
+        }
+
+        // Backward shift deletion keeps probe sequences unbroken
+        size_t next = (slot + 1) & mask;
+        while(NULL != values[next]) {
+            const size_t home = hash(keys[next]);
+
+            if(((next - home) & mask) >= ((next - slot) & mask)) {
+                keys[slot] = keys[next];
+                values[slot] = values[next];
+                slot = next;
+            }
+
+            next = (next + 1) & mask;
+        }
+
+        values[slot] = NULL;
+        entryCount--;
+    }
+
+    size_t size() const {
+        return entryCount;
+    }
+
+private:
+    size_t hash(const StandardMem::Request::id_t id) const {
+        return (size_t) ((id * 0x9E3779B97F4A7C15ULL) >> 20) & mask;
+    }
+
+    void resizeTable(const size_t newSize) {
+        std::vector<StandardMem::Request::id_t> oldKeys;
+        std::vector<CPURequest*> oldValues;
+
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+
+        keys.assign(newSize, 0);
+        values.assign(newSize, NULL);
+        mask = newSize - 1;
+        entryCount = 0;
+
+        for(size_t i = 0; i < oldValues.size(); ++i) {
+            if(NULL != oldValues[i]) {
+                insert(oldKeys[i], oldValues[i]);
+            }
+        }
+    }
+
+    // deque keeps CPURequest addresses stable as the pool grows
+    std::deque<CPURequest> requests;
+    std::vector<CPURequest*> freeRequests;
+
+    std::vector<StandardMem::Request::id_t> keys;
+    std::vector<CPURequest*> values;
+    size_t mask;
+    size_t entryCount;
+};
+
 class RequestGenCPU : public SST::Component {
 public:
 
@@ -141,13 +269,15 @@ private:
     TimeConverter* timeConverter;
     Clock::HandlerBase* clockHandler;
     RequestGenerator* reqGen;
-    std::map<StandardMem::Request::id_t, CPURequest*> requestsInFlight;
+    CPURequestTable requestsInFlight;
     StandardMem* cache_link;
     Link* srcLink;
     MirandaReqEvent* srcReqEvent;
     StdMemHandler* stdMemHandlers;
 
     MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+    std::vector<uint32_t> retiredRequests;
+    std::unordered_set<uint64_t> outstandingRequests;
     MirandaMemoryManager* memMgr;
 
     uint32_t maxRequestsPending[OPCOUNT];
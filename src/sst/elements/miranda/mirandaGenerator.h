@@ -23,7 +23,12 @@
 #include <sst/core/output.h>
 #include <sst/core/interfaces/stdMem.h>
 
+#include <algorithm>
+#include <atomic>
+#include <new>
 #include <queue>
+#include <unordered_set>
+#include <vector>
 
 namespace SST {
 namespace Miranda {
@@ -37,9 +42,63 @@ typedef enum {
 } ReqOperation;
 
 
+#define MIRANDA_INLINE_DEPENDENCIES 2
+
+/*
+ * Thread local free list of fixed size blocks, generators allocate and
+ * retire requests at the rate the CPU issues them so recycling the blocks
+ * keeps the window from going back to the heap for every request.
+ */
+template<size_t BlockSize>
+class MirandaRequestPool {
+public:
+	static void* allocate() {
+		FreeList& pool = freeList();
+
+		if(NULL == pool.head) {
+			return ::operator new(BlockSize);
+		}
+
+		FreeBlock* block = pool.head;
+		pool.head = block->next;
+		return block;
+	}
+
+	static void release(void* ptr) {
+		FreeList& pool = freeList();
+		FreeBlock* block = static_cast<FreeBlock*>(ptr);
+
+		block->next = pool.head;
+		pool.head = block;
+	}
+
+private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct FreeList {
+		FreeList() : head(NULL) {}
+		~FreeList() {
+			while(NULL != head) {
+				FreeBlock* next = head->next;
+				::operator delete(head);
+				head = next;
+			}
+		}
+
+		FreeBlock* head;
+	};
+
+	static FreeList& freeList() {
+		static thread_local FreeList pool;
+		return pool;
+	}
+};
+
 class GeneratorRequest {
 public:
-	GeneratorRequest() {
+	GeneratorRequest() : inlineDepCount(0) {
 		reqID = nextGeneratorRequestID++;
 	}
 
@@ -48,7 +107,13 @@ public:
 	uint64_t getRequestID() const { return reqID; }
 
 	void addDependency(uint64_t depReq) {
-		dependsOn.push_back(depReq);
+		// Most requests have one or two dependencies, only spill to the
+		// heap for the long dependency lists (e.g. SpMV row results)
+		if(inlineDepCount < MIRANDA_INLINE_DEPENDENCIES) {
+			inlineDeps[inlineDepCount++] = depReq;
+		} else {
+			dependsOn.push_back(depReq);
+		}
 	}
 
 	void satisfyDependency(const GeneratorRequest* req) {
@@ -56,18 +121,54 @@ public:
 	}
 
 	void satisfyDependency(const uint64_t req) {
+		for(uint32_t i = 0; i < inlineDepCount; ++i) {
+			if( req == inlineDeps[i] ) {
+				inlineDeps[i] = inlineDeps[--inlineDepCount];
+
+				// Keep the inline slots full while there are spilled dependencies
+				if(! dependsOn.empty()) {
+					inlineDeps[inlineDepCount++] = dependsOn.back();
+					dependsOn.pop_back();
+				}
+
+				return;
+			}
+		}
+
 		std::vector<uint64_t>::iterator searchDeps;
 
 		for(searchDeps = dependsOn.begin(); searchDeps != dependsOn.end(); searchDeps++) {
 			if( req == (*searchDeps) ) {
-				dependsOn.erase(searchDeps);
+				(*searchDeps) = dependsOn.back();
+				dependsOn.pop_back();
 				break;
 			}
 		}
 	}
 
+	// A dependency on a request which completed before this one was
+	// generated is never satisfied by a response, drop it here
+	void satisfyRetiredDependencies(const std::unordered_set<uint64_t>& outstanding) {
+		for(uint32_t i = 0; i < inlineDepCount; ) {
+			if(0 == outstanding.count(inlineDeps[i])) {
+				satisfyDependency(inlineDeps[i]);
+			} else {
+				i++;
+			}
+		}
+
+		for(size_t i = 0; i < dependsOn.size(); ) {
+			if(0 == outstanding.count(dependsOn[i])) {
+				dependsOn[i] = dependsOn.back();
+				dependsOn.pop_back();
+			} else {
+				i++;
+			}
+		}
+	}
+
 	bool canIssue() {
-		return dependsOn.empty();
+		return 0 == inlineDepCount;
 	}
 
 	uint64_t getIssueTime() const {
@@ -80,17 +181,25 @@ public:
 protected:
 	uint64_t reqID;
 	uint64_t issueTime;
+	uint64_t inlineDeps[MIRANDA_INLINE_DEPENDENCIES];
+	uint32_t inlineDepCount;
 	std::vector<uint64_t> dependsOn;
 private:
 	static std::atomic<uint64_t> nextGeneratorRequestID;
 };
 
+/*
+ * Window of generated requests, kept as a ring so retiring the oldest
+ * requests only moves the head and erasing from the middle compacts in
+ * place rather than reallocating the queue every cycle.
+ */
 template<typename QueueType>
 class MirandaRequestQueue {
 public:
        	MirandaRequestQueue() {
                         theQ = (QueueType*) malloc(sizeof(QueueType) * 16);
                         maxCapacity = 16;
+                        head = 0;
                         curSize = 0;
                 }
         ~MirandaRequestQueue() {
@@ -102,20 +211,31 @@ public:
         }
 
         void resize(const uint32_t newSize) {
-//		printf("Resizing MirandaQueue from: %" PRIu32 " to %" PRIu32 "\n",
-//			curSize, newSize);
+		uint32_t newCapacity = 16;
+		while(newCapacity < newSize) {
+			newCapacity *= 2;
+		}
+
+               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newCapacity);
+		curSize = std::min(curSize, newSize);
 
-               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newSize);
                	for(uint32_t i = 0; i < curSize; ++i) {
-                       	newQ[i] = theQ[i];
+                       	newQ[i] = at(i);
                 }
 
                 free(theQ);
                	theQ = newQ;
-               	maxCapacity = newSize;
-               	curSize = std::min(curSize, newSize);
+               	maxCapacity = newCapacity;
+		head = 0;
         }
 
+	// Ensure count more entries can be pushed without growing the ring
+	void reserve(const uint32_t count) {
+		if(curSize + count > maxCapacity) {
+			resize(curSize + count);
+		}
+	}
+
 	uint32_t size() const {
 		return curSize;
 	}
@@ -125,52 +245,51 @@ public:
 	}
 
        	QueueType at(const uint32_t index) {
-               	return theQ[index];
+               	return theQ[(head + index) & (maxCapacity - 1)];
        	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+       	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
-
-               	uint32_t nextSkipIndex = 0;
-               	uint32_t nextSkip = eraseList.at(nextSkipIndex);
-                uint32_t nextNewQIndex = 0;
-
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	if(nextSkip == i) {
-                                nextSkipIndex++;
-
-                                if(nextSkipIndex >= eraseList.size()) {
-                                       	nextSkip = curSize;
-                               	} else {
-                                       	nextSkip = eraseList.at(nextSkipIndex);
-                                }
-                       	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
-                                nextNewQIndex++;
-                       	}
-               	}
+		// Requests retired from the front of the window just advance the head
+		uint32_t nextSkipIndex = 0;
+		while(nextSkipIndex < eraseList.size() && eraseList[nextSkipIndex] == nextSkipIndex) {
+			nextSkipIndex++;
+		}
 
-                free(theQ);
+		const uint32_t frontErased = nextSkipIndex;
+		const uint32_t mask = maxCapacity - 1;
+		uint32_t nextSkip = (nextSkipIndex < eraseList.size()) ? eraseList[nextSkipIndex] : curSize;
+		uint32_t nextNewQIndex = frontErased;
+
+		for(uint32_t i = frontErased; i < curSize; ++i) {
+			if(nextSkip == i) {
+				nextSkipIndex++;
+				nextSkip = (nextSkipIndex < eraseList.size()) ? eraseList[nextSkipIndex] : curSize;
+			} else {
+				theQ[(head + nextNewQIndex) & mask] = theQ[(head + i) & mask];
+				nextNewQIndex++;
+			}
+		}
 
-               	theQ = newQ;
-		curSize = nextNewQIndex;
+		head = (head + frontErased) & mask;
+		curSize = nextNewQIndex - frontErased;
         }
 
 	void push_back(QueueType t) {
                 if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
+                        resize(maxCapacity * 2);
                 }
 
-                theQ[curSize] = t;
+                theQ[(head + curSize) & (maxCapacity - 1)] = t;
                 curSize++;
         }
 private:
         QueueType* theQ;
         uint32_t maxCapacity;
+        uint32_t head;
         uint32_t curSize;
 };
 
@@ -182,6 +301,20 @@ public:
 		GeneratorRequest(),
 		addr(cAddr), length(cLength), op(cOpType) {}
 	~MemoryOpRequest() {}
+
+	static void* operator new(size_t size) {
+		return (sizeof(MemoryOpRequest) == size) ?
+			MirandaRequestPool<sizeof(MemoryOpRequest)>::allocate() : ::operator new(size);
+	}
+
+	static void operator delete(void* ptr, size_t size) {
+		if(sizeof(MemoryOpRequest) == size) {
+			MirandaRequestPool<sizeof(MemoryOpRequest)>::release(ptr);
+		} else {
+			::operator delete(ptr);
+		}
+	}
+
 	ReqOperation getOperation() const { return op; }
 	bool isRead() const { return op == READ; }
 	bool isWrite() const { return op == WRITE; }
@@ -223,6 +356,15 @@ public:
 	RequestGenerator( ComponentId_t id, Params& params) : SubComponent(id) {}
 	~RequestGenerator() {}
 	virtual void generate(MirandaRequestQueue<GeneratorRequest*>* q) { }
+
+	// Performs up to count generation steps (each equivalent to one call of
+	// generate(q)) stopping early if the generator finishes. Generators
+	// override this to fill the window without a virtual call per step.
+	virtual void generate(MirandaRequestQueue<GeneratorRequest*>* q, const uint32_t count) {
+		for(uint32_t i = 0; i < count && ! isFinished(); ++i) {
+			generate(q);
+		}
+	}
 	virtual bool isFinished() { return true; }
 	virtual void completed() { }
 
@@ -15,6 +15,7 @@
 
 #include <sst_config.h>
 
+#include "generators/compositegen.h"
 #include "generators/copygen.h"
 #include "generators/gupsgen.h"
 #include "generators/inorderstreambench.h"
@@ -26,3 +27,4 @@
 #include "generators/stencil3dbench.h"
 #include "generators/streambench.h"
 #include "generators/streambench_customcmd.h"
+#include "generators/tracereplay.h"
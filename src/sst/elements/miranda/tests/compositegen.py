@@ -0,0 +1,91 @@
+import os
+import sys
+import getopt
+import tempfile
+
+import sst
+
+mode = "interleave"
+
+try:
+    opts, args = getopt.getopt(sys.argv[1:], "", ["mode="])
+except getopt.GetoptError as err:
+    print(str(err))
+    sys.exit(2)
+for o, a in opts:
+    if o == "--mode":
+        mode = a
+
+# Replay the reference trace next to a read stream
+test_dir = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, test_dir)
+import mirandatrace
+
+trace_fd, trace_file = tempfile.mkstemp(prefix="miranda_compositegen_", suffix=".mtrc")
+os.close(trace_fd)
+mirandatrace.convert(os.path.join(test_dir, "tracereplay.trace"), trace_file)
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "miranda.BaseCPU")
+comp_cpu.addParams({
+	"verbose" : 0,
+	"printStats" : 1,
+})
+
+gen = comp_cpu.setSubComponent("generator", "miranda.CompositeGenerator")
+gen.addParams({
+	"verbose" : 0,
+	"mode" : mode,
+	"generator_count" : 2,
+	"generator0" : "miranda.TraceReplayGenerator",
+	"generator0Params.file" : trace_file,
+	"generator0Params.address_offset" : 4096,
+	"weight0" : 1,
+	"generator1" : "miranda.SingleStreamGenerator",
+	"generator1Params.startat" : 0x80000,
+	"generator1Params.count" : 256,
+	"generator1Params.max_address" : 0x100000,
+	"weight1" : 4,
+})
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+# Only the request counts are the same in every mode
+comp_cpu.enableStatistics(["read_reqs", "write_reqs", "split_read_reqs", "split_write_reqs",
+	"total_bytes_read", "total_bytes_write"], {"type":"sst.AccumulatorStatistic"})
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams({
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "debug" : "0",
+      "L1" : "1",
+      "cache_size" : "2KB"
+})
+
+comp_memctrl = sst.Component("memory", "memHierarchy.MemController")
+comp_memctrl.addParams({
+      "clock" : "1GHz",
+      "addr_range_end" : 512 * 1024 * 1024 - 1
+})
+memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+      "access_time" : "100 ns",
+      "mem_size" : "512MiB",
+})
+
+# Define the simulation links
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (comp_cpu, "cache_link", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+link_cpu_cache_link.setNoCut()
+
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_memctrl, "direct_link", "50ps") )
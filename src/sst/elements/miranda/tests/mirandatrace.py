@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+#
+# Writes Miranda MIRTRC01 address streams for miranda.TraceReplayGenerator
+# (see generators/tracereplay.h for the binary layout).
+#
+# The text form has one record per line, blank lines and anything after a
+# '#' are ignored:
+#
+#   R <address> <length> [dep=<k>] [t=<ns>]
+#   W <address> <length> [dep=<k>] [t=<ns>]
+#   F [dep=<k>] [t=<ns>]
+#
+# Addresses and lengths accept any Python integer literal. dep=k makes the
+# record depend on the k-th previous record and t=ns holds it back until ns
+# nanoseconds after the start of the replay. If any record uses dep or t
+# the field is written for every record (as 0 where it is missing).
+#
+# Usage: mirandatrace.py <text trace> <binary trace>
+
+import struct
+import sys
+
+MAGIC = b"MIRTRC01"
+VERSION = 1
+HAS_DEPENDENCY = 0x1
+HAS_TIMING = 0x2
+
+OPS = { "R" : 0, "W" : 1, "F" : 2 }
+
+def parse(lines):
+    records = []
+    for lineno, line in enumerate(lines, 1):
+        fields = line.split("#", 1)[0].split()
+        if not fields:
+            continue
+
+        op = fields[0].upper()
+        if op not in OPS:
+            raise ValueError("line {0}: unknown operation {1}".format(lineno, fields[0]))
+
+        record = { "op" : OPS[op], "address" : 0, "length" : 0, "dep" : None, "time" : None }
+        args = fields[1:]
+        if op != "F":
+            if len(args) < 2:
+                raise ValueError("line {0}: {1} needs an address and a length".format(lineno, op))
+            record["address"] = int(args[0], 0)
+            record["length"] = int(args[1], 0)
+            args = args[2:]
+
+        for arg in args:
+            key, _, value = arg.partition("=")
+            if key == "dep":
+                record["dep"] = int(value, 0)
+            elif key == "t":
+                record["time"] = int(value, 0)
+            else:
+                raise ValueError("line {0}: unknown field {1}".format(lineno, arg))
+
+        records.append(record)
+    return records
+
+def write(path, records):
+    flags = 0
+    if any(r["dep"] is not None for r in records):
+        flags |= HAS_DEPENDENCY
+    if any(r["time"] is not None for r in records):
+        flags |= HAS_TIMING
+
+    with open(path, "wb") as f:
+        f.write(struct.pack("<8sIIQ", MAGIC, VERSION, flags, len(records)))
+        for r in records:
+            f.write(struct.pack("<QIB3x", r["address"], r["length"], r["op"]))
+            if flags & HAS_DEPENDENCY:
+                f.write(struct.pack("<I", r["dep"] or 0))
+            if flags & HAS_TIMING:
+                f.write(struct.pack("<Q", r["time"] or 0))
+
+def convert(text_path, binary_path):
+    with open(text_path, "r") as f:
+        records = parse(f.readlines())
+    write(binary_path, records)
+    return records
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit("Usage: {0} <text trace> <binary trace>".format(sys.argv[0]))
+    records = convert(sys.argv[1], sys.argv[2])
+    print("Wrote {0} records to {1}".format(len(records), sys.argv[2]))
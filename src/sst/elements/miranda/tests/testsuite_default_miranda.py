@@ -3,6 +3,8 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+import os
+
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
 
@@ -71,27 +73,65 @@ class testcase_miranda_Component(SSTTestCase):
     def test_miranda_gupsgen(self):
         self.miranda_test_template("gupsgen")
 
+    def test_miranda_tracereplay(self):
+        # Only the request counts are compared, they follow from the
+        # reference trace and do not depend on memory timing
+        outfile = self.miranda_test_template("tracereplay", grepfor="cpu\\.")
+
+        # With a 4 entry window the second pointer chase cannot start before
+        # 5200 ns and its 16 dependent 100 ns misses take 1600 ns more, it
+        # would finish near 4500 ns if the misses were issued in parallel
+        simTime = self._simulatedTimeNano(outfile)
+        self.assertTrue(simTime >= 6000, "Trace replay finished at {0} ns, the pointer chase was not serialized".format(simTime))
+
+    def test_miranda_compositegen_interleave(self):
+        self.miranda_compositegen_template("interleave")
+
+    def test_miranda_compositegen_sequence(self):
+        self.miranda_compositegen_template("sequence")
+
+    def test_miranda_compositegen_phase(self):
+        self.miranda_compositegen_template("phase")
+
 #####
 
-    def miranda_test_template(self, testcase, testtimeout=240):
+    def miranda_compositegen_template(self, mode):
+        # Every mode issues the same requests, only their order changes
+        outfile = self.miranda_test_template("compositegen", grepfor="cpu\\.", variant=mode,
+            otherargs='--model-options=\"--mode={0}\"'.format(mode))
+
+        # The replayed pointer chase starts at 2000 ns and is 16 dependent
+        # 100 ns misses, even when interleave hands it one record per call
+        simTime = self._simulatedTimeNano(outfile)
+        self.assertTrue(simTime >= 3600, "Composite {0} run finished at {1} ns, the pointer chase was not serialized".format(mode, simTime))
+
+    def miranda_test_template(self, testcase, testtimeout=240, grepfor=None, variant=None, otherargs=""):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
         tmpdir = self.get_test_output_tmp_dir()
 
-        # Set the various file paths
+        # Set the various file paths, variants share the config and reference
         testDataFileName="test_miranda_{0}".format(testcase)
-
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+
+        if variant is not None:
+            testDataFileName = "{0}_{1}".format(testDataFileName, variant)
+
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
 
-        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
 
         testing_remove_component_warning_from_file(outfile)
 
+        cmpfile = outfile
+        if grepfor is not None:
+            cmpfile = "{0}/{1}.cmp".format(tmpdir, testDataFileName)
+            os.system("grep '{0}' {1} > {2}".format(grepfor, outfile, cmpfile))
+
         # NOTE: THE PASS / FAIL EVALUATIONS ARE PORTED FROM THE SQE BAMBOO
         #       BASED testSuite_XXX.sh THESE SHOULD BE RE-EVALUATED BY THE
         #       DEVELOPER AGAINST THE LATEST VERSION OF SST TO SEE IF THE
@@ -102,8 +142,19 @@ class testcase_miranda_Component(SSTTestCase):
             log_testing_note("miranda test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
 
         # Perform the test
-        cmp_result = testing_compare_sorted_diff(testcase, outfile, reffile)
+        cmp_result = testing_compare_sorted_diff(testcase, cmpfile, reffile)
         if (cmp_result == False):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
-        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
\ No newline at end of file
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(cmpfile, reffile))
+        return outfile
+
+    def _simulatedTimeNano(self, outfile):
+        # "Simulation is complete, simulated time: 6.8125 us"
+        scale = { "s" : 1e9, "ms" : 1e6, "us" : 1e3, "ns" : 1.0, "ps" : 1e-3 }
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                if "simulated time:" in line:
+                    fields = line.split("simulated time:")[1].split()
+                    return float(fields[0]) * scale.get(fields[1], 0.0)
+        return 0.0
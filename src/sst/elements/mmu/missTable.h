@@ -0,0 +1,185 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MMU_MISS_TABLE_H
+#define MMU_MISS_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SST {
+
+namespace MMU_Lib {
+
+/*
+ * Outstanding translation misses keyed by page number. The first miss to a
+ * page creates the entry, later misses to the same page wait on it in FIFO
+ * order. Entries live in an open addressed hash table and their waiter
+ * lists are recycled, so steady state misses do not allocate.
+ */
+template< typename T >
+class MissTable {
+
+  public:
+    class Waiters {
+      public:
+        Waiters() : m_head(0) {}
+        bool empty() const { return m_head == m_items.size(); }
+        size_t size() const { return m_items.size() - m_head; }
+        T& front() { return m_items[m_head]; }
+        void push( const T& item ) { m_items.push_back( item ); }
+        void pop() { ++m_head; }
+
+        typename std::vector<T>::iterator begin() { return m_items.begin() + m_head; }
+        typename std::vector<T>::iterator end() { return m_items.end(); }
+
+      private:
+        friend class MissTable;
+        void reset() { m_items.clear(); m_head = 0; }
+
+        std::vector<T> m_items;
+        size_t m_head;
+    };
+
+    MissTable( size_t expected = 64 ) : m_count(0) {
+        size_t cap = 16;
+        while ( cap < expected * 2 ) {
+            cap <<= 1;
+        }
+        m_slots.resize( cap );
+        m_mask = cap - 1;
+    }
+
+    size_t size() const { return m_count; }
+
+    bool contains( uint64_t key ) const { return nullptr != lookup( key ); }
+
+    Waiters* find( uint64_t key ) {
+        const Slot* slot = lookup( key );
+        return slot ? &m_lists[ slot->list ] : nullptr;
+    }
+
+    // Returns the waiters for key, creating an empty entry if there is none
+    Waiters& operator[]( uint64_t key ) {
+        Waiters* waiters = find( key );
+        if ( waiters ) {
+            return *waiters;
+        }
+
+        if ( ( m_count + 1 ) * 2 > m_slots.size() ) {
+            grow();
+        }
+
+        uint32_t list;
+        if ( m_freeLists.empty() ) {
+            list = m_lists.size();
+            m_lists.push_back( Waiters() );
+        } else {
+            list = m_freeLists.back();
+            m_freeLists.pop_back();
+        }
+
+        place( key, list );
+        ++m_count;
+        return m_lists[list];
+    }
+
+    bool erase( uint64_t key ) {
+        size_t i = hash( key );
+        while ( m_slots[i].used && m_slots[i].key != key ) {
+            i = ( i + 1 ) & m_mask;
+        }
+        if ( ! m_slots[i].used ) {
+            return false;
+        }
+
+        m_lists[ m_slots[i].list ].reset();
+        m_freeLists.push_back( m_slots[i].list );
+
+        // backward shift the rest of the probe chain into the hole
+        size_t hole = i;
+        size_t j = ( i + 1 ) & m_mask;
+        while ( m_slots[j].used ) {
+            size_t home = hash( m_slots[j].key );
+            if ( ( ( j - home ) & m_mask ) >= ( ( j - hole ) & m_mask ) ) {
+                m_slots[hole] = m_slots[j];
+                hole = j;
+            }
+            j = ( j + 1 ) & m_mask;
+        }
+        m_slots[hole].used = false;
+        --m_count;
+        return true;
+    }
+
+  private:
+    struct Slot {
+        Slot() : key(0), list(0), used(false) {}
+        uint64_t key;
+        uint32_t list;
+        bool used;
+    };
+
+    size_t hash( uint64_t key ) const {
+        // Fibonacci hashing spreads strided page numbers across the table
+        return ( key * 0x9E3779B97F4A7C15ULL ) >> 32 & m_mask;
+    }
+
+    const Slot* lookup( uint64_t key ) const {
+        size_t i = hash( key );
+        while ( m_slots[i].used ) {
+            if ( m_slots[i].key == key ) {
+                return &m_slots[i];
+            }
+            i = ( i + 1 ) & m_mask;
+        }
+        return nullptr;
+    }
+
+    void place( uint64_t key, uint32_t list ) {
+        size_t i = hash( key );
+        while ( m_slots[i].used ) {
+            i = ( i + 1 ) & m_mask;
+        }
+        m_slots[i].key = key;
+        m_slots[i].list = list;
+        m_slots[i].used = true;
+    }
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap( m_slots );
+        m_slots.resize( old.size() * 2 );
+        m_mask = m_slots.size() - 1;
+        for ( size_t i = 0; i < old.size(); i++ ) {
+            if ( old[i].used ) {
+                place( old[i].key, old[i].list );
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_mask;
+    size_t m_count;
+
+    std::vector<Waiters> m_lists;
+    std::vector<uint32_t> m_freeLists;
+};
+
+} //namespace MMU_Lib
+} //namespace SST
+
+#endif /* MMU_MISS_TABLE_H */
@@ -0,0 +1,242 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MMU_RADIX_TABLE_H
+#define MMU_RADIX_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace SST {
+
+namespace MMU_Lib {
+
+/*
+ * Radix tree keyed by page number, 9 bits per level like an x86 page table.
+ * Each level is a flat array of fixed size nodes and children are stored as
+ * indices into the level below, so a copy of the table is a deep copy. The
+ * tree grows in height as larger keys are inserted. Nodes are not reclaimed
+ * on erase, page tables rarely shrink.
+ */
+template< typename V >
+class RadixTable {
+
+    static const int LevelBits = 9;
+    static const int Fanout = 1 << LevelBits;
+    static const uint64_t SlotMask = Fanout - 1;
+    static const int MaxHeight = ( 64 + LevelBits - 1 ) / LevelBits;
+
+    struct Leaf {
+        Leaf() {
+            for ( int i = 0; i < Fanout / 64; i++ ) {
+                present[i] = 0;
+            }
+        }
+        bool isPresent( uint64_t slot ) const { return present[slot / 64] & ( (uint64_t) 1 << ( slot % 64 ) ); }
+        void setPresent( uint64_t slot ) { present[slot / 64] |= ( (uint64_t) 1 << ( slot % 64 ) ); }
+        void clearPresent( uint64_t slot ) { present[slot / 64] &= ~( (uint64_t) 1 << ( slot % 64 ) ); }
+
+        V value[Fanout];
+        uint64_t present[Fanout / 64];
+    };
+
+    // child index + 1, 0 is an empty slot
+    struct Node {
+        Node() {
+            for ( int i = 0; i < Fanout; i++ ) {
+                child[i] = 0;
+            }
+        }
+        uint32_t child[Fanout];
+    };
+
+  public:
+    RadixTable() : m_height(0), m_count(0), m_lastLeafKey(0), m_lastLeaf(-1) {}
+
+    size_t size() const { return m_count; }
+    bool empty() const { return 0 == m_count; }
+
+    bool contains( uint64_t key ) { return nullptr != find( key ); }
+
+    V* find( uint64_t key ) {
+        int leaf = findLeaf( key );
+        if ( leaf < 0 ) {
+            return nullptr;
+        }
+        Leaf& l = m_leaves[leaf];
+        uint64_t slot = key & SlotMask;
+        return l.isPresent( slot ) ? &l.value[slot] : nullptr;
+    }
+
+    // Returns the existing value or a default constructed one, like std::map
+    V& operator[]( uint64_t key ) {
+        uint64_t slot = key & SlotMask;
+        Leaf& l = m_leaves[ createLeaf( key ) ];
+        if ( ! l.isPresent( slot ) ) {
+            l.value[slot] = V();
+            l.setPresent( slot );
+            ++m_count;
+        }
+        return l.value[slot];
+    }
+
+    void insert( uint64_t key, const V& value ) {
+        (*this)[key] = value;
+    }
+
+    bool erase( uint64_t key ) {
+        int leaf = findLeaf( key );
+        if ( leaf < 0 ) {
+            return false;
+        }
+        Leaf& l = m_leaves[leaf];
+        uint64_t slot = key & SlotMask;
+        if ( ! l.isPresent( slot ) ) {
+            return false;
+        }
+        l.clearPresent( slot );
+        --m_count;
+        return true;
+    }
+
+    void clear() {
+        m_levels.clear();
+        m_leaves.clear();
+        m_height = 0;
+        m_count = 0;
+        m_lastLeaf = -1;
+    }
+
+    // Calls func( key, value ) for every present entry in key order
+    template< typename Func >
+    void forEach( Func func ) {
+        if ( m_height > 0 ) {
+            visit( m_height - 1, 0, 0, func );
+        }
+    }
+
+  private:
+
+    uint64_t span( int height ) const {
+        return height * LevelBits >= 64 ? 0 : (uint64_t) 1 << ( height * LevelBits );
+    }
+
+    bool covers( uint64_t key ) const {
+        if ( 0 == m_height ) {
+            return false;
+        }
+        uint64_t limit = span( m_height );
+        return 0 == limit || key < limit;
+    }
+
+    int findLeaf( uint64_t key ) {
+        uint64_t leafKey = key >> LevelBits;
+        if ( m_lastLeaf >= 0 && leafKey == m_lastLeafKey ) {
+            return m_lastLeaf;
+        }
+        if ( ! covers( key ) ) {
+            return -1;
+        }
+
+        uint32_t index = 0;
+        for ( int level = m_height - 2; level >= 0; level-- ) {
+            uint32_t child = m_levels[level][index].child[ ( key >> ( LevelBits * ( level + 1 ) ) ) & SlotMask ];
+            if ( 0 == child ) {
+                return -1;
+            }
+            index = child - 1;
+        }
+
+        m_lastLeafKey = leafKey;
+        m_lastLeaf = index;
+        return index;
+    }
+
+    int createLeaf( uint64_t key ) {
+        int leaf = findLeaf( key );
+        if ( leaf >= 0 ) {
+            return leaf;
+        }
+
+        if ( 0 == m_height ) {
+            m_leaves.push_back( Leaf() );
+            m_height = 1;
+        }
+
+        // add a root above the current one until the key is in range, the
+        // old root is always index 0 of its level so it becomes child 0
+        while ( ! covers( key ) ) {
+            m_levels.push_back( std::vector<Node>( 1 ) );
+            m_levels.back()[0].child[0] = 1;
+            ++m_height;
+        }
+
+        uint32_t index = 0;
+        for ( int level = m_height - 2; level >= 0; level-- ) {
+            uint64_t slot = ( key >> ( LevelBits * ( level + 1 ) ) ) & SlotMask;
+            uint32_t child = m_levels[level][index].child[slot];
+            if ( 0 == child ) {
+                if ( 0 == level ) {
+                    m_leaves.push_back( Leaf() );
+                    child = m_leaves.size();
+                } else {
+                    m_levels[level - 1].push_back( Node() );
+                    child = m_levels[level - 1].size();
+                }
+                m_levels[level][index].child[slot] = child;
+            }
+            index = child - 1;
+        }
+
+        m_lastLeafKey = key >> LevelBits;
+        m_lastLeaf = index;
+        return index;
+    }
+
+    template< typename Func >
+    void visit( int depth, uint32_t index, uint64_t prefix, Func& func ) {
+        if ( 0 == depth ) {
+            Leaf& l = m_leaves[index];
+            for ( uint64_t slot = 0; slot < (uint64_t) Fanout; slot++ ) {
+                if ( l.isPresent( slot ) ) {
+                    func( ( prefix << LevelBits ) | slot, l.value[slot] );
+                }
+            }
+            return;
+        }
+
+        Node& n = m_levels[depth - 1][index];
+        for ( uint64_t slot = 0; slot < (uint64_t) Fanout; slot++ ) {
+            if ( n.child[slot] ) {
+                visit( depth - 1, n.child[slot] - 1, ( prefix << LevelBits ) | slot, func );
+            }
+        }
+    }
+
+    // m_levels[0] holds the nodes directly above the leaves
+    std::vector< std::vector<Node> > m_levels;
+    std::vector< Leaf > m_leaves;
+    int m_height;
+    size_t m_count;
+
+    uint64_t m_lastLeafKey;
+    int m_lastLeaf;
+};
+
+} //namespace MMU_Lib
+} //namespace SST
+
+#endif /* MMU_RADIX_TABLE_H */
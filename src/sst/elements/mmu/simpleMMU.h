@@ -19,6 +19,7 @@
 #include <sst/core/link.h>
 #include "mmu.h"
 #include "mmuTypes.h"
+#include "radixTable.h"
 
 namespace SST {
 
@@ -101,30 +102,26 @@ class SimpleMMU : public MMU {
     class PageTable {
       public:
         void add( uint32_t vpn, PTE pte ) { 
-            pteMap[vpn] = pte;
+            pteTable.insert( vpn, pte );
         }
         void remove( uint32_t vpn ) { 
-            pteMap.erase(vpn);
+            pteTable.erase( vpn );
         }
         PTE* find( uint32_t vpn ) {
-            if ( pteMap.find( vpn ) == pteMap.end() ) {
-                return nullptr;
-            } else { 
-                return &pteMap[vpn];
-            }
+            return pteTable.find( vpn );
         }
         void removeWrite(  ) { 
-            for ( auto& kv : pteMap ) {
-                kv.second.perms &= ~0x2;
-            }
+            pteTable.forEach( []( uint64_t vpn, PTE& pte ) {
+                pte.perms &= ~0x2;
+            } );
         }
         void print( const std::string str) {
-            for ( auto& kv : pteMap ) {
-                printf("PageTabl::%s() %s vpn=%d ppn=%d perm=%#x\n",__func__,str.c_str(),kv.first,kv.second.ppn,kv.second.perms);
-            }
+            pteTable.forEach( [&]( uint64_t vpn, PTE& pte ) {
+                printf("PageTabl::%s() %s vpn=%d ppn=%d perm=%#x\n",__func__,str.c_str(),(int)vpn,pte.ppn,pte.perms);
+            } );
         }
       private:
-        std::map<uint32_t,PTE> pteMap; 
+        RadixTable<PTE> pteTable; 
     };
 
     void initPageTable( unsigned pid, PageTable* table = nullptr ) {
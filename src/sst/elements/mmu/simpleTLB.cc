@@ -115,13 +115,15 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
 
     // send the first fill response 
     m_selfLink->send( 0, new SelfEvent( record->reqId, physAddr ));
-    auto& waiting = m_waitingMiss[record->hwThreadId];
-    waiting[vpn].pop();
+    auto& waitingMiss = m_waitingMiss[record->hwThreadId];
+    auto waiting = waitingMiss.find( vpn );
+    assert( waiting );
+    waiting->pop();
     delete record;
 
     // while there are other misses for this page send them 
-    while ( ! waiting[vpn].empty() ) {
-        auto record = reinterpret_cast<TlbRecord*>(waiting[vpn].front());
+    while ( ! waiting->empty() ) {
+        auto record = reinterpret_cast<TlbRecord*>(waiting->front());
 
         uint64_t physAddr = req->getPPN() << m_pageShift | blockOffset( record->virtAddr );
         if( ! req->isSuccess() ) {
@@ -142,9 +144,9 @@ void SimpleTLB::handleMMUEvent( Event* ev ) {
 
         m_selfLink->send( 0, new SelfEvent( record->reqId, physAddr ));
         delete record;
-        waiting[vpn].pop();
+        waiting->pop();
     }
-    waiting.erase(vpn);
+    waitingMiss.erase(vpn);
 
     delete ev;
 }
@@ -163,7 +165,7 @@ void SimpleTLB::getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAdd
 
     TlbEntry* entry = findTlbEntry( hwThreadId, vpn );
 
-    if ( nullptr != entry && checkPerms( perms, entry->perms() ) && waiting.find( vpn ) == waiting.end()) {
+    if ( nullptr != entry && checkPerms( perms, entry->perms() ) && ! waiting.contains( vpn ) ) {
 
         m_dbg.debug(CALL_INFO,1,0,"hit ppn=%zu\n", entry->ppn() );
         uint64_t physAddr = entry->ppn() << m_pageShift | blockOffset( virtAddr );
@@ -175,7 +177,7 @@ void SimpleTLB::getVirtToPhys( RequestID reqId, int hwThreadId, uint64_t virtAdd
 
         m_dbg.debug(CALL_INFO,1,0,"miss id=%#" PRIx64 "\n", id );
 
-        if ( waiting.find( vpn ) == waiting.end() ) {
+        if ( ! waiting.contains( vpn ) ) {
             m_dbg.debug(CALL_INFO,1,0,"miss id=%#" PRIx64 " send to MMU\n", id );
             // we are passing the virtAddr as well as the vpn because we use it for debug with instPtr
             // this addition happened after the initial design and it makes VPN uneeded becuse VPN can be deduced at the MMU with virtAddr
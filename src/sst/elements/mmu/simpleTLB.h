@@ -21,7 +21,7 @@
 
 #include "mmuEvents.h"
 #include "tlb.h"
-#include <queue>
+#include "missTable.h"
 
 namespace SST {
 
@@ -199,7 +199,7 @@ class SimpleTLB : public TLB {
     uint64_t m_minVirtAddr;
     uint64_t m_maxVirtAddr;
 
-    std::vector< std::map<size_t,std::queue<RequestID> > > m_waitingMiss;
+    std::vector< MissTable<RequestID> > m_waitingMiss;
 };
 
 } //namespace MMU_Lib
@@ -78,3 +78,44 @@ ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
 		return NULL;
 	}
 }
+
+uint64_t ProsperoBinaryTraceReader::readCyclesAt(const uint64_t record) {
+	uint64_t reqCycles = 0;
+
+	if(0 != fseeko(traceInput, (off_t) (record * recordLength), SEEK_SET) ||
+		1 != fread(&reqCycles, sizeof(uint64_t), 1, traceInput)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to read record %" PRIu64 " while seeking in binary trace.\n",
+			getName().c_str(), record);
+	}
+
+	return reqCycles;
+}
+
+bool ProsperoBinaryTraceReader::seekToCycle(const uint64_t cycle, ProsperoTraceEntry& entry) {
+	if(0 != fseeko(traceInput, 0, SEEK_END)) {
+		return ProsperoTraceReader::seekToCycle(cycle, entry);
+	}
+
+	const uint64_t recordCount = (uint64_t) ftello(traceInput) / recordLength;
+
+	// Records are written in instruction count order so binary search for
+	// the first record at or after the requested cycle
+	uint64_t lower = 0;
+	uint64_t upper = recordCount;
+
+	while(lower < upper) {
+		const uint64_t middle = lower + ((upper - lower) / 2);
+
+		if(readCyclesAt(middle) < cycle) {
+			lower = middle + 1;
+		} else {
+			upper = middle;
+		}
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Binary reader seek to cycle %" PRIu64 " skips %" PRIu64 " of %" PRIu64 " records.\n",
+		cycle, lower, recordCount);
+
+	fseeko(traceInput, (off_t) (lower * recordLength), SEEK_SET);
+	return fillNextEntry(entry);
+}
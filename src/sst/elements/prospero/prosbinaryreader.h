@@ -28,6 +28,7 @@ public:
     ProsperoBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
     ~ProsperoBinaryTraceReader();
     ProsperoTraceEntry* readNextEntry();
+    bool seekToCycle(const uint64_t cycle, ProsperoTraceEntry& entry);
 
  	SST_ELI_REGISTER_SUBCOMPONENT(
         ProsperoBinaryTraceReader,
@@ -45,6 +46,7 @@ public:
 private:
 	void copy(char* target, const char* source,
 		const size_t offset, const size_t len);
+	uint64_t readCyclesAt(const uint64_t record);
 	FILE* traceInput;
 	char* buffer;
 	uint32_t recordLength;
@@ -0,0 +1,159 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_FORMAT
+#define _H_SST_PROSPERO_BLOCK_FORMAT
+
+#include <stdint.h>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Prospero block trace format
+ *
+ *   ProsperoBlockFileHeader
+ *   block 0 .. block N-1       (each block compressed on its own)
+ *   ProsperoBlockIndexEntry[N] (at header.indexOffset)
+ *
+ * A block decompresses to recordCount ProsperoBlockRecords laid out
+ * exactly as the struct below, so a reader can decompress straight into
+ * an array of records. When the header has PROSPERO_BLOCK_FLAG_COLUMNAR
+ * set a block instead holds each field as its own column (cycle deltas,
+ * address deltas, lengths, then write flags), which compresses far better
+ * and is transposed back into records after decompression. The index makes
+ * any block reachable without touching the ones before it. Values are
+ * stored in host (little endian) byte order.
+ */
+
+namespace SST {
+namespace Prospero {
+
+#define PROSPERO_BLOCK_MAGIC          "PROSBLK1"
+#define PROSPERO_BLOCK_VERSION        1
+#define PROSPERO_BLOCK_DEFAULT_RECORDS 65536
+
+#define PROSPERO_BLOCK_FLAG_COLUMNAR  0x1
+#define PROSPERO_BLOCK_KNOWN_FLAGS    (PROSPERO_BLOCK_FLAG_COLUMNAR)
+
+typedef enum {
+	PROSPERO_BLOCK_CODEC_NONE = 0,
+	PROSPERO_BLOCK_CODEC_ZLIB = 1
+} ProsperoBlockCodec;
+
+typedef struct {
+	char     magic[8];
+	uint32_t version;
+	uint32_t codec;
+	uint32_t recordsPerBlock;
+	uint32_t flags;
+	uint64_t recordCount;
+	uint64_t blockCount;
+	uint64_t indexOffset;
+} ProsperoBlockFileHeader;
+
+typedef struct {
+	uint64_t offset;
+	uint64_t firstRecord;
+	uint64_t firstCycle;
+	uint32_t compressedLength;
+	uint32_t recordCount;
+} ProsperoBlockIndexEntry;
+
+typedef struct {
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	uint8_t  isWrite;
+	uint8_t  padding[3];
+} ProsperoBlockRecord;
+
+static inline void prosperoInitBlockHeader(ProsperoBlockFileHeader* header, uint32_t codec, uint32_t recordsPerBlock) {
+	memset(header, 0, sizeof(ProsperoBlockFileHeader));
+	memcpy(header->magic, PROSPERO_BLOCK_MAGIC, 8);
+	header->version = PROSPERO_BLOCK_VERSION;
+	header->codec = codec;
+	header->recordsPerBlock = recordsPerBlock;
+}
+
+static inline size_t prosperoBlockDecodedLength(const ProsperoBlockFileHeader* header, const uint32_t count) {
+	if(header->flags & PROSPERO_BLOCK_FLAG_COLUMNAR) {
+		return (size_t) count * (sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t));
+	}
+
+	return (size_t) count * sizeof(ProsperoBlockRecord);
+}
+
+static inline void prosperoPackColumns(const ProsperoBlockRecord* records, const uint32_t count, uint8_t* packed) {
+	uint8_t* cycleColumn   = packed;
+	uint8_t* addressColumn = cycleColumn + (size_t) count * sizeof(uint64_t);
+	uint8_t* lengthColumn  = addressColumn + (size_t) count * sizeof(uint64_t);
+	uint8_t* writeColumn   = lengthColumn + (size_t) count * sizeof(uint32_t);
+
+	uint64_t lastCycle = 0;
+	uint64_t lastAddress = 0;
+
+	for(uint32_t i = 0; i < count; ++i) {
+		// Deltas wrap on unsigned subtraction and unpack exactly on addition
+		const uint64_t cycleDelta = records[i].cycles - lastCycle;
+		const uint64_t addressDelta = records[i].address - lastAddress;
+
+		memcpy(cycleColumn + (size_t) i * sizeof(uint64_t), &cycleDelta, sizeof(uint64_t));
+		memcpy(addressColumn + (size_t) i * sizeof(uint64_t), &addressDelta, sizeof(uint64_t));
+		memcpy(lengthColumn + (size_t) i * sizeof(uint32_t), &records[i].length, sizeof(uint32_t));
+		writeColumn[i] = records[i].isWrite;
+
+		lastCycle = records[i].cycles;
+		lastAddress = records[i].address;
+	}
+}
+
+static inline void prosperoUnpackColumns(const uint8_t* packed, const uint32_t count, ProsperoBlockRecord* records) {
+	const uint8_t* cycleColumn   = packed;
+	const uint8_t* addressColumn = cycleColumn + (size_t) count * sizeof(uint64_t);
+	const uint8_t* lengthColumn  = addressColumn + (size_t) count * sizeof(uint64_t);
+	const uint8_t* writeColumn   = lengthColumn + (size_t) count * sizeof(uint32_t);
+
+	uint64_t cycle = 0;
+	uint64_t address = 0;
+
+	for(uint32_t i = 0; i < count; ++i) {
+		uint64_t cycleDelta;
+		uint64_t addressDelta;
+
+		memcpy(&cycleDelta, cycleColumn + (size_t) i * sizeof(uint64_t), sizeof(uint64_t));
+		memcpy(&addressDelta, addressColumn + (size_t) i * sizeof(uint64_t), sizeof(uint64_t));
+
+		cycle += cycleDelta;
+		address += addressDelta;
+
+		records[i].cycles = cycle;
+		records[i].address = address;
+		memcpy(&records[i].length, lengthColumn + (size_t) i * sizeof(uint32_t), sizeof(uint32_t));
+		records[i].isWrite = writeColumn[i];
+		memset(records[i].padding, 0, sizeof(records[i].padding));
+	}
+}
+
+static inline bool prosperoCheckBlockHeader(const ProsperoBlockFileHeader* header) {
+	return 0 == memcmp(header->magic, PROSPERO_BLOCK_MAGIC, 8) &&
+		PROSPERO_BLOCK_VERSION == header->version &&
+		0 == (header->flags & ~PROSPERO_BLOCK_KNOWN_FLAGS);
+}
+
+}
+}
+
+#endif
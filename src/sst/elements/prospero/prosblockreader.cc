@@ -0,0 +1,327 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosblockreader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+using namespace SST::Prospero;
+
+
+ProsperoBlockTraceReader::ProsperoBlockTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out),
+	traceFD(-1), mapBase(NULL), mapLength(0), blockIndex(NULL),
+	nextConsumeBlock(0), holdingBlock(false),
+	currentRecords(NULL), currentIndex(0), currentCount(0),
+	stopDecoder(false), decodeFailed(false), failedBlock(0) {
+
+	traceFile = params.find<std::string>("file", "");
+	traceFD = open(traceFile.c_str(), O_RDONLY);
+
+	if(traceFD < 0) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in block reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	struct stat traceStat;
+	if(0 != fstat(traceFD, &traceStat) || (size_t) traceStat.st_size < sizeof(ProsperoBlockFileHeader)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s is too small to be a block trace.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	mapLength = (size_t) traceStat.st_size;
+	void* mapped = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, traceFD, 0);
+
+	if(MAP_FAILED == mapped) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to map trace file: %s\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	mapBase = (const uint8_t*) mapped;
+	posix_madvise(mapped, mapLength, POSIX_MADV_SEQUENTIAL);
+
+	memcpy(&header, mapBase, sizeof(ProsperoBlockFileHeader));
+
+	if(! prosperoCheckBlockHeader(&header)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s is not a version %d Prospero block trace or uses unknown layout flags.\n",
+			getName().c_str(), traceFile.c_str(), PROSPERO_BLOCK_VERSION);
+	}
+
+#ifndef HAVE_LIBZ
+	if(PROSPERO_BLOCK_CODEC_ZLIB == header.codec) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s is zlib compressed but Prospero was built without zlib.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+#endif
+
+	if(header.codec != PROSPERO_BLOCK_CODEC_NONE && header.codec != PROSPERO_BLOCK_CODEC_ZLIB) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s uses unknown block codec %" PRIu32 "\n",
+			getName().c_str(), traceFile.c_str(), header.codec);
+	}
+
+	if(header.indexOffset > mapLength ||
+		header.blockCount > (mapLength - header.indexOffset) / sizeof(ProsperoBlockIndexEntry)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s has a block index outside of the file, is it truncated?\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	blockIndex = (const ProsperoBlockIndexEntry*) (mapBase + header.indexOffset);
+
+	for(uint64_t i = 0; i < header.blockCount; ++i) {
+		if(blockIndex[i].offset > mapLength ||
+			blockIndex[i].compressedLength > mapLength - blockIndex[i].offset ||
+			blockIndex[i].recordCount > header.recordsPerBlock) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s has a corrupt index entry for block %" PRIu64 "\n",
+				getName().c_str(), traceFile.c_str(), i);
+		}
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Block trace %s: %" PRIu64 " records in %" PRIu64 " blocks, codec=%" PRIu32 ", layout=%s\n",
+		traceFile.c_str(), header.recordCount, header.blockCount, header.codec,
+		(header.flags & PROSPERO_BLOCK_FLAG_COLUMNAR) ? "columnar" : "rows");
+
+	uint32_t prefetchBlocks = params.find<uint32_t>("prefetch_blocks", 4);
+	if(prefetchBlocks < 2) {
+		prefetchBlocks = 2;
+	}
+
+	ring.resize(prefetchBlocks);
+	for(size_t i = 0; i < ring.size(); ++i) {
+		ring[i].records.resize(header.recordsPerBlock);
+
+		if(header.flags & PROSPERO_BLOCK_FLAG_COLUMNAR) {
+			ring[i].columns.resize(prosperoBlockDecodedLength(&header, header.recordsPerBlock));
+		}
+	}
+
+	startDecoder(0);
+}
+
+ProsperoBlockTraceReader::~ProsperoBlockTraceReader() {
+	stopDecoderThread();
+
+	if(NULL != mapBase) {
+		munmap((void*) mapBase, mapLength);
+	}
+
+	if(traceFD >= 0) {
+		close(traceFD);
+	}
+}
+
+void ProsperoBlockTraceReader::startDecoder(const uint64_t firstBlock) {
+	for(size_t i = 0; i < ring.size(); ++i) {
+		ring[i].ready = false;
+	}
+
+	stopDecoder = false;
+	decodeFailed = false;
+	nextConsumeBlock = firstBlock;
+	holdingBlock = false;
+	currentRecords = NULL;
+	currentIndex = 0;
+	currentCount = 0;
+
+	decoder = std::thread(&ProsperoBlockTraceReader::decodeLoop, this, firstBlock);
+}
+
+void ProsperoBlockTraceReader::stopDecoderThread() {
+	{
+		std::lock_guard<std::mutex> guard(ringLock);
+		stopDecoder = true;
+	}
+	blockFree.notify_all();
+
+	if(decoder.joinable()) {
+		decoder.join();
+	}
+}
+
+bool ProsperoBlockTraceReader::decodeBlock(const uint64_t block, DecodedBlock& target) {
+	const ProsperoBlockIndexEntry& entry = blockIndex[block];
+	const uint8_t* source = mapBase + entry.offset;
+	const size_t expected = prosperoBlockDecodedLength(&header, entry.recordCount);
+	const bool columnar = (header.flags & PROSPERO_BLOCK_FLAG_COLUMNAR) != 0;
+
+	// Row blocks decode straight into the records, columnar blocks go through
+	// the column buffer and are transposed afterwards
+	uint8_t* decoded = columnar ? target.columns.data() : (uint8_t*) target.records.data();
+
+	if(PROSPERO_BLOCK_CODEC_NONE == header.codec) {
+		if(entry.compressedLength != expected) {
+			return false;
+		}
+		memcpy(decoded, source, expected);
+	} else {
+#ifdef HAVE_LIBZ
+		uLongf decodedLength = (uLongf) expected;
+		if(Z_OK != uncompress((Bytef*) decoded, &decodedLength,
+			(const Bytef*) source, (uLong) entry.compressedLength) || decodedLength != expected) {
+			return false;
+		}
+#else
+		return false;
+#endif
+	}
+
+	if(columnar) {
+		prosperoUnpackColumns(decoded, entry.recordCount, target.records.data());
+	}
+
+	// The compressed bytes are not needed again. Unmap their pages from
+	// this process (posix_madvise DONTNEED is a no-op in glibc) and tell
+	// the kernel it can evict them, rather than keep hundreds of GB of
+	// trace resident. The mapping is read only, a later touch just faults
+	// the page back in from the file.
+	const uintptr_t pageSize = (uintptr_t) sysconf(_SC_PAGESIZE);
+	const uintptr_t start = ((uintptr_t) source) & ~(pageSize - 1);
+	const uintptr_t end = ((uintptr_t) source + entry.compressedLength) & ~(pageSize - 1);
+	if(end > start) {
+		madvise((void*) start, end - start, MADV_DONTNEED);
+#ifdef POSIX_FADV_DONTNEED
+		posix_fadvise(traceFD, (off_t) (start - (uintptr_t) mapBase), (off_t) (end - start), POSIX_FADV_DONTNEED);
+#endif
+	}
+
+	target.count = entry.recordCount;
+	return true;
+}
+
+void ProsperoBlockTraceReader::decodeLoop(const uint64_t firstBlock) {
+	for(uint64_t block = firstBlock; block < header.blockCount; ++block) {
+		DecodedBlock& slot = ring[block % ring.size()];
+
+		{
+			std::unique_lock<std::mutex> guard(ringLock);
+			blockFree.wait(guard, [&] { return stopDecoder || ! slot.ready; });
+
+			if(stopDecoder) {
+				return;
+			}
+		}
+
+		// Slot is owned by this thread until it is marked ready
+		const bool decoded = decodeBlock(block, slot);
+
+		{
+			std::lock_guard<std::mutex> guard(ringLock);
+			if(! decoded) {
+				decodeFailed = true;
+				failedBlock = block;
+			}
+			slot.ready = true;
+		}
+		blockReady.notify_one();
+
+		if(! decoded) {
+			return;
+		}
+	}
+}
+
+bool ProsperoBlockTraceReader::advanceBlock() {
+	std::unique_lock<std::mutex> guard(ringLock);
+
+	// Hand the block we have finished with back to the decoder
+	if(holdingBlock) {
+		ring[(nextConsumeBlock - 1) % ring.size()].ready = false;
+		holdingBlock = false;
+		blockFree.notify_one();
+	}
+
+	if(nextConsumeBlock >= header.blockCount) {
+		return false;
+	}
+
+	DecodedBlock& slot = ring[nextConsumeBlock % ring.size()];
+	blockReady.wait(guard, [&] { return slot.ready; });
+
+	if(decodeFailed && failedBlock == nextConsumeBlock) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to decode block %" PRIu64 " of trace file: %s\n",
+			getName().c_str(), nextConsumeBlock, traceFile.c_str());
+	}
+
+	currentRecords = slot.records.data();
+	currentCount = slot.count;
+	currentIndex = 0;
+	holdingBlock = true;
+	nextConsumeBlock++;
+	return true;
+}
+
+bool ProsperoBlockTraceReader::fillNextEntry(ProsperoTraceEntry& entry) {
+	while(currentIndex >= currentCount) {
+		if(! advanceBlock()) {
+			return false;
+		}
+	}
+
+	const ProsperoBlockRecord& record = currentRecords[currentIndex++];
+	entry = ProsperoTraceEntry(record.cycles, record.address, record.length,
+		record.isWrite ? WRITE : READ);
+	return true;
+}
+
+ProsperoTraceEntry* ProsperoBlockTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
+
+	if(fillNextEntry(entry)) {
+		return new ProsperoTraceEntry(entry);
+	}
+
+	return NULL;
+}
+
+bool ProsperoBlockTraceReader::seekToCycle(const uint64_t cycle, ProsperoTraceEntry& entry) {
+	// Find the last block which starts before the requested cycle, the entry
+	// we want is either in that block or is the first of the next one
+	uint64_t lower = 0;
+	uint64_t upper = header.blockCount;
+
+	while(lower < upper) {
+		const uint64_t middle = lower + ((upper - lower) / 2);
+
+		if(blockIndex[middle].firstCycle < cycle) {
+			lower = middle + 1;
+		} else {
+			upper = middle;
+		}
+	}
+
+	const uint64_t firstBlock = (lower > 0) ? lower - 1 : 0;
+
+	output->verbose(CALL_INFO, 1, 0, "Block reader seek to cycle %" PRIu64 " starts decoding at block %" PRIu64 " of %" PRIu64 "\n",
+		cycle, firstBlock, header.blockCount);
+
+	stopDecoderThread();
+	startDecoder(firstBlock);
+
+	while(fillNextEntry(entry)) {
+		if(entry.getIssueAtCycle() >= cycle) {
+			return true;
+		}
+	}
+
+	return false;
+}
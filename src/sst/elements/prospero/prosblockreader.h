@@ -0,0 +1,101 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_READER
+#define _H_SST_PROSPERO_BLOCK_READER
+
+#include "prosreader.h"
+#include "prosblockformat.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace Prospero {
+
+class ProsperoBlockTraceReader : public ProsperoTraceReader {
+
+public:
+	ProsperoBlockTraceReader( ComponentId_t id, Params& params, Output* out );
+	~ProsperoBlockTraceReader();
+	ProsperoTraceEntry* readNextEntry();
+	bool fillNextEntry(ProsperoTraceEntry& entry);
+	bool seekToCycle(const uint64_t cycle, ProsperoTraceEntry& entry);
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		ProsperoBlockTraceReader,
+		"prospero",
+		"ProsperoBlockTraceReader",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Memory mapped, block compressed trace reader with a background decompression thread",
+		SST::Prospero::ProsperoTraceReader
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the block trace file for the reader to use (see tracetool/prosblockconvert)", "" },
+		{ "prefetch_blocks", "Number of blocks the background thread decompresses ahead of the core", "4" }
+	)
+
+private:
+	class DecodedBlock {
+	public:
+		DecodedBlock() : count(0), ready(false) {}
+		std::vector<ProsperoBlockRecord> records;
+		std::vector<uint8_t> columns;
+		uint32_t count;
+		bool ready;
+	};
+
+	void startDecoder(const uint64_t firstBlock);
+	void stopDecoderThread();
+	void decodeLoop(const uint64_t firstBlock);
+	bool decodeBlock(const uint64_t block, DecodedBlock& target);
+	bool advanceBlock();
+
+	int traceFD;
+	const uint8_t* mapBase;
+	size_t mapLength;
+	std::string traceFile;
+
+	ProsperoBlockFileHeader header;
+	const ProsperoBlockIndexEntry* blockIndex;
+
+	// Ring of decoded blocks, filled by the decoder thread in block order
+	std::vector<DecodedBlock> ring;
+	uint64_t nextConsumeBlock;
+	bool holdingBlock;
+
+	const ProsperoBlockRecord* currentRecords;
+	uint32_t currentIndex;
+	uint32_t currentCount;
+
+	std::thread decoder;
+	std::mutex ringLock;
+	std::condition_variable blockReady;
+	std::condition_variable blockFree;
+	bool stopDecoder;
+	bool decodeFailed;
+	uint64_t failedBlock;
+
+};
+
+}
+}
+
+#endif
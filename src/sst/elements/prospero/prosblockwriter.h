@@ -0,0 +1,350 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_WRITER
+#define _H_SST_PROSPERO_BLOCK_WRITER
+
+#include <stdint.h>
+#include <cstdio>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "prosblockformat.h"
+
+namespace SST {
+namespace Prospero {
+
+#ifdef HAVE_LIBZ
+#define PROSPERO_BLOCK_DEFAULT_CODEC_NAME "zlib"
+#else
+#define PROSPERO_BLOCK_DEFAULT_CODEC_NAME "none"
+#endif
+
+// Number of full blocks which can wait for the background writer before
+// append() blocks the caller
+#define PROSPERO_BLOCK_DEFAULT_FLUSH_BUFFERS 4
+
+static inline bool prosperoBlockCodecFromName(const std::string& name, uint32_t& codec) {
+	if("none" == name) {
+		codec = PROSPERO_BLOCK_CODEC_NONE;
+		return true;
+	}
+
+#ifdef HAVE_LIBZ
+	if("zlib" == name) {
+		codec = PROSPERO_BLOCK_CODEC_ZLIB;
+		return true;
+	}
+#endif
+
+	return false;
+}
+
+static inline bool prosperoBlockFlagsFromLayout(const std::string& layout, uint32_t& flags) {
+	if("rows" == layout) {
+		flags = 0;
+		return true;
+	}
+
+	if("columnar" == layout) {
+		flags = PROSPERO_BLOCK_FLAG_COLUMNAR;
+		return true;
+	}
+
+	return false;
+}
+
+/*
+ * Writes Prospero block traces (see prosblockformat.h) from inside a
+ * simulation. Records are appended into a block sized buffer owned by the
+ * writer, full blocks are handed to a background thread which packs,
+ * compresses and writes them while the simulation keeps filling the next
+ * buffer. append() only takes a lock when a block fills. The writer is
+ * header only so that components outside of Prospero (Ariel, cacheTracer)
+ * can produce traces without linking against it. Each writer is owned by
+ * a single component and must only be appended to from that component.
+ */
+class ProsperoBlockTraceWriter {
+public:
+	ProsperoBlockTraceWriter() :
+		traceFile(NULL), isOpen(false), submitted(0), flushed(0),
+		stopFlush(false), writeFailed(false), fileOffset(0),
+		currentBlock(NULL), currentCount(0) {}
+
+	~ProsperoBlockTraceWriter() {
+		close();
+	}
+
+	bool open(const std::string& path, const uint32_t codec, const uint32_t recordsPerBlock,
+		const uint32_t flags, const uint32_t flushBuffers) {
+
+		if(isOpen || 0 == recordsPerBlock) {
+			return fail("writer is already open or has no records per block");
+		}
+
+#ifndef HAVE_LIBZ
+		if(PROSPERO_BLOCK_CODEC_ZLIB == codec) {
+			return fail("zlib codec requested but this build does not have zlib");
+		}
+#endif
+
+		if(codec != PROSPERO_BLOCK_CODEC_NONE && codec != PROSPERO_BLOCK_CODEC_ZLIB) {
+			return fail("unknown block codec");
+		}
+
+		traceFile = fopen(path.c_str(), "wb");
+		if(NULL == traceFile) {
+			return fail("unable to open " + path + " for writing");
+		}
+
+		prosperoInitBlockHeader(&header, codec, recordsPerBlock);
+		header.flags = flags;
+
+		// Placeholder, rewritten on close once the counts and index are known
+		fileOffset = sizeof(header);
+		if(1 != fwrite(&header, sizeof(header), 1, traceFile)) {
+			fclose(traceFile);
+			traceFile = NULL;
+			return fail("unable to write trace header");
+		}
+
+		blocks.resize(flushBuffers < 2 ? 2 : flushBuffers);
+		for(size_t i = 0; i < blocks.size(); ++i) {
+			blocks[i].records.resize(recordsPerBlock);
+			blocks[i].count = 0;
+		}
+
+		submitted = 0;
+		flushed = 0;
+		stopFlush = false;
+		currentBlock = &blocks[0];
+		currentCount = 0;
+		isOpen = true;
+
+		flusher = std::thread(&ProsperoBlockTraceWriter::flushLoop, this);
+		return true;
+	}
+
+	bool append(const uint64_t cycles, const uint64_t address, const uint32_t length, const bool isWrite) {
+		ProsperoBlockRecord& record = currentBlock->records[currentCount];
+
+		record.cycles = cycles;
+		record.address = address;
+		record.length = length;
+		record.isWrite = isWrite ? 1 : 0;
+		record.padding[0] = record.padding[1] = record.padding[2] = 0;
+
+		if(++currentCount == header.recordsPerBlock) {
+			return submitBlock();
+		}
+
+		return true;
+	}
+
+	// Flushes the partially filled block, waits for the background thread
+	// and finishes the file with its index. Safe to call more than once.
+	bool close() {
+		if(! isOpen) {
+			return ! writeFailed;
+		}
+
+		if(currentCount > 0) {
+			submitBlock();
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(blockLock);
+			stopFlush = true;
+		}
+		blockSubmitted.notify_one();
+		flusher.join();
+
+		isOpen = false;
+
+		if(! writeFailed) {
+			header.blockCount = index.size();
+			header.indexOffset = fileOffset;
+
+			if(index.size() > 0 &&
+				1 != fwrite(index.data(), index.size() * sizeof(ProsperoBlockIndexEntry), 1, traceFile)) {
+				fail("unable to write block index");
+			} else if(0 != fseek(traceFile, 0, SEEK_SET) || 1 != fwrite(&header, sizeof(header), 1, traceFile)) {
+				fail("unable to rewrite trace header");
+			}
+		}
+
+		if(0 != fclose(traceFile)) {
+			fail("unable to close trace file");
+		}
+
+		traceFile = NULL;
+		return ! writeFailed;
+	}
+
+	bool failed() {
+		std::lock_guard<std::mutex> guard(blockLock);
+		return writeFailed;
+	}
+
+	const std::string& getError() const { return errorMessage; }
+	uint64_t getRecordCount() const { return header.recordCount; }
+	uint64_t getBlockCount() const { return header.blockCount; }
+	uint64_t getBytesWritten() const { return fileOffset + (uint64_t) (index.size() * sizeof(ProsperoBlockIndexEntry)); }
+
+private:
+	class PendingBlock {
+	public:
+		std::vector<ProsperoBlockRecord> records;
+		uint32_t count;
+	};
+
+	bool fail(const std::string& message) {
+		if(! writeFailed) {
+			errorMessage = message;
+			writeFailed = true;
+		}
+		return false;
+	}
+
+	bool submitBlock() {
+		std::unique_lock<std::mutex> guard(blockLock);
+
+		currentBlock->count = currentCount;
+		submitted++;
+		blockSubmitted.notify_one();
+
+		// Wait for the flush thread to hand back the oldest buffer
+		blockFlushed.wait(guard, [&] { return (submitted - flushed) < blocks.size(); });
+
+		currentBlock = &blocks[submitted % blocks.size()];
+		currentCount = 0;
+
+		return ! writeFailed;
+	}
+
+	void flushLoop() {
+		std::vector<uint8_t> columns;
+		std::vector<uint8_t> packed;
+
+		while(true) {
+			PendingBlock* block = NULL;
+			bool skipBlock = false;
+
+			{
+				std::unique_lock<std::mutex> guard(blockLock);
+				blockSubmitted.wait(guard, [&] { return stopFlush || flushed < submitted; });
+
+				if(flushed == submitted) {
+					return;
+				}
+
+				block = &blocks[flushed % blocks.size()];
+				skipBlock = writeFailed;
+			}
+
+			// The block belongs to this thread until flushed is advanced, once
+			// a write has failed the remaining blocks are discarded
+			const char* error = skipBlock ? NULL : writeBlock(*block, columns, packed);
+
+			{
+				std::lock_guard<std::mutex> guard(blockLock);
+				if(NULL != error) {
+					fail(error);
+				}
+				flushed++;
+			}
+			blockFlushed.notify_one();
+		}
+	}
+
+	const char* writeBlock(const PendingBlock& block, std::vector<uint8_t>& columns, std::vector<uint8_t>& packed) {
+		const size_t rawLength = prosperoBlockDecodedLength(&header, block.count);
+		const uint8_t* blockData = (const uint8_t*) block.records.data();
+
+		if(header.flags & PROSPERO_BLOCK_FLAG_COLUMNAR) {
+			columns.resize(rawLength);
+			prosperoPackColumns(block.records.data(), block.count, columns.data());
+			blockData = columns.data();
+		}
+
+		size_t blockLength = rawLength;
+
+#ifdef HAVE_LIBZ
+		if(PROSPERO_BLOCK_CODEC_ZLIB == header.codec) {
+			uLongf packedLength = compressBound((uLong) rawLength);
+			packed.resize(packedLength);
+
+			if(Z_OK != compress2((Bytef*) packed.data(), &packedLength,
+				(const Bytef*) blockData, (uLong) rawLength, Z_BEST_SPEED)) {
+				return "zlib failed to compress a block";
+			}
+
+			blockData = packed.data();
+			blockLength = (size_t) packedLength;
+		}
+#endif
+
+		if(1 != fwrite(blockData, blockLength, 1, traceFile)) {
+			return "unable to write block to trace file";
+		}
+
+		ProsperoBlockIndexEntry entry;
+		entry.offset = fileOffset;
+		entry.firstRecord = header.recordCount;
+		entry.firstCycle = block.records[0].cycles;
+		entry.compressedLength = (uint32_t) blockLength;
+		entry.recordCount = block.count;
+		index.push_back(entry);
+
+		fileOffset += blockLength;
+		header.recordCount += block.count;
+		return NULL;
+	}
+
+	FILE* traceFile;
+	bool isOpen;
+	ProsperoBlockFileHeader header;
+	std::vector<ProsperoBlockIndexEntry> index;
+
+	std::vector<PendingBlock> blocks;
+	uint64_t submitted;
+	uint64_t flushed;
+	bool stopFlush;
+	std::mutex blockLock;
+	std::condition_variable blockSubmitted;
+	std::condition_variable blockFlushed;
+	std::thread flusher;
+
+	bool writeFailed;
+	std::string errorMessage;
+	uint64_t fileOffset;
+
+	PendingBlock* currentBlock;
+	uint32_t currentCount;
+};
+
+}
+}
+
+#endif
@@ -85,17 +85,61 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
     }
 	output->verbose(CALL_INFO, 1, 0, "Configuration of memory interface completed.\n");
 
-	output->verbose(CALL_INFO, 1, 0, "Reading first entry from the trace reader...\n");
-	currentEntry = reader->readNextEntry();
-	output->verbose(CALL_INFO, 1, 0, "Read of first entry complete.\n");
+	syncLink = NULL;
+	nextSyncMarker = 0;
+	syncReportedEpochs = 0;
+	syncReleasedEpochs = 0;
+	syncFinishSent = false;
+	cycleOffset = 0;
+
+	syncLookahead = params.find<uint64_t>("sync_lookahead", 0);
+
+	const std::string syncFile = params.find<std::string>("sync_file", "");
+	if("" != syncFile) {
+		if(! isPortConnected("sync_link")) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: sync_file is set but the sync_link port is not connected to a sync hub.\n",
+				getName().c_str());
+		}
+
+		syncLink = configureLink("sync_link", new Event::Handler<ProsperoComponent>(this, &ProsperoComponent::handleSyncEvent));
+		loadSyncMarkers(syncFile);
+	}
+
+	roiStartCycle = params.find<uint64_t>("skip_to_cycle", 0);
+
+	const uint64_t skipMarkers = params.find<uint64_t>("skip_markers", 0);
+	if(skipMarkers > 0) {
+		if(skipMarkers > syncMarkers.size()) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: asked to skip %" PRIu64 " markers but the sync file only has %" PRIu64 "\n",
+				getName().c_str(), skipMarkers, (uint64_t) syncMarkers.size());
+		}
+
+		// Every shard skips the same markers so they count as passed by all
+		roiStartCycle = std::max(roiStartCycle, syncMarkers[skipMarkers - 1]);
+		nextSyncMarker = skipMarkers;
+		syncReportedEpochs = skipMarkers;
+		syncReleasedEpochs = skipMarkers;
+	}
+
+	bool haveFirstEntry = false;
+
+	if(roiStartCycle > 0) {
+		output->verbose(CALL_INFO, 1, 0, "Skipping trace to cycle %" PRIu64 "...\n", roiStartCycle);
+		haveFirstEntry = reader->seekToCycle(roiStartCycle, currentEntry);
+		output->verbose(CALL_INFO, 1, 0, "Skip to region of interest complete.\n");
+	} else {
+		output->verbose(CALL_INFO, 1, 0, "Reading first entry from the trace reader...\n");
+		haveFirstEntry = reader->fillNextEntry(currentEntry);
+		output->verbose(CALL_INFO, 1, 0, "Read of first entry complete.\n");
+	}
 
 	output->verbose(CALL_INFO, 1, 0, "Creating memory manager with page size %" PRIu64 "...\n", pageSize);
 	memMgr = new ProsperoMemoryManager(pageSize, output);
 	output->verbose(CALL_INFO, 1, 0, "Created memory manager successfully.\n");
 
-	// We start by telling the system to continue to process as long as the first entry
-	// is not NULL
-	traceEnded = currentEntry == NULL;
+	// We start by telling the system to continue to process as long as there
+	// is a first entry
+	traceEnded = ! haveFirstEntry;
 
 	readsIssued = 0;
 	writesIssued = 0;
@@ -107,6 +151,7 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	currentOutstanding = 0;
 	cyclesWithNoIssue = 0;
 	cyclesWithIssue = 0;
+	cyclesSyncStalled = 0;
 
 	output->verbose(CALL_INFO, 1, 0, "Prospero configuration completed successfully.\n");
 
@@ -133,6 +178,10 @@ void ProsperoComponent::finish() {
 	output->output("- Cycles with ops issued:                %" PRIu64 " cycles\n", cyclesWithIssue);
 	output->output("- Cycles with no ops issued (LS full):   %" PRIu64 " cycles\n", cyclesWithNoIssue);
 
+	if(NULL != syncLink) {
+		output->output("- Cycles stalled at sync markers:        %" PRIu64 " cycles\n", cyclesSyncStalled);
+	}
+
 	output->output("------------------------------------------------------------------------\n");
 	output->output("- Reads issued:                          %" PRIu64 "\n", readsIssued);
 	output->output("- Writes issued:                         %" PRIu64 "\n", writesIssued);
@@ -191,19 +240,80 @@ void ProsperoComponent::handleResponse(StandardMem::Request *ev) {
 	delete ev;
 }
 
+void ProsperoComponent::handleSyncEvent(SST::Event* ev) {
+	ProsperoSyncEvent* syncEv = static_cast<ProsperoSyncEvent*>(ev);
+
+	output->verbose(CALL_INFO, 4, 0, "Sync hub released %" PRIu64 " markers.\n", syncEv->getEpochs());
+	syncReleasedEpochs = std::max(syncReleasedEpochs, syncEv->getEpochs());
+
+	delete syncEv;
+}
+
+void ProsperoComponent::loadSyncMarkers(const std::string& syncFile) {
+	FILE* syncInput = fopen(syncFile.c_str(), "rt");
+
+	if(NULL == syncInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to open sync marker file: %s\n",
+			getName().c_str(), syncFile.c_str());
+	}
+
+	uint64_t epoch = 0;
+	uint64_t markerCycle = 0;
+
+	while(2 == fscanf(syncInput, "%" PRIu64 " %" PRIu64 "", &epoch, &markerCycle)) {
+		if(epoch != syncMarkers.size()) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: sync marker file: %s has epoch %" PRIu64 " out of order\n",
+				getName().c_str(), syncFile.c_str(), epoch);
+		}
+
+		syncMarkers.push_back(markerCycle);
+	}
+
+	fclose(syncInput);
+
+	output->verbose(CALL_INFO, 1, 0, "Loaded %" PRIu64 " sync markers from %s, lookahead is %" PRIu64 " markers.\n",
+		(uint64_t) syncMarkers.size(), syncFile.c_str(), syncLookahead);
+}
+
+bool ProsperoComponent::passSyncMarkers(const uint64_t traceCycle) {
+	while(nextSyncMarker < syncMarkers.size() && traceCycle >= syncMarkers[nextSyncMarker]) {
+		const uint64_t markerEpochs = nextSyncMarker + 1;
+
+		if(syncReportedEpochs < markerEpochs) {
+			syncReportedEpochs = markerEpochs;
+			syncLink->send(new ProsperoSyncEvent(syncReportedEpochs));
+		}
+
+		// Held until the slowest shard is within the lookahead of this marker
+		if(syncReleasedEpochs + syncLookahead < markerEpochs) {
+			return false;
+		}
+
+		nextSyncMarker++;
+	}
+
+	return true;
+}
+
 bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
-	if(NULL == currentEntry) {
-		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", current entry is NULL, outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
+	if(traceEnded) {
+		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", trace has ended, outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
 			(uint64_t) currentCycle, currentOutstanding, maxOutstanding);
 	} else {
 		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", current entry time: %" PRIu64 ", outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
-			(uint64_t) currentCycle, (uint64_t) currentEntry->getIssueAtCycle(),
+			(uint64_t) currentCycle, (uint64_t) currentEntry.getIssueAtCycle(),
 			currentOutstanding, maxOutstanding);
 	}
 
 	// If we have finished reading the trace we need to let the events in flight
 	// drain and the system come to a rest
 	if(traceEnded) {
+		// Never hold the other shards back once this trace has ended
+		if(NULL != syncLink && ! syncFinishSent) {
+			syncLink->send(new ProsperoSyncEvent(PROSPERO_SYNC_FINISHED));
+			syncFinishSent = true;
+		}
+
 		if(0 == currentOutstanding) {
 			primaryComponentOKToEndSim();
                         return true;
@@ -217,17 +327,20 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 	// Wait to see if the current operation can be issued, if yes then
 	// go ahead and issue it, otherwise we will stall
 	for(uint32_t i = 0; i < maxIssuePerCycle; ++i) {
-		if(currentCycle >= currentEntry->getIssueAtCycle()) {
-			if(currentOutstanding < maxOutstanding) {
+		if(currentCycle >= currentEntry.getIssueAtCycle() - roiStartCycle + cycleOffset) {
+			if(NULL != syncLink && ! passSyncMarkers(currentEntry.getIssueAtCycle())) {
+				// Waiting on other shards, shift the rest of the trace along
+				cyclesSyncStalled++;
+				cycleOffset++;
+				break;
+			} else if(currentOutstanding < maxOutstanding) {
 				// Issue the pending request into the memory subsystem
 				issueRequest(currentEntry);
 
-				// Obtain the next newest request
-				currentEntry = reader->readNextEntry();
-
-				// Trace reader has read all entries, time to begin draining
-				// the system, caches etc
-				if(NULL == currentEntry) {
+				// Obtain the next newest request, trace reader has read all
+				// entries if there is none, time to begin draining the
+				// system, caches etc
+				if(! reader->fillNextEntry(currentEntry)) {
 					traceEnded = true;
 					break;
 				}
@@ -237,7 +350,7 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 			}
 		} else {
 			output->verbose(CALL_INFO, 8, 0, "Not issuing on cycle %" PRIu64 ", waiting for cycle: %" PRIu64 "\n",
-				(uint64_t) currentCycle, currentEntry->getIssueAtCycle());
+				(uint64_t) currentCycle, currentEntry.getIssueAtCycle() - roiStartCycle + cycleOffset);
 			// Have reached a point in the trace which is too far ahead in time
 			// so stall until we find that point
 			break;
@@ -257,13 +370,13 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 	return false;
 }
 
-void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
+void ProsperoComponent::issueRequest(const ProsperoTraceEntry& entry) {
     // Trim request size to cacheline length in case of instructions like xsave, fxsave, etc. (happens rarely)
-    const uint64_t entryAddress = entry->getAddress();
-    const uint64_t entryLength  = std::min((uint64_t) entry->getLength(), cacheLineSize);
+    const uint64_t entryAddress = entry.getAddress();
+    const uint64_t entryLength  = std::min((uint64_t) entry.getLength(), cacheLineSize);
 
     const uint64_t lineOffset   = entryAddress % cacheLineSize;
-    bool  isRead                = entry->isRead();
+    bool  isRead                = entry.isRead();
 
 	if(isRead) {
 		totalBytesRead += entryLength;
@@ -327,7 +440,4 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 
 		currentOutstanding++;
 	}
-
-	// Delete this entry, we are done converting it into a request
-	delete entry;
 }
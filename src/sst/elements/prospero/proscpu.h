@@ -27,6 +27,7 @@
 
 #include "prosreader.h"
 #include "prosmemmgr.h"
+#include "prossync.h"
 
 #ifdef HAVE_LIBZ
 #include <zlib.h>
@@ -65,10 +66,15 @@ public:
     	{ "clock", "Sets the clock of the core", "2GHz"} ,
     	{ "max_outstanding", "Sets the maximum number of outstanding transactions that the memory system will allow", "16"},
     	{ "max_issue_per_cycle", "Sets the maximum number of new transactions that the system can issue per cycle", "2"},
+    	{ "skip_to_cycle", "Skip the trace up to this instruction count (region of interest) before replay starts", "0"},
+    	{ "sync_file", "Synchronization marker file written with the trace shard (sstmemtrace -s), requires sync_link", ""},
+    	{ "skip_markers", "Skip the trace up to the last of this many synchronization markers before replay starts", "0"},
+    	{ "sync_lookahead", "Number of synchronization markers this core may run ahead of the slowest shard", "0"},
    )
 
    SST_ELI_DOCUMENT_PORTS(
-	{ "cache_link", "Link to the memHierarchy cache", { "memHierarchy.memEvent", "" } }
+	{ "cache_link", "Link to the memHierarchy cache", { "memHierarchy.memEvent", "" } },
+	{ "sync_link", "Link to a prospero.prosperoSyncHub when replaying sharded traces", { "prospero.ProsperoSyncEvent", "" } }
    )
 
    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
@@ -81,12 +87,15 @@ private:
   void operator=(const ProsperoComponent&);    // Do not impl.
 
   void handleResponse( StandardMem::Request* ev );
+  void handleSyncEvent( SST::Event* ev );
   bool tick( Cycle_t );
-  void issueRequest(const ProsperoTraceEntry* entry);
+  void issueRequest(const ProsperoTraceEntry& entry);
+  void loadSyncMarkers(const std::string& syncFile);
+  bool passSyncMarkers(const uint64_t traceCycle);
 
   Output* output;
   ProsperoTraceReader* reader;
-  ProsperoTraceEntry* currentEntry;
+  ProsperoTraceEntry currentEntry;
   ProsperoMemoryManager* memMgr;
   StandardMem* cache_link;
   FILE* traceFile;
@@ -100,6 +109,19 @@ private:
   uint32_t currentOutstanding;
   uint32_t maxIssuePerCycle;
 
+  // Entries issue at (trace cycle - roiStartCycle + cycleOffset), the offset
+  // grows while the core is held at a synchronization marker
+  uint64_t roiStartCycle;
+  uint64_t cycleOffset;
+
+  Link* syncLink;
+  std::vector<uint64_t> syncMarkers;
+  size_t nextSyncMarker;
+  uint64_t syncReportedEpochs;
+  uint64_t syncReleasedEpochs;
+  uint64_t syncLookahead;
+  bool syncFinishSent;
+
   uint64_t readsIssued;
   uint64_t writesIssued;
   uint64_t splitReadsIssued;
@@ -108,6 +130,7 @@ private:
   uint64_t totalBytesWritten;
   uint64_t cyclesWithIssue;
   uint64_t cyclesWithNoIssue;
+  uint64_t cyclesSyncStalled;
 
 };
 
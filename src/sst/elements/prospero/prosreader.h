@@ -32,6 +32,11 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() :
+		cycles(0), address(0), length(0), op(READ) {
+
+		}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -48,10 +53,10 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -65,6 +70,35 @@ public:
 
 	~ProsperoTraceReader() { };
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	// Reads the next entry into the caller's storage, returns false at the
+	// end of the trace. Readers which can avoid a heap entry per record
+	// override this, the default wraps readNextEntry().
+	virtual bool fillNextEntry(ProsperoTraceEntry& entry) {
+		ProsperoTraceEntry* next = readNextEntry();
+
+		if(NULL == next) {
+			return false;
+		}
+
+		entry = *next;
+		delete next;
+		return true;
+	}
+
+	// Positions the reader at the first entry issued at or after cycle and
+	// fills it into entry, returns false if the trace ends first. Readers
+	// over seekable files override this, the default reads and discards.
+	virtual bool seekToCycle(const uint64_t cycle, ProsperoTraceEntry& entry) {
+		while(fillNextEntry(entry)) {
+			if(entry.getIssueAtCycle() >= cycle) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
 	void setOutput(Output* out) { output = out; }
 
 protected:
@@ -0,0 +1,82 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "prossync.h"
+
+#include <algorithm>
+
+using namespace SST;
+using namespace SST::Prospero;
+
+ProsperoSyncHub::ProsperoSyncHub(ComponentId_t id, Params& params) :
+	Component(id), releasedEpochs(0) {
+
+	const uint32_t output_level = (uint32_t) params.find<uint32_t>("verbose", 0);
+	output = new SST::Output("ProsperoSync[@p:@l]: ", output_level, 0, SST::Output::STDOUT);
+
+	const uint32_t shards = (uint32_t) params.find<uint32_t>("shards", 1);
+
+	if(0 == shards) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: sync hub must have at least one shard.\n", getName().c_str());
+	}
+
+	char portName[64];
+
+	for(uint32_t i = 0; i < shards; ++i) {
+		snprintf(portName, 64, "shard%" PRIu32, i);
+
+		Link* link = configureLink(portName, new Event::Handler<ProsperoSyncHub, uint32_t>(this,
+			&ProsperoSyncHub::handleShardEvent, i));
+
+		if(NULL == link) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: sync hub port %s is not connected.\n",
+				getName().c_str(), portName);
+		}
+
+		shardLinks.push_back(link);
+	}
+
+	shardEpochs.resize(shards, 0);
+
+	output->verbose(CALL_INFO, 1, 0, "Configured Prospero sync hub for %" PRIu32 " shards.\n", shards);
+}
+
+ProsperoSyncHub::~ProsperoSyncHub() {
+	delete output;
+}
+
+void ProsperoSyncHub::handleShardEvent(SST::Event* ev, uint32_t shard) {
+	ProsperoSyncEvent* syncEv = static_cast<ProsperoSyncEvent*>(ev);
+
+	shardEpochs[shard] = std::max(shardEpochs[shard], syncEv->getEpochs());
+	delete syncEv;
+
+	const uint64_t slowest = *std::min_element(shardEpochs.begin(), shardEpochs.end());
+
+	// Finished shards report PROSPERO_SYNC_FINISHED so they never hold
+	// back the shards which are still replaying
+	if(slowest > releasedEpochs) {
+		releasedEpochs = slowest;
+
+		output->verbose(CALL_INFO, 2, 0, "All shards have passed %" PRIu64 " markers, releasing.\n", releasedEpochs);
+
+		for(uint32_t i = 0; i < shardLinks.size(); ++i) {
+			if(PROSPERO_SYNC_FINISHED != shardEpochs[i]) {
+				shardLinks[i]->send(new ProsperoSyncEvent(releasedEpochs));
+			}
+		}
+	}
+}
@@ -0,0 +1,99 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _SST_PROSPERO_SYNC_H
+#define _SST_PROSPERO_SYNC_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+
+#include <vector>
+
+namespace SST {
+namespace Prospero {
+
+#define PROSPERO_SYNC_FINISHED UINT64_MAX
+
+/*
+ * Sent by a shard when it reaches a synchronization marker (epochs is the
+ * number of markers it has passed, PROSPERO_SYNC_FINISHED once its trace
+ * has ended) and by the hub when every shard has reached a marker (epochs
+ * is then the number of markers all shards have passed).
+ */
+class ProsperoSyncEvent : public SST::Event {
+public:
+	ProsperoSyncEvent() : SST::Event(), epochs(0) {}
+	ProsperoSyncEvent(const uint64_t e) : SST::Event(), epochs(e) {}
+
+	uint64_t getEpochs() const { return epochs; }
+
+private:
+	uint64_t epochs;
+
+	void serialize_order(SST::Core::Serialization::serializer &ser) override {
+		Event::serialize_order(ser);
+		ser & epochs;
+	}
+
+	ImplementSerializable(SST::Prospero::ProsperoSyncEvent);
+};
+
+class ProsperoSyncHub : public Component {
+public:
+	ProsperoSyncHub(ComponentId_t id, Params& params);
+	~ProsperoSyncHub();
+
+	void setup() { }
+	void finish() { }
+
+	SST_ELI_REGISTER_COMPONENT(
+		ProsperoSyncHub,
+		"prospero",
+		"prosperoSyncHub",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Releases sharded Prospero cores past trace synchronization markers",
+		COMPONENT_CATEGORY_PROCESSOR
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0" },
+		{ "shards", "Number of Prospero cores connected to the hub", "1" }
+	)
+
+	SST_ELI_DOCUMENT_PORTS(
+		{ "shard%(shards)d", "Link to the sync_link port of each Prospero core", { "prospero.ProsperoSyncEvent", "" } }
+	)
+
+private:
+	ProsperoSyncHub();                       // Serialization only
+	ProsperoSyncHub(const ProsperoSyncHub&); // Do not impl.
+	void operator=(const ProsperoSyncHub&);  // Do not impl.
+
+	void handleShardEvent(SST::Event* ev, uint32_t shard);
+
+	Output* output;
+	std::vector<Link*> shardLinks;
+	std::vector<uint64_t> shardEpochs;
+	uint64_t releasedEpochs;
+
+};
+
+}
+}
+
+#endif /* _SST_PROSPERO_SYNC_H */
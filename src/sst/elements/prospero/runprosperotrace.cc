@@ -38,6 +38,7 @@ void printUsage() {
 	printf("  -o <file>     Name of trace output files.\n");
 	printf("  -f <format>   Output <format> = {text, binary, compressed}\n");
 	printf("  -t <maxthr>   Maximum number of threads to trace, if not set will search for OMP_NUM_THREADS or set to 1\n");
+	printf("  -s <instr>    Write per-thread synchronization markers every <instr> instructions of thread 0\n");
 	printf("\n");
 }
 
@@ -148,6 +149,13 @@ int main(int argc, char* argv[]) {
 					exit(-1);
 				}
 			}
+		} else if( std::strcmp(prosParams[i], "-s") == 0 ) {
+			if(i == (prosParams.size() - 1) ) {
+				fprintf(stderr, "-s needs an instruction interval to be specified\n");
+				exit(-1);
+			} else {
+				i++;
+			}
 		} else {
 			fprintf(stderr, "Error: program option: %s\n",
 				prosParams[i]);
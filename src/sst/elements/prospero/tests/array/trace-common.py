@@ -17,7 +17,7 @@ def main():
     global useTimingDram
 
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir=","TraceFile="])
     except getopt.GetopError as err:
         print(str(err))
         sys.exit(2)
@@ -35,6 +35,9 @@ def main():
                 # print "args are ", o, "and", a
                 Tracetype = "CompressedBinary"
                 traceFile = "sstprospero-0-0-gz.trace"
+            elif a == "block":
+                Tracetype = "Block"
+                traceFile = "sstprospero-0-0-bin.trace.blk"
             else:
                 print("no match a= ", a)
                 print("Found nothing for o", o)
@@ -43,6 +46,8 @@ def main():
                 useTimingDram = 'yes'
         elif o in ("--TraceDir"):
             traceDir=a
+        elif o in ("--TraceFile"):
+            traceFile=a
         else:
             print("no match for o", o)
             assert False, "Unknown Options !"
@@ -59,7 +64,7 @@ comp_cpu = sst.Component("cpu", "prospero.prosperoCPU")
 comp_cpu.addParams({
        "verbose" : "0",
        "reader" : "prospero.Prospero" + Tracetype + "TraceReader",
-       "readerParams.file" : traceDir + "/" + traceFile
+       "readerParams.file" : os.path.join(traceDir, traceFile)
 })
 comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
 comp_l1cache.addParams({
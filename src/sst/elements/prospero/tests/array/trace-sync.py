@@ -0,0 +1,84 @@
+# Replay two trace shards which are kept in step by a prosperoSyncHub
+import sst
+import os
+import sys,getopt
+
+traceDir = "Dir Error"
+skipToCycle = [ "0", "0" ]
+
+def main():
+    global traceDir
+
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceDir=","SkipShard0=","SkipShard1="])
+    except getopt.GetopError as err:
+        print(str(err))
+        sys.exit(2)
+    for o, a in opts:
+        if o in ("--TraceDir"):
+            traceDir=a
+        elif o in ("--SkipShard0"):
+            skipToCycle[0]=a
+        elif o in ("--SkipShard1"):
+            skipToCycle[1]=a
+        else:
+            print("no match for o", o)
+            assert False, "Unknown Options !"
+
+
+main()
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stop-at", "5s")
+
+# Shard 0 replays a binary trace, shard 1 a block trace, so both seek
+# implementations are used to find skip_to_cycle
+shards = [
+    ( "Binary", "sync-shard0.trace" ),
+    ( "Block",  "sync-shard1.trace.blk" ),
+]
+
+comp_hub = sst.Component("synchub", "prospero.prosperoSyncHub")
+comp_hub.addParams({
+      "shards" : len(shards),
+})
+
+for shard, (tracetype, tracefile) in enumerate(shards):
+    comp_cpu = sst.Component("cpu%d" % shard, "prospero.prosperoCPU")
+    comp_cpu.addParams({
+          "verbose" : "0",
+          "reader" : "prospero.Prospero" + tracetype + "TraceReader",
+          "readerParams.file" : os.path.join(traceDir, tracefile),
+          "skip_to_cycle" : skipToCycle[shard],
+          "sync_file" : os.path.join(traceDir, "sync-shard%d.markers" % shard),
+    })
+    comp_l1cache = sst.Component("l1cache%d" % shard, "memHierarchy.Cache")
+    comp_l1cache.addParams({
+          "access_latency_cycles" : "1",
+          "cache_frequency" : "2 Ghz",
+          "replacement_policy" : "lru",
+          "coherence_protocol" : "MESI",
+          "associativity" : "8",
+          "cache_line_size" : "64",
+          "L1" : "1",
+          "cache_size" : "64 KB"
+    })
+    comp_memctrl = sst.Component("memory%d" % shard, "memHierarchy.MemController")
+    comp_memctrl.addParams({
+          "clock" : "1GHz",
+          "addr_range_start" : 0,
+    })
+    memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+        "access_time" : "10 ns",
+        "mem_size" : "64MiB",
+    })
+
+    # Define the simulation links
+    link_cpu_cache_link = sst.Link("link_cpu_cache_link%d" % shard)
+    link_cpu_cache_link.connect( (comp_cpu, "cache_link", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+    link_mem_bus_link = sst.Link("link_mem_bus_link%d" % shard)
+    link_mem_bus_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_memctrl, "direct_link", "50ps") )
+    link_sync_link = sst.Link("link_sync_link%d" % shard)
+    link_sync_link.connect( (comp_cpu, "sync_link", "1000ps"), (comp_hub, "shard%d" % shard, "1000ps") )
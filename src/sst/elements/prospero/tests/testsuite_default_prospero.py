@@ -4,6 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 import os
 import glob
+import struct
 
 USE_PIN_TRACES = True
 USE_TAR_TRACES = False
@@ -77,6 +78,17 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_binary_withtimingdram_using_TAR_traces(self):
         self.prospero_test_template("binary", WITH_TIMINGDRAM, USE_TAR_TRACES)
 
+    def test_prospero_block_using_TAR_traces(self):
+        self._convert_prospero_block_trace(USE_TAR_TRACES)
+        self.prospero_test_template("block", NO_TIMINGDRAM, USE_TAR_TRACES, ref_trace_name="binary")
+
+    def test_prospero_block_withtimingdram_using_TAR_traces(self):
+        self._convert_prospero_block_trace(USE_TAR_TRACES)
+        self.prospero_test_template("block", WITH_TIMINGDRAM, USE_TAR_TRACES, ref_trace_name="binary")
+
+    def test_prospero_sync_shards(self):
+        self.prospero_sync_test_template()
+
     @unittest.skipIf(not pin_loaded, "test_prospero_text_using_PIN_traces: Requires PIN, but Env Var 'INTEL_PIN_DIR' is not found or path does not exist.")
     def test_prospero_text_using_PIN_traces(self):
         self.prospero_test_template("text", NO_TIMINGDRAM, USE_PIN_TRACES)
@@ -95,7 +107,7 @@ class testcase_prospero(SSTTestCase):
 
 #####
 
-    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240):
+    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240, ref_trace_name=None):
         pass
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -129,8 +141,14 @@ class testcase_prospero(SSTTestCase):
         else:
             tracetype = "tar"
 
+        # A converted trace must replay exactly like the trace it came from
+        if ref_trace_name is None:
+            refDataFileName = testDataFileName
+        else:
+            refDataFileName = testDataFileName.replace(trace_name, ref_trace_name)
+
         sdlfile = "{0}/array/trace-common.py".format(test_path)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, refDataFileName)
         outfile = "{0}/{1}_using_{2}_traces.out".format(outdir, testDataFileName, tracetype)
         errfile = "{0}/{1}_using_{2}_traces.out.err".format(outdir, testDataFileName, tracetype)
         mpioutfiles = "{0}/{1}_using_{2}_traces.out.testfile".format(outdir, testDataFileName, tracetype)
@@ -184,6 +202,58 @@ class testcase_prospero(SSTTestCase):
             self.assertTrue(filesAreTheSame, "Output file {0} does not pass check against the Reference File {1} ".format(outfile, reffile))
 
 
+    def prospero_sync_test_template(self, testtimeout=240):
+        # Replay two shards kept in step by a prosperoSyncHub, each skipping
+        # into its own trace. Shard 1 runs ten times as many cycles between
+        # markers as shard 0, so shard 0 must wait for it at every marker.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        tracedir = "{0}/testProsperoSyncTraces".format(tmpdir)
+        self._create_prospero_sync_traces(tracedir)
+
+        testDataFileName = "test_prospero_sync_shards"
+        sdlfile = "{0}/array/trace-sync.py".format(test_path)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        cmpfile = "{0}/{1}.cmp".format(tmpdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        otherargs = '--model-options=\"--TraceDir={0} --SkipShard0=500 --SkipShard1=5050\"'.format(tracedir)
+        self.run_sst(sdlfile, outfile, errfile, other_args = otherargs,
+                     set_cwd=tracedir, mpi_out_files=mpioutfiles,
+                     timeout_sec=testtimeout)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("prospero test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # The requests issued after skip_to_cycle are fixed by the traces
+        os.system("grep -e '^- \\(Reads\\|Writes\\|Split\\|Bytes\\)' {0} > {1}".format(outfile, cmpfile))
+        cmp_result = testing_compare_sorted_diff(testDataFileName, cmpfile, reffile)
+        if not cmp_result:
+            diffdata = testing_get_diff_data(testDataFileName)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(cmpfile, reffile))
+
+        # The stall cycles depend on the memory timing, but shard 0 cannot
+        # pass its last marker before shard 1 reaches cycle 90000 of its
+        # trace, 84950 cycles into the replay, where shard 0 only needs 8500
+        stalls = {}
+        with open(outfile, 'r') as f:
+            stalled = None
+            for line in f:
+                if line.startswith("- Cycles stalled at sync markers:"):
+                    stalled = int(line.split(":")[1].split()[0])
+                elif line.startswith("- Reads issued:") and stalled is not None:
+                    shard = 0 if int(line.split(":")[1]) > 0 else 1
+                    stalls[shard] = stalled
+                    stalled = None
+        self.assertEqual(len(stalls), 2, "Output file {0} does not report sync stalls for both shards".format(outfile))
+        self.assertTrue(stalls[0] >= 70000, "Shard 0 only stalled {0} cycles at sync markers, it ran ahead of shard 1".format(stalls[0]))
+        self.assertTrue(stalls[1] < stalls[0], "Shard 1 stalled {0} cycles at sync markers, more than shard 0 ({1})".format(stalls[1], stalls[0]))
+
 #######################
 
     def _setup_prospero_test_dirs(self):
@@ -272,6 +342,70 @@ class testcase_prospero(SSTTestCase):
             log_debug("Prospero build binary Traces result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
             self.assertTrue(rtn.result() == 0, "Binary Traces failed to compile")
 
+####
+
+    def _convert_prospero_block_trace(self, use_pin_traces):
+        # Convert the binary trace into a block trace with the converter
+        # tool. Small blocks make the reader step through many blocks, so
+        # the decoder ring wraps and decoded blocks are released.
+        tmpdir = self.get_test_output_tmp_dir()
+        if use_pin_traces:
+            targetdir = "{0}/testProsperoPINTraces".format(tmpdir)
+        else:
+            targetdir = "{0}/testProsperoTARTraces".format(tmpdir)
+
+        infile = "{0}/sstprospero-0-0-bin.trace".format(targetdir)
+        outfile = "{0}.blk".format(infile)
+        if os.path.isfile(outfile):
+            return
+        self.assertTrue(os.path.isfile(infile), "Prospero - binary trace {0} not found".format(infile))
+
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        filepath_block_convert_app = "{0}/sst-prospero-block-convert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(filepath_block_convert_app), "Prospero - {0} not found".format(filepath_block_convert_app))
+
+        # Write a temporary file so a failed conversion is not picked up
+        # by a later test
+        cmd = "{0} -f binary -r 4096 -i {1} -o {2}.tmp".format(filepath_block_convert_app, infile, outfile)
+        rtn = OSCommand(cmd, set_cwd=targetdir).run()
+        log_debug("Prospero block trace convert result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-prospero-block-convert failed to convert {0}".format(infile))
+        os.rename("{0}.tmp".format(outfile), outfile)
+
+####
+
+    def _create_prospero_sync_traces(self, tracedir):
+        # Shard 0 reads every 10 cycles and has a marker every 1000 cycles,
+        # shard 1 writes every 100 cycles with a marker every 10000 cycles.
+        # Both touch a single 4KB page so the L1 absorbs almost everything.
+        if os.path.isfile("{0}/sync-shard1.trace.blk".format(tracedir)):
+            return
+        if not os.path.isdir(tracedir):
+            os.makedirs(tracedir)
+
+        with open("{0}/sync-shard0.trace".format(tracedir), 'wb') as f:
+            for i in range(1000):
+                f.write(struct.pack("<QcQI", i * 10, b'R', 4096 + (i * 8) % 4096, 8))
+        with open("{0}/sync-shard1.trace.txt".format(tracedir), 'w') as f:
+            for i in range(1000):
+                f.write("{0} W {1} 8\n".format(i * 100, 4096 + (i * 8) % 4096))
+
+        for shard, interval in enumerate([1000, 10000]):
+            with open("{0}/sync-shard{1}.markers".format(tracedir, shard), 'w') as f:
+                for epoch in range(9):
+                    f.write("{0} {1}\n".format(epoch, (epoch + 1) * interval))
+
+        # Small blocks so the seek has to search the block index
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        filepath_block_convert_app = "{0}/sst-prospero-block-convert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(filepath_block_convert_app), "Prospero - {0} not found".format(filepath_block_convert_app))
+
+        cmd = "{0} -f text -r 64 -i sync-shard1.trace.txt -o sync-shard1.trace.blk.tmp".format(filepath_block_convert_app)
+        rtn = OSCommand(cmd, set_cwd=tracedir).run()
+        log_debug("Prospero sync trace convert result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-prospero-block-convert failed to convert the shard 1 trace")
+        os.rename("{0}/sync-shard1.trace.blk.tmp".format(tracedir), "{0}/sync-shard1.trace.blk".format(tracedir))
+
 ####
 
     def _download_prospero_TAR_trace_files(self):
@@ -0,0 +1,238 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <string>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "../prosblockwriter.h"
+
+using namespace SST::Prospero;
+
+void printUsage() {
+	printf("sst-prospero-block-convert [options] -i <input> -o <output>\n");
+	printf("\n");
+	printf("Converts an existing Prospero trace into the block compressed format\n");
+	printf("read by prospero.ProsperoBlockTraceReader.\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -f <format>   Input <format> = {text, binary, compressed}, default is binary\n");
+	printf("  -c <codec>    Block <codec> = {none, zlib}, default is zlib when available\n");
+	printf("  -l <layout>   Block <layout> = {rows, columnar}, default is columnar\n");
+	printf("  -r <records>  Number of records per block, default is %d\n", PROSPERO_BLOCK_DEFAULT_RECORDS);
+	printf("  -h            Print this help message\n");
+	printf("\n");
+}
+
+class TraceInput {
+public:
+	virtual ~TraceInput() {}
+	virtual bool next(ProsperoBlockRecord& record) = 0;
+};
+
+class TextTraceInput : public TraceInput {
+public:
+	TextTraceInput(FILE* in) : input(in) {}
+	~TextTraceInput() { fclose(input); }
+
+	bool next(ProsperoBlockRecord& record) {
+		char reqType = 'R';
+
+		if(4 != fscanf(input, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "",
+			&record.cycles, &reqType, &record.address, &record.length)) {
+			return false;
+		}
+
+		record.isWrite = (reqType == 'R' || reqType == 'r') ? 0 : 1;
+		return true;
+	}
+
+private:
+	FILE* input;
+};
+
+// Same 21 byte record the binary and compressed readers consume
+static const size_t binaryRecordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+static void decodeBinaryRecord(const char* buffer, ProsperoBlockRecord& record) {
+	char reqType = 'R';
+
+	memcpy(&record.cycles,  buffer, sizeof(uint64_t));
+	memcpy(&reqType,        buffer + sizeof(uint64_t), sizeof(char));
+	memcpy(&record.address, buffer + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	memcpy(&record.length,  buffer + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	record.isWrite = (reqType == 'R' || reqType == 'r') ? 0 : 1;
+}
+
+class BinaryTraceInput : public TraceInput {
+public:
+	BinaryTraceInput(FILE* in) : input(in) {}
+	~BinaryTraceInput() { fclose(input); }
+
+	bool next(ProsperoBlockRecord& record) {
+		char buffer[binaryRecordLength];
+
+		if(1 != fread(buffer, binaryRecordLength, 1, input)) {
+			return false;
+		}
+
+		decodeBinaryRecord(buffer, record);
+		return true;
+	}
+
+private:
+	FILE* input;
+};
+
+#ifdef HAVE_LIBZ
+class CompressedTraceInput : public TraceInput {
+public:
+	CompressedTraceInput(gzFile in) : input(in) {}
+	~CompressedTraceInput() { gzclose(input); }
+
+	bool next(ProsperoBlockRecord& record) {
+		char buffer[binaryRecordLength];
+
+		if((int) binaryRecordLength != gzread(input, buffer, binaryRecordLength)) {
+			return false;
+		}
+
+		decodeBinaryRecord(buffer, record);
+		return true;
+	}
+
+private:
+	gzFile input;
+};
+#endif
+
+int main(int argc, char* argv[]) {
+	std::string inputFormat = "binary";
+	std::string inputPath   = "";
+	std::string outputPath  = "";
+	uint32_t recordsPerBlock = PROSPERO_BLOCK_DEFAULT_RECORDS;
+	uint32_t flags = PROSPERO_BLOCK_FLAG_COLUMNAR;
+	uint32_t codec = PROSPERO_BLOCK_CODEC_NONE;
+
+	prosperoBlockCodecFromName(PROSPERO_BLOCK_DEFAULT_CODEC_NAME, codec);
+
+	int opt;
+	while(-1 != (opt = getopt(argc, argv, "f:c:l:r:i:o:h"))) {
+		switch(opt) {
+		case 'f':
+			inputFormat = optarg;
+			break;
+		case 'c':
+			if(! prosperoBlockCodecFromName(optarg, codec)) {
+				fprintf(stderr, "Error: unknown codec or codec not available in this build: %s\n", optarg);
+				exit(-1);
+			}
+			break;
+		case 'l':
+			if(! prosperoBlockFlagsFromLayout(optarg, flags)) {
+				fprintf(stderr, "Error: unknown layout: %s\n", optarg);
+				exit(-1);
+			}
+			break;
+		case 'r':
+			recordsPerBlock = (uint32_t) strtoul(optarg, NULL, 10);
+			break;
+		case 'i':
+			inputPath = optarg;
+			break;
+		case 'o':
+			outputPath = optarg;
+			break;
+		case 'h':
+			printUsage();
+			exit(0);
+		default:
+			printUsage();
+			exit(-1);
+		}
+	}
+
+	if("" == inputPath || "" == outputPath || 0 == recordsPerBlock) {
+		printUsage();
+		exit(-1);
+	}
+
+	TraceInput* input = NULL;
+
+	if("text" == inputFormat) {
+		FILE* in = fopen(inputPath.c_str(), "rt");
+		if(NULL != in) input = new TextTraceInput(in);
+	} else if("binary" == inputFormat) {
+		FILE* in = fopen(inputPath.c_str(), "rb");
+		if(NULL != in) input = new BinaryTraceInput(in);
+	} else if("compressed" == inputFormat) {
+#ifdef HAVE_LIBZ
+		gzFile in = gzopen(inputPath.c_str(), "rb");
+		if(NULL != in) input = new CompressedTraceInput(in);
+#else
+		fprintf(stderr, "Error: compressed input requested but this build does not have zlib.\n");
+		exit(-1);
+#endif
+	} else {
+		fprintf(stderr, "Error: unknown input format: %s\n", inputFormat.c_str());
+		exit(-1);
+	}
+
+	if(NULL == input) {
+		fprintf(stderr, "Error: unable to open input trace: %s\n", inputPath.c_str());
+		exit(-1);
+	}
+
+	ProsperoBlockTraceWriter writer;
+
+	if(! writer.open(outputPath, codec, recordsPerBlock, flags, PROSPERO_BLOCK_DEFAULT_FLUSH_BUFFERS)) {
+		fprintf(stderr, "Error: %s\n", writer.getError().c_str());
+		exit(-1);
+	}
+
+	ProsperoBlockRecord record;
+	memset(&record, 0, sizeof(record));
+
+	while(input->next(record)) {
+		if(! writer.append(record.cycles, record.address, record.length, record.isWrite != 0)) {
+			break;
+		}
+	}
+
+	delete input;
+
+	if(! writer.close()) {
+		fprintf(stderr, "Error: %s\n", writer.getError().c_str());
+		exit(-1);
+	}
+
+	printf("Converted %" PRIu64 " records into %" PRIu64 " blocks (%" PRIu64 " bytes).\n",
+		writer.getRecordCount(), writer.getBlockCount(), writer.getBytesWritten());
+
+	return 0;
+}
@@ -32,6 +32,9 @@ uint32_t trace_format;
 uint64_t instruction_count;
 uint32_t traceEnabled __attribute__((aligned(64)));
 uint64_t nextFileTrip;
+uint64_t syncInterval;
+uint64_t nextSyncTrip;
+uint64_t syncEpoch __attribute__((aligned(64)));
 
 const char READ_OPERATION_CHAR = 'R';
 const char WRITE_OPERATION_CHAR = 'W';
@@ -42,13 +45,18 @@ char RECORD_BUFFER[ sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + siz
 // "normal" (binary or text) traces
 FILE** trace;
 
+// Per-thread synchronization marker files, one "epoch instruction" line is
+// written each time a thread passes a global epoch so shards can be replayed
+// with bounded lookahead
+FILE** syncTrace;
+
 typedef struct {
 	UINT64 threadInit;
 	UINT64 insCount;
 	UINT64 readCount;
 	UINT64 writeCount;
 	UINT64 currentFile;
-	UINT64 padD;
+	UINT64 syncEpoch;
 	UINT64 padE;
 	UINT64 padF;
 } threadRecord;
@@ -70,6 +78,8 @@ KNOB<UINT32> KnobTraceEnabled(KNOB_MODE_WRITEONCE, "pintool",
     "d", "1", "Disable until application says that tracing can start, 0=disable until app, 1=start enabled, default=1");
 KNOB<UINT64> KnobFileTrip(KNOB_MODE_WRITEONCE, "pintool",
     "l", "1125899906842624", "Trip into a new trace file at this instruction count, default=1125899906842624 (2**50)");
+KNOB<UINT64> KnobSyncInterval(KNOB_MODE_WRITEONCE, "pintool",
+    "s", "0", "Write a synchronization marker for every thread each time thread 0 executes this many instructions, 0=disabled");
 
 void prospero_enable() {
 	printf("PROSPERO: Tracing enabled\n");
@@ -177,9 +187,29 @@ VOID RecordMemWrite(VOID * addr, UINT32 size, THREADID thr)
 
 }
 
+VOID RecordSyncMarkers(THREADID id) {
+	if(0 == id && thread_instr_id[0].insCount >= nextSyncTrip) {
+		syncEpoch++;
+		nextSyncTrip += syncInterval;
+	}
+
+	// Threads which started late or were descheduled catch up on every
+	// epoch they missed at their current instruction count
+	while(thread_instr_id[id].syncEpoch < syncEpoch) {
+		fprintf(syncTrace[id], "%llu %llu\n",
+			(unsigned long long int) thread_instr_id[id].syncEpoch,
+			(unsigned long long int) thread_instr_id[id].insCount);
+		thread_instr_id[id].syncEpoch++;
+	}
+}
+
 VOID IncrementInstructionCount(THREADID id) {
 	thread_instr_id[id].insCount++;
 
+	if(syncInterval > 0 && id < max_thread_count) {
+		RecordSyncMarkers(id);
+	}
+
 	if(thread_instr_id[id].insCount >= (nextFileTrip * thread_instr_id[id].currentFile)) {
 		char buffer[256];
 
@@ -291,6 +321,12 @@ VOID Fini(INT32 code, VOID *v)
 	}
     }
 
+    if(syncInterval > 0) {
+	for(UINT32 i = 0; i < max_thread_count; ++i) {
+		fclose(syncTrace[i]);
+	}
+    }
+
     printf("PROSPERO: Thread read entries:     %" PRIu64 "\n", thread_instr_id[0].readCount);
     printf("PROSPERO: Thread write entries:    %" PRIu64 "\n", thread_instr_id[0].writeCount);
     printf("PROSPERO: Done.\n");
@@ -371,11 +407,26 @@ int main(int argc, char *argv[])
 
 	// Next file is going to be marked as 1 (we are really on file 0).
 	thread_instr_id[i].currentFile = 1;
+	thread_instr_id[i].syncEpoch = 0;
     }
 
     nextFileTrip = KnobFileTrip.Value();
     printf("PROSPERO: Next file trip count set to %" PRIu64 " instructions.\n", nextFileTrip);
 
+    syncInterval = KnobSyncInterval.Value();
+    syncEpoch = 0;
+    nextSyncTrip = syncInterval;
+
+    if(syncInterval > 0) {
+	printf("PROSPERO: Synchronization markers every %" PRIu64 " instructions.\n", syncInterval);
+	syncTrace = (FILE**) malloc(sizeof(FILE*) * max_thread_count);
+
+	for(UINT32 i = 0; i < max_thread_count; ++i) {
+		sprintf(nameBuffer, "%s-%lu.sync", KnobTraceFile.Value().c_str(), (unsigned long) i);
+		syncTrace[i] = fopen(nameBuffer, "wt");
+	}
+    }
+
     // Thread zero is always started
     thread_instr_id[0].threadInit = 1;
 
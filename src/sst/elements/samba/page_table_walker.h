@@ -21,6 +21,7 @@
 #include <sst/core/componentExtension.h>
 
 #include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/mmu/radixTable.h>
 
 #include <map>
 #include <vector>
@@ -32,6 +33,10 @@
 
 typedef std::pair<uint64_t, int> id_type;
 typedef uint64_t Address_t;
+
+// Page table levels and page mark sets, keyed by virtual page number
+typedef SST::MMU_Lib::RadixTable<Address_t> PageTableLevel;
+typedef SST::MMU_Lib::RadixTable<int> PageMarkTable;
 enum PageMigrationType { NONE, FTP};
 // FTP: First touch policy
 
@@ -106,21 +111,21 @@ class PageTableWalker : public ComponentExtension
 
     // Holds the PGD, PUD, PMT, PTE physical pointers
     // PTE should give you the exact physical address of the page
-    std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-    std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-    std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-    std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
+    PageTableLevel * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
+    PageTableLevel * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
+    PageTableLevel * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
+    PageTableLevel * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
 
     // The structures below are used to quickly check if the page is mapped or not
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
+    PageMarkTable * MAPPED_PAGE_SIZE4KB;
+    PageMarkTable * MAPPED_PAGE_SIZE2MB;
+    PageMarkTable * MAPPED_PAGE_SIZE1GB;
 
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
+    PageMarkTable *PENDING_PAGE_FAULTS;
+    PageMarkTable *PENDING_PAGE_FAULTS_PGD;
+    PageMarkTable *PENDING_PAGE_FAULTS_PUD;
+    PageMarkTable *PENDING_PAGE_FAULTS_PMD;
+    PageMarkTable *PENDING_PAGE_FAULTS_PTE;
 
     // This link is used to send internal events within the page table walker
     SST::Link * s_EventChan;
@@ -156,9 +161,9 @@ class PageTableWalker : public ComponentExtension
     PageTableWalker(ComponentId_t id, int page_size, int assoc, PageTableWalker * next_level, int size);
     PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker * Next_level,int level, SST::Params& params);
 
-    void setPageTablePointers( Address_t * cr3, std::map<Address_t, Address_t> * pgd,  std::map<Address_t, Address_t> * pud,  std::map<Address_t, Address_t> * pmd, std::map<Address_t, Address_t> * pte,
-            std::map<Address_t,int> * gb,  std::map<Address_t,int> * mb,  std::map<Address_t,int> * kb, std::map<Address_t,int> * pr, int *cr3I, std::map<Address_t,int> *pf_pgd,  std::map<Address_t,int> *pf_pud,
-            std::map<Address_t,int> *pf_pmd, std::map<Address_t,int> * pf_pte)
+    void setPageTablePointers( Address_t * cr3, PageTableLevel * pgd,  PageTableLevel * pud,  PageTableLevel * pmd, PageTableLevel * pte,
+            PageMarkTable * gb,  PageMarkTable * mb,  PageMarkTable * kb, PageMarkTable * pr, int *cr3I, PageMarkTable *pf_pgd,  PageMarkTable *pf_pud,
+            PageMarkTable *pf_pmd, PageMarkTable * pf_pte)
     {
         CR3 = cr3;
         PGD = pgd;
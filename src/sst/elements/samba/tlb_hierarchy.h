@@ -102,23 +102,23 @@ class TLBhierarchy : public ComponentExtension
     Address_t *CR3;
 
     // Holds the PGD, PUD, PMT, PTE physical pointers
-    std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-    std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-    std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-    std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
+    PageTableLevel * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
+    PageTableLevel * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
+    PageTableLevel * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
+    PageTableLevel * PTE; // key is 9 bits 12-20, i.e., VA/(4096)
                                             // PTE should give you the exact physical address of the page
 
     // The structures below are used to quickly check if the page is mapped or not
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-    std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
+    PageMarkTable * MAPPED_PAGE_SIZE4KB;
+    PageMarkTable * MAPPED_PAGE_SIZE2MB;
+    PageMarkTable * MAPPED_PAGE_SIZE1GB;
 
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-    std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
-    std::map<Address_t,int> *PENDING_SHOOTDOWN_EVENTS;
+    PageMarkTable *PENDING_PAGE_FAULTS;
+    PageMarkTable *PENDING_PAGE_FAULTS_PGD;
+    PageMarkTable *PENDING_PAGE_FAULTS_PUD;
+    PageMarkTable *PENDING_PAGE_FAULTS_PMD;
+    PageMarkTable *PENDING_PAGE_FAULTS_PTE;
+    PageMarkTable *PENDING_SHOOTDOWN_EVENTS;
 
 
     public:
@@ -133,19 +133,19 @@ class TLBhierarchy : public ComponentExtension
 
 
     void setPageTablePointers(  Address_t * cr3,
-                                std::map<Address_t, Address_t> * pgd,
-                                std::map<Address_t, Address_t> * pud,
-                                std::map<Address_t, Address_t> * pmd,
-                                std::map<Address_t, Address_t> * pte,
-                                std::map<Address_t,int> * gb,
-                                std::map<Address_t,int> * mb,
-                                std::map<Address_t,int> * kb,
-                                std::map<Address_t,int> * pr,
+                                PageTableLevel * pgd,
+                                PageTableLevel * pud,
+                                PageTableLevel * pmd,
+                                PageTableLevel * pte,
+                                PageMarkTable * gb,
+                                PageMarkTable * mb,
+                                PageMarkTable * kb,
+                                PageMarkTable * pr,
                                 int *cr3I,
-                                std::map<Address_t,int> *pf_pgd,
-                                std::map<Address_t,int> *pf_pud,
-                                std::map<Address_t,int> *pf_pmd,
-                                std::map<Address_t,int> * pf_pte)
+                                PageMarkTable *pf_pgd,
+                                PageMarkTable *pf_pud,
+                                PageMarkTable *pf_pmd,
+                                PageMarkTable * pf_pte)
     {
                     CR3 = cr3;
                     PGD = pgd;
@@ -225,20 +225,14 @@ bool TLB::tick(SST::Cycle_t x)
 
 
 		// Check if there are other misses that were going to the same translation and waiting for the response of this miss
-		if((level==1) && (SAME_MISS.find(addr/4096)!=SAME_MISS.end()))
+		SST::MMU_Lib::MissTable<MemHierarchy::MemEventBase *>::Waiters * same_miss = PENDING_MISS.find(addr/4096);
+		if((level==1) && same_miss)
 		{
-		  std::map< MemHierarchy::MemEventBase*, int>::iterator same_st, same_en;
-		  same_st = SAME_MISS[addr/4096].begin();
-    		  same_en = SAME_MISS[addr/4096].end();
-   		   while(same_st!=same_en)
+		    for(auto same_ev : *same_miss)
 		    {
-
-	    		ready_by[same_st->first] = x + latency + 2*upper_link_latency;
-	    		ready_by_size[same_st->first] = pushed_back_size[ev];
-			same_st++;
+	    		ready_by[same_ev] = x + latency + 2*upper_link_latency;
+	    		ready_by_size[same_ev] = pushed_back_size[ev];
 		    }
-		  SAME_MISS.erase(addr/4096);
-		 // PENDING_MISS.erase(addr/4096);
 		}
 		PENDING_MISS.erase(addr/4096);
 
@@ -309,16 +303,16 @@ bool TLB::tick(SST::Cycle_t x)
 
 				// Check if the miss is not currently being handled
 				bool currently_handled=false;
-				if((level==1) && (PENDING_MISS.find(addr/4096) != PENDING_MISS.end()))
+				if((level==1) && PENDING_MISS.contains(addr/4096))
 				{
 
-					SAME_MISS[addr/4096][ev]=1; // Just adding it to the 2D map, so we later hand it back once the master miss is complete
+					PENDING_MISS[addr/4096].push(ev); // Wait on the master miss, we later hand it back once the master miss is complete
 					currently_handled = true;
 				}
 				else if(level==1)
 				{
 
-					PENDING_MISS[addr/4096]=1;
+					PENDING_MISS[addr/4096]; // Opens the master miss entry with no waiters
 
 				}
 
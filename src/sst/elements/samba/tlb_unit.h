@@ -18,6 +18,7 @@
 #include <sst/core/timeConverter.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 #include "page_table_walker.h"
+#include <sst/elements/mmu/missTable.h>
 #include <map>
 #include <vector>
 #include "utils.h"
@@ -74,8 +75,7 @@ class TLB : public ComponentExtension
     // === ???
 	std::map<long long int, int> SIZE_LOOKUP; // This structure checks if a size is supported inside the structure, and its index structure
 
-	std::map< Address_t, std::map< MemHierarchy::MemEventBase *, int, MemEventPtrCompare>> SAME_MISS; // This tracks the misses for the same location and deduplicates them
-	std::map<Address_t, int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
+	SST::MMU_Lib::MissTable<MemHierarchy::MemEventBase *> PENDING_MISS; // This tracks the pages of the current master misses, other misses for the same page wait on the entry
 
 
     //=======================================================================
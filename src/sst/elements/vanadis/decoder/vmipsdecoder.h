@@ -552,6 +552,7 @@ public:
                                         if ( branch_predictor->contains(ip) ) {
                                             const uint64_t predicted_address = branch_predictor->predictAddress(ip);
                                             speculated_ins->setSpeculatedAddress(predicted_address);
+                                            speculated_ins->setPredictionTag(branch_predictor->predictionTag());
 
                                             // This is essential a predicted not taken branch
                                             if ( predicted_address == (ip + 8) ) {
@@ -591,6 +592,7 @@ public:
                                             //											speculated_ins->setSpeculatedDirection(
                                             // BRANCH_NOT_TAKEN );
                                             speculated_ins->setSpeculatedAddress(ip + 8);
+                                            speculated_ins->setPredictionTag(branch_predictor->predictionTag());
 
                                             // We don't urgh.. let's just carry on
                                             // remember we increment the IP by 2 instructions (me +
@@ -171,6 +171,7 @@ public:
                                     // We have an address predicton from the branching unit
                                     const uint64_t predicted_address = branch_predictor->predictAddress(ip);
                                     next_spec_ins->setSpeculatedAddress(predicted_address);
+                                    next_spec_ins->setPredictionTag(branch_predictor->predictionTag());
 
                                     if(output->getVerboseLevel() >= 16) {
                                         output->verbose(
@@ -198,6 +199,7 @@ public:
 
                                     ip += bundle->pcIncrement();
                                     next_spec_ins->setSpeculatedAddress(ip);
+                                    next_spec_ins->setPredictionTag(branch_predictor->predictionTag());
                                     bundle_has_branch = true;
                                 }
                             }
@@ -46,11 +46,14 @@ public:
 
         // speculatedAddress = (addr + 4);
         takenAddress = UINT64_MAX;
+        predictionTag = 0;
     }
 
     virtual uint64_t getSpeculatedAddress() const { return speculatedAddress; }
     virtual void     setSpeculatedAddress(const uint64_t spec_ad) { speculatedAddress = spec_ad; }
     virtual uint64_t getTakenAddress() const { return takenAddress; }
+    uint64_t         getPredictionTag() const { return predictionTag; }
+    void             setPredictionTag(const uint64_t tag) { predictionTag = tag; }
     virtual bool     isSpeculated() const { return true; }
 
     virtual VanadisFunctionalUnitType getInstFuncType() const { return INST_BRANCH; }
@@ -58,8 +61,12 @@ public:
     virtual VanadisDelaySlotRequirement getDelaySlotType() const { return delayType; }
     uint64_t                            getInstructionWidth() const { return ins_width; }
 
+    // Address execution resumes at if the branch is not taken, this is also
+    // the value written to the link register by jump-and-link instructions
+    uint64_t getNotTakenAddress() const { return calculateStandardNotTakenAddress(); }
+
 protected:
-    uint64_t calculateStandardNotTakenAddress()
+    uint64_t calculateStandardNotTakenAddress() const
     {
         uint64_t new_addr = getInstructionAddress();
 
@@ -79,6 +86,7 @@ protected:
     VanadisDelaySlotRequirement delayType;
     uint64_t                    speculatedAddress;
     uint64_t                    takenAddress;
+    uint64_t                    predictionTag;
     uint64_t                    ins_width;
 };
 
@@ -0,0 +1,134 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <algorithm>
+#include <cassert>
+#include <inttypes.h>
+
+#include "os/velfcache.h"
+
+namespace SST {
+namespace Vanadis {
+
+VanadisELFImageCache& VanadisELFImageCache::getInstance() {
+    static VanadisELFImageCache instance;
+    return instance;
+}
+
+VanadisELFImageCache::~VanadisELFImageCache() {
+    for ( auto& kv : m_byPath ) {
+        destroy( kv.second );
+    }
+}
+
+VanadisELFInfo* VanadisELFImageCache::acquire( Output* output, const std::string& path ) {
+    std::lock_guard<std::mutex> guard( m_lock );
+
+    auto iter = m_byPath.find( path );
+    if ( iter == m_byPath.end() ) {
+        // readBinaryELFInfo does not return if fatal error is encountered
+        Entry* entry = new Entry( readBinaryELFInfo( output, path.c_str() ), path );
+        iter = m_byPath.insert( std::make_pair( path, entry ) ).first;
+        m_byInfo[entry->info] = entry;
+    }
+
+    ++iter->second->refCount;
+    return iter->second->info;
+}
+
+void VanadisELFImageCache::release( VanadisELFInfo* elf_info ) {
+    std::lock_guard<std::mutex> guard( m_lock );
+
+    auto iter = m_byInfo.find( elf_info );
+    assert( iter != m_byInfo.end() );
+
+    Entry* entry = iter->second;
+    if ( 0 == --entry->refCount ) {
+        m_byInfo.erase( iter );
+        m_byPath.erase( entry->path );
+        destroy( entry );
+    }
+}
+
+void VanadisELFImageCache::destroy( Entry* entry ) {
+    if ( nullptr != entry->file ) {
+        fclose( entry->file );
+    }
+    delete entry->info;
+    delete entry;
+}
+
+VanadisELFImageCache::PageImage VanadisELFImageCache::getZeroPage( int page_size ) {
+    auto iter = m_zeroPages.find( page_size );
+    if ( iter == m_zeroPages.end() ) {
+        iter = m_zeroPages.insert( std::make_pair( page_size, std::make_shared<const std::vector<uint8_t>>( page_size, 0 ) ) ).first;
+    }
+    return iter->second;
+}
+
+VanadisELFImageCache::PageImage VanadisELFImageCache::getPage( Output* output, VanadisELFInfo* elf_info,
+        const VanadisELFProgramHeaderEntry* hdr, uint64_t page_addr, int page_size )
+{
+    std::lock_guard<std::mutex> guard( m_lock );
+
+    auto entryIter = m_byInfo.find( elf_info );
+    assert( entryIter != m_byInfo.end() );
+    Entry* entry = entryIter->second;
+
+    PageKey key( hdr, page_addr, page_size );
+    auto pageIter = entry->pages.find( key );
+    if ( pageIter != entry->pages.end() ) {
+        return pageIter->second;
+    }
+
+    uint64_t secAddr = hdr->getVirtualMemoryStart();
+    uint64_t start = std::max( page_addr, secAddr );
+    uint64_t end = std::min( page_addr + page_size, secAddr + hdr->getHeaderImageLength() );
+
+    PageImage image;
+
+    if ( start < end ) {
+        if ( nullptr == entry->file ) {
+            entry->file = fopen( entry->path.c_str(), "rb" );
+            if ( nullptr == entry->file ) {
+                output->fatal(CALL_INFO, -1, "Error: unable to open %s\n", entry->path.c_str() );
+            }
+        }
+
+        std::vector<uint8_t>* data = new std::vector<uint8_t>( page_size, 0 );
+
+        fseek( entry->file, hdr->getImageOffset() + ( start - secAddr ), SEEK_SET );
+        if ( 1 != fread( data->data() + ( start - page_addr ), end - start, 1, entry->file ) ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to read %s\n", entry->path.c_str() );
+        }
+
+        if ( std::all_of( data->begin(), data->end(), []( uint8_t byte ) { return 0 == byte; } ) ) {
+            delete data;
+            image = getZeroPage( page_size );
+        } else {
+            image = PageImage( data );
+        }
+    } else {
+        image = getZeroPage( page_size );
+    }
+
+    entry->pages[key] = image;
+    return image;
+}
+
+} // namespace Vanadis
+} // namespace SST
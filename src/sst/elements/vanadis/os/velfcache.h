@@ -0,0 +1,80 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_OS_ELF_IMAGE_CACHE
+#define _H_VANADIS_OS_ELF_IMAGE_CACHE
+
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sst/core/output.h"
+#include "velf/velfinfo.h"
+
+namespace SST {
+namespace Vanadis {
+
+/*
+ * Process-wide cache of parsed ELF headers and of the read-only page images
+ * loaded from them. Every node OS (on every SST thread) that runs the same
+ * binary shares one parse and reads each page from the file only once.
+ * Pages that are entirely zero share a single buffer.
+ */
+class VanadisELFImageCache {
+public:
+    typedef std::shared_ptr<const std::vector<uint8_t>> PageImage;
+
+    static VanadisELFImageCache& getInstance();
+
+    // Returns the shared ELF info for path, parsing it on first use
+    VanadisELFInfo* acquire( Output* output, const std::string& path );
+    void release( VanadisELFInfo* elf_info );
+
+    // The page_size bytes at page_addr that come from hdr's file image, zero filled elsewhere
+    PageImage getPage( Output* output, VanadisELFInfo* elf_info, const VanadisELFProgramHeaderEntry* hdr,
+            uint64_t page_addr, int page_size );
+
+    ~VanadisELFImageCache();
+
+private:
+    typedef std::tuple<const VanadisELFProgramHeaderEntry*, uint64_t, int> PageKey;
+
+    struct Entry {
+        Entry( VanadisELFInfo* info, const std::string& path ) : info(info), path(path), file(nullptr), refCount(0) {}
+        VanadisELFInfo*                 info;
+        std::string                     path;
+        FILE*                           file;
+        unsigned                        refCount;
+        std::map<PageKey, PageImage>    pages;
+    };
+
+    VanadisELFImageCache() {}
+    PageImage getZeroPage( int page_size );
+    void destroy( Entry* entry );
+
+    std::mutex                                  m_lock;
+    std::map<std::string, Entry*>               m_byPath;
+    std::map<const VanadisELFInfo*, Entry*>     m_byInfo;
+    std::map<int, PageImage>                    m_zeroPages;
+};
+
+}
+}
+
+#endif
@@ -18,6 +18,7 @@
 #include <string>
 #include <math.h>
 #include "os/velfloader.h"
+#include "os/velfcache.h"
 #include "os/vloadpage.h"
 #include "os/vosDbgFlags.h"
 
@@ -115,55 +116,22 @@ void loadElfFile( Output* output, Interfaces::StandardMem* mem_if, MMU_Lib::MMU*
 }
 
 uint8_t* readElfPage( Output* output, VanadisELFInfo* elf_info, int vpn, int page_size ) {
-    uint64_t virtAddr = vpn<<12;  
+    uint64_t virtAddr = (uint64_t) vpn * page_size;
     auto path = elf_info->getBinaryPath();
-    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF, "-> Loading %s, to locate program sections ...\n", path);
     output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"%s vpn=%d addr=%#" PRIx64 " page_size=%d\n",path,vpn,virtAddr,page_size);
-    FILE* exec_file = fopen(elf_info->getBinaryPath(), "rb");
-    if ( nullptr == exec_file ) {
-        output->fatal(CALL_INFO, -1, "Error: unable to open %s\n", path);
-    }
-    uint8_t* data = new uint8_t[page_size];
-    bzero(data, page_size); 
     const VanadisELFProgramHeaderEntry* secHdr = elf_info->findProgramHeader( virtAddr );
 
     assert( secHdr );
-    uint64_t secAddr = secHdr->getVirtualMemoryStart(); 
-    size_t   secMemLen = secHdr->getHeaderMemoryLength();
-    size_t   secImageLen = secHdr->getHeaderImageLength();
-    size_t   secImageOffset = secHdr->getImageOffset();
-    uint64_t secAlignment = secHdr->getAlignment();
-    uint64_t secFlags = secHdr->getSegmentFlags();
-
-    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF," section: virtAddr=%#" PRIx64 " imageOffset=%zu memLen=%zu imageLen=%zu flags=%#" PRIx64 " align=%#" PRIx64 "\n",
-            secAddr,secImageOffset,secMemLen,secImageLen,secFlags,secAlignment);
-
-    // if the requested address is less than the section virtual address then this is the first page and it's not aligned
-    // we read the file from the start of the section
-    size_t imageOffset = virtAddr < secAddr ? 0 : virtAddr - secAddr;
-     
-    // The memory footprint of the section can be greater than the file image.
-    // if the imageOffset is less than the secImageLen we had data to transfer
-    if ( imageOffset < secImageLen ) {
-        // we write the data to offset in the buffer 
-        size_t dataOffset = virtAddr < secAddr ? secAddr - virtAddr : 0;
-
-        // at most we read a page
-        size_t numBytes = page_size;
-    
-        // if we are not aligned we can, at most, read from the unaligned start to the end of the page
-        numBytes -= dataOffset;
-
-        // if there is not enough data to read a full pagge
-        numBytes = secImageLen - imageOffset < numBytes ? secImageLen - imageOffset : numBytes;
-    
-        output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF,"imageOffset=%zu dataOffset=%zu numBytes=%zu toEnd=%zu\n", imageOffset, dataOffset, numBytes, secImageLen - imageOffset );
-        fseek(exec_file, secImageOffset + imageOffset, SEEK_SET); 
-
-        fread( data + dataOffset, numBytes, 1, exec_file);
-    }
+    output->verbose( CALL_INFO, 2, VANADIS_OS_DBG_READ_ELF," section: virtAddr=%#" PRIx64 " imageOffset=%" PRIu64 " memLen=%" PRIu64 " imageLen=%" PRIu64 " flags=%#" PRIx64 " align=%#" PRIx64 "\n",
+            secHdr->getVirtualMemoryStart(),secHdr->getImageOffset(),secHdr->getHeaderMemoryLength(),secHdr->getHeaderImageLength(),
+            secHdr->getSegmentFlags(),secHdr->getAlignment());
 
-    fclose(exec_file);
+    // the page image is read from the file once per process and shared by every node OS
+    auto image = VanadisELFImageCache::getInstance().getPage( output, elf_info, secHdr, virtAddr, page_size );
+
+    // the caller owns the returned buffer
+    uint8_t* data = new uint8_t[page_size];
+    memcpy( data, image->data(), page_size );
     return data; 
 }
 
@@ -17,6 +17,7 @@
 #include <sst_config.h>
 #include <sst/core/component.h>
 
+#include <algorithm>
 #include <functional>
 
 #include "os/vgetthreadstate.h"
@@ -25,6 +26,7 @@
 #include "os/vnodeos.h"
 #include "os/voscallev.h"
 #include "os/velfloader.h"
+#include "os/velfcache.h"
 #include "os/vstartthreadreq.h"
 #include "os/vdumpregsreq.h"
 #include "sst/elements/mmu/utils.h"
@@ -95,6 +97,11 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
         // we don't use it
     }
 
+    m_preloadElf = params.find<bool>("preload_elf", false);
+    if ( m_preloadElf && nullptr == m_mmu ) {
+        output->fatal(CALL_INFO, -1, "Error: preload_elf requires useMMU\n");
+    }
+
     m_nodeNum = params.find<int>("node_id", -1);
 
     int numProcess = 0;
@@ -111,8 +118,8 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
 
             auto iter = m_elfMap.find( exe );
             if ( iter == m_elfMap.end() ) {
-                VanadisELFInfo* elfInfo = readBinaryELFInfo(output, exe.c_str());
-                // readBinaryELFInfo does not return if fatal error is encountered
+                // the parsed ELF, and the page images read from it, are shared by all node OS instances
+                VanadisELFInfo* elfInfo = VanadisELFImageCache::getInstance().acquire( output, exe );
                 if ( elfInfo->isDynamicExecutable() ) {
                     output->fatal( CALL_INFO, -1, "--> error - exe %s is not staticlly linked\n",exe.c_str());
                 }
@@ -177,6 +184,9 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
 }
 
 VanadisNodeOSComponent::~VanadisNodeOSComponent() {
+    for ( auto& kv : m_elfMap ) {
+        VanadisELFImageCache::getInstance().release( kv.second );
+    }
     delete output;
     delete m_physMemMgr;
 }
@@ -189,6 +199,13 @@ VanadisNodeOSComponent::init(unsigned int phase) {
         m_mmu->init(phase);
     }
 
+    // the backing store accepts untimed writes in any init phase, do it once
+    if ( m_preloadElf && 0 == phase ) {
+        for ( const auto kv : m_threadMap ) {
+            preloadElfPages( kv.second );
+        }
+    }
+
     // do we need to check for this, really?
     for (Link* next_link : core_links) {
         while (SST::Event* ev = next_link->recvUntimedData()) {
@@ -254,7 +271,10 @@ VanadisNodeOSComponent::startProcess( OS::HwThreadID& threadID, OS::ProcessInfo*
     int pid = process->getpid();
 
     if ( m_mmu ) {
-        m_mmu->initPageTable( pid );
+        // the page table was created when the ELF was preloaded
+        if ( ! m_preloadElf ) {
+            m_mmu->initPageTable( pid );
+        }
         m_mmu->setCoreToPageTable( threadID.core, threadID.hwThread, pid );
     }
 
@@ -317,6 +337,108 @@ void VanadisNodeOSComponent::writeMem( OS::ProcessInfo* process, uint64_t virtAd
     writePage( page->getPPN() << m_pageShift, tmp, m_pageSize, callback );
 }
 
+// Map every page of the ELF load segments that has file image data and write
+// its contents straight into the memory backing store with an untimed write.
+// Pages which are only zero fill (bss) are left to be faulted in on demand.
+void VanadisNodeOSComponent::preloadElfPages( OS::ProcessInfo* process )
+{
+    VanadisELFInfo* elfInfo = process->getElfInfo();
+    unsigned pid = process->getpid();
+
+    m_mmu->initPageTable( pid );
+
+    size_t numPages = 0;
+    size_t numCached = 0;
+
+    for ( size_t i = 0; i < elfInfo->countProgramHeaders(); ++i ) {
+        const VanadisELFProgramHeaderEntry* hdr = elfInfo->getProgramHeader(i);
+        if ( PROG_HEADER_LOAD != hdr->getHeaderType() || 0 == hdr->getHeaderImageLength() ) {
+            continue;
+        }
+
+        uint64_t secAddr = hdr->getVirtualMemoryStart();
+        uint64_t secImageEnd = secAddr + hdr->getHeaderImageLength();
+        uint64_t pageAddr = secAddr & ~((uint64_t) m_pageSize - 1);
+
+        auto region = process->findMemRegion( secAddr );
+        assert( region && region->backing && region->backing->elfInfo == elfInfo );
+        bool isText = 0 == region->name.compare("text");
+
+        output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_INIT, "pid=%u preload segment %#" PRIx64 " - %#" PRIx64 " region=%s\n",
+                pid, secAddr, secImageEnd, region->name.c_str() );
+
+        for ( ; pageAddr < secImageEnd; pageAddr += m_pageSize ) {
+            unsigned vpn = pageAddr >> m_pageShift;
+
+            // a segment can start in the last page of the previous one, write
+            // this segment's bytes into that page rather than a new one
+            int pagePerms = m_mmu->getPerms( pid, vpn );
+            if ( -1 != pagePerms ) {
+                preloadSharedElfPage( process, elfInfo, hdr, region, vpn, pagePerms );
+                continue;
+            }
+
+            OS::Page* page = isText ? checkPageCache( elfInfo, vpn ) : nullptr;
+
+            // shared text pages are owned by the page cache, not the region
+            if ( nullptr != page ) {
+                page->incRefCnt();
+                m_mmu->map( pid, vpn, page->getPPN(), m_pageSize, region->perms );
+                ++numCached;
+                continue;
+            }
+
+            try {
+                page = allocPage( );
+            } catch ( int err ) {
+                output->fatal(CALL_INFO, -1, "Error: ran out of physical memory\n");
+            }
+
+            process->mapVirtToPage( vpn, page );
+            m_mmu->map( pid, vpn, page->getPPN(), m_pageSize, region->perms );
+            if ( isText ) {
+                updatePageCache( elfInfo, vpn, page );
+            }
+
+            auto image = VanadisELFImageCache::getInstance().getPage( output, elfInfo, hdr, pageAddr, m_pageSize );
+
+            mem_if->sendUntimedData( new StandardMem::Write( (uint64_t) page->getPPN() << m_pageShift, image->size(), *image ) );
+            ++numPages;
+        }
+    }
+
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_INIT, "pid=%u preloaded %zu ELF pages, %zu shared from the page cache\n",
+            pid, numPages, numCached );
+}
+
+// The first page of a segment is already mapped by the segment before it.
+// Write only the bytes this segment covers, at their offset in the page, and
+// add the segment's read and execute permissions to the mapping. Write
+// permission is not added: the page may be a text page shared through the
+// page cache, the first store takes the copy on write fault instead.
+void VanadisNodeOSComponent::preloadSharedElfPage( OS::ProcessInfo* process, VanadisELFInfo* elfInfo,
+        const VanadisELFProgramHeaderEntry* hdr, OS::MemoryRegion* region, unsigned vpn, int pagePerms )
+{
+    unsigned pid = process->getpid();
+    uint64_t pageAddr = (uint64_t) vpn << m_pageShift;
+    uint64_t start = std::max( pageAddr, hdr->getVirtualMemoryStart() );
+    uint64_t end = std::min( pageAddr + m_pageSize, hdr->getVirtualMemoryStart() + hdr->getHeaderImageLength() );
+    uint32_t ppn = m_mmu->virtToPhys( pid, vpn );
+
+    auto image = VanadisELFImageCache::getInstance().getPage( output, elfInfo, hdr, pageAddr, m_pageSize );
+    std::vector<uint8_t> data( image->begin() + ( start - pageAddr ), image->begin() + ( end - pageAddr ) );
+
+    output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_INIT, "pid=%u vpn=%u ppn=%" PRIu32 " already mapped, write %#" PRIx64 " - %#" PRIx64 "\n",
+            pid, vpn, ppn, start, end );
+
+    mem_if->sendUntimedData( new StandardMem::Write( ( (uint64_t) ppn << m_pageShift ) + ( start - pageAddr ), data.size(), data ) );
+
+    uint32_t perms = pagePerms | ( region->perms & ~0x2 );
+    if ( perms != (uint32_t) pagePerms ) {
+        m_mmu->map( pid, vpn, ppn, m_pageSize, perms );
+    }
+}
+
 void
 VanadisNodeOSComponent::handleIncomingSyscall(SST::Event* ev) {
     VanadisSyscallEvent* sys_ev = dynamic_cast<VanadisSyscallEvent*>(ev);
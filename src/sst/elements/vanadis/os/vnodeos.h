@@ -57,6 +57,8 @@ public:
                             { "physMemSize", "Size of available physical memory in bytes, with units. Ex: 2GiB", NULL },
                             { "page_size", "Size of a page, in bytes", "4096" },
                             { "useMMU", "Whether an MMU subcomponent is being used.", "False" },
+                            { "preload_elf", "Place the ELF segments and their page table entries directly into the memory backing store during init, "
+                                             "rather than demand loading them with timed memory writes. Requires useMMU.", "False" },
                             { "process%(processnum)d.env_count", "Number of environment variables to pass to the process", "0"},
                             { "process%(processnum)d.env%(argnum)d", "Environment variable to pass to the process. Example: 'OMPNUMTHREADS=64'. 'argnum' should be contiguous starting at 0 and ending at env_count-1", ""},
                             { "proccess%(processnum)d.exe", "Name of executable, including path", NULL},
@@ -168,6 +170,9 @@ private:
     void pageFault( PageFault* );
     void pageFaultFini( PageFault*, bool success = true );
     void startProcess( OS::HwThreadID&, OS::ProcessInfo* process );
+    void preloadElfPages( OS::ProcessInfo* process );
+    void preloadSharedElfPage( OS::ProcessInfo* process, VanadisELFInfo* elfInfo, const VanadisELFProgramHeaderEntry* hdr,
+            OS::MemoryRegion* region, unsigned vpn, int pagePerms );
     void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, Callback* );
 
     void sendMemoryEvent(VanadisSyscall* syscall, StandardMem::Request* ev ) {
@@ -355,6 +360,7 @@ private:
     uint64_t                    m_stack_top;
     int                         m_nodeNum;
     uint64_t                    m_osStartTimeNano;
+    bool                        m_preloadElf;
 
     std::queue<PageFault*>                          m_pendingFault;
     std::map<std::string, VanadisELFInfo* >         m_elfMap; 
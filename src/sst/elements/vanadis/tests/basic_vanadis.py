@@ -15,6 +15,10 @@ isa="riscv64"
 
 loader_mode = os.getenv("VANADIS_LOADER_MODE", "0")
 
+branch_unit = os.getenv("VANADIS_BRANCH_UNIT", "vanadis.VanadisBasicBranchUnit")
+
+preload_elf = os.getenv("VANADIS_PRELOAD_ELF", "0")
+
 testDir="basic-io"
 exe = "hello-world"
 #exe = "hello-world-cpp"
@@ -133,6 +137,7 @@ osParams = {
     "page_size"  : 4096,
     "physMemSize" : physMemSize,
     "useMMU" : True,
+    "preload_elf" : preload_elf,
 }
 
 
@@ -346,7 +351,7 @@ class CPU_Builder:
             os_hdlr.addParams( osHdlrParams )
 
             # CPU.decocer.branch_pred
-            branch_pred = decode.setSubComponent( "branch_unit", "vanadis.VanadisBasicBranchUnit" )
+            branch_pred = decode.setSubComponent( "branch_unit", branch_unit )
             branch_pred.addParams( branchPredParams )
             branch_pred.enableAllStatistics()
 
@@ -9,6 +9,16 @@ module_init = 0
 module_sema = threading.Semaphore()
 vanadis_test_matrix = []
 
+# A variant reruns an existing test with extra environment settings for
+# basic_vanadis.py and checks the program output against the same gold
+# files. Timing and statistics change with the configuration, so the SST
+# statistics gold file is not compared for a variant.
+vanadis_variants = {
+    "preload" : { "VANADIS_PRELOAD_ELF" : "1" },
+    "gshare" : { "VANADIS_BRANCH_UNIT" : "vanadis.VanadisGShareBranchUnit" },
+    "tage" : { "VANADIS_BRANCH_UNIT" : "vanadis.VanadisTAGEBranchUnit" },
+}
+
 MakeTests = False
 #MakeTests = True
 updateFiles = False
@@ -91,6 +101,17 @@ def build_vanadis_test_matrix():
             testlist.append(["basic_vanadis.py", location, test,arch, 1,32, "32thread", 300])
             testlist.append(["basic_vanadis.py", location, test,arch, 4,8, "4core-8thread", 300])
 
+    # variants of the tests above
+    arch_list = ["mipsel","riscv64"]
+    for arch in arch_list:
+        testlist.append(["basic_vanadis.py", "small/basic-io", "hello-world", arch, 1, 1, "", 300, "preload"])
+        testlist.append(["basic_vanadis.py", "small/basic-io", "printf-check", arch, 1, 1, "", 300, "preload"])
+        testlist.append(["basic_vanadis.py", "small/misc", "fork", arch, 2, 1, "gold1", 300, "preload"])
+        for variant in ["gshare", "tage"]:
+            testlist.append(["basic_vanadis.py", "small/basic-ops", "test-branch", arch, 1, 1, "", 300, variant])
+            testlist.append(["basic_vanadis.py", "small/basic-io", "printf-check", arch, 1, 1, "", 300, variant])
+            testlist.append(["basic_vanadis.py", "small/basic-math", "sqrt-double", arch, 1, 1, "", 300, variant])
+
     # Process each line and crack up into an index, hash, options and sdl file
     for testnum, test_info in enumerate(testlist):
         # Make testnum start at 1
@@ -103,10 +124,13 @@ def build_vanadis_test_matrix():
         numHwThreads = test_info[5]
         goldfiledir = test_info[6]
         timeout_sec = test_info[7]
+        variant = test_info[8] if len(test_info) > 8 else ""
         testname = "{0}_{1}_{2}_{3}".format(elftestdir.replace("/", "_"), elffile,isa,goldfiledir)
+        if len(variant):
+            testname = "{0}_{1}".format(testname, variant)
 
         # Build the test_data structure
-        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec )
+        test_data = (testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, variant )
         vanadis_test_matrix.append(test_data)
 
 ################################################################################
@@ -162,20 +186,22 @@ class testcase_vanadis(SSTTestCase):
 #####
 
     @parameterized.expand(vanadis_test_matrix, name_func=gen_custom_name)
-    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec):
+    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, variant):
         self._checkSkipConditions( isa )
 
         if MakeTests:
             self.makeTest( testname, isa, elftestdir, elffile )
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}, isa {5}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, isa, timeout_sec))
-        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec )
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, timeout_sec, variant )
 
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, isa, numCores, numHwThreads, goldfiledir, testtimeout=120, variant=""):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}/{3}/{4}".format(self.get_test_output_run_dir(), elftestdir,elffile,isa,goldfiledir)
+        if len(variant):
+            outdir = "{0}/{1}".format(outdir, variant)
         tmpdir = self.get_test_output_tmp_dir()
         os.makedirs(outdir)
 
@@ -208,6 +234,13 @@ class testcase_vanadis(SSTTestCase):
         os.environ['VANADIS_NUM_CORES'] = str(numCores)
         os.environ['VANADIS_NUM_HW_THREADS'] = str(numHwThreads)
 
+        # the environment is shared by all tests, clear every variant setting first
+        for settings in vanadis_variants.values():
+            for key in settings:
+                os.environ.pop(key, None)
+        if len(variant):
+            os.environ.update(vanadis_variants[variant])
+
         testfile_exists = os.path.exists(testfilepath) and os.path.isfile(testfilepath)
         self.assertTrue(testfile_exists, "Vanadis test {0} does not exist".format(testfilepath))
 
@@ -224,7 +257,10 @@ class testcase_vanadis(SSTTestCase):
         self.assertTrue(os_outfileexists, "Vanadis test outfile-os not found in directory {0}".format(outdir))
         self.assertTrue(os_errfileexists, "Vanadis test errfile-os not found in directory {0}".format(outdir))
 
-        if ( os.path.exists( ref_sst_outfile ) ):
+        if len(variant):
+            cmd = 'grep -q "all process have exited" {0}'.format(sst_outfile)
+            self.assertTrue(os.system(cmd) == 0, "Vanadis output file {0} does not show all processes exiting".format(sst_outfile))
+        elif ( os.path.exists( ref_sst_outfile ) ):
             cmp_result = testing_compare_filtered_diff(testname, sst_outfile, ref_sst_outfile ,filters=[StartsWithFilter(" v0.instructions_issued.1")])
             if (cmp_result == False):
                 diffdata = testing_get_diff_data(testname)
@@ -863,7 +863,15 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 }
 #endif
                 thread_decoders[ins_thread]->getBranchPredictor()->push(
-                    spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                    spec_ins->getInstructionAddress(), pipeline_reset_addr, spec_ins->getPredictionTag(),
+                    perform_pipeline_clear);
+
+                // a taken branch which writes a (non-zero) link register is a call
+                if ( (spec_ins->countISAIntRegOut() > 0) && (pipeline_reset_addr != spec_ins->getNotTakenAddress()) &&
+                     (spec_ins->getISAIntRegOut(0) != spec_ins->getISAOptions()->getRegisterIgnoreWrites()) ) {
+                    thread_decoders[ins_thread]->getBranchPredictor()->notifyCall(
+                        spec_ins->getInstructionAddress(), spec_ins->getNotTakenAddress());
+                }
 
                 if ( stop_verbose_when_retire_address > 0 && (rob_front->getInstructionAddress() == stop_verbose_when_retire_address) ) {
                     output->setVerboseLevel(0);
@@ -0,0 +1,286 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_GSHARE
+#define _H_VANADIS_BRANCH_UNIT_GSHARE
+
+#include "vbranch/vbranchunit.h"
+#include "vbranch/vbranchras.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Branch target predictor which indexes a single flat table by the branch
+// address XOR'd with a global path history. Branches which resolve to the
+// address on the top of the return address stack are marked as returns and
+// predicted from the stack instead of the table.
+//
+// The history is updated at retire so the fetch-side prediction uses the
+// committed (non-speculative) path, no repair is needed on a squash. Each
+// prediction records the table index it was read from and the branch trains
+// that entry when it retires, even if the history has moved on since.
+class VanadisGShareBranchUnit : public VanadisBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisGShareBranchUnit, "vanadis", "VanadisGShareBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Implements a gshare-style branch target predictor using a flat table indexed "
+                                          "by branch address and global path history with a return address stack",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "branch_entries", "Sets the number of entries in the prediction table, must be a power of two", "1024" },
+                            { "history_bits", "Sets the number of global history bits folded into the table index", "10" },
+                            { "ras_entries", "Sets the number of entries in the return address stack", "16" })
+
+    SST_ELI_DOCUMENT_STATISTICS({ "branch_cache_hit",
+                                  "Counts the number of times a speculated "
+                                  "address is found in the prediction table",
+                                  "hits", 1 },
+                                { "branch_cache_miss",
+                                  "Counts the number of times a speculated "
+                                  "address is not found in the prediction table",
+                                  "misses", 1 },
+                                { "branch_cache_castout",
+                                  "Counts the number of entries that are replaced by a different branch",
+                                  "entries", 1 },
+                                { "branch_predict_correct",
+                                  "Counts retired branches whose target matched the prediction", "branches", 1 },
+                                { "branch_predict_incorrect",
+                                  "Counts retired branches whose target did not match the prediction", "branches", 1 },
+                                { "branch_table_probes",
+                                  "Counts the number of table entries read to form predictions", "probes", 1 },
+                                { "branch_ras_predict",
+                                  "Counts the number of predictions supplied by the return address stack", "predictions", 1 })
+
+    VanadisGShareBranchUnit(ComponentId_t id, Params& params) : VanadisBranchUnit(id, params),
+        ras(params.find<uint32_t>("ras_entries", 16)) {
+
+        const uint32_t entries = params.find<uint32_t>("branch_entries", 1024);
+        const uint32_t history_bits = params.find<uint32_t>("history_bits", 10);
+
+        if ((0 == entries) || (0 != (entries & (entries - 1)))) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                "Error: branch_entries (%" PRIu32 ") must be a power of two.\n", entries);
+        }
+
+        if (history_bits > 63) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                "Error: history_bits (%" PRIu32 ") must be less than 64.\n", history_bits);
+        }
+
+        table.resize(entries);
+        return_marks.resize(entries, 0);
+
+        index_mask = entries - 1;
+        history_mask = (UINT64_C(1) << history_bits) - 1;
+        history = 0;
+
+        predictions.resize(prediction_slots);
+        next_prediction_tag = 1;
+        last_lookup_valid = false;
+
+        stat_branch_hits = registerStatistic<uint64_t>("branch_cache_hit", "1");
+        stat_branch_misses = registerStatistic<uint64_t>("branch_cache_miss", "1");
+        stat_branch_cache_castout = registerStatistic<uint64_t>("branch_cache_castout", "1");
+        stat_predict_correct = registerStatistic<uint64_t>("branch_predict_correct", "1");
+        stat_predict_incorrect = registerStatistic<uint64_t>("branch_predict_incorrect", "1");
+        stat_table_probes = registerStatistic<uint64_t>("branch_table_probes", "1");
+        stat_ras_predict = registerStatistic<uint64_t>("branch_ras_predict", "1");
+    }
+
+    virtual ~VanadisGShareBranchUnit() {}
+
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) {
+        train(ins_addr, pred_addr, tableIndex(ins_addr));
+    }
+
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr, const uint64_t pred_tag, const bool mispredicted) {
+        if (mispredicted) {
+            stat_predict_incorrect->addData(1);
+        } else {
+            stat_predict_correct->addData(1);
+        }
+
+        const GSharePrediction* prediction = findPrediction(pred_tag, ins_addr);
+        train(ins_addr, pred_addr, (nullptr == prediction) ? tableIndex(ins_addr) : prediction->index);
+    }
+
+    virtual void notifyCall(const uint64_t ins_addr, const uint64_t return_addr) {
+        ras.push(return_addr);
+        last_lookup_valid = false;
+    }
+
+    virtual uint64_t predictAddress(const uint64_t addr) {
+        const GSharePrediction& prediction = lookup(addr);
+        return prediction.found ? prediction.target : 0;
+    }
+
+    virtual bool contains(const uint64_t addr) {
+        const bool found = lookup(addr).found;
+
+        if (found) {
+            stat_branch_hits->addData(1);
+        } else {
+            stat_branch_misses->addData(1);
+        }
+
+        return found;
+    }
+
+    virtual uint64_t predictionTag() const { return last_lookup_valid ? last_lookup_tag : 0; }
+
+protected:
+    struct GShareEntry {
+        GShareEntry() : ins_addr(0), target(0), confidence(0) {}
+
+        uint64_t ins_addr;
+        uint64_t target;
+        uint8_t confidence;
+    };
+
+    // The state a prediction was made from, kept until the branch retires
+    // or the slot is reused by a later prediction
+    struct GSharePrediction {
+        GSharePrediction() : tag(0), ins_addr(0), index(0), target(0), found(false) {}
+
+        uint64_t tag;
+        uint64_t ins_addr;
+        uint64_t index;
+        uint64_t target;
+        bool found;
+    };
+
+    // enough slots to cover the branches in flight in a large reorder buffer
+    static const uint64_t prediction_slots = 256;
+
+    void train(const uint64_t ins_addr, const uint64_t pred_addr, const uint64_t index) {
+        uint64_t& return_mark = return_marks[(ins_addr >> 1) & index_mask];
+
+        if ((!ras.empty()) && (ras.peek() == pred_addr)) {
+            ras.pop();
+            return_mark = ins_addr;
+        } else if (return_mark == ins_addr) {
+            return_mark = 0;
+        }
+
+        GShareEntry& entry = table[index];
+
+        if (entry.ins_addr == ins_addr) {
+            if (entry.target == pred_addr) {
+                entry.confidence = (entry.confidence < 3) ? entry.confidence + 1 : 3;
+            } else if (entry.confidence > 0) {
+                entry.confidence--;
+            } else {
+                entry.target = pred_addr;
+            }
+        } else {
+            if (0 != entry.ins_addr) {
+                stat_branch_cache_castout->addData(1);
+            }
+
+            entry.ins_addr = ins_addr;
+            entry.target = pred_addr;
+            entry.confidence = 0;
+        }
+
+        updateHistory(ins_addr, pred_addr);
+    }
+
+    uint64_t tableIndex(const uint64_t ins_addr) const {
+        return ((ins_addr >> 1) ^ (history & history_mask)) & index_mask;
+    }
+
+    const GSharePrediction* findPrediction(const uint64_t tag, const uint64_t ins_addr) const {
+        if (0 == tag) {
+            return nullptr;
+        }
+
+        const GSharePrediction& prediction = predictions[tag % prediction_slots];
+        return ((prediction.tag == tag) && (prediction.ins_addr == ins_addr)) ? &prediction : nullptr;
+    }
+
+    // The decoder asks contains() and then predictAddress() for the same
+    // address, the result is held until the history or stack next changes
+    const GSharePrediction& lookup(const uint64_t ins_addr) {
+        if (last_lookup_valid && (predictions[last_lookup_tag % prediction_slots].ins_addr == ins_addr)) {
+            return predictions[last_lookup_tag % prediction_slots];
+        }
+
+        last_lookup_tag = next_prediction_tag++;
+
+        GSharePrediction& result = predictions[last_lookup_tag % prediction_slots];
+        result.tag = last_lookup_tag;
+        result.ins_addr = ins_addr;
+        result.index = tableIndex(ins_addr);
+        result.target = 0;
+        result.found = false;
+
+        if ((return_marks[(ins_addr >> 1) & index_mask] == ins_addr) && (!ras.empty())) {
+            result.target = ras.peek();
+            result.found = true;
+            stat_ras_predict->addData(1);
+        } else {
+            const GShareEntry& entry = table[result.index];
+            stat_table_probes->addData(1);
+
+            if (entry.ins_addr == ins_addr) {
+                result.target = entry.target;
+                result.found = true;
+            }
+        }
+
+        last_lookup_valid = true;
+
+        return result;
+    }
+
+    void updateHistory(const uint64_t ins_addr, const uint64_t target) {
+        // a target within two instructions of the branch is treated as a fall-through
+        const uint64_t taken = ((target > ins_addr) && (target <= (ins_addr + 8))) ? 0 : 1;
+        history = (history << 2) | (taken << 1) | ((target >> 2) & 0x1);
+        last_lookup_valid = false;
+    }
+
+    std::vector<GShareEntry> table;
+    std::vector<uint64_t> return_marks;
+    VanadisReturnAddressStack ras;
+
+    uint64_t index_mask;
+    uint64_t history_mask;
+    uint64_t history;
+
+    std::vector<GSharePrediction> predictions;
+    uint64_t next_prediction_tag;
+
+    bool last_lookup_valid;
+    uint64_t last_lookup_tag;
+
+    Statistic<uint64_t>* stat_branch_cache_castout;
+    Statistic<uint64_t>* stat_branch_hits;
+    Statistic<uint64_t>* stat_branch_misses;
+    Statistic<uint64_t>* stat_predict_correct;
+    Statistic<uint64_t>* stat_predict_incorrect;
+    Statistic<uint64_t>* stat_table_probes;
+    Statistic<uint64_t>* stat_ras_predict;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
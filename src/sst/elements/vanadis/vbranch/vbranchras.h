@@ -0,0 +1,68 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_RAS
+#define _H_VANADIS_BRANCH_RAS
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Fixed size return address stack, when the stack overflows the oldest
+// entry is overwritten so that deep recursion only loses the outermost
+// return addresses
+class VanadisReturnAddressStack {
+public:
+    VanadisReturnAddressStack(const uint32_t entries) : stack(entries > 0 ? entries : 1, 0), top(0), count(0) {}
+
+    void push(const uint64_t return_addr) {
+        top        = (top + 1) % stack.size();
+        stack[top] = return_addr;
+
+        if (count < stack.size()) {
+            count++;
+        }
+    }
+
+    uint64_t peek() const { return (count > 0) ? stack[top] : 0; }
+
+    uint64_t pop() {
+        if (0 == count) {
+            return 0;
+        }
+
+        const uint64_t return_addr = stack[top];
+        top                        = (top + stack.size() - 1) % stack.size();
+        count--;
+
+        return return_addr;
+    }
+
+    bool empty() const { return 0 == count; }
+    uint32_t size() const { return count; }
+    void clear() { count = 0; }
+
+protected:
+    std::vector<uint64_t> stack;
+    uint32_t top;
+    uint32_t count;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,528 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TAGE
+#define _H_VANADIS_BRANCH_UNIT_TAGE
+
+#include "vbranch/vbranchunit.h"
+#include "vbranch/vbranchras.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// TAGE-style branch target predictor (in the spirit of ITTAGE). A direct
+// mapped base table indexed by branch address supplies a default target and
+// a set of tagged tables, each indexed by the branch address hashed with a
+// geometrically longer slice of the global path history, supply targets for
+// branches whose destination depends on the path taken to reach them. The
+// longest matching tagged table provides the prediction.
+//
+// All tables are flat power-of-two arrays and the folded history used to
+// index each table is recomputed once per retired branch, so a lookup costs
+// one probe per table. History is updated at retire, each prediction records
+// the history and provider it used so the retiring branch trains and
+// allocates against the state it was predicted from.
+class VanadisTAGEBranchUnit : public VanadisBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisTAGEBranchUnit, "vanadis", "VanadisTAGEBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Implements a TAGE-style branch target predictor with a base table, tagged "
+                                          "global history tables and a return address stack",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS({ "branch_entries", "Sets the number of entries in the base table, must be a power of two", "1024" },
+                            { "tagged_tables", "Sets the number of tagged history tables", "4" },
+                            { "tagged_entries", "Sets the number of entries in each tagged table, must be a power of two", "512" },
+                            { "tag_bits", "Sets the number of bits in each tagged table entry tag (max 16)", "11" },
+                            { "min_history", "Sets the history length (in bits) used by the shortest tagged table", "4" },
+                            { "max_history", "Sets the history length (in bits) used by the longest tagged table (max 64)", "64" },
+                            { "useful_reset_period", "Sets the number of updates between ageing the useful counters of tagged entries", "262144" },
+                            { "ras_entries", "Sets the number of entries in the return address stack", "16" })
+
+    SST_ELI_DOCUMENT_STATISTICS({ "branch_cache_hit",
+                                  "Counts the number of times a speculated "
+                                  "address is found in the predictor",
+                                  "hits", 1 },
+                                { "branch_cache_miss",
+                                  "Counts the number of times a speculated "
+                                  "address is not found in the predictor",
+                                  "misses", 1 },
+                                { "branch_cache_castout",
+                                  "Counts the number of base table entries that are replaced by a different branch",
+                                  "entries", 1 },
+                                { "branch_predict_correct",
+                                  "Counts retired branches whose target matched the prediction", "branches", 1 },
+                                { "branch_predict_incorrect",
+                                  "Counts retired branches whose target did not match the prediction", "branches", 1 },
+                                { "branch_table_probes",
+                                  "Counts the number of table entries read to form predictions", "probes", 1 },
+                                { "branch_tagged_provider",
+                                  "Counts the number of predictions supplied by a tagged history table", "predictions", 1 },
+                                { "branch_tagged_alloc",
+                                  "Counts the number of tagged table entries allocated after a misprediction", "entries", 1 },
+                                { "branch_ras_predict",
+                                  "Counts the number of predictions supplied by the return address stack", "predictions", 1 })
+
+    VanadisTAGEBranchUnit(ComponentId_t id, Params& params) : VanadisBranchUnit(id, params),
+        ras(params.find<uint32_t>("ras_entries", 16)) {
+
+        const uint32_t base_entries = params.find<uint32_t>("branch_entries", 1024);
+        const uint32_t table_count = params.find<uint32_t>("tagged_tables", 4);
+        const uint32_t tagged_entries = params.find<uint32_t>("tagged_entries", 512);
+        const uint32_t min_history = params.find<uint32_t>("min_history", 4);
+        const uint32_t max_history = params.find<uint32_t>("max_history", 64);
+
+        tag_bits = params.find<uint32_t>("tag_bits", 11);
+        useful_reset_period = params.find<uint64_t>("useful_reset_period", 262144);
+
+        if (!isPowerOfTwo(base_entries)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                "Error: branch_entries (%" PRIu32 ") must be a power of two.\n", base_entries);
+        }
+
+        if ((table_count > 0) && !isPowerOfTwo(tagged_entries)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                "Error: tagged_entries (%" PRIu32 ") must be a power of two.\n", tagged_entries);
+        }
+
+        if ((tag_bits == 0) || (tag_bits > 16)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                "Error: tag_bits (%" PRIu32 ") must be between 1 and 16.\n", tag_bits);
+        }
+
+        if ((min_history == 0) || (min_history > max_history) || (max_history > 64)) {
+            getSimulationOutput().fatal(CALL_INFO, -1,
+                "Error: history lengths must satisfy 0 < min_history (%" PRIu32 ") <= max_history (%" PRIu32 ") <= 64.\n",
+                min_history, max_history);
+        }
+
+        base_table.resize(base_entries);
+        base_mask = base_entries - 1;
+
+        tagged_index_bits = log2Of(tagged_entries);
+        tagged_mask = tagged_entries - 1;
+        tag_mask = (UINT64_C(1) << tag_bits) - 1;
+
+        tagged_tables.resize(table_count);
+        history_lengths.resize(table_count);
+        folded_index.resize(table_count, 0);
+        folded_tag.resize(table_count, 0);
+
+        for (uint32_t i = 0; i < table_count; ++i) {
+            tagged_tables[i].resize(tagged_entries);
+
+            // geometric series of history lengths between the min and max
+            if (table_count > 1) {
+                history_lengths[i] = static_cast<uint32_t>(std::lround(min_history *
+                    std::pow(static_cast<double>(max_history) / static_cast<double>(min_history),
+                        static_cast<double>(i) / static_cast<double>(table_count - 1))));
+            } else {
+                history_lengths[i] = max_history;
+            }
+        }
+
+        history = 0;
+        update_count = 0;
+
+        predictions.resize(prediction_slots);
+        next_prediction_tag = 1;
+        last_lookup_valid = false;
+
+        stat_branch_hits = registerStatistic<uint64_t>("branch_cache_hit", "1");
+        stat_branch_misses = registerStatistic<uint64_t>("branch_cache_miss", "1");
+        stat_branch_cache_castout = registerStatistic<uint64_t>("branch_cache_castout", "1");
+        stat_predict_correct = registerStatistic<uint64_t>("branch_predict_correct", "1");
+        stat_predict_incorrect = registerStatistic<uint64_t>("branch_predict_incorrect", "1");
+        stat_table_probes = registerStatistic<uint64_t>("branch_table_probes", "1");
+        stat_tagged_provider = registerStatistic<uint64_t>("branch_tagged_provider", "1");
+        stat_tagged_alloc = registerStatistic<uint64_t>("branch_tagged_alloc", "1");
+        stat_ras_predict = registerStatistic<uint64_t>("branch_ras_predict", "1");
+    }
+
+    virtual ~VanadisTAGEBranchUnit() {}
+
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) {
+        train(ins_addr, pred_addr, nullptr);
+    }
+
+    virtual void push(const uint64_t ins_addr, const uint64_t pred_addr, const uint64_t pred_tag, const bool mispredicted) {
+        if (mispredicted) {
+            stat_predict_incorrect->addData(1);
+        } else {
+            stat_predict_correct->addData(1);
+        }
+
+        train(ins_addr, pred_addr, findPrediction(pred_tag, ins_addr));
+    }
+
+    virtual void notifyCall(const uint64_t ins_addr, const uint64_t return_addr) {
+        ras.push(return_addr);
+        last_lookup_valid = false;
+    }
+
+    virtual uint64_t predictAddress(const uint64_t addr) {
+        const TAGELookup& result = lookup(addr);
+        return result.found ? result.target : 0;
+    }
+
+    virtual bool contains(const uint64_t addr) {
+        const bool found = lookup(addr).found;
+
+        if (found) {
+            stat_branch_hits->addData(1);
+        } else {
+            stat_branch_misses->addData(1);
+        }
+
+        return found;
+    }
+
+    virtual uint64_t predictionTag() const { return last_lookup_valid ? last_lookup_tag : 0; }
+
+protected:
+    struct TAGEBaseEntry {
+        TAGEBaseEntry() : ins_addr(0), target(0), confidence(0), is_return(false) {}
+
+        uint64_t ins_addr;
+        uint64_t target;
+        uint8_t confidence;
+        bool is_return;
+    };
+
+    struct TAGETaggedEntry {
+        TAGETaggedEntry() : target(0), tag(0), confidence(0), useful(0), valid(false) {}
+
+        uint64_t target;
+        uint16_t tag;
+        uint8_t confidence;
+        uint8_t useful;
+        bool valid;
+    };
+
+    // The state a prediction was made from, kept until the branch retires
+    // or the slot is reused by a later prediction
+    struct TAGELookup {
+        TAGELookup() : tag(0), addr(0), history(0), target(0), alt_target(0), provider_index(0),
+            provider(-1), provider_tag(0), found(false), alt_found(false) {}
+
+        uint64_t tag;
+        uint64_t addr;
+        uint64_t history;
+        uint64_t target;
+        uint64_t alt_target;
+        uint64_t provider_index;
+        int32_t provider;
+        uint16_t provider_tag;
+        bool found;
+        bool alt_found;
+    };
+
+    // enough slots to cover the branches in flight in a large reorder buffer
+    static const uint64_t prediction_slots = 256;
+
+    // Without a recorded prediction (a unit driven through the two argument
+    // push, or a slot reused before the branch retired) only the base table
+    // is trained and no tagged entry is allocated
+    void train(const uint64_t ins_addr, const uint64_t pred_addr, const TAGELookup* prediction) {
+        TAGEBaseEntry& base = base_table[(ins_addr >> 1) & base_mask];
+        bool is_return = false;
+
+        if ((!ras.empty()) && (ras.peek() == pred_addr)) {
+            ras.pop();
+            is_return = true;
+        }
+
+        if (base.ins_addr == ins_addr) {
+            updateTarget(base.target, base.confidence, pred_addr);
+        } else {
+            if (0 != base.ins_addr) {
+                stat_branch_cache_castout->addData(1);
+            }
+
+            base.ins_addr = ins_addr;
+            base.target = pred_addr;
+            base.confidence = 0;
+        }
+
+        base.is_return = is_return;
+
+        if (nullptr != prediction) {
+            trainTagged(*prediction, pred_addr);
+        }
+
+        update_count++;
+
+        if ((useful_reset_period > 0) && (0 == (update_count % useful_reset_period))) {
+            for (auto& table : tagged_tables) {
+                for (auto& entry : table) {
+                    entry.useful >>= 1;
+                }
+            }
+        }
+
+        updateHistory(ins_addr, pred_addr);
+    }
+
+    void trainTagged(const TAGELookup& result, const uint64_t pred_addr) {
+        if (result.provider >= 0) {
+            TAGETaggedEntry& provider = tagged_tables[result.provider][result.provider_index];
+
+            // the entry may have been reallocated while the branch was in flight
+            if (provider.valid && (provider.tag == result.provider_tag)) {
+                const bool provider_correct = (provider.target == pred_addr);
+
+                if (provider_correct != (result.alt_found && (result.alt_target == pred_addr))) {
+                    if (provider_correct) {
+                        provider.useful = (provider.useful < 3) ? provider.useful + 1 : 3;
+                    } else if (provider.useful > 0) {
+                        provider.useful--;
+                    }
+                }
+
+                updateTarget(provider.target, provider.confidence, pred_addr);
+            }
+        }
+
+        // Only branches we already know about are given a history entry, a
+        // first-seen branch is handled by allocating into the base table
+        if (result.found && (result.target != pred_addr)) {
+            allocate(result.provider + 1, result.addr, pred_addr, result.history);
+        }
+    }
+
+    static bool isPowerOfTwo(const uint32_t v) { return (v != 0) && (0 == (v & (v - 1))); }
+
+    static uint32_t log2Of(uint32_t v) {
+        uint32_t bits = 0;
+
+        while (v > 1) {
+            v >>= 1;
+            bits++;
+        }
+
+        return bits;
+    }
+
+    static uint64_t fold(uint64_t value, const uint32_t length, const uint32_t bits) {
+        if (length < 64) {
+            value &= (UINT64_C(1) << length) - 1;
+        }
+
+        uint64_t folded = 0;
+
+        while (value != 0) {
+            folded ^= value & ((UINT64_C(1) << bits) - 1);
+            value >>= bits;
+        }
+
+        return folded;
+    }
+
+    static void updateTarget(uint64_t& target, uint8_t& confidence, const uint64_t new_target) {
+        if (target == new_target) {
+            confidence = (confidence < 3) ? confidence + 1 : 3;
+        } else if (confidence > 0) {
+            confidence--;
+        } else {
+            target = new_target;
+        }
+    }
+
+    uint64_t foldIndex(const uint32_t table, const uint64_t hist) const {
+        return fold(hist, history_lengths[table], tagged_index_bits > 0 ? tagged_index_bits : 1);
+    }
+
+    uint64_t foldTag(const uint32_t table, const uint64_t hist) const {
+        return fold(hist, history_lengths[table], tag_bits) ^
+            (fold(hist, history_lengths[table], tag_bits > 1 ? tag_bits - 1 : 1) << 1);
+    }
+
+    uint64_t taggedIndex(const uint32_t table, const uint64_t ins_addr, const uint64_t folded) const {
+        return ((ins_addr >> 1) ^ (ins_addr >> (1 + tagged_index_bits)) ^ folded) & tagged_mask;
+    }
+
+    uint16_t taggedTag(const uint64_t ins_addr, const uint64_t folded) const {
+        return static_cast<uint16_t>(((ins_addr >> 1) ^ folded) & tag_mask);
+    }
+
+    const TAGELookup* findPrediction(const uint64_t tag, const uint64_t ins_addr) const {
+        if (0 == tag) {
+            return nullptr;
+        }
+
+        const TAGELookup& prediction = predictions[tag % prediction_slots];
+        return ((prediction.tag == tag) && (prediction.addr == ins_addr)) ? &prediction : nullptr;
+    }
+
+    // The decoder asks contains() and then predictAddress() for the same
+    // address, the result is held until the history or stack next changes
+    const TAGELookup& lookup(const uint64_t ins_addr) {
+        if (last_lookup_valid && (predictions[last_lookup_tag % prediction_slots].addr == ins_addr)) {
+            return predictions[last_lookup_tag % prediction_slots];
+        }
+
+        last_lookup_tag = next_prediction_tag++;
+
+        TAGELookup& result = predictions[last_lookup_tag % prediction_slots];
+        result.tag = last_lookup_tag;
+        result.addr = ins_addr;
+        result.history = history;
+        result.target = 0;
+        result.alt_target = 0;
+        result.provider_index = 0;
+        result.provider = -1;
+        result.provider_tag = 0;
+        result.found = false;
+        result.alt_found = false;
+
+        const TAGEBaseEntry& base = base_table[(ins_addr >> 1) & base_mask];
+        const bool base_hit = (base.ins_addr == ins_addr);
+        uint64_t probes = 1;
+
+        if (base_hit && base.is_return && (!ras.empty())) {
+            result.target = ras.peek();
+            result.found = true;
+            stat_ras_predict->addData(1);
+        } else {
+            // Search from the longest history down, the first match is the
+            // provider and the next is the alternate prediction
+            for (int32_t i = static_cast<int32_t>(tagged_tables.size()) - 1; i >= 0; --i) {
+                const uint64_t index = taggedIndex(i, ins_addr, folded_index[i]);
+                const TAGETaggedEntry& entry = tagged_tables[i][index];
+                probes++;
+
+                if (entry.valid && (entry.tag == taggedTag(ins_addr, folded_tag[i]))) {
+                    if (result.provider < 0) {
+                        result.provider = i;
+                        result.provider_index = index;
+                        result.provider_tag = entry.tag;
+                    } else {
+                        result.alt_target = entry.target;
+                        result.alt_found = true;
+                        break;
+                    }
+                }
+            }
+
+            if ((!result.alt_found) && base_hit) {
+                result.alt_target = base.target;
+                result.alt_found = true;
+            }
+
+            if (result.provider >= 0) {
+                const TAGETaggedEntry& provider = tagged_tables[result.provider][result.provider_index];
+
+                // a newly allocated entry is not trusted over an alternate
+                if ((0 == provider.confidence) && result.alt_found) {
+                    result.target = result.alt_target;
+                } else {
+                    result.target = provider.target;
+                    stat_tagged_provider->addData(1);
+                }
+
+                result.found = true;
+            } else if (base_hit) {
+                result.target = base.target;
+                result.found = true;
+            }
+        }
+
+        stat_table_probes->addData(probes);
+        last_lookup_valid = true;
+
+        return result;
+    }
+
+    // Allocates using the history the branch was predicted with, which is
+    // the history the next lookup along the same path will see
+    void allocate(const int32_t first_table, const uint64_t ins_addr, const uint64_t target, const uint64_t hist) {
+        const int32_t table_count = static_cast<int32_t>(tagged_tables.size());
+
+        for (int32_t i = first_table; i < table_count; ++i) {
+            TAGETaggedEntry& entry = tagged_tables[i][taggedIndex(i, ins_addr, foldIndex(i, hist))];
+
+            if (0 == entry.useful) {
+                entry.target = target;
+                entry.tag = taggedTag(ins_addr, foldTag(i, hist));
+                entry.confidence = 0;
+                entry.valid = true;
+                stat_tagged_alloc->addData(1);
+                return;
+            }
+        }
+
+        // no free entry, age the candidates so a later allocation succeeds
+        for (int32_t i = first_table; i < table_count; ++i) {
+            tagged_tables[i][taggedIndex(i, ins_addr, foldIndex(i, hist))].useful--;
+        }
+    }
+
+    void updateHistory(const uint64_t ins_addr, const uint64_t target) {
+        // a target within two instructions of the branch is treated as a fall-through
+        const uint64_t taken = ((target > ins_addr) && (target <= (ins_addr + 8))) ? 0 : 1;
+        history = (history << 2) | (taken << 1) | ((target >> 2) & 0x1);
+
+        for (size_t i = 0; i < tagged_tables.size(); ++i) {
+            folded_index[i] = foldIndex(i, history);
+            folded_tag[i] = foldTag(i, history);
+        }
+
+        last_lookup_valid = false;
+    }
+
+    std::vector<TAGEBaseEntry> base_table;
+    std::vector<std::vector<TAGETaggedEntry>> tagged_tables;
+    std::vector<uint32_t> history_lengths;
+    std::vector<uint64_t> folded_index;
+    std::vector<uint64_t> folded_tag;
+    VanadisReturnAddressStack ras;
+
+    uint64_t base_mask;
+    uint64_t tagged_mask;
+    uint64_t tag_mask;
+    uint32_t tagged_index_bits;
+    uint32_t tag_bits;
+
+    uint64_t history;
+    uint64_t update_count;
+    uint64_t useful_reset_period;
+
+    std::vector<TAGELookup> predictions;
+    uint64_t next_prediction_tag;
+
+    bool last_lookup_valid;
+    uint64_t last_lookup_tag;
+
+    Statistic<uint64_t>* stat_branch_cache_castout;
+    Statistic<uint64_t>* stat_branch_hits;
+    Statistic<uint64_t>* stat_branch_misses;
+    Statistic<uint64_t>* stat_predict_correct;
+    Statistic<uint64_t>* stat_predict_incorrect;
+    Statistic<uint64_t>* stat_table_probes;
+    Statistic<uint64_t>* stat_tagged_provider;
+    Statistic<uint64_t>* stat_tagged_alloc;
+    Statistic<uint64_t>* stat_ras_predict;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -40,6 +40,22 @@ public:
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
     virtual bool contains(const uint64_t addr) = 0;
+
+    // Units which predict from state that changes between decode and retire
+    // (global history, tagged table contents) return a tag for the state the
+    // last contains()/predictAddress() call used. The decoder stores it on
+    // the branch and it comes back to push() at retire along with whether
+    // the core had to clear the pipeline for this branch.
+    virtual uint64_t predictionTag() const { return 0; }
+    virtual void     push(const uint64_t ins_addr, const uint64_t pred_addr, const uint64_t pred_tag, const bool mispredicted)
+    {
+        push(ins_addr, pred_addr);
+    }
+
+    // Called at retire for branches which write a link register, units
+    // which model a return address stack can use this to record the
+    // address the matching return is expected to jump to
+    virtual void notifyCall(const uint64_t ins_addr, const uint64_t return_addr) {}
 };
 
 } // namespace Vanadis
@@ -32,7 +32,8 @@ using namespace SST::Zodiac;
 #endif
 
 
-SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose)
+SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose,
+	uint32_t prefetchRecords, uint32_t bufferBytes, bool prefetch)
 {
 
 	rank = focusOnRank;
@@ -46,6 +47,18 @@ SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, s
 		exit(-1);
 	}
 
+	// Records are decoded from large reads, so stdio does not need its own buffer
+	setvbuf(trace, NULL, _IONBF, 0);
+
+	stream = new SiriusTraceStream(trace, bufferBytes, prefetchRecords);
+	usePrefetch = prefetch;
+	nextRecord = 0;
+	records.reserve(qLimit);
+
+	if(usePrefetch) {
+		SiriusPrefetcher::getInstance().registerStream(stream);
+	}
+
 	prevEventTime = 0;
 	output = new Output("SiriusReader", verbose, 0, Output::STDOUT);
 	readInit();
@@ -58,14 +71,48 @@ void SiriusReader::close() {
 		output->verbose(CALL_INFO, 4, 0, "Closing trace file.\n");
 	}
 
+	if(usePrefetch) {
+		SiriusPrefetcher::getInstance().unregisterStream(stream);
+	}
+
+	delete stream;
+	stream = NULL;
+
 	fclose(trace);
+	trace = NULL;
 }
 
 uint32_t SiriusReader::generateNextEvents() {
 //	int finalized_reached = 0;
 
 	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
-		generateNextEvent();
+		if(nextRecord == records.size()) {
+			records.clear();
+			nextRecord = 0;
+
+			bool wantsFill = false;
+			if(0 == stream->take(records, qLimit, wantsFill)) {
+				if(stream->exhausted()) {
+					if(SIRIUS_STREAM_TRUNCATED == stream->getStatus()) {
+						output->fatal(CALL_INFO, -1, "Error: Sirius trace for rank %" PRIu32 " is truncated at position %" PRIu64 "\n",
+							rank, stream->getOffset());
+					}
+
+					output->verbose(CALL_INFO, 2, 0, "Trace for rank %" PRIu32 " ended without an MPI_Finalize.\n", rank);
+					break;
+				}
+
+				// The prefetch thread has not caught up, decode in place
+				stream->fill();
+				continue;
+			}
+
+			if(usePrefetch && wantsFill) {
+				SiriusPrefetcher::getInstance().wake();
+			}
+		}
+
+		generateNextEvent(records[nextRecord++]);
 	}
 
 	return (uint32_t) eventQ->size();
@@ -79,10 +126,8 @@ uint32_t SiriusReader::getCurrentQueueSize() {
 	return eventQ->size();
 }
 
-void SiriusReader::generateNextEvent() {
-	uint32_t call_type = readUINT32();
-	double callTime = readTime();
-	double evTimeDiff = callTime - prevEventTime;
+void SiriusReader::generateNextEvent(const SiriusRecord& rec) {
+	double evTimeDiff = rec.callTime - prevEventTime;
 
 	if(evTimeDiff > 0) {
 		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", evTimeDiff);
@@ -91,32 +136,32 @@ void SiriusReader::generateNextEvent() {
 	} else {
 		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
 			"Did not generate next event timing prevTime=%f, callTime=%f, diff=%f\n",
-			prevEventTime, callTime, evTimeDiff);
+			prevEventTime, rec.callTime, evTimeDiff);
 	}
 
-	switch(call_type) {
+	switch(rec.callType) {
 	case SIRIUS_MPI_SEND:
-		readSend();
+		readSend(rec);
 		break;
 
 	case SIRIUS_MPI_RECV:
-		readRecv();
+		readRecv(rec);
 		break;
 
 	case SIRIUS_MPI_IRECV:
-		readIrecv();
+		readIrecv(rec);
 		break;
 
 	case SIRIUS_MPI_ALLREDUCE:
-		readAllreduce();
+		readAllreduce(rec);
 		break;
 
 	case SIRIUS_MPI_BARRIER:
-		readBarrier();
+		readBarrier(rec);
 		break;
 
 	case SIRIUS_MPI_WAIT:
-		readWait();
+		readWait(rec);
 		break;
 
 	case SIRIUS_MPI_INIT:
@@ -128,90 +173,55 @@ void SiriusReader::generateNextEvent() {
 		break;
 
 	default:
-		std::cout << "Unknown MPI command in trace (" << call_type << ") position: " <<
-			ftell(trace) << std::endl;
+		std::cout << "Unknown MPI command in trace (" << rec.callType << ") position: " <<
+			rec.offset << std::endl;
 		exit(-1);
 		break;
 	}
 
-
-	// Read the profiled MPI time
-	prevEventTime = readTime();
-	// read the MPI function result
-	readINT32();
+	// The profiled MPI time
+	prevEventTime = rec.endTime;
 }
 
-void SiriusReader::readAllreduce() {
-	uint64_t sbuff = readUINT64();
-	uint64_t rbuff = readUINT64();
-	uint32_t length = readUINT32();
-	uint32_t dtype = readUINT32();
-	uint32_t op    = readUINT32();
-	uint32_t comm  = readUINT32();
-
+void SiriusReader::readAllreduce(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
 
 	ZodiacAllreduceEvent* ev = new ZodiacAllreduceEvent(
-			length,
-			convertToHermesType(dtype),
-			convertToHermesOp(op),
-			comm);
+			rec.count,
+			convertToHermesType(rec.dtype),
+			convertToHermesOp(rec.op),
+			rec.comm);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readSend() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  dest   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
+void SiriusReader::readSend(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
 
-	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) dest, count,
-		convertToHermesType(dtype), tag, comm);
+	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) rec.peer, rec.count,
+		convertToHermesType(rec.dtype), rec.tag, rec.comm);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readRecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
+void SiriusReader::readRecv(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
 
-	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm);
+	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) rec.peer, rec.count,
+		convertToHermesType(rec.dtype), rec.tag, rec.comm);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readIrecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-	uint64_t req    = readUINT64();
-
+void SiriusReader::readIrecv(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
 
-	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm, req);
+	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) rec.peer, rec.count,
+		convertToHermesType(rec.dtype), rec.tag, rec.comm, rec.request);
 	eventQ->push(ev);
 }
 
-void SiriusReader::readWait() {
-	uint64_t reqID = readUINT64();
-	uint64_t status = readUINT64();
-
+void SiriusReader::readWait(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
 
-	ZodiacWaitEvent* ev = new ZodiacWaitEvent(reqID);
+	ZodiacWaitEvent* ev = new ZodiacWaitEvent(rec.request);
 	eventQ->push(ev);
 }
 
@@ -230,45 +240,13 @@ void SiriusReader::readFinalize() {
 	foundFinalize = true;
 }
 
-void SiriusReader::readBarrier() {
-	uint32_t comm = readUINT32();
-
+void SiriusReader::readBarrier(const SiriusRecord& rec) {
 	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Barrier\n");
 
-	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(comm);
+	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(rec.comm);
 	eventQ->push(ev);
 }
 
-uint32_t SiriusReader::readUINT32() {
-	uint32_t temp;
-	fread(&temp, 1, sizeof(uint32_t), trace);
-	return temp;
-}
-
-uint64_t SiriusReader::readUINT64() {
-	uint64_t temp;
-	fread(&temp, 1, sizeof(uint64_t), trace);
-	return temp;
-}
-
-double SiriusReader::readTime() {
-	double temp;
-	fread(&temp, 1, sizeof(double), trace);
-	return temp;
-}
-
-int32_t SiriusReader::readINT32() {
-	int32_t temp;
-	fread(&temp, 1, sizeof(int32_t), trace);
-	return temp;
-}
-
-int64_t SiriusReader::readINT64() {
-	int64_t temp;
-	fread(&temp, 1, sizeof(int64_t), trace);
-	return temp;
-}
-
 PayloadDataType SiriusReader::convertToHermesType(uint32_t dtype) {
 	PayloadDataType hType = CHAR;
 
@@ -25,11 +25,13 @@
 #include <string>
 #include <iostream>
 #include <queue>
+#include <vector>
 
 #include "sst/core/output.h"
 #include "sst/elements/hermes/msgapi.h"
 
 #include "sirius/siriusconst.h"
+#include "siriusstream.h"
 
 #include "zevent.h"
 #include "zinitevent.h"
@@ -51,7 +53,8 @@ namespace Zodiac {
 
 class SiriusReader {
     public:
-	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose,
+		uint32_t prefetchRecords = 1024, uint32_t bufferBytes = 65536, bool prefetch = true);
         void close();
 	void setOutput(Output* oput);
 	uint32_t generateNextEvents();
@@ -66,21 +69,20 @@ class SiriusReader {
 	bool foundFinalize;
 	std::queue<ZodiacEvent*>* eventQ;
 	FILE* trace;
+	SiriusTraceStream* stream;
+	bool usePrefetch;
+	std::vector<SiriusRecord> records;
+	size_t nextRecord;
 	double prevEventTime;
-	void generateNextEvent();
-	inline uint32_t readUINT32();
-	inline uint64_t readUINT64();
-	inline double readTime();
-	inline int32_t readINT32();
-	inline int64_t readINT64();
-	void readSend();
-	void readIrecv();
-	void readRecv();
+	void generateNextEvent(const SiriusRecord& rec);
+	void readSend(const SiriusRecord& rec);
+	void readIrecv(const SiriusRecord& rec);
+	void readRecv(const SiriusRecord& rec);
 	void readInit();
 	void readFinalize();
-	void readBarrier();
-	void readWait();
-	void readAllreduce();
+	void readBarrier(const SiriusRecord& rec);
+	void readWait(const SiriusRecord& rec);
+	void readAllreduce(const SiriusRecord& rec);
 
 	PayloadDataType convertToHermesType(uint32_t dtype);
 	ReductionOperation convertToHermesOp(uint32_t op);
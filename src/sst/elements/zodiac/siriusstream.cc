@@ -0,0 +1,308 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include <algorithm>
+
+#include "siriusstream.h"
+#include "sirius/siriusconst.h"
+
+using namespace SST::Zodiac;
+
+// call type and call time lead every record, the profiled end time and
+// the MPI return code close it
+static const size_t SIRIUS_RECORD_HEADER  = sizeof(uint32_t) + sizeof(double);
+static const size_t SIRIUS_RECORD_TRAILER = sizeof(double) + sizeof(int32_t);
+
+static size_t siriusBodySize(const uint32_t callType) {
+	switch(callType) {
+	case SIRIUS_MPI_SEND:
+	case SIRIUS_MPI_RECV:
+		return sizeof(uint64_t) + 5 * sizeof(uint32_t);
+	case SIRIUS_MPI_IRECV:
+		return 2 * sizeof(uint64_t) + 5 * sizeof(uint32_t);
+	case SIRIUS_MPI_ALLREDUCE:
+		return 2 * sizeof(uint64_t) + 4 * sizeof(uint32_t);
+	case SIRIUS_MPI_BARRIER:
+		return sizeof(uint32_t);
+	case SIRIUS_MPI_WAIT:
+		return 2 * sizeof(uint64_t);
+	default:
+		return 0;
+	}
+}
+
+static bool siriusKnownCall(const uint32_t callType) {
+	return (SIRIUS_MPI_INIT == callType) || (SIRIUS_MPI_FINALIZE == callType) ||
+		(0 != siriusBodySize(callType));
+}
+
+SiriusTraceStream::SiriusTraceStream(FILE* traceFile, size_t bufferBytes, size_t maxRecords) :
+	trace(traceFile),
+	buffer(std::max(bufferBytes, (size_t) 256)),
+	bufferPos(0),
+	bufferEnd(0),
+	fileOffset(0),
+	ring(std::max(maxRecords, (size_t) 2)),
+	ringHead(0),
+	ringCount(0),
+	endOfTrace(false),
+	status(SIRIUS_STREAM_OK)
+{
+	lowWater = ring.size() / 2;
+}
+
+void SiriusTraceStream::fill() {
+	std::lock_guard<std::mutex> guard(streamLock);
+	fillLocked();
+}
+
+bool SiriusTraceStream::tryFill() {
+	std::unique_lock<std::mutex> guard(streamLock, std::try_to_lock);
+
+	if(!guard.owns_lock() || endOfTrace || ringCount > lowWater) {
+		return false;
+	}
+
+	fillLocked();
+	return true;
+}
+
+void SiriusTraceStream::fillLocked() {
+	while((!endOfTrace) && (ringCount < ring.size())) {
+		SiriusRecord& rec = ring[(ringHead + ringCount) % ring.size()];
+
+		if(!decodeRecord(rec)) {
+			endOfTrace = true;
+			break;
+		}
+
+		ringCount++;
+
+		if(SIRIUS_MPI_FINALIZE == rec.callType || !siriusKnownCall(rec.callType)) {
+			// Nothing follows finalize; an unknown call type is handed to
+			// the reader as-is so it can report it
+			endOfTrace = true;
+		}
+	}
+}
+
+size_t SiriusTraceStream::take(std::vector<SiriusRecord>& out, size_t max, bool& wantsFill) {
+	std::lock_guard<std::mutex> guard(streamLock);
+
+	const size_t count = std::min(max, ringCount);
+	for(size_t i = 0; i < count; i++) {
+		out.push_back(ring[ringHead]);
+		ringHead = (ringHead + 1) % ring.size();
+	}
+
+	// Only ask for a refill when this take crossed the low water mark
+	wantsFill = (!endOfTrace) && (ringCount > lowWater) && (ringCount - count <= lowWater);
+
+	ringCount -= count;
+	return count;
+}
+
+bool SiriusTraceStream::exhausted() {
+	std::lock_guard<std::mutex> guard(streamLock);
+	return endOfTrace && (0 == ringCount);
+}
+
+SiriusStreamStatus SiriusTraceStream::getStatus() {
+	std::lock_guard<std::mutex> guard(streamLock);
+	return status;
+}
+
+uint64_t SiriusTraceStream::getOffset() {
+	std::lock_guard<std::mutex> guard(streamLock);
+	return fileOffset + bufferPos;
+}
+
+bool SiriusTraceStream::ensureBytes(size_t need) {
+	if(bufferEnd - bufferPos >= need) {
+		return true;
+	}
+
+	// Move the partial record to the front and read the next large chunk
+	const size_t remaining = bufferEnd - bufferPos;
+	memmove(&buffer[0], &buffer[bufferPos], remaining);
+	fileOffset += bufferPos;
+	bufferPos = 0;
+	bufferEnd = remaining;
+
+	while(bufferEnd < need) {
+		const size_t got = fread(&buffer[bufferEnd], 1, buffer.size() - bufferEnd, trace);
+		if(0 == got) {
+			return false;
+		}
+		bufferEnd += got;
+	}
+
+	return true;
+}
+
+bool SiriusTraceStream::decodeRecord(SiriusRecord& rec) {
+	if(!ensureBytes(SIRIUS_RECORD_HEADER)) {
+		if(bufferEnd != bufferPos) {
+			status = SIRIUS_STREAM_TRUNCATED;
+		}
+		return false;
+	}
+
+	memset(&rec, 0, sizeof(rec));
+	rec.offset   = fileOffset + bufferPos;
+	rec.callType = next<uint32_t>();
+	rec.callTime = next<double>();
+
+	if(!siriusKnownCall(rec.callType)) {
+		return true;
+	}
+
+	if(!ensureBytes(siriusBodySize(rec.callType) + SIRIUS_RECORD_TRAILER)) {
+		status = SIRIUS_STREAM_TRUNCATED;
+		return false;
+	}
+
+	switch(rec.callType) {
+	case SIRIUS_MPI_SEND:
+	case SIRIUS_MPI_RECV:
+	case SIRIUS_MPI_IRECV:
+		next<uint64_t>();
+		rec.count = next<uint32_t>();
+		rec.dtype = next<uint32_t>();
+		rec.peer  = next<int32_t>();
+		rec.tag   = next<int32_t>();
+		rec.comm  = next<uint32_t>();
+		if(SIRIUS_MPI_IRECV == rec.callType) {
+			rec.request = next<uint64_t>();
+		}
+		break;
+
+	case SIRIUS_MPI_ALLREDUCE:
+		next<uint64_t>();
+		next<uint64_t>();
+		rec.count = next<uint32_t>();
+		rec.dtype = next<uint32_t>();
+		rec.op    = next<uint32_t>();
+		rec.comm  = next<uint32_t>();
+		break;
+
+	case SIRIUS_MPI_BARRIER:
+		rec.comm = next<uint32_t>();
+		break;
+
+	case SIRIUS_MPI_WAIT:
+		rec.request = next<uint64_t>();
+		next<uint64_t>();
+		break;
+
+	default:
+		break;
+	}
+
+	rec.endTime = next<double>();
+	next<int32_t>();
+
+	return true;
+}
+
+SiriusPrefetcher& SiriusPrefetcher::getInstance() {
+	static SiriusPrefetcher instance;
+	return instance;
+}
+
+SiriusPrefetcher::SiriusPrefetcher() :
+	wakeRequested(false),
+	shutdown(false)
+{
+}
+
+SiriusPrefetcher::~SiriusPrefetcher() {
+	std::lock_guard<std::mutex> guard(lifecycleLock);
+	stop();
+}
+
+void SiriusPrefetcher::registerStream(SiriusTraceStream* stream) {
+	std::lock_guard<std::mutex> guard(lifecycleLock);
+
+	{
+		std::lock_guard<std::mutex> registry(registryLock);
+		streams.push_back(stream);
+	}
+
+	if(!helper.joinable()) {
+		shutdown = false;
+		helper = std::thread(&SiriusPrefetcher::run, this);
+	}
+
+	wake();
+}
+
+void SiriusPrefetcher::unregisterStream(SiriusTraceStream* stream) {
+	std::lock_guard<std::mutex> guard(lifecycleLock);
+	bool empty = false;
+
+	{
+		// Waits for any pass of the helper thread to finish with the stream
+		std::lock_guard<std::mutex> registry(registryLock);
+		streams.erase(std::remove(streams.begin(), streams.end(), stream), streams.end());
+		empty = streams.empty();
+	}
+
+	if(empty) {
+		stop();
+	}
+}
+
+void SiriusPrefetcher::wake() {
+	std::lock_guard<std::mutex> guard(wakeLock);
+	wakeRequested = true;
+	wakeCond.notify_one();
+}
+
+void SiriusPrefetcher::stop() {
+	if(!helper.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(wakeLock);
+		shutdown = true;
+		wakeCond.notify_one();
+	}
+
+	helper.join();
+}
+
+void SiriusPrefetcher::run() {
+	while(true) {
+		{
+			std::unique_lock<std::mutex> guard(wakeLock);
+			wakeCond.wait(guard, [this] { return wakeRequested || shutdown; });
+
+			if(shutdown) {
+				break;
+			}
+
+			wakeRequested = false;
+		}
+
+		std::lock_guard<std::mutex> registry(registryLock);
+		for(SiriusTraceStream* stream : streams) {
+			stream->tryFill();
+		}
+	}
+}
@@ -0,0 +1,134 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_SIRIUS_STREAM
+#define _H_ZODIAC_SIRIUS_STREAM
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace Zodiac {
+
+/*
+ * One decoded Sirius trace record. Fields that a call type does not
+ * carry are left zero.
+ */
+class SiriusRecord {
+    public:
+	uint32_t callType;
+	uint32_t count;
+	uint32_t dtype;
+	uint32_t op;
+	int32_t  peer;
+	int32_t  tag;
+	uint32_t comm;
+	uint64_t request;
+	double   callTime;
+	double   endTime;
+	uint64_t offset;
+};
+
+enum SiriusStreamStatus {
+	SIRIUS_STREAM_OK,
+	SIRIUS_STREAM_TRUNCATED
+};
+
+/*
+ * Decodes a Sirius trace from large file reads into a bounded ring of
+ * records. The ring is filled either by the shared prefetch thread or,
+ * when it runs dry, by the simulation thread itself.
+ */
+class SiriusTraceStream {
+    public:
+	SiriusTraceStream(FILE* trace, size_t bufferBytes, size_t maxRecords);
+
+	void fill();
+	bool tryFill();
+	size_t take(std::vector<SiriusRecord>& out, size_t max, bool& wantsFill);
+	bool exhausted();
+	SiriusStreamStatus getStatus();
+	uint64_t getOffset();
+
+    private:
+	void fillLocked();
+	bool decodeRecord(SiriusRecord& rec);
+	bool ensureBytes(size_t need);
+
+	template<typename T> T next() {
+		T value;
+		memcpy(&value, &buffer[bufferPos], sizeof(T));
+		bufferPos += sizeof(T);
+		return value;
+	}
+
+	std::mutex streamLock;
+	FILE* trace;
+
+	std::vector<char> buffer;
+	size_t bufferPos;
+	size_t bufferEnd;
+	uint64_t fileOffset;
+
+	std::vector<SiriusRecord> ring;
+	size_t ringHead;
+	size_t ringCount;
+	size_t lowWater;
+
+	bool endOfTrace;
+	SiriusStreamStatus status;
+};
+
+/*
+ * A single helper thread per process that keeps every registered stream's
+ * ring topped up, so that thousands of ranks do not need a thread each.
+ */
+class SiriusPrefetcher {
+    public:
+	static SiriusPrefetcher& getInstance();
+
+	void registerStream(SiriusTraceStream* stream);
+	void unregisterStream(SiriusTraceStream* stream);
+	void wake();
+
+	~SiriusPrefetcher();
+
+    private:
+	SiriusPrefetcher();
+	void run();
+	void stop();
+
+	std::mutex lifecycleLock;
+	std::mutex registryLock;
+	std::mutex wakeLock;
+	std::condition_variable wakeCond;
+
+	std::vector<SiriusTraceStream*> streams;
+	std::thread helper;
+	bool wakeRequested;
+	bool shutdown;
+};
+
+}
+}
+
+#endif
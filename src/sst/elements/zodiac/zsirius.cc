@@ -80,6 +80,10 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
     emptyBufferSize = (uint32_t) params.find("buffer", 4096);
     emptyBuffer = (char*) malloc(sizeof(char) * emptyBufferSize);
 
+    prefetchTrace = params.find<bool>("prefetch", true);
+    prefetchEvents = params.find<uint32_t>("prefetch_events", 1024);
+    traceBufferBytes = params.find<uint32_t>("trace_buffer", 65536);
+
     // Make sure we don't stop the simulation until we are ready
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -101,7 +105,8 @@ void ZodiacSiriusTraceReader::setup() {
     snprintf(trace_name, trace_file.length() + 20, "%s.%d", trace_file.c_str(), rank);
 
     printf("Opening trace file: %s\n", trace_name);
-    trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
+    trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel,
+        prefetchEvents, traceBufferBytes, prefetchTrace);
     trace->setOutput(&zOut);
 
     int count = trace->generateNextEvents();
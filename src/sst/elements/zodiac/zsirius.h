@@ -62,6 +62,9 @@ public:
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
 	{ "buffer", "Sets the size of the buffer to use for message data backing, default is 4096 bytes", "4096" },
+	{ "prefetch", "Decode the trace ahead of the simulation on a shared helper thread (1) or only on demand (0)", "1" },
+	{ "prefetch_events", "Maximum number of decoded trace records buffered per rank", "1024" },
+	{ "trace_buffer", "Size in bytes of each read from the trace file", "65536" },
     	{ "name","used internally","" },
     	{ "module","used internally","" }
   )
@@ -157,6 +160,10 @@ private:
   uint64_t* accumulateTimeInto;
   double scaleCompute;
 
+  bool prefetchTrace;
+  uint32_t prefetchEvents;
+  uint32_t traceBufferBytes;
+
   ////////////////////////////////////////////////////////
 
 };